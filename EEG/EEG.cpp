@@ -18,6 +18,7 @@
 
 #include "EEG.h"
 #include "Sound_and_Spectrum.h"
+#include "MelderThread.h"
 
 #include "oo_DESTROY.h"
 #include "EEG_def.h"
@@ -92,343 +93,401 @@ integer EEG_getChannelNumber (EEG me, conststring32 channelName) {
 	return 0;
 }
 
-autoEEG EEG_readFromBdfFile (MelderFile file) {
-	try {
-		autofile f = Melder_fopen (file, "rb");
-		char buffer [81];
-		(void) fread (buffer, 1, 8, f);
-		buffer [8] = '\0';
-		const bool is24bit = ( buffer [0] == (char) 255 );
-		(void) fread (buffer, 1, 80, f);
-		buffer [80] = '\0';
-		trace (U"Local subject identification: \"", Melder_peek8to32 (buffer), U"\"");
-		(void) fread (buffer, 1, 80, f);
-		buffer [80] = '\0';
-		trace (U"Local recording identification: \"", Melder_peek8to32 (buffer), U"\"");
-		(void) fread (buffer, 1, 8, f);
-		buffer [8] = '\0';
-		trace (U"Start date of recording: \"", Melder_peek8to32 (buffer), U"\"");
-		(void) fread (buffer, 1, 8, f);
+static conststring32 theNamesOf32CapElectrodes [] = {
+	U"Fp1", U"AF3", U"F7", U"F3", U"FC1", U"FC5", U"T7", U"C3",
+	U"CP1", U"CP5", U"P7", U"P3", U"Pz", U"PO3", U"O1", U"Oz",
+	U"O2", U"PO4", U"P4", U"P8", U"CP6", U"CP2", U"C4", U"T8",
+	U"FC6", U"FC2", U"F4", U"F8", U"AF4", U"Fp2", U"Fz", U"Cz"
+};
+
+static conststring32 theNamesOf64CapElectrodes [] = {
+	U"Fp1", U"AF7", U"AF3", U"F1", U"F3", U"F5", U"F7", U"FT7",
+	U"FC5", U"FC3", U"FC1", U"C1", U"C3", U"C5", U"T7", U"TP7",
+	U"CP5", U"CP3", U"CP1", U"P1", U"P3", U"P5", U"P7", U"P9",
+	U"PO7", U"PO3", U"O1", U"Iz", U"Oz", U"POz", U"Pz", U"CPz",
+	U"Fpz", U"Fp2", U"AF8", U"AF4", U"AFz", U"Fz", U"F2", U"F4",
+	U"F6", U"F8", U"FT8", U"FC6", U"FC4", U"FC2", U"FCz", U"Cz",
+	U"C2", U"C4", U"C6", U"T8", U"TP8", U"CP6", U"CP4", U"CP2",
+	U"P2", U"P4", U"P6", U"P8", U"P10", U"PO8", U"PO4", U"O2"
+};
+
+void BdfFile_open (BdfFile *me, MelderFile file) {
+	MelderFile_copy (file, & my file);
+	my f = Melder_fopen (file, "rb");
+	char buffer [81];
+	(void) fread (buffer, 1, 8, my f);
+	buffer [8] = '\0';
+	my is24bit = ( buffer [0] == (char) 255 );
+	(void) fread (buffer, 1, 80, my f);
+	buffer [80] = '\0';
+	trace (U"Local subject identification: \"", Melder_peek8to32 (buffer), U"\"");
+	(void) fread (buffer, 1, 80, my f);
+	buffer [80] = '\0';
+	trace (U"Local recording identification: \"", Melder_peek8to32 (buffer), U"\"");
+	(void) fread (buffer, 1, 8, my f);
+	buffer [8] = '\0';
+	trace (U"Start date of recording: \"", Melder_peek8to32 (buffer), U"\"");
+	(void) fread (buffer, 1, 8, my f);
+	buffer [8] = '\0';
+	trace (U"Start time of recording: \"", Melder_peek8to32 (buffer), U"\"");
+	(void) fread (buffer, 1, 8, my f);
+	buffer [8] = '\0';
+	const integer numberOfBytesInHeaderRecord = atol (buffer);
+	trace (U"Number of bytes in header record: ", numberOfBytesInHeaderRecord);
+	(void) fread (buffer, 1, 44, my f);
+	buffer [44] = '\0';
+	trace (U"Version of data format: \"", Melder_peek8to32 (buffer), U"\"");
+	(void) fread (buffer, 1, 8, my f);
+	buffer [8] = '\0';
+	my numberOfDataRecords = strtol (buffer, nullptr, 10);
+	trace (U"Number of data records: ", my numberOfDataRecords);
+	(void) fread (buffer, 1, 8, my f);
+	buffer [8] = '\0';
+	my durationOfDataRecord = atof (buffer);
+	trace (U"Duration of a data record: ", my durationOfDataRecord);
+	(void) fread (buffer, 1, 4, my f);
+	buffer [4] = '\0';
+	const integer numberOfChannels = my numberOfChannels = atol (buffer);
+	trace (U"Number of channels in data record: ", numberOfChannels);
+	if (numberOfBytesInHeaderRecord != (numberOfChannels + 1) * 256)
+		Melder_throw (U"Number of bytes in header record (", numberOfBytesInHeaderRecord,
+			U") doesn't match number of channels (", numberOfChannels, U").");
+	my channelNames = autoSTRVEC (numberOfChannels);
+	for (integer ichannel = 1; ichannel <= numberOfChannels; ichannel ++) {
+		(void) fread (buffer, 1, 16, my f);
+		buffer [16] = '\0';   // labels of the channels
+		/*
+		 * Strip all final spaces.
+		 */
+		for (int i = 15; i >= 0; i --) {
+			if (buffer [i] == ' ')
+				buffer [i] = '\0';
+			else
+				break;
+		}
+		my channelNames [ichannel] = Melder_8to32 (buffer);
+		trace (U"Channel <<", my channelNames [ichannel].get(), U">>");
+	}
+	my hasLetters = str32equ (my channelNames [numberOfChannels].get(), U"EDF Annotations");
+	my samplingFrequency = undefined;
+	for (integer channel = 1; channel <= numberOfChannels; channel ++) {
+		(void) fread (buffer, 1, 80, my f);
+		buffer [80] = '\0';   // transducer type
+	}
+	for (integer channel = 1; channel <= numberOfChannels; channel ++) {
+		(void) fread (buffer, 1, 8, my f);
+		buffer [8] = '\0';   // physical dimension of channels
+	}
+	autoVEC physicalMinimum = raw_VEC (numberOfChannels);
+	for (integer ichannel = 1; ichannel <= numberOfChannels; ichannel ++) {
+		(void) fread (buffer, 1, 8, my f);
 		buffer [8] = '\0';
-		trace (U"Start time of recording: \"", Melder_peek8to32 (buffer), U"\"");
-		(void) fread (buffer, 1, 8, f);
+		physicalMinimum [ichannel] = atof (buffer);
+	}
+	autoVEC physicalMaximum = raw_VEC (numberOfChannels);
+	for (integer ichannel = 1; ichannel <= numberOfChannels; ichannel ++) {
+		(void) fread (buffer, 1, 8, my f);
 		buffer [8] = '\0';
-		const integer numberOfBytesInHeaderRecord = atol (buffer);
-		trace (U"Number of bytes in header record: ", numberOfBytesInHeaderRecord);
-		(void) fread (buffer, 1, 44, f);
-		buffer [44] = '\0';
-		trace (U"Version of data format: \"", Melder_peek8to32 (buffer), U"\"");
-		(void) fread (buffer, 1, 8, f);
+		physicalMaximum [ichannel] = atof (buffer);
+	}
+	autoVEC digitalMinimum = raw_VEC (numberOfChannels);
+	for (integer ichannel = 1; ichannel <= numberOfChannels; ichannel ++) {
+		(void) fread (buffer, 1, 8, my f);
 		buffer [8] = '\0';
-		const integer numberOfDataRecords = strtol (buffer, nullptr, 10);
-		trace (U"Number of data records: ", numberOfDataRecords);
-		(void) fread (buffer, 1, 8, f);
+		digitalMinimum [ichannel] = atof (buffer);
+	}
+	autoVEC digitalMaximum = raw_VEC (numberOfChannels);
+	for (integer ichannel = 1; ichannel <= numberOfChannels; ichannel ++) {
+		(void) fread (buffer, 1, 8, my f);
 		buffer [8] = '\0';
-		const double durationOfDataRecord = atof (buffer);
-		trace (U"Duration of a data record: ", durationOfDataRecord);
-		(void) fread (buffer, 1, 4, f);
-		buffer [4] = '\0';
-		const integer numberOfChannels = atol (buffer);
-		trace (U"Number of channels in data record: ", numberOfChannels);
-		if (numberOfBytesInHeaderRecord != (numberOfChannels + 1) * 256)
-			Melder_throw (U"Number of bytes in header record (", numberOfBytesInHeaderRecord,
-				U") doesn't match number of channels (", numberOfChannels, U").");
-		autoSTRVEC channelNames (numberOfChannels);
-		for (integer ichannel = 1; ichannel <= numberOfChannels; ichannel ++) {
-			(void) fread (buffer, 1, 16, f);
-			buffer [16] = '\0';   // labels of the channels
-			/*
-			 * Strip all final spaces.
-			 */
-			for (int i = 15; i >= 0; i --) {
-				if (buffer [i] == ' ')
-					buffer [i] = '\0';
-				else
-					break;
-			}
-			channelNames [ichannel] = Melder_8to32 (buffer);
-			trace (U"Channel <<", channelNames [ichannel].get(), U">>");
-		}
-		const bool hasLetters = str32equ (channelNames [numberOfChannels].get(), U"EDF Annotations");
-		double samplingFrequency = undefined;
-		for (integer channel = 1; channel <= numberOfChannels; channel ++) {
-			(void) fread (buffer, 1, 80, f);
-			buffer [80] = '\0';   // transducer type
-		}
-		for (integer channel = 1; channel <= numberOfChannels; channel ++) {
-			(void) fread (buffer, 1, 8, f);
-			buffer [8] = '\0';   // physical dimension of channels
-		}
-		autoVEC physicalMinimum = raw_VEC (numberOfChannels);
-		for (integer ichannel = 1; ichannel <= numberOfChannels; ichannel ++) {
-			(void) fread (buffer, 1, 8, f);
-			buffer [8] = '\0';
-			physicalMinimum [ichannel] = atof (buffer);
-		}
-		autoVEC physicalMaximum = raw_VEC (numberOfChannels);
-		for (integer ichannel = 1; ichannel <= numberOfChannels; ichannel ++) {
-			(void) fread (buffer, 1, 8, f);
-			buffer [8] = '\0';
-			physicalMaximum [ichannel] = atof (buffer);
-		}
-		autoVEC digitalMinimum = raw_VEC (numberOfChannels);
-		for (integer ichannel = 1; ichannel <= numberOfChannels; ichannel ++) {
-			(void) fread (buffer, 1, 8, f);
-			buffer [8] = '\0';
-			digitalMinimum [ichannel] = atof (buffer);
-		}
-		autoVEC digitalMaximum = raw_VEC (numberOfChannels);
-		for (integer ichannel = 1; ichannel <= numberOfChannels; ichannel ++) {
-			(void) fread (buffer, 1, 8, f);
-			buffer [8] = '\0';
-			digitalMaximum [ichannel] = atof (buffer);
-		}
-		for (integer channel = 1; channel <= numberOfChannels; channel ++) {
-			(void) fread (buffer, 1, 80, f);
-			buffer [80] = '\0';   // prefiltering
-		}
-		integer numberOfSamplesPerDataRecord = 0;
-		for (integer channel = 1; channel <= numberOfChannels; channel ++) {
-			(void) fread (buffer, 1, 8, f);
-			buffer [8] = '\0';   // number of samples in each data record
-			const integer numberOfSamplesInThisDataRecord = atol (buffer);
-			if (isundef (samplingFrequency)) {
-				numberOfSamplesPerDataRecord = numberOfSamplesInThisDataRecord;
-				samplingFrequency = numberOfSamplesInThisDataRecord / durationOfDataRecord;
-			}
-			if (numberOfSamplesInThisDataRecord / durationOfDataRecord != samplingFrequency)
-				Melder_throw (U"Number of samples per data record in channel ", channel,
-					U" (", numberOfSamplesInThisDataRecord,
-					U") doesn't match sampling frequency of channel 1 (", samplingFrequency, U").");
-		}
-		for (integer channel = 1; channel <= numberOfChannels; channel ++) {
-			(void) fread (buffer, 1, 32, f);
-			buffer [32] = '\0';   // reserved
+		digitalMaximum [ichannel] = atof (buffer);
+	}
+	for (integer channel = 1; channel <= numberOfChannels; channel ++) {
+		(void) fread (buffer, 1, 80, my f);
+		buffer [80] = '\0';   // prefiltering
+	}
+	my numberOfSamplesPerDataRecord = 0;
+	for (integer channel = 1; channel <= numberOfChannels; channel ++) {
+		(void) fread (buffer, 1, 8, my f);
+		buffer [8] = '\0';   // number of samples in each data record
+		const integer numberOfSamplesInThisDataRecord = atol (buffer);
+		if (isundef (my samplingFrequency)) {
+			my numberOfSamplesPerDataRecord = numberOfSamplesInThisDataRecord;
+			my samplingFrequency = numberOfSamplesInThisDataRecord / my durationOfDataRecord;
 		}
-		const double duration = numberOfDataRecords * durationOfDataRecord;
-		autoEEG him = EEG_create (0, duration);
-		his numberOfChannels = numberOfChannels;
-		autoSound me = Sound_createSimple (numberOfChannels, duration, samplingFrequency);
-		Melder_assert (my nx == numberOfSamplesPerDataRecord * numberOfDataRecords);
-		autoBYTEVEC dataBuffer = zero_BYTEVEC (3 * numberOfSamplesPerDataRecord);
-		for (integer record = 1; record <= numberOfDataRecords; record ++) {
-			for (integer channel = 1; channel <= numberOfChannels; channel ++) {
-				double factor = ( channel == numberOfChannels ? 1.0 : physicalMinimum [channel] / digitalMinimum [channel] );
-				if (channel < numberOfChannels - EEG_getNumberOfExtraSensors (him.get()))
-					factor /= 1000000.0;
-				if (is24bit) {
-					(void) fread (dataBuffer.asArgumentToFunctionThatExpectsZeroBasedArray(), 3, (size_t) numberOfSamplesPerDataRecord, f);
-					byte *p = & dataBuffer [1];
-					for (integer i = 1; i <= numberOfSamplesPerDataRecord; i ++) {
-						const integer sample = i + (record - 1) * numberOfSamplesPerDataRecord;
-						Melder_assert (sample <= my nx);
-						const uint8 lowByte = *p ++, midByte = *p ++, highByte = *p ++;
-						uint32 externalValue = ((uint32) highByte << 16) | ((uint32) midByte << 8) | (uint32) lowByte;
-						if ((highByte & 128) != 0)   // is the 24-bit sign bit on?
-							externalValue |= 0xFF00'0000;   // extend negative sign to 32 bits
-						my z [channel] [sample] = (int32) externalValue * factor;
-					}
-				} else {
-					(void) fread (dataBuffer.asArgumentToFunctionThatExpectsZeroBasedArray(), 2, (size_t) numberOfSamplesPerDataRecord, f);
-					byte *p = & dataBuffer [1];
-					for (integer i = 1; i <= numberOfSamplesPerDataRecord; i ++) {
-						const integer sample = i + (record - 1) * numberOfSamplesPerDataRecord;
-						Melder_assert (sample <= my nx);
-						const uint8 lowByte = *p ++, highByte = *p ++;
-						const uint16 externalValue = (uint16) ((uint16) highByte << 8) | (uint16) lowByte;
-						my z [channel] [sample] = (int16) externalValue * factor;
+		if (numberOfSamplesInThisDataRecord / my durationOfDataRecord != my samplingFrequency)
+			Melder_throw (U"Number of samples per data record in channel ", channel,
+				U" (", numberOfSamplesInThisDataRecord,
+				U") doesn't match sampling frequency of channel 1 (", my samplingFrequency, U").");
+	}
+	for (integer channel = 1; channel <= numberOfChannels; channel ++) {
+		(void) fread (buffer, 1, 32, my f);
+		buffer [32] = '\0';   // reserved
+	}
+	my factors = raw_VEC (numberOfChannels);
+	for (integer channel = 1; channel <= numberOfChannels; channel ++) {
+		my factors [channel] = ( channel == numberOfChannels ? 1.0 : physicalMinimum [channel] / digitalMinimum [channel] );
+		if (channel < numberOfChannels - EEG_getNumberOfExtraSensors (numberOfChannels))
+			my factors [channel] /= 1000000.0;
+	}
+	if (EEG_getNumberOfCapElectrodes (numberOfChannels) == 32)
+		for (integer channel = 1; channel <= 32; channel ++)
+			my channelNames [channel] = Melder_dup (theNamesOf32CapElectrodes [channel - 1]);
+	else if (EEG_getNumberOfCapElectrodes (numberOfChannels) == 64)
+		for (integer channel = 1; channel <= 64; channel ++)
+			my channelNames [channel] = Melder_dup (theNamesOf64CapElectrodes [channel - 1]);
+}
+
+void BdfFile_readSamples (BdfFile *me, integer firstSample, constINTVECVU const& channelNumbers, MATVU const& into) {
+	Melder_assert (into.nrow == channelNumbers.size);
+	for (integer ichan = 1; ichan <= channelNumbers.size; ichan ++)
+		Melder_require (channelNumbers [ichan] >= 1 && channelNumbers [ichan] <= my numberOfChannels,
+			U"There is no channel ", channelNumbers [ichan], U" in ", & my file, U".");
+	into  <<=  0.0;   // for the samples outside the recording
+	const integer numberOfSamplesPerRecord = my numberOfSamplesPerDataRecord;
+	const integer firstSampleToRead = std::max (firstSample, 1_integer);
+	const integer lastSampleToRead = std::min (firstSample + into.ncol - 1, my numberOfDataRecords * numberOfSamplesPerRecord);
+	if (lastSampleToRead < firstSampleToRead)
+		return;
+	const integer firstRecord = (firstSampleToRead - 1) / numberOfSamplesPerRecord + 1;
+	const integer lastRecord = (lastSampleToRead - 1) / numberOfSamplesPerRecord + 1;
+	const integer numberOfBytesPerSample = ( my is24bit ? 3 : 2 );
+	const integer numberOfBytesPerChannel = numberOfSamplesPerRecord * numberOfBytesPerSample;
+	const integer numberOfBytesPerRecord = my numberOfChannels * numberOfBytesPerChannel;
+	/*
+		Read the records in blocks of at most 16 MB, so that the raw recording never has to be in memory as a whole,
+		and decode the records of each block in parallel; different records fill different columns of `into`.
+	*/
+	const integer maximumNumberOfRecordsPerBlock = std::max (1_integer, (16_integer << 20) / numberOfBytesPerRecord);
+	autoBYTEVEC block = raw_BYTEVEC (std::min (maximumNumberOfRecordsPerBlock, lastRecord - firstRecord + 1) * numberOfBytesPerRecord);
+	if (fseeko (my f, off_t ((my numberOfChannels + 1) * 256) + off_t (firstRecord - 1) * off_t (numberOfBytesPerRecord), SEEK_SET) != 0)
+		Melder_throw (U"Cannot seek in ", & my file, U".");
+	for (integer firstRecordOfBlock = firstRecord; firstRecordOfBlock <= lastRecord; firstRecordOfBlock += maximumNumberOfRecordsPerBlock) {
+		const integer numberOfRecordsInBlock = std::min (maximumNumberOfRecordsPerBlock, lastRecord - firstRecordOfBlock + 1);
+		const size_t numberOfBytesInBlock = (size_t) (numberOfRecordsInBlock * numberOfBytesPerRecord);
+		if (fread (block.asArgumentToFunctionThatExpectsZeroBasedArray(), 1, numberOfBytesInBlock, my f) != numberOfBytesInBlock)
+			Melder_throw (U"Cannot read data record ", firstRecordOfBlock, U" from ", & my file, U".");
+		const integer numberOfThreads = MelderThread_getNumberOfThreadsToUse (numberOfRecordsInBlock, 4);
+		MelderThread_runChunks (numberOfThreads, numberOfRecordsInBlock, [&] (integer /* ithread */, integer firstRecordInBlock, integer lastRecordInBlock) {
+			for (integer irecord = firstRecordInBlock; irecord <= lastRecordInBlock; irecord ++) {
+				const integer sampleOffset = (firstRecordOfBlock + irecord - 2) * numberOfSamplesPerRecord;
+				const integer firstSampleInRecord = std::max (firstSampleToRead - sampleOffset, 1_integer);
+				const integer lastSampleInRecord = std::min (lastSampleToRead - sampleOffset, numberOfSamplesPerRecord);
+				for (integer ichan = 1; ichan <= channelNumbers.size; ichan ++) {
+					const integer channel = channelNumbers [ichan];
+					const double factor = my factors [channel];
+					const byte *p = & block [1] + (irecord - 1) * numberOfBytesPerRecord + (channel - 1) * numberOfBytesPerChannel
+							+ (firstSampleInRecord - 1) * numberOfBytesPerSample;
+					double *out = & into [ichan] [sampleOffset + firstSampleInRecord - firstSample + 1];
+					const integer stride = into.colStride;
+					if (my is24bit) {
+						for (integer i = firstSampleInRecord; i <= lastSampleInRecord; i ++, out += stride) {
+							const uint8 lowByte = *p ++, midByte = *p ++, highByte = *p ++;
+							uint32 externalValue = ((uint32) highByte << 16) | ((uint32) midByte << 8) | (uint32) lowByte;
+							if ((highByte & 128) != 0)   // is the 24-bit sign bit on?
+								externalValue |= 0xFF00'0000;   // extend negative sign to 32 bits
+							*out = (int32) externalValue * factor;
+						}
+					} else {
+						for (integer i = firstSampleInRecord; i <= lastSampleInRecord; i ++, out += stride) {
+							const uint8 lowByte = *p ++, highByte = *p ++;
+							const uint16 externalValue = (uint16) ((uint16) highByte << 8) | (uint16) lowByte;
+							*out = (int16) externalValue * factor;
+						}
 					}
 				}
 			}
-		}
-		int numberOfStatusBits = 8;
-		for (integer i = 1; i <= my nx; i ++) {
-			const uint32 value = (uint32) (int32) my z [numberOfChannels] [i];
-			if (value & 0x0000'FF00)
-				numberOfStatusBits = 16;
-		}
-		autoTextGrid thee;
-		if (hasLetters) {
-			thee = TextGrid_create (0, duration, U"Mark Trigger", U"Mark Trigger");
-			autoMelderString letters;
-			double time = undefined;
-			for (integer i = 1; i <= my nx; i ++) {
-				const uint32 value = (uint32) (int32) my z [numberOfChannels] [i];
-				for (int ibyte = 1; ibyte <= numberOfStatusBits / 8; ibyte ++) {
-					const uint32 mask = ( ibyte == 1 ? 0x0000'00ff : 0x0000'ff00 );
-					const char32 kar = ( ibyte == 1 ? (value & mask) : (value & mask) >> 8 );
-					if (kar != U'\0' && kar != 20) {
+		});
+	}
+}
+
+/*
+	`status` holds consecutive samples of the status channel, the first of which lies at time `x1`.
+	If these samples do not start at the beginning of the recording (`isStartOfRecording` is false),
+	the first sample gives the state of the status bits before it,
+	and any letters before the first separator belong to a string that started earlier and are skipped.
+	The number of status bits (8 or 16) is determined from the samples in `status` only.
+*/
+static autoTextGrid TextGrid_createFromBdfStatusChannel (constVEC const& status, bool hasLetters, double duration,
+	double x1, double dx, bool isStartOfRecording)
+{
+	int numberOfStatusBits = 8;
+	for (integer i = 1; i <= status.size; i ++) {
+		const uint32 value = (uint32) (int32) status [i];
+		if (value & 0x0000'FF00)
+			numberOfStatusBits = 16;
+	}
+	autoTextGrid thee;
+	if (hasLetters) {
+		thee = TextGrid_create (0, duration, U"Mark Trigger", U"Mark Trigger");
+		autoMelderString letters;
+		double time = undefined;
+		bool isSkippingLetters = ! isStartOfRecording;
+		for (integer i = 1; i <= status.size; i ++) {
+			const uint32 value = (uint32) (int32) status [i];
+			for (int ibyte = 1; ibyte <= numberOfStatusBits / 8; ibyte ++) {
+				const uint32 mask = ( ibyte == 1 ? 0x0000'00ff : 0x0000'ff00 );
+				const char32 kar = ( ibyte == 1 ? (value & mask) : (value & mask) >> 8 );
+				if (kar != U'\0' && kar != 20) {
+					if (! isSkippingLetters)
 						MelderString_appendCharacter (& letters, kar);
-					} else if (letters. string [0] != U'\0') {
-						if (letters. string [0] == U'+') {
-							if (isdefined (time)) {
-								try {
-									TextGrid_insertPoint (thee.get(), 1, time, U"");
-								} catch (MelderError) {
-									Melder_throw (U"Did not insert empty mark (", letters. string, U") on Mark tier.");
-								}
-								time = undefined;   // defensive
+				} else if (isSkippingLetters) {
+					isSkippingLetters = false;
+				} else if (letters. string [0] != U'\0') {
+					if (letters. string [0] == U'+') {
+						if (isdefined (time)) {
+							try {
+								TextGrid_insertPoint (thee.get(), 1, time, U"");
+							} catch (MelderError) {
+								Melder_throw (U"Did not insert empty mark (", letters. string, U") on Mark tier.");
 							}
-							time = Melder_atof (& letters. string [1]);
-							MelderString_empty (& letters);
-						} else {
-							if (isundef (time)) {
+							time = undefined;   // defensive
+						}
+						time = Melder_atof (& letters. string [1]);
+						MelderString_empty (& letters);
+					} else {
+						if (isundef (time)) {
+							if (isStartOfRecording)
 								Melder_throw (U"Undefined time for label at sample ", i, U".");
-							}
-							try {
-								if (Melder_nequ (letters. string, U"Trigger-", 8)) {
-									try {
-										TextGrid_insertPoint (thee.get(), 2, time, & letters. string [8]);
-									} catch (MelderError) {
-										Melder_clearError ();
-										trace (U"Duplicate trigger at ", time, U" seconds: ", & letters. string [8]);
-									}
-								} else {
-									TextGrid_insertPoint (thee.get(), 1, time, & letters. string [0]);
+							MelderString_empty (& letters);   // its time was before the decoded samples
+							continue;
+						}
+						try {
+							if (Melder_nequ (letters. string, U"Trigger-", 8)) {
+								try {
+									TextGrid_insertPoint (thee.get(), 2, time, & letters. string [8]);
+								} catch (MelderError) {
+									Melder_clearError ();
+									trace (U"Duplicate trigger at ", time, U" seconds: ", & letters. string [8]);
 								}
-							} catch (MelderError) {
-								Melder_throw (U"Did not insert mark (", letters. string, U") on Trigger tier.");
+							} else {
+								TextGrid_insertPoint (thee.get(), 1, time, & letters. string [0]);
 							}
-							time = undefined;   // crucial
-							MelderString_empty (& letters);
+						} catch (MelderError) {
+							Melder_throw (U"Did not insert mark (", letters. string, U") on Trigger tier.");
 						}
+						time = undefined;   // crucial
+						MelderString_empty (& letters);
 					}
 				}
 			}
-			if (isdefined (time)) {
-				TextGrid_insertPoint (thee.get(), 1, time, U"");
-				time = undefined;   // defensive
-			}
-		} else {
-			thee = TextGrid_create (0.0, duration,
-				numberOfStatusBits == 8 ? U"S1 S2 S3 S4 S5 S6 S7 S8" : U"S1 S2 S3 S4 S5 S6 S7 S8 S9 S10 S11 S12 S13 S14 S15 S16",
-				U""
-			);
-			for (int bit = 1; bit <= numberOfStatusBits; bit ++) {
-				const uint32 bitValue = 1 << (bit - 1);
-				IntervalTier tier = (IntervalTier) thy tiers->at [bit];
-				for (integer i = 1; i <= my nx; i ++) {
-					const uint32 previousValue = ( i == 1 ? 0 : (uint32) (int32) my z [numberOfChannels] [i - 1] );
-					const uint32 thisValue = (uint32) (int32) my z [numberOfChannels] [i];
-					if ((thisValue & bitValue) != (previousValue & bitValue)) {
-						const double time = ( i == 1 ? 0.0 : my x1 + (i - 1.5) * my dx );
-						if (time != 0.0)
-							TextGrid_insertBoundary (thee.get(), bit, time);
-						if ((thisValue & bitValue) != 0)
-							TextGrid_setIntervalText (thee.get(), bit, tier -> intervals.size, U"1");
-					}
+		}
+		if (isdefined (time)) {
+			TextGrid_insertPoint (thee.get(), 1, time, U"");
+			time = undefined;   // defensive
+		}
+	} else {
+		thee = TextGrid_create (0.0, duration,
+			numberOfStatusBits == 8 ? U"S1 S2 S3 S4 S5 S6 S7 S8" : U"S1 S2 S3 S4 S5 S6 S7 S8 S9 S10 S11 S12 S13 S14 S15 S16",
+			U""
+		);
+		for (int bit = 1; bit <= numberOfStatusBits; bit ++) {
+			const uint32 bitValue = 1 << (bit - 1);
+			IntervalTier tier = (IntervalTier) thy tiers->at [bit];
+			for (integer i = 1; i <= status.size; i ++) {
+				const uint32 previousValue = ( i == 1 ? 0 : (uint32) (int32) status [i - 1] );
+				const uint32 thisValue = (uint32) (int32) status [i];
+				if ((thisValue & bitValue) != (previousValue & bitValue)) {
+					const double time = ( i == 1 ? 0.0 : x1 + (i - 1.5) * dx );
+					if (time != 0.0)
+						TextGrid_insertBoundary (thee.get(), bit, time);
+					if ((thisValue & bitValue) != 0)
+						TextGrid_setIntervalText (thee.get(), bit, tier -> intervals.size, U"1");
 				}
 			}
 		}
-		f.close (file);
-		his channelNames = std::move (channelNames);
+	}
+	return thee;
+}
+
+autoTextGrid BdfFile_readMarks (BdfFile *me) {
+	/*
+		The marks come from the status channel (the last channel) of the whole recording;
+		only that channel is decoded.
+	*/
+	const double duration = my numberOfDataRecords * my durationOfDataRecord;
+	autoSound status = Sound_createSimple (1, duration, my samplingFrequency);
+	Melder_assert (status -> nx == my numberOfSamplesPerDataRecord * my numberOfDataRecords);
+	BdfFile_readSamples (me, 1, autoINTVEC ({ my numberOfChannels }).get(), status -> z.get());
+	return TextGrid_createFromBdfStatusChannel (status -> z.row (1), my hasLetters, duration, status -> x1, status -> dx, true);
+}
+
+autoTextGrid BdfFile_readMarks_part (BdfFile *me, double fromTime, double toTime) {
+	/*
+		Only the status channel of the records that contain the samples of the part is decoded,
+		together with the record before (for the state of the status bits before the part,
+		and for a string of letters that continues into the part)
+		and the sample after the part (for a boundary between the last sample of the part and `toTime`).
+	*/
+	const double duration = my numberOfDataRecords * my durationOfDataRecord;
+	const integer numberOfSamplesPerRecord = my numberOfSamplesPerDataRecord;
+	const integer numberOfSamples = my numberOfDataRecords * numberOfSamplesPerRecord;
+	const double dx = 1.0 / my samplingFrequency, x1 = 0.5 * dx;
+	const integer itmin = 1 + Melder_iceiling ((fromTime - x1) / dx);
+	const integer itmax = 1 + Melder_ifloor ((toTime - x1) / dx);
+	const integer firstRecord = std::max (1_integer, (Melder_clipped (1_integer, itmin, numberOfSamples) - 1) / numberOfSamplesPerRecord);
+	const integer lastRecord = (Melder_clipped (1_integer, itmax + 1, numberOfSamples) - 1) / numberOfSamplesPerRecord + 1;
+	const integer firstSample = (firstRecord - 1) * numberOfSamplesPerRecord + 1;
+	autoMAT status = raw_MAT (1, (lastRecord - firstRecord + 1) * numberOfSamplesPerRecord);
+	BdfFile_readSamples (me, firstSample, autoINTVEC ({ my numberOfChannels }).get(), status.get());
+	autoTextGrid marks = TextGrid_createFromBdfStatusChannel (status.row (1), my hasLetters, duration,
+			x1 + (firstSample - 1) * dx, dx, firstRecord == 1);
+	return TextGrid_extractPart (marks.get(), fromTime, toTime, true);
+}
+
+autoEEG EEG_readFromBdfFile (MelderFile file) {
+	try {
+		BdfFile bdf { };
+		BdfFile_open (& bdf, file);
+		const integer numberOfChannels = bdf.numberOfChannels;
+		const double duration = bdf.numberOfDataRecords * bdf.durationOfDataRecord;
+		autoEEG him = EEG_create (0, duration);
+		his numberOfChannels = numberOfChannels;
+		autoSound me = Sound_createSimple (numberOfChannels, duration, bdf.samplingFrequency);
+		Melder_assert (my nx == bdf.numberOfSamplesPerDataRecord * bdf.numberOfDataRecords);
+		BdfFile_readSamples (& bdf, 1, to_INTVEC (numberOfChannels).get(), my z.get());
+		his textgrid = TextGrid_createFromBdfStatusChannel (my z.row (numberOfChannels), bdf.hasLetters, duration, my x1, my dx, true);
+		his channelNames = bdf.channelNames.move();
 		his sound = me.move();
-		his textgrid = thee.move();
-		if (EEG_getNumberOfCapElectrodes (him.get()) == 32) {
-			EEG_setChannelName (him.get(), 1, U"Fp1");
-			EEG_setChannelName (him.get(), 2, U"AF3");
-			EEG_setChannelName (him.get(), 3, U"F7");
-			EEG_setChannelName (him.get(), 4, U"F3");
-			EEG_setChannelName (him.get(), 5, U"FC1");
-			EEG_setChannelName (him.get(), 6, U"FC5");
-			EEG_setChannelName (him.get(), 7, U"T7");
-			EEG_setChannelName (him.get(), 8, U"C3");
-			EEG_setChannelName (him.get(), 9, U"CP1");
-			EEG_setChannelName (him.get(), 10, U"CP5");
-			EEG_setChannelName (him.get(), 11, U"P7");
-			EEG_setChannelName (him.get(), 12, U"P3");
-			EEG_setChannelName (him.get(), 13, U"Pz");
-			EEG_setChannelName (him.get(), 14, U"PO3");
-			EEG_setChannelName (him.get(), 15, U"O1");
-			EEG_setChannelName (him.get(), 16, U"Oz");
-			EEG_setChannelName (him.get(), 17, U"O2");
-			EEG_setChannelName (him.get(), 18, U"PO4");
-			EEG_setChannelName (him.get(), 19, U"P4");
-			EEG_setChannelName (him.get(), 20, U"P8");
-			EEG_setChannelName (him.get(), 21, U"CP6");
-			EEG_setChannelName (him.get(), 22, U"CP2");
-			EEG_setChannelName (him.get(), 23, U"C4");
-			EEG_setChannelName (him.get(), 24, U"T8");
-			EEG_setChannelName (him.get(), 25, U"FC6");
-			EEG_setChannelName (him.get(), 26, U"FC2");
-			EEG_setChannelName (him.get(), 27, U"F4");
-			EEG_setChannelName (him.get(), 28, U"F8");
-			EEG_setChannelName (him.get(), 29, U"AF4");
-			EEG_setChannelName (him.get(), 30, U"Fp2");
-			EEG_setChannelName (him.get(), 31, U"Fz");
-			EEG_setChannelName (him.get(), 32, U"Cz");
-		} else if (EEG_getNumberOfCapElectrodes (him.get()) == 64) {
-			EEG_setChannelName (him.get(), 1, U"Fp1");
-			EEG_setChannelName (him.get(), 2, U"AF7");
-			EEG_setChannelName (him.get(), 3, U"AF3");
-			EEG_setChannelName (him.get(), 4, U"F1");
-			EEG_setChannelName (him.get(), 5, U"F3");
-			EEG_setChannelName (him.get(), 6, U"F5");
-			EEG_setChannelName (him.get(), 7, U"F7");
-			EEG_setChannelName (him.get(), 8, U"FT7");
-			EEG_setChannelName (him.get(), 9, U"FC5");
-			EEG_setChannelName (him.get(), 10, U"FC3");
-			EEG_setChannelName (him.get(), 11, U"FC1");
-			EEG_setChannelName (him.get(), 12, U"C1");
-			EEG_setChannelName (him.get(), 13, U"C3");
-			EEG_setChannelName (him.get(), 14, U"C5");
-			EEG_setChannelName (him.get(), 15, U"T7");
-			EEG_setChannelName (him.get(), 16, U"TP7");
-			EEG_setChannelName (him.get(), 17, U"CP5");
-			EEG_setChannelName (him.get(), 18, U"CP3");
-			EEG_setChannelName (him.get(), 19, U"CP1");
-			EEG_setChannelName (him.get(), 20, U"P1");
-			EEG_setChannelName (him.get(), 21, U"P3");
-			EEG_setChannelName (him.get(), 22, U"P5");
-			EEG_setChannelName (him.get(), 23, U"P7");
-			EEG_setChannelName (him.get(), 24, U"P9");
-			EEG_setChannelName (him.get(), 25, U"PO7");
-			EEG_setChannelName (him.get(), 26, U"PO3");
-			EEG_setChannelName (him.get(), 27, U"O1");
-			EEG_setChannelName (him.get(), 28, U"Iz");
-			EEG_setChannelName (him.get(), 29, U"Oz");
-			EEG_setChannelName (him.get(), 30, U"POz");
-			EEG_setChannelName (him.get(), 31, U"Pz");
-			EEG_setChannelName (him.get(), 32, U"CPz");
-			EEG_setChannelName (him.get(), 33, U"Fpz");
-			EEG_setChannelName (him.get(), 34, U"Fp2");
-			EEG_setChannelName (him.get(), 35, U"AF8");
-			EEG_setChannelName (him.get(), 36, U"AF4");
-			EEG_setChannelName (him.get(), 37, U"AFz");
-			EEG_setChannelName (him.get(), 38, U"Fz");
-			EEG_setChannelName (him.get(), 39, U"F2");
-			EEG_setChannelName (him.get(), 40, U"F4");
-			EEG_setChannelName (him.get(), 41, U"F6");
-			EEG_setChannelName (him.get(), 42, U"F8");
-			EEG_setChannelName (him.get(), 43, U"FT8");
-			EEG_setChannelName (him.get(), 44, U"FC6");
-			EEG_setChannelName (him.get(), 45, U"FC4");
-			EEG_setChannelName (him.get(), 46, U"FC2");
-			EEG_setChannelName (him.get(), 47, U"FCz");
-			EEG_setChannelName (him.get(), 48, U"Cz");
-			EEG_setChannelName (him.get(), 49, U"C2");
-			EEG_setChannelName (him.get(), 50, U"C4");
-			EEG_setChannelName (him.get(), 51, U"C6");
-			EEG_setChannelName (him.get(), 52, U"T8");
-			EEG_setChannelName (him.get(), 53, U"TP8");
-			EEG_setChannelName (him.get(), 54, U"CP6");
-			EEG_setChannelName (him.get(), 55, U"CP4");
-			EEG_setChannelName (him.get(), 56, U"CP2");
-			EEG_setChannelName (him.get(), 57, U"P2");
-			EEG_setChannelName (him.get(), 58, U"P4");
-			EEG_setChannelName (him.get(), 59, U"P6");
-			EEG_setChannelName (him.get(), 60, U"P8");
-			EEG_setChannelName (him.get(), 61, U"P10");
-			EEG_setChannelName (him.get(), 62, U"PO8");
-			EEG_setChannelName (him.get(), 63, U"PO4");
-			EEG_setChannelName (him.get(), 64, U"O2");
-		}
 		return him;
 	} catch (MelderError) {
 		Melder_throw (U"BDF file not read.");
 	}
 }
 
+autoEEG EEG_readFromBdfFile_part (MelderFile file, double fromTime, double toTime, constINTVECVU const& channelNumbers) {
+	try {
+		Melder_require (channelNumbers.size > 0,
+			U"The number of channels should be greater than 0.");
+		BdfFile bdf { };
+		BdfFile_open (& bdf, file);
+		const double duration = bdf.numberOfDataRecords * bdf.durationOfDataRecord;
+		if (fromTime >= toTime) {
+			fromTime = 0.0;
+			toTime = duration;
+		}
+		/*
+			The same samples as in `EEG_extractPart (EEG_readFromBdfFile (file), fromTime, toTime, true)`.
+		*/
+		const double dx = 1.0 / bdf.samplingFrequency, x1 = 0.5 * dx;
+		const integer itmin = 1 + Melder_iceiling ((fromTime - x1) / dx);
+		const integer itmax = 1 + Melder_ifloor ((toTime - x1) / dx);
+		Melder_require (itmax >= itmin,
+			U"The part would contain no samples.");
+		autoEEG him = EEG_create (fromTime, toTime);
+		his numberOfChannels = channelNumbers.size;
+		his sound = Sound_create (channelNumbers.size, fromTime, toTime, itmax - itmin + 1, dx, x1 + (itmin - 1) * dx);
+		BdfFile_readSamples (& bdf, itmin, channelNumbers, his sound -> z.get());
+		his channelNames = autoSTRVEC (channelNumbers.size);
+		for (integer ichan = 1; ichan <= channelNumbers.size; ichan ++)
+			his channelNames [ichan] = Melder_dup (bdf.channelNames [channelNumbers [ichan]].get());
+		his textgrid = BdfFile_readMarks_part (& bdf, fromTime, toTime);
+		return him;
+	} catch (MelderError) {
+		Melder_throw (U"Part of BDF file not read.");
+	}
+}
+
 static void detrend (VEC const& channel) {
 	const double firstValue = channel [1], lastValue = channel [channel.size];
 	channel [1] = channel [channel.size] = 0.0;
@@ -443,23 +502,12 @@ void EEG_detrend (EEG me) {
 
 void EEG_filter (EEG me, double lowFrequency, double lowWidth, double highFrequency, double highWidth, bool doNotch50Hz) {
 	try {
-/*
-	integer nsampFFT = 1;
-	while (nsampFFT < my sound -> nx)
-		nsampFFT *= 2;
-	autoNUMfft_Table fftTable;
-	NUMfft_Table_init (& fftTable, nsampFFT);
-*/
-		for (integer ichan = 1; ichan <= my numberOfChannels - EEG_getNumberOfExtraSensors (me); ichan ++) {
-			autoSound channel = Sound_extractChannel (my sound.get(), ichan);
-			autoSpectrum spec = Sound_to_Spectrum (channel.get(), true);
-			Spectrum_passHannBand (spec.get(), lowFrequency, 0.0, lowWidth);
-			Spectrum_passHannBand (spec.get(), 0.0, highFrequency, highWidth);
-			if (doNotch50Hz)
-				Spectrum_stopHannBand (spec.get(), 48.0, 52.0, 1.0);
-			autoSound him = Spectrum_to_Sound (spec.get());
-			my sound -> z.row (ichan)  <<=  his z.row (1).part (1, my sound -> nx);
-		}
+		const integer numberOfChannelsToFilter = my numberOfChannels - EEG_getNumberOfExtraSensors (me);
+		const SpectrumHannBand highPass { false, lowFrequency, 0.0, lowWidth }, lowPass { false, 0.0, highFrequency, highWidth };
+		if (doNotch50Hz)
+			Sound_filterHannBands_inplace (my sound.get(), numberOfChannelsToFilter, { highPass, lowPass, { true, 48.0, 52.0, 1.0 } });
+		else
+			Sound_filterHannBands_inplace (my sound.get(), numberOfChannelsToFilter, { highPass, lowPass });
 	} catch (MelderError) {
 		Melder_throw (me, U": not filtered.");
 	}
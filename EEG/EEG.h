@@ -27,17 +27,50 @@
 autoEEG EEG_create (double tmin, double tmax);
 
 autoEEG EEG_readFromBdfFile (MelderFile file);
+autoEEG EEG_readFromBdfFile_part (MelderFile file, double fromTime, double toTime, constINTVECVU const& channelNumbers);
+
+/*
+	A BDF or EDF recording that stays on disk, so that short windows of a long recording
+	can be read on demand (as with a LongSound) instead of the whole recording being decoded into memory.
+*/
+struct BdfFile {
+	structMelderFile file;
+	autofile f;
+	bool is24bit, hasLetters;
+	integer numberOfChannels, numberOfDataRecords, numberOfSamplesPerDataRecord;
+	double durationOfDataRecord, samplingFrequency;
+	autoSTRVEC channelNames;
+	autoVEC factors;   // from digital values to physical values
+};
+void BdfFile_open (BdfFile *me, MelderFile file);
+void BdfFile_readSamples (BdfFile *me, integer firstSample, constINTVECVU const& channelNumbers, MATVU const& into);
+/*
+	Fills row i of `into` with the samples `firstSample` .. `firstSample + into.ncol - 1` of channel `channelNumbers [i]`;
+	samples outside the recording are set to zero.
+*/
+autoTextGrid BdfFile_readMarks (BdfFile *me);
+autoTextGrid BdfFile_readMarks_part (BdfFile *me, double fromTime, double toTime);
+/*
+	The marks of the part `fromTime` .. `toTime`, with times preserved,
+	decoded from the status channel of only the data records around that part.
+*/
 
 autoEEG EEGs_concatenate (OrderedOf<structEEG>* me);
 
 void EEG_init (EEG me, double tmin, double tmax);
 integer EEG_getChannelNumber (EEG me, conststring32 channelName);
 void EEG_setChannelName (EEG me, integer channelNumber, conststring32 newName);
+static inline integer EEG_getNumberOfCapElectrodes (integer numberOfChannels) {
+	return (numberOfChannels - 1) & ~ 15L;   // BUG
+}
 static inline integer EEG_getNumberOfCapElectrodes (EEG me) {
-	return (my numberOfChannels - 1) & ~ 15L;   // BUG
+	return EEG_getNumberOfCapElectrodes (my numberOfChannels);
+}
+static inline integer EEG_getNumberOfExtraSensors (integer numberOfChannels) {
+	return numberOfChannels == 1 ? 0 : numberOfChannels & 1 ? 1 : 8;   // BUG
 }
 static inline integer EEG_getNumberOfExtraSensors (EEG me) {
-	return my numberOfChannels == 1 ? 0 : my numberOfChannels & 1 ? 1 : 8;   // BUG
+	return EEG_getNumberOfExtraSensors (my numberOfChannels);
 }
 static inline integer EEG_getNumberOfExternalElectrodes (EEG me) {
 	return my numberOfChannels - EEG_getNumberOfCapElectrodes (me) - EEG_getNumberOfExtraSensors (me);
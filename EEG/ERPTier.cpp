@@ -17,6 +17,7 @@
  */
 
 #include "ERPTier.h"
+#include "MelderThread.h"
 
 #include "oo_DESTROY.h"
 #include "ERPTier_def.h"
@@ -64,45 +65,92 @@ double ERPTier_getMean (ERPTier me, integer pointNumber, conststring32 channelNa
 	return ERPTier_getMean (me, pointNumber, ERPTier_getChannelNumber (me, channelName), tmin, tmax);
 }
 
+/*
+	The epoching loop shared by the EEG_to_ERPTier_xxx and ERPTier_readFromBdfFile_xxx functions.
+	All epochs are created here, in the calling thread, with zeroes. Then `readWindow (firstSample, into)` is called for each epoch;
+	it should fill `into` (channels x samples) with the samples `firstSample` .. `firstSample + into.ncol - 1` of the recording,
+	leaving the zeroes outside the recording. If `numberOfThreads` is greater than 1,
+	`readWindow` is called for different epochs from several threads at the same time.
+	The epochs are not carved out of a single contiguous matrix: every ERPPoint owns its Sound,
+	which is how ERPTiers are written to file and how "Extract ERP" and "Remove events" hand them out,
+	so a shared buffer would have to be copied back into separate Sounds anyway.
+	Within an epoch, the samples of each channel are contiguous already.
+*/
+template <typename ReadWindow>
+static autoERPTier PointProcess_to_ERPTier (PointProcess events, double fromTime, double toTime,
+	constSTRVEC const& channelNames, double x1, double samplingPeriod, integer numberOfThreads, ReadWindow const& readWindow)
+{
+	autoERPTier thee = Thing_new (ERPTier);
+	Function_init (thee.get(), fromTime, toTime);
+	thy numberOfChannels = channelNames.size;
+	Melder_assert (thy numberOfChannels > 0);
+	thy channelNames = copy_STRVEC (channelNames);
+	integer numberOfEvents = events -> nt;
+	double soundDuration = toTime - fromTime;
+	integer numberOfSamples = Melder_ifloor (soundDuration / samplingPeriod) + 1;
+	if (numberOfSamples < 1)
+		Melder_throw (U"Time window too short.");
+	double midTime = 0.5 * (fromTime + toTime);
+	double soundPhysicalDuration = numberOfSamples * samplingPeriod;
+	double firstTime = midTime - 0.5 * soundPhysicalDuration + 0.5 * samplingPeriod;   // distribute the samples evenly over the time domain
+	autoINTVEC firstSamples = raw_INTVEC (numberOfEvents);
+	for (integer ievent = 1; ievent <= numberOfEvents; ievent ++) {
+		double eegEventTime = events -> t [ievent];
+		autoERPPoint event = Thing_new (ERPPoint);
+		event -> number = eegEventTime;
+		event -> erp = Sound_create (thy numberOfChannels, fromTime, toTime, numberOfSamples, samplingPeriod, firstTime);
+		double erpEventTime = 0.0;
+		double eegSample = 1 + (eegEventTime - x1) / samplingPeriod;
+		double erpSample = 1 + (erpEventTime - firstTime) / samplingPeriod;
+		integer sampleDifference = Melder_iround (eegSample - erpSample);
+		firstSamples [ievent] = 1 + sampleDifference;
+		thy points. addItem_move (event.move());
+	}
+	Melder_assert (thy points.size == numberOfEvents);   // the events of a PointProcess have distinct times
+	MelderThread_runChunks (numberOfThreads, numberOfEvents, [&] (integer /* ithread */, integer firstEvent, integer lastEvent) {
+		for (integer ievent = firstEvent; ievent <= lastEvent; ievent ++)
+			readWindow (firstSamples [ievent], thy points.at [ievent] -> erp -> z.get());
+	});
+	return thee;
+}
+
 static autoERPTier EEG_PointProcess_to_ERPTier (EEG me, PointProcess events, double fromTime, double toTime) {
 	try {
-		autoERPTier thee = Thing_new (ERPTier);
-		Function_init (thee.get(), fromTime, toTime);
-		thy numberOfChannels = my numberOfChannels - EEG_getNumberOfExtraSensors (me);
-		Melder_assert (thy numberOfChannels > 0);
-		thy channelNames = copy_STRVEC (my channelNames.part (1, thy numberOfChannels));
-		integer numberOfEvents = events -> nt;
-		double soundDuration = toTime - fromTime;
-		double samplingPeriod = my sound -> dx;
-		integer numberOfSamples = Melder_ifloor (soundDuration / samplingPeriod) + 1;
-		if (numberOfSamples < 1)
-			Melder_throw (U"Time window too short.");
-		double midTime = 0.5 * (fromTime + toTime);
-		double soundPhysicalDuration = numberOfSamples * samplingPeriod;
-		double firstTime = midTime - 0.5 * soundPhysicalDuration + 0.5 * samplingPeriod;   // distribute the samples evenly over the time domain
-		for (integer ievent = 1; ievent <= numberOfEvents; ievent ++) {
-			double eegEventTime = events -> t [ievent];
-			autoERPPoint event = Thing_new (ERPPoint);
-			event -> number = eegEventTime;
-			event -> erp = Sound_create (thy numberOfChannels, fromTime, toTime, numberOfSamples, samplingPeriod, firstTime);
-			double erpEventTime = 0.0;
-			double eegSample = 1 + (eegEventTime - my sound -> x1) / samplingPeriod;
-			double erpSample = 1 + (erpEventTime - firstTime) / samplingPeriod;
-			integer sampleDifference = Melder_iround (eegSample - erpSample);
-			for (integer ichannel = 1; ichannel <= thy numberOfChannels; ichannel ++) {
-				for (integer isample = 1; isample <= numberOfSamples; isample ++) {
-					integer jsample = isample + sampleDifference;
-					event -> erp -> z [ichannel] [isample] = jsample < 1 || jsample > my sound -> nx ? 0.0 : my sound -> z [ichannel] [jsample];
-				}
+		const integer numberOfChannels = my numberOfChannels - EEG_getNumberOfExtraSensors (me);
+		/*
+			The recording is in memory, so the epochs can be copied in parallel.
+		*/
+		const integer numberOfThreads = MelderThread_getNumberOfThreadsToUse (events -> nt, 16);
+		return PointProcess_to_ERPTier (events, fromTime, toTime, my channelNames.part (1, numberOfChannels),
+			my sound -> x1, my sound -> dx, numberOfThreads, [&] (integer firstSample, MAT const& into) {
+				const integer offset = firstSample - 1;
+				const integer firstColumn = std::max (1_integer, 1 - offset), lastColumn = std::min (into.ncol, my sound -> nx - offset);
+				if (lastColumn < firstColumn)
+					return;
+				for (integer ichannel = 1; ichannel <= into.nrow; ichannel ++)
+					into.row (ichannel).part (firstColumn, lastColumn)  <<=
+							my sound -> z.row (ichannel).part (firstColumn + offset, lastColumn + offset);
 			}
-			thy points. addItem_move (event.move());
-		}
-		return thee;
+		);
 	} catch (MelderError) {
 		Melder_throw (me, U": ERP analysis not performed.");
 	}
 }
 
+static autoERPTier BdfFile_PointProcess_to_ERPTier (BdfFile *me, PointProcess events, double fromTime, double toTime) {
+	const integer numberOfChannels = my numberOfChannels - EEG_getNumberOfExtraSensors (my numberOfChannels);
+	autoINTVEC channelNumbers = to_INTVEC (numberOfChannels);
+	const double samplingPeriod = 1.0 / my samplingFrequency;
+	/*
+		One thread, because the file has a single read position; BdfFile_readSamples decodes each window in parallel itself.
+	*/
+	return PointProcess_to_ERPTier (events, fromTime, toTime, my channelNames.part (1, numberOfChannels),
+		0.5 * samplingPeriod, samplingPeriod, 1, [&] (integer firstSample, MAT const& into) {
+			BdfFile_readSamples (me, firstSample, channelNumbers.get(), into);
+		}
+	);
+}
+
 autoERPTier EEG_to_ERPTier_bit (EEG me, double fromTime, double toTime, int markerBit) {
 	try {
 		autoPointProcess events = TextGrid_getStartingPoints (my textgrid.get(), markerBit, kMelder_string::EQUAL_TO, U"1");
@@ -180,23 +228,76 @@ autoERPTier EEG_to_ERPTier_triggers_preceded (EEG me, double fromTime, double to
 	}
 }
 
+autoERPTier ERPTier_readFromBdfFile_bit (MelderFile file, double fromTime, double toTime, int markerBit) {
+	try {
+		BdfFile bdf { };
+		BdfFile_open (& bdf, file);
+		autoTextGrid marks = BdfFile_readMarks (& bdf);
+		autoPointProcess events = TextGrid_getStartingPoints (marks.get(), markerBit, kMelder_string::EQUAL_TO, U"1");
+		return BdfFile_PointProcess_to_ERPTier (& bdf, events.get(), fromTime, toTime);
+	} catch (MelderError) {
+		Melder_throw (U"ERPTier not read from ", file, U".");
+	}
+}
+
+autoERPTier ERPTier_readFromBdfFile_marker (MelderFile file, double fromTime, double toTime, uint16 marker) {
+	try {
+		BdfFile bdf { };
+		BdfFile_open (& bdf, file);
+		autoTextGrid marks = BdfFile_readMarks (& bdf);
+		autoPointProcess events = TextGrid_getStartingPoints_multiNumeric (marks.get(), marker);
+		return BdfFile_PointProcess_to_ERPTier (& bdf, events.get(), fromTime, toTime);
+	} catch (MelderError) {
+		Melder_throw (U"ERPTier not read from ", file, U".");
+	}
+}
+
+autoERPTier ERPTier_readFromBdfFile_triggers (MelderFile file, double fromTime, double toTime,
+	kMelder_string which, conststring32 criterion)
+{
+	try {
+		BdfFile bdf { };
+		BdfFile_open (& bdf, file);
+		autoTextGrid marks = BdfFile_readMarks (& bdf);
+		autoPointProcess events = TextGrid_getPoints (marks.get(), 2, which, criterion);
+		return BdfFile_PointProcess_to_ERPTier (& bdf, events.get(), fromTime, toTime);
+	} catch (MelderError) {
+		Melder_throw (U"ERPTier not read from ", file, U".");
+	}
+}
+
+autoERPTier ERPTier_readFromBdfFile_triggers_preceded (MelderFile file, double fromTime, double toTime,
+	kMelder_string which, conststring32 criterion,
+	kMelder_string precededBy, conststring32 criterion_precededBy)
+{
+	try {
+		BdfFile bdf { };
+		BdfFile_open (& bdf, file);
+		autoTextGrid marks = BdfFile_readMarks (& bdf);
+		autoPointProcess events = TextGrid_getPoints_preceded (marks.get(), 2,
+			which, criterion, precededBy, criterion_precededBy);
+		return BdfFile_PointProcess_to_ERPTier (& bdf, events.get(), fromTime, toTime);
+	} catch (MelderError) {
+		Melder_throw (U"ERPTier not read from ", file, U".");
+	}
+}
+
 void ERPTier_subtractBaseline (ERPTier me, double tmin, double tmax) {
 	integer numberOfEvents = my points.size;
 	if (numberOfEvents < 1)
 		return;   // nothing to do
 	ERPPoint firstEvent = my points.at [1];
 	integer numberOfChannels = firstEvent -> erp -> ny;
-	integer numberOfSamples = firstEvent -> erp -> nx;
-	for (integer ievent = 1; ievent <= numberOfEvents; ievent ++) {
-		ERPPoint event = my points.at [ievent];
-		for (integer ichannel = 1; ichannel <= numberOfChannels; ichannel ++) {
-			double mean = Vector_getMean (event -> erp.get(), tmin, tmax, ichannel);
-			VEC channel = event -> erp -> z.row (ichannel);
-			for (integer isample = 1; isample <= numberOfSamples; isample ++) {
-				channel [isample] -= mean;
+	const integer numberOfThreads = MelderThread_getNumberOfThreadsToUse (numberOfEvents, 16);
+	MelderThread_runChunks (numberOfThreads, numberOfEvents, [&] (integer /* ithread */, integer firstEventOfChunk, integer lastEventOfChunk) {
+		for (integer ievent = firstEventOfChunk; ievent <= lastEventOfChunk; ievent ++) {
+			ERPPoint event = my points.at [ievent];
+			for (integer ichannel = 1; ichannel <= numberOfChannels; ichannel ++) {
+				double mean = Vector_getMean (event -> erp.get(), tmin, tmax, ichannel);
+				event -> erp -> z.row (ichannel)  -=  mean;
 			}
 		}
-	}
+	});
 }
 
 void ERPTier_rejectArtefacts (ERPTier me, double threshold) {
@@ -208,22 +309,34 @@ void ERPTier_rejectArtefacts (ERPTier me, double threshold) {
 	integer numberOfSamples = firstEvent -> erp -> nx;
 	if (numberOfSamples < 1)
 		return;   // nothing to do
-	for (integer ievent = numberOfEvents; ievent >= 1; ievent --) {   // cycle down because of removal
-		ERPPoint event = my points.at [ievent];
-		double minimum = event -> erp -> z [1] [1];
-		double maximum = minimum;
-		for (integer ichannel = 1; ichannel <= (numberOfChannels & ~ 15); ichannel ++) {
-			constVEC channel = event -> erp -> z.row (ichannel);
-			for (integer isample = 1; isample <= numberOfSamples; isample ++) {
-				double value = channel [isample];
-				if (value < minimum) minimum = value;
-				if (value > maximum) maximum = value;
+	/*
+		Decide in parallel which events to reject,
+		then remove them in a single pass instead of shifting the remaining events for every removal.
+	*/
+	autoBOOLVEC mustBeRejected = raw_BOOLVEC (numberOfEvents);
+	const integer numberOfThreads = MelderThread_getNumberOfThreadsToUse (numberOfEvents, 16);
+	MelderThread_runChunks (numberOfThreads, numberOfEvents, [&] (integer /* ithread */, integer firstEventOfChunk, integer lastEventOfChunk) {
+		for (integer ievent = firstEventOfChunk; ievent <= lastEventOfChunk; ievent ++) {
+			ERPPoint event = my points.at [ievent];
+			double minimum = event -> erp -> z [1] [1];
+			double maximum = minimum;
+			for (integer ichannel = 1; ichannel <= (numberOfChannels & ~ 15); ichannel ++) {
+				for (const double value : event -> erp -> z.row (ichannel)) {
+					if (value < minimum) minimum = value;
+					if (value > maximum) maximum = value;
+				}
 			}
+			mustBeRejected [ievent] = ( minimum < - threshold || maximum > threshold );
 		}
-		if (minimum < - threshold || maximum > threshold) {
-			my points. removeItem (ievent);
-		}
+	});
+	std::vector <autoERPPoint> keptEvents;
+	for (integer ievent = numberOfEvents; ievent >= 1; ievent --) {   // cycle down, so that every subtraction is from the end
+		autoERPPoint event = my points. subtractItem_move (ievent);
+		if (! mustBeRejected [ievent])
+			keptEvents. push_back (event.move());
 	}
+	for (auto event = keptEvents.rbegin(); event != keptEvents.rend(); ++ event)
+		my points. _insertItem_move (std::move (*event), my points.size + 1);
 }
 
 autoERP ERPTier_extractERP (ERPTier me, integer eventNumber) {
@@ -256,9 +369,21 @@ autoERP ERPTier_to_ERP_mean (ERPTier me) {
 		for (integer ievent = 2; ievent <= numberOfEvents; ievent ++) {
 			ERPPoint event = my points.at [ievent];
 			Melder_assert (event -> erp -> ny == my numberOfChannels);
-			mean -> z.all()  +=  event -> erp -> z.all();
+			Melder_assert (event -> erp -> nx == mean -> nx);
 		}
-		mean -> z.all()  *=  1.0 / numberOfEvents;
+		/*
+			Parallel over channels, so that every sum is taken in the same order as in a single thread.
+		*/
+		const integer numberOfThreads = MelderThread_getNumberOfThreadsToUse (my numberOfChannels, 1);
+		MelderThread_runChunks (numberOfThreads, my numberOfChannels, [&] (integer /* ithread */, integer firstChannel, integer lastChannel) {
+			for (integer ievent = 2; ievent <= numberOfEvents; ievent ++) {
+				constMAT erp = my points.at [ievent] -> erp -> z.get();
+				for (integer ichannel = firstChannel; ichannel <= lastChannel; ichannel ++)
+					mean -> z.row (ichannel)  +=  erp.row (ichannel);
+			}
+			for (integer ichannel = firstChannel; ichannel <= lastChannel; ichannel ++)
+				mean -> z.row (ichannel)  *=  1.0 / numberOfEvents;
+		});
 		mean -> channelNames = copy_STRVEC (my channelNames.get());
 		return mean;
 	} catch (MelderError) {
@@ -47,5 +47,17 @@ autoERPTier EEG_to_ERPTier_triggers_preceded (EEG me, double fromTime, double to
 	kMelder_string which, conststring32 criterion,
 	kMelder_string precededBy, conststring32 criterion_precededBy);
 
+/*
+	The same, but reading only the epochs (and the status channel) from a BDF or EDF file,
+	so that the whole recording never has to be in memory.
+*/
+autoERPTier ERPTier_readFromBdfFile_bit (MelderFile file, double fromTime, double toTime, int markerBit);
+autoERPTier ERPTier_readFromBdfFile_marker (MelderFile file, double fromTime, double toTime, uint16 marker);
+autoERPTier ERPTier_readFromBdfFile_triggers (MelderFile file, double fromTime, double toTime,
+	kMelder_string which, conststring32 criterion);
+autoERPTier ERPTier_readFromBdfFile_triggers_preceded (MelderFile file, double fromTime, double toTime,
+	kMelder_string which, conststring32 criterion,
+	kMelder_string precededBy, conststring32 criterion_precededBy);
+
 /* End of file ERPTier.h */
 #endif
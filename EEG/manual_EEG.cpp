@@ -30,6 +30,9 @@ NORMAL (U"You typically create an EEG object in Praat by opening a BDF/EDF file
 	"Praat tries to read the whole file into memory, so you may want to work with a 64-bit edition of Praat "
 	"if you want to avoid “out of memory” messages.")
 NORMAL (U"After you do ##Read from file...#, an EEG object will appear in the list of objects.")
+NORMAL (U"If the recording is too long to fit into memory, you can read only a part of it, "
+	"with @@Read EEG from BDF file (part)...@, or you can cut the ERPs directly out of the file "
+	"with the ##Read ERPTier from BDF file# commands (see below).")
 ENTRY (U"2. How to look into an EEG object")
 NORMAL (U"Once you have an EEG object in the list, you can click ##View & Edit# to look into it. "
 	"You will typically see the first 8 channels, but you scroll to the other channels by clicking on the up and down arrows. "
@@ -90,6 +93,100 @@ ENTRY (U"See also")
 LIST_ITEM (U"\\bu @@Independent Component Analysis on EEG@")
 MAN_END
 
+MAN_BEGIN (U"Read EEG from BDF file (part)...", U"agent", 20261019)
+INTRO (U"A command in the @@Open menu@ that reads a part of a BDF or EDF file into an @EEG object.")
+ENTRY (U"Settings")
+TERM (U"##File name")
+DEFINITION (U"the BDF or EDF file.")
+TERM (U"##Time range (s)")
+DEFINITION (U"the part of the recording that you want to read. If the start time is not less than the end time, "
+	"the whole duration of the recording is read.")
+TERM (U"##Channel numbers")
+DEFINITION (U"the channels that you want to read, in the order in which they should appear in the EEG object.")
+ENTRY (U"Behaviour")
+NORMAL (U"The result is the same as reading the whole file with @@Read from file...@, "
+	"followed by ##Extract part...# (with times preserved) and ##Extract channels...#, "
+	"but only the requested part of the requested channels, plus the Status channel, is ever held in memory. "
+	"The marks are computed from the Status channel of only the data records around the part. "
+	"For this reason, the number of Status tiers (8 or 16) can differ from the number in the whole file, "
+	"if the upper 8 status bits are used only outside the part.")
+ENTRY (U"ERPs from long files")
+NORMAL (U"The commands @@Read ERPTier from BDF file (bit)...@, @@Read ERPTier from BDF file (marker)...@, "
+	"@@Read ERPTier from BDF file (triggers)...@ and @@Read ERPTier from BDF file (triggers, preceded)...@ "
+	"give the same result as reading the whole file and then using the corresponding ##To ERPTier# command, "
+	"but they read from the file only the Status channel and the time windows around the events.")
+MAN_END
+
+MAN_BEGIN (U"Read ERPTier from BDF file (bit)...", U"agent", 20261019)
+INTRO (U"A command in the @@Open menu@ that cuts an @ERPTier directly out of a BDF or EDF file, "
+	"with one ERP for every event whose marker has a certain bit switched on.")
+ENTRY (U"Settings")
+TERM (U"##File name")
+DEFINITION (U"the BDF or EDF file.")
+TERM (U"##From time (s)# and ##To time (s)")
+DEFINITION (U"the time window of each ERP, relative to the time of its event.")
+TERM (U"##Marker bit")
+DEFINITION (U"the bit (1 to 16) of the Status channel whose switching on marks an event.")
+ENTRY (U"Behaviour")
+NORMAL (U"The result is the same as reading the whole file with @@Read from file...@ "
+	"and then doing ##To ERPTier (bit)...# with the same settings, "
+	"but only the Status channel and the windows around the events are ever read from the file, "
+	"so that you can cut ERPs out of recordings that are too long to fit into memory. "
+	"As with ##To ERPTier (bit)...#, the extra sensors are not included, "
+	"and the parts of windows that lie outside the recording are zero.")
+MAN_END
+
+MAN_BEGIN (U"Read ERPTier from BDF file (marker)...", U"agent", 20261019)
+INTRO (U"A command in the @@Open menu@ that cuts an @ERPTier directly out of a BDF or EDF file, "
+	"with one ERP for every event with a certain marker number.")
+ENTRY (U"Settings")
+TERM (U"##File name")
+DEFINITION (U"the BDF or EDF file.")
+TERM (U"##From time (s)# and ##To time (s)")
+DEFINITION (U"the time window of each ERP, relative to the time of its event.")
+TERM (U"##Marker number")
+DEFINITION (U"the number formed by the 16 marker bits of the Status channel at the start of an event; "
+	"an event is taken if exactly the bits of this number are switched on.")
+ENTRY (U"Behaviour")
+NORMAL (U"The result is the same as reading the whole file with @@Read from file...@ "
+	"and then doing ##To ERPTier (marker)...# with the same settings, "
+	"but only the Status channel and the windows around the events are ever read from the file.")
+MAN_END
+
+MAN_BEGIN (U"Read ERPTier from BDF file (triggers)...", U"agent", 20261019)
+INTRO (U"A command in the @@Open menu@ that cuts an @ERPTier directly out of an EDF+ file with annotations, "
+	"with one ERP for every trigger whose text matches a criterion.")
+ENTRY (U"Settings")
+TERM (U"##File name")
+DEFINITION (U"the EDF file, whose last channel should contain the “EDF Annotations”.")
+TERM (U"##From time (s)# and ##To time (s)")
+DEFINITION (U"the time window of each ERP, relative to the time of its trigger.")
+TERM (U"##Get every event with a trigger that# and ##...the text")
+DEFINITION (U"the criterion that the text of a trigger has to match.")
+ENTRY (U"Behaviour")
+NORMAL (U"The result is the same as reading the whole file with @@Read from file...@ "
+	"and then doing ##To ERPTier (triggers)...# with the same settings, "
+	"but only the annotation channel and the windows around the triggers are ever read from the file.")
+MAN_END
+
+MAN_BEGIN (U"Read ERPTier from BDF file (triggers, preceded)...", U"agent", 20261019)
+INTRO (U"A command in the @@Open menu@ that cuts an @ERPTier directly out of an EDF+ file with annotations, "
+	"with one ERP for every trigger whose text matches a criterion and that is preceded by a trigger whose text matches a second criterion.")
+ENTRY (U"Settings")
+TERM (U"##File name")
+DEFINITION (U"the EDF file, whose last channel should contain the “EDF Annotations”.")
+TERM (U"##From time (s)# and ##To time (s)")
+DEFINITION (U"the time window of each ERP, relative to the time of its trigger.")
+TERM (U"##Get every event with a trigger that# and ##...the text")
+DEFINITION (U"the criterion that the text of a trigger has to match.")
+TERM (U"##and is preceded by a trigger that# and ##...the text")
+DEFINITION (U"the criterion that the text of the previous trigger has to match.")
+ENTRY (U"Behaviour")
+NORMAL (U"The result is the same as reading the whole file with @@Read from file...@ "
+	"and then doing ##To ERPTier (triggers, preceded)...# with the same settings, "
+	"but only the annotation channel and the windows around the triggers are ever read from the file.")
+MAN_END
+
 MAN_BEGIN (U"Independent Component Analysis on EEG", U"ppgb", 20180502)
 INTRO (U"Independent Component Analysis (ICA) is often used to improve @EEG signals. "
 	"See @@blind source separation@ for the algorithm.")
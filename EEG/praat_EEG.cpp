@@ -710,6 +710,86 @@ DO
 	CONVERT_ONE_AND_ONE_TO_ONE_END (my name.get())
 }
 
+// MARK: - Open
+
+FORM (READ1_EEG_readFromBdfFile_part, U"Read EEG from BDF file (part)", U"Read EEG from BDF file (part)...") {
+	INFILE (fileName, U"File name", U"")
+	REAL (fromTime, U"left Time range (s)", U"0.0")
+	REAL (toTime, U"right Time range (s)", U"10.0")
+	NATURALVECTOR (channels, U"Channel numbers", RANGES_, U"1:64")
+	OK
+DO
+	CREATE_ONE
+		structMelderFile file { };
+		Melder_relativePathToFile (fileName, & file);
+		autoEEG result = EEG_readFromBdfFile_part (& file, fromTime, toTime, channels);
+	CREATE_ONE_END (MelderFile_name (& file), U"_part")
+}
+
+FORM (READ1_ERPTier_readFromBdfFile_bit, U"Read ERPTier from BDF file (bit)", U"Read ERPTier from BDF file (bit)...") {
+	INFILE (fileName, U"File name", U"")
+	REAL (fromTime, U"From time (s)", U"-0.11")
+	REAL (toTime, U"To time (s)", U"0.39")
+	NATURAL (markerBit, U"Marker bit", U"8")
+	OK
+DO
+	CREATE_ONE
+		structMelderFile file { };
+		Melder_relativePathToFile (fileName, & file);
+		autoERPTier result = ERPTier_readFromBdfFile_bit (& file, fromTime, toTime, markerBit);
+	CREATE_ONE_END (MelderFile_name (& file), U"_bit", markerBit)
+}
+
+FORM (READ1_ERPTier_readFromBdfFile_marker, U"Read ERPTier from BDF file (marker)", U"Read ERPTier from BDF file (marker)...") {
+	INFILE (fileName, U"File name", U"")
+	REAL (fromTime, U"From time (s)", U"-0.11")
+	REAL (toTime, U"To time (s)", U"0.39")
+	NATURAL (markerNumber, U"Marker number", U"12")
+	OK
+DO
+	CREATE_ONE
+		structMelderFile file { };
+		Melder_relativePathToFile (fileName, & file);
+		autoERPTier result = ERPTier_readFromBdfFile_marker (& file, fromTime, toTime, (uint16) markerNumber);
+	CREATE_ONE_END (MelderFile_name (& file), U"_", markerNumber)
+}
+
+FORM (READ1_ERPTier_readFromBdfFile_triggers, U"Read ERPTier from BDF file (triggers)", U"Read ERPTier from BDF file (triggers)...") {
+	INFILE (fileName, U"File name", U"")
+	REAL (fromTime, U"From time (s)", U"-0.11")
+	REAL (toTime, U"To time (s)", U"0.39")
+	OPTIONMENU_ENUM (kMelder_string, getEveryEventWithATriggerThat,
+			U"Get every event with a trigger that", kMelder_string::DEFAULT)
+	SENTENCE (theText, U"...the text", U"1")
+	OK
+DO
+	CREATE_ONE
+		structMelderFile file { };
+		Melder_relativePathToFile (fileName, & file);
+		autoERPTier result = ERPTier_readFromBdfFile_triggers (& file, fromTime, toTime, getEveryEventWithATriggerThat, theText);
+	CREATE_ONE_END (MelderFile_name (& file), U"_trigger", theText)
+}
+
+FORM (READ1_ERPTier_readFromBdfFile_triggers_preceded, U"Read ERPTier from BDF file (triggers, preceded)", U"Read ERPTier from BDF file (triggers, preceded)...") {
+	INFILE (fileName, U"File name", U"")
+	REAL (fromTime, U"From time (s)", U"-0.11")
+	REAL (toTime, U"To time (s)", U"0.39")
+	OPTIONMENU_ENUM (kMelder_string, getEveryEventWithATriggerThat,
+			U"Get every event with a trigger that", kMelder_string::DEFAULT)
+	SENTENCE (text1, U"...the text", U"1")
+	OPTIONMENU_ENUM (kMelder_string, andIsPrecededByATriggerThat,
+			U"and is preceded by a trigger that", kMelder_string::DEFAULT)
+	SENTENCE (text2, U" ...the text", U"4")
+	OK
+DO
+	CREATE_ONE
+		structMelderFile file { };
+		Melder_relativePathToFile (fileName, & file);
+		autoERPTier result = ERPTier_readFromBdfFile_triggers_preceded (& file, fromTime, toTime,
+			getEveryEventWithATriggerThat, text1, andIsPrecededByATriggerThat, text2);
+	CREATE_ONE_END (MelderFile_name (& file), U"_trigger", text2)
+}
+
 // MARK: - file recognizers
 
 static autoDaata bdfFileRecognizer (integer nread, const char [] /* header */, MelderFile file) {
@@ -730,6 +810,15 @@ void praat_EEG_init () {
 
 	Data_recognizeFileType (bdfFileRecognizer);
 
+	praat_addMenuCommand (U"Objects", U"Open", U"-- read EEG --", nullptr, 0, nullptr);
+	praat_addMenuCommand (U"Objects", U"Open", U"Read EEG from BDF file (part)...", nullptr, 0, READ1_EEG_readFromBdfFile_part);
+	praat_addMenuCommand (U"Objects", U"Open", U"Read ERPTier from BDF file", nullptr, 0, nullptr);
+		praat_addMenuCommand (U"Objects", U"Open", U"Read ERPTier from BDF file (bit)...", nullptr, GuiMenu_DEPTH_1, READ1_ERPTier_readFromBdfFile_bit);
+		praat_addMenuCommand (U"Objects", U"Open", U"Read ERPTier from BDF file (marker)...", nullptr, GuiMenu_DEPTH_1, READ1_ERPTier_readFromBdfFile_marker);
+		praat_addMenuCommand (U"Objects", U"Open", U"Read ERPTier from BDF file (triggers)...", nullptr, GuiMenu_DEPTH_1, READ1_ERPTier_readFromBdfFile_triggers);
+		praat_addMenuCommand (U"Objects", U"Open", U"Read ERPTier from BDF file (triggers, preceded)...", nullptr, GuiMenu_DEPTH_1,
+				READ1_ERPTier_readFromBdfFile_triggers_preceded);
+
 	praat_addAction1 (classEEG, 0, U"EEG help", nullptr, 0, HELP_EEG_help);
 	praat_addAction1 (classEEG, 1, U"View & Edit", nullptr, GuiMenu_ATTRACTIVE, EDITOR_ONE_EEG_viewAndEdit);
 	praat_addAction1 (classEEG, 0, U"Query -", nullptr, 0, nullptr);
@@ -1094,6 +1094,12 @@ LIST_ITEM (U"2.  We convert the melspectrogram values to mel frequency cepstral
 	"coefficients (see @@MelSpectrogram: To MFCC...@ for details).")
 MAN_END
 
+MAN_BEGIN (U"LongSound: To MFCC...", U"djmw", 20261019)
+INTRO (U"A command that creates a @MFCC object from every selected @LongSound object.")
+NORMAL (U"The result is the same as that of @@Sound: To MFCC...@ on the whole sound, "
+	"but the samples are read from file block by block, so that the sound does not have to fit in memory.")
+MAN_END
+
 MAN_BEGIN (U"Spectrum: To PowerCepstrum", U"djmw", 20190908)
 INTRO (U"A command to create a @PowerCepstrum from every selected @Spectrum.")
 ENTRY (U"Mathematical procedure")
@@ -1365,6 +1365,22 @@ DO
 	CONVERT_EACH_TO_ONE_END (my name.get())
 }
 
+FORM (CONVERT_EACH_TO_ONE__LongSound_to_MFCC, U"LongSound: To MFCC", U"LongSound: To MFCC...") {
+	NATURAL (numberOfCoefficients, U"Number of coefficients", U"12")
+	POSITIVE (windowLength, U"Window length (s)", U"0.015")
+	POSITIVE (timeStep, U"Time step (s)", U"0.005")
+	LABEL (U"Filter bank parameters")
+	POSITIVE (firstFilterFrequency, U"First filter frequency (mel)", U"100.0")
+	POSITIVE (distancBetweenFilters, U"Distance between filters (mel)", U"100.0")
+	REAL (maximumFrequency, U"Maximum frequency (mel)", U"0.0");
+	OK
+DO
+	Melder_require (numberOfCoefficients < 25, U"The number of coefficients should be less than 25.");
+	CONVERT_EACH_TO_ONE (LongSound)
+		autoMFCC result = LongSound_to_MFCC (me, numberOfCoefficients, windowLength, timeStep, firstFilterFrequency, maximumFrequency, distancBetweenFilters);
+	CONVERT_EACH_TO_ONE_END (my name.get())
+}
+
 FORM (GRAPHICS_EACH__VocalTract_drawSegments, U"VocalTract: Draw segments", nullptr) {
 	POSITIVE (maximumLength, U"Maximum length (cm)", U"20.0")
 	POSITIVE (maximumArea, U"Maximum area (cm^2)", U"90.0")
@@ -1819,6 +1835,8 @@ void praat_uvafon_LPC_init () {
 			CONVERT_EACH_TO_ONE__Sound_to_LPC_marple);
 	praat_addAction1 (classSound, 0, U"To MFCC...", U"To LPC (marple)...", 1,
 			CONVERT_EACH_TO_ONE__Sound_to_MFCC);
+	praat_addAction1 (classLongSound, 0, U"To MFCC...", nullptr, 0,
+			CONVERT_EACH_TO_ONE__LongSound_to_MFCC);
 	praat_addAction2 (classSound, 1, classFormantPath, 1, U"View & Edit", nullptr,0,
 			EDITOR_ONE_WITH_ONE_Sound_FormantPath_createFormantPathEditor);
 	praat_addAction2 (classTextGrid, 1, classFormantPath, 1, U"View & Edit", nullptr,0,
@@ -41,8 +41,10 @@
 #include <errno.h>
 
 /*
-	File open and read emulations. The FILE * is internally used as a pointer to the index of the file in the Set.
-	List of open files has to contain per file: index, position, length (bytes), pointer to data
+	File open and read emulations. The FILE * is internally used as the index of the file in the Set,
+	so that every stream operation finds its file in constant time, without looking up its path.
+	Each file carries its own stream state (position, error, pushed-back character) and an 'open' flag;
+	the list of open files is only maintained for reporting, and is only touched by fopen and fclose.
 */
 
 Thing_implement (FileInMemoryManager, Daata, 0);
@@ -114,14 +116,16 @@ autoFileInMemorySet FileInMemoryManager_extractFiles (FileInMemoryManager me, kM
 	return FileInMemorySet_extractFiles (my files.get(), which, criterion);
 }
 
-static integer _FileInMemoryManager_getIndexInOpenFiles (FileInMemoryManager me, FILE *stream) {
+/*
+	Returns the file that belongs to the stream, or nullptr if that file is not open.
+*/
+static FileInMemory _FileInMemoryManager_getOpenFile (FileInMemoryManager me, FILE *stream) {
 	const integer filesIndex = reinterpret_cast<integer> (stream);
 	Melder_require (filesIndex > 0 && filesIndex <= my files -> size,
 		U": Invalid file index: ", filesIndex);
 
 	const FileInMemory fim = static_cast<FileInMemory> (my files -> at [filesIndex]);
-	const integer openFilesIndex = FileInMemorySet_lookUp (my openFiles.get(), fim -> d_path.get());
-	return openFilesIndex;
+	return ( fim -> _isOpen ? fim : nullptr );
 }
 
 /* 
@@ -177,10 +181,13 @@ FILE *FileInMemoryManager_fopen (FileInMemoryManager me, const char *filename, c
 			index = FileInMemorySet_lookUp (my files.get(), Melder_peek8to32(filename));
 			if (index > 0) {
 				const FileInMemory fim = (FileInMemory) my files -> at [index];
-				if (fim -> d_position == 0) // not open
+				if (! fim -> _isOpen) {
 					my openFiles -> addItem_ref (fim);
-				else // reset position
-					fim -> d_position = 0;
+					fim -> _isOpen = true;
+				}
+				fim -> d_position = 0;
+				fim -> d_errno = 0;
+				fim -> ungetChar = -1;
 			} else {
 				// file does not exist, set error condition?
 			}
@@ -214,9 +221,8 @@ FILE *FileInMemoryManager_fopen (FileInMemoryManager me, const char *filename, c
 	none
 */
 void FileInMemoryManager_rewind (FileInMemoryManager me, FILE *stream) {
-	const integer openFilesIndex = _FileInMemoryManager_getIndexInOpenFiles (me, stream);
-	if (openFilesIndex > 0) {
-		const FileInMemory fim = static_cast<FileInMemory> (my openFiles -> at [openFilesIndex]);
+	const FileInMemory fim = _FileInMemoryManager_getOpenFile (me, stream);
+	if (fim) {
 		fim -> d_position = 0;
 		fim -> d_errno = 0;
 		fim -> ungetChar = -1;
@@ -245,12 +251,14 @@ void FileInMemoryManager_rewind (FileInMemoryManager me, FILE *stream) {
 	On failure, EOF is returned.
 */
 int FileInMemoryManager_fclose (FileInMemoryManager me, FILE *stream) {
-	const integer openFilesIndex = _FileInMemoryManager_getIndexInOpenFiles (me, stream);
-	if (openFilesIndex > 0) {
-		const FileInMemory fim = static_cast<FileInMemory> (my openFiles -> at [openFilesIndex]);
+	const FileInMemory fim = _FileInMemoryManager_getOpenFile (me, stream);
+	if (fim) {
 		fim -> d_position = 0;
 		fim -> d_errno = 0;
 		fim -> ungetChar = -1;
+		fim -> _isOpen = false;
+		const integer openFilesIndex = FileInMemorySet_lookUp (my openFiles.get(), fim -> d_path.get());
+		Melder_assert (openFilesIndex > 0);
 		my openFiles -> removeItem (openFilesIndex);
 	}
 	return my errorNumber = 0; // always ok
@@ -280,10 +288,9 @@ int FileInMemoryManager_fclose (FileInMemoryManager me, FILE *stream) {
 	Otherwise, zero is returned.
 */
 int FileInMemoryManager_feof (FileInMemoryManager me, FILE *stream) {
-	const integer openFilesIndex = _FileInMemoryManager_getIndexInOpenFiles (me, stream);
+	const FileInMemory fim = _FileInMemoryManager_getOpenFile (me, stream);
 	int eof = 0;
-	if (openFilesIndex > 0) {
-		const FileInMemory fim = static_cast<FileInMemory> (my openFiles -> at [openFilesIndex]);
+	if (fim) {
 		if (fim -> d_position >= fim -> d_numberOfBytes)
 			eof = 1;
 	}
@@ -329,10 +336,9 @@ int FileInMemoryManager_feof (FileInMemoryManager me, FILE *stream) {
 	If a read or write error occurs, the error indicator (ferror) is set.
 */
 int FileInMemoryManager_fseek (FileInMemoryManager me, FILE *stream, integer offset, int origin) {
-	const integer openFilesIndex = _FileInMemoryManager_getIndexInOpenFiles (me, stream);
+	const FileInMemory fim = _FileInMemoryManager_getOpenFile (me, stream);
 	int errval = EBADF;
-	if (openFilesIndex > 0) {
-		const FileInMemory fim = static_cast<FileInMemory> (my openFiles -> at [openFilesIndex]);
+	if (fim) {
 		integer newPosition = 0;
 		if (origin == SEEK_SET)
 			newPosition = offset;
@@ -375,13 +381,11 @@ int FileInMemoryManager_fseek (FileInMemoryManager me, FILE *stream, integer off
 	On failure, -1L is returned, and errno is set to a system-specific positive value.
 */
 integer FileInMemoryManager_ftell (FileInMemoryManager me, FILE *stream) {
-	const integer openFilesIndex = _FileInMemoryManager_getIndexInOpenFiles (me, stream);
+	const FileInMemory fim = _FileInMemoryManager_getOpenFile (me, stream);
 	/* int errval = EBADF; */
 	integer currentPosition = -1L;
-	if (openFilesIndex > 0) {
-		const FileInMemory fim = static_cast<FileInMemory> (my openFiles -> at [openFilesIndex]);
+	if (fim)
 		currentPosition = fim -> d_position;
-	}
 	return currentPosition;
 }
 
@@ -415,36 +419,40 @@ integer FileInMemoryManager_ftell (FileInMemoryManager me, FILE *stream) {
 	If a read error occurs, the error indicator (ferror) is set and a null pointer is also returned (but the contents pointed by str may have changed). 
  */
 char *FileInMemoryManager_fgets (FileInMemoryManager me, char *str, int num, FILE *stream) {
-	const integer openFilesIndex = _FileInMemoryManager_getIndexInOpenFiles (me, stream);
-	char *result = nullptr;
-	
-	Melder_require (openFilesIndex > 0,
+	const FileInMemory fim = _FileInMemoryManager_getOpenFile (me, stream);
+	Melder_require (fim,
 		U": File should be open.");
-
-	FileInMemory fim = static_cast<FileInMemory> (my openFiles -> at [openFilesIndex]);
-	integer startPos = fim -> d_position;
-	if (startPos < fim -> d_numberOfBytes) {
-		integer i = 0, endPos = startPos + num;
-		endPos = endPos < fim -> d_numberOfBytes ? endPos : fim -> d_numberOfBytes;
-		const unsigned char * p = fim -> d_data.asArgumentToFunctionThatExpectsZeroBasedArray () + startPos;
-		char *p_str = str;
-		if (fim -> ungetChar > 0) {
-			/*
-				copy the ungetChar and advance one position in stream
-			*/
-			*p_str ++ = fim -> ungetChar;
-			p ++;
-			i ++;
-			fim -> ungetChar = -1;
-		}
-		while (i ++ < num && (*p_str ++ = *p) && *p ++ != '\n');
-		str [i] = '\0';
-		fim -> d_position += i;
-		result = str; // everything ok, return the str pointer
-	} else {
+	if (fim -> d_position >= fim -> d_numberOfBytes) {
 		fim -> d_errno = EOF;
+		return nullptr;
 	}
-	return result;
+	if (num <= 0)
+		return nullptr;
+	const unsigned char *data = fim -> d_data.asArgumentToFunctionThatExpectsZeroBasedArray ();
+	integer position = fim -> d_position, numberOfCharacters = 0;
+	const integer maximumNumberOfCharacters = num - 1;   // room for the terminating null byte
+	if (fim -> ungetChar >= 0 && maximumNumberOfCharacters > 0) {
+		/*
+			The pushed-back character replaces the byte at the current position.
+		*/
+		str [numberOfCharacters ++] = static_cast<char> (fim -> ungetChar);
+		position ++;
+		fim -> ungetChar = -1;
+	}
+	if (numberOfCharacters == 0 || str [0] != '\n') {
+		const integer numberOfBytesToScan = std::min (maximumNumberOfCharacters - numberOfCharacters, fim -> d_numberOfBytes - position);
+		if (numberOfBytesToScan > 0) {
+			const unsigned char *start = data + position;
+			const unsigned char *newline = static_cast<const unsigned char *> (memchr (start, '\n', uinteger (numberOfBytesToScan)));
+			const integer numberOfBytesToCopy = ( newline ? newline - start + 1 : numberOfBytesToScan );
+			memcpy (str + numberOfCharacters, start, uinteger (numberOfBytesToCopy));
+			numberOfCharacters += numberOfBytesToCopy;
+			position += numberOfBytesToCopy;
+		}
+	}
+	str [numberOfCharacters] = '\0';
+	fim -> d_position = position;
+	return str;
 }
 
 /*
@@ -473,9 +481,21 @@ char *FileInMemoryManager_fgets (FileInMemoryManager me, char *str, int num, FIL
 	If some other reading error happens, the function also returns EOF, but sets its error indicator (ferror) instead.
 */
 int FileInMemoryManager_fgetc (FileInMemoryManager me, FILE *stream) {
-	char str [4];
-	(void) FileInMemoryManager_fgets (me, str, 1, stream);
-	return FileInMemoryManager_feof (me, stream) ? EOF : static_cast<int> (*str);
+	const FileInMemory fim = _FileInMemoryManager_getOpenFile (me, stream);
+	Melder_require (fim,
+		U": File should be open.");
+	if (fim -> d_position >= fim -> d_numberOfBytes) {
+		fim -> d_errno = EOF;
+		return EOF;
+	}
+	int character;
+	if (fim -> ungetChar >= 0) {
+		character = fim -> ungetChar;
+		fim -> ungetChar = -1;
+	} else
+		character = fim -> d_data.asArgumentToFunctionThatExpectsZeroBasedArray () [fim -> d_position];
+	fim -> d_position ++;
+	return character;
 }
 
 /*
@@ -509,31 +529,31 @@ int FileInMemoryManager_fgetc (FileInMemoryManager me, FILE *stream) {
 	size_t is an unsigned integral type. 
 */
 size_t FileInMemoryManager_fread (FileInMemoryManager me, void *ptr, size_t size, size_t count, FILE *stream) {
-	const integer openFilesIndex = _FileInMemoryManager_getIndexInOpenFiles (me, stream);
-	
-	Melder_require (openFilesIndex > 0 && size > 0 && count > 0,
+	const FileInMemory fim = _FileInMemoryManager_getOpenFile (me, stream);
+	Melder_require (fim,
 		U": File should be open.");
-	
-	const FileInMemory fim = static_cast<FileInMemory> (my openFiles -> at [openFilesIndex]);
-	size_t result = 0;
-	integer startPos = fim -> d_position;
-	if (startPos < fim -> d_numberOfBytes) {
-		integer i = 0, endPos = startPos + count * size;
-		
-		if (endPos > fim -> d_numberOfBytes) {
-			count = (fim -> d_numberOfBytes - startPos) / size;
-			endPos = startPos + count * size;
-			fim -> d_errno = EOF;
+	if (size == 0 || count == 0)
+		return 0;
+	const integer startPos = fim -> d_position;
+	if (startPos >= fim -> d_numberOfBytes) {
+		fim -> d_errno = EOF;
+		return 0;
+	}
+	const size_t numberOfBytesAvailable = size_t (fim -> d_numberOfBytes - startPos);
+	if (count > numberOfBytesAvailable / size) {
+		count = numberOfBytesAvailable / size;   // only complete elements
+		fim -> d_errno = EOF;
+	}
+	const size_t numberOfBytes = count * size;
+	if (numberOfBytes > 0) {
+		memcpy (ptr, fim -> d_data.asArgumentToFunctionThatExpectsZeroBasedArray () + startPos, numberOfBytes);
+		if (fim -> ungetChar >= 0) {
+			* static_cast<unsigned char *> (ptr) = static_cast<unsigned char> (fim -> ungetChar);
+			fim -> ungetChar = -1;
 		}
-		const integer numberOfBytes = count * size;
-		const unsigned char * p = fim -> d_data.asArgumentToFunctionThatExpectsZeroBasedArray () + fim -> d_position;
-		char * str = static_cast<char *> (ptr);
-		while (i < numberOfBytes)
-			str [i ++] = *p ++;
-		fim -> d_position = endPos;
+		fim -> d_position = startPos + integer (numberOfBytes);
 	}
-	result = count;
-	return result;
+	return count;
 }
 
 /*
@@ -572,11 +592,10 @@ size_t FileInMemoryManager_fread (FileInMemoryManager me, void *ptr, size_t size
 int FileInMemoryManager_ungetc (FileInMemoryManager me, int character, FILE * stream) {
 	int result = EOF;
 	if (character != EOF) {
-		const integer openFilesIndex = _FileInMemoryManager_getIndexInOpenFiles (me, stream);
-		if (openFilesIndex > 0) {
-			const FileInMemory fim = static_cast<FileInMemory> (my openFiles -> at [openFilesIndex]);
+		const FileInMemory fim = _FileInMemoryManager_getOpenFile (me, stream);
+		if (fim && fim -> d_position > 0) {   // nothing to push back before the start of the data
 			-- (fim -> d_position);
-			result = fim -> ungetChar = character;
+			result = fim -> ungetChar = static_cast<unsigned char> (character);
 		}
 	}
 	return result;
@@ -733,18 +752,19 @@ void test_FileInMemoryManager_io (void) {
 	// fopen test
 	MelderInfo_writeLine (U"\tOpen file ", file1 -> path);
 	FILE * f1 = FileInMemoryManager_fopen (me.get(), Melder_peek32to8_fileSystem (file1 -> path), "r");
-	const integer openFilesIndex1 = _FileInMemoryManager_getIndexInOpenFiles (me.get(), f1);
-	Melder_assert (openFilesIndex1 == 1);
+	Melder_assert (_FileInMemoryManager_getOpenFile (me.get(), f1));
+	Melder_assert (my openFiles -> size == 1);
 	MelderInfo_writeLine (U"\t\t ...opened");
 	
 	MelderInfo_writeLine (U"\tOpen file ", file2 -> path);
 	FILE * f2 = FileInMemoryManager_fopen (me.get(), Melder_peek32to8_fileSystem (file2 -> path), "r");
-	const integer openFilesIndex2 = _FileInMemoryManager_getIndexInOpenFiles (me.get(), f2);
-	Melder_assert (openFilesIndex2 == 2);
+	Melder_assert (_FileInMemoryManager_getOpenFile (me.get(), f2));
+	Melder_assert (my openFiles -> size == 2);
 	MelderInfo_writeLine (U"\t\t ...opened");
 	
 	FileInMemoryManager_fclose (me.get(), f2);
 	Melder_assert (my openFiles -> size == 1);
+	Melder_assert (! _FileInMemoryManager_getOpenFile (me.get(), f2));
 	MelderInfo_writeLine (U"\tClosed file ", file2 -> path);
 	
 	// read from open text file
@@ -753,7 +773,7 @@ void test_FileInMemoryManager_io (void) {
 	char buf0 [200], buf1 [200];
 	const long nbuf = 200;
 	
-	FileInMemory fim = (FileInMemory) my files -> at [openFilesIndex1];
+	FileInMemory fim = (FileInMemory) my files -> at [reinterpret_cast<integer> (f1)];
 	FILE *file0 = fopen (Melder_peek32to8_fileSystem (file1 -> path), "r");
 	for (integer i = 0; i <= 2; i ++) {
 		char *p0 = fgets (buf0, nbuf, file0);
@@ -798,6 +818,52 @@ void test_FileInMemoryManager_io (void) {
 	MelderInfo_writeLine (U"\tEOF ? ", eof0, U" and ", eof1);
 	
 	Melder_assert (eof0 != 0 && eof1 != 0);
+	nread0 = fread (buf0, 1, count, file0);
+	nread1 = FileInMemoryManager_fread (me.get(), buf1, 1, count, f1);
+	Melder_assert (nread0 == 0 && nread1 == 0);
+
+	// read character by character, with pushing back
+
+	MelderInfo_writeLine (U"\tRead characters: ", file1 -> path);
+	rewind (file0);
+	FileInMemoryManager_rewind (me.get(), f1);
+	for (;;) {
+		const int c0 = fgetc (file0);
+		const int c1 = FileInMemoryManager_fgetc (me.get(), f1);
+		Melder_assert (c0 == c1);
+		Melder_assert (ftell (file0) == FileInMemoryManager_ftell (me.get(), f1));
+		if (c0 == EOF)
+			break;
+		if (c0 == 'b' || c0 == '\n') {
+			Melder_assert (ungetc ('X', file0) == FileInMemoryManager_ungetc (me.get(), 'X', f1));
+			Melder_assert (fgetc (file0) == 'X' && FileInMemoryManager_fgetc (me.get(), f1) == 'X');
+		}
+	}
+	Melder_assert (FileInMemoryManager_feof (me.get(), f1));
+
+	// read lines that are longer than the buffer, with a pushed-back character
+
+	MelderInfo_writeLine (U"\tRead short buffers: ", file1 -> path);
+	rewind (file0);
+	FileInMemoryManager_rewind (me.get(), f1);
+	Melder_assert (FileInMemoryManager_ungetc (me.get(), 'Z', f1) == EOF);   // at the start, the position stays 0
+	Melder_assert (FileInMemoryManager_ftell (me.get(), f1) == 0);
+	(void) fgetc (file0);
+	(void) FileInMemoryManager_fgetc (me.get(), f1);
+	ungetc ('Y', file0);
+	FileInMemoryManager_ungetc (me.get(), 'Y', f1);
+	for (;;) {
+		char *p0 = fgets (buf0, 3, file0);
+		char *p1 = FileInMemoryManager_fgets (me.get(), buf1, 3, f1);
+		Melder_assert (!! p0 == !! p1);
+		if (! p0)
+			break;
+		Melder_assert (strcmp (buf0, buf1) == 0);
+		Melder_assert (ftell (file0) == FileInMemoryManager_ftell (me.get(), f1));
+	}
+	fclose (file0);
+	FileInMemoryManager_fclose (me.get(), f1);
+	Melder_assert (my openFiles -> size == 0);
 	
 	//  clean up
 	
@@ -193,15 +193,34 @@ integer FileInMemorySet_getIndexFromId (FileInMemorySet me, conststring32 id) {
 }
 
 integer FileInMemorySet_lookUp (FileInMemorySet me, conststring32 path) {
-	integer index = 0;
-	for (integer i = 1; i <= my size; i ++) {
-		const FileInMemory fim = (FileInMemory) my at [i];
-		if (Melder_equ (path, fim -> d_path.get())) {
-			index = i;
-			break;
-		}
+	/*
+		The set is sorted by path (see s_compareHook), so we can use binary search.
+	*/
+	if (my size == 0)
+		return 0;
+	const int atEnd = Melder_cmp (path, static_cast <FileInMemory> (my at [my size]) -> d_path.get());
+	if (atEnd > 0)
+		return 0;
+	if (atEnd == 0)
+		return my size;
+	const int atStart = Melder_cmp (path, static_cast <FileInMemory> (my at [1]) -> d_path.get());
+	if (atStart < 0)
+		return 0;
+	if (atStart == 0)
+		return 1;
+	integer left = 1, right = my size;
+	while (left < right - 1) {
+		const integer mid = (left + right) / 2;
+		const int here = Melder_cmp (path, static_cast <FileInMemory> (my at [mid]) -> d_path.get());
+		if (here == 0)
+			return mid;
+		if (here > 0)
+			left = mid;
+		else
+			right = mid;
 	}
-	return index;
+	Melder_assert (right == left + 1);
+	return 0;
 }
 
 integer FileInMemorySet_findNumberOfMatches_path (FileInMemorySet me, kMelder_string which, conststring32 criterion) {
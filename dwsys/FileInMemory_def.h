@@ -38,6 +38,10 @@ oo_DEFINE_CLASS (FileInMemory, Daata)
 		oo_UBYTE (_dontOwnData)
 	#endif
 
+	#if oo_DECLARING
+		bool _isOpen;   // as a stream of a FileInMemoryManager; the stream state is d_position, d_errno and ungetChar
+	#endif
+
 	#if oo_DECLARING
 		void v1_info () override; 
 	#endif
@@ -21,6 +21,7 @@
 #include "NUMmachar.h"
 #include "NUM2.h"
 #include "SVD.h"
+#include "MelderThread.h"
 
 #include "oo_DESTROY.h"
 #include "NMF_def.h"
@@ -202,12 +203,39 @@ static double getMaximumChange (constMATVU const& m, MATVU const& m0, const doub
 }
 
 /*
-	Calculating elementwise matrix multiplication, division and addition m = m0 .* (numerm ./(denom + eps))
-	Set elements < zero_threshold to zero
+	Calculating elementwise matrix multiplication, division and addition m = m .* (numer ./ (denom + eps)) in place.
+	Set elements < zero_threshold to zero.
+	In the same pass we compute the maximum relative change of m, as in getMaximumChange (),
+	and (if out_innerProduct is not null) the inner product of the new m with numer, which the convergence test needs,
+	so that neither a copy of the old m nor extra passes over m are needed.
+	The work is divided over threads along the longer dimension of m, in chunks of lines that do not depend on the number of threads.
 */
+static void update_part (MATVU const& m, constMATVU const& numer, constMATVU const& denom, double zeroThreshold, double divByZeroAvoidance,
+	double *out_maximumOld, double *out_maximumChange, double *out_innerProduct)
+{
+	double maximumOld = 0.0, maximumChange = 0.0, innerProduct = 0.0;
+	for (integer irow = 1; irow <= m.nrow; irow ++)
+		for (integer icol = 1; icol <= m.ncol; icol++) {
+			const double old = m [irow] [icol];
+			double update = 0.0;
+			if (old != 0.0 && numer [irow] [icol] != 0.0) {
+				update = old * (numer [irow] [icol] / (denom [irow] [icol] + divByZeroAvoidance));
+				if (update < zeroThreshold)
+					update = 0.0;
+			}
+			m [irow] [icol] = update;
+			maximumOld = std::max (maximumOld, fabs (old));
+			maximumChange = std::max (maximumChange, fabs (old - update));
+			innerProduct += update * numer [irow] [icol];
+		}
+	*out_maximumOld = maximumOld;
+	*out_maximumChange = maximumChange;
+	*out_innerProduct = innerProduct;
+}
 
-static const void update (MATVU const& m, constMATVU const& m0, constMATVU const& numer, constMATVU const& denom, double zeroThreshold, double maximum) {
-	Melder_assert (m.nrow == m0.nrow && m.ncol == m0.ncol);
+static double update (MATVU const& m, constMATVU const& numer, constMATVU const& denom, double zeroThreshold, double maximum, double sqrteps,
+	double *out_innerProduct)
+{
 	Melder_assert (m.nrow == numer.nrow && m.ncol == numer.ncol);
 	Melder_assert (m.nrow == denom.nrow && m.ncol == denom.ncol);
 	/*
@@ -217,15 +245,37 @@ static const void update (MATVU const& m, constMATVU const& m0, constMATVU const
 		A scaling with the maximum value seems reasonable.
 	*/
 	const double divByZeroAvoidance = 1e-09 * ( maximum < 1.0 ? maximum : 1.0 );
-	for (integer irow = 1; irow <= m.nrow; irow ++) 
-		for (integer icol = 1; icol <= m.ncol; icol++) {
-			if (m0 [irow] [icol] == 0.0 || numer [irow] [icol]  == 0.0) {
-				m [irow] [icol] = 0.0;
-			} else {
-				double update = m0 [irow] [icol] * (numer [irow] [icol] / (denom [irow] [icol] + divByZeroAvoidance));
-				m [irow] [icol] = ( update < zeroThreshold ? 0.0 : update );
-			}
+	const bool byRows = ( m.nrow >= m.ncol );
+	const integer numberOfLines = ( byRows ? m.nrow : m.ncol ), lineLength = ( byRows ? m.ncol : m.nrow );
+	/*
+		The partial results are computed per chunk of lines, and the chunk boundaries do not depend on the number of threads,
+		so that the inner product (and therefore the convergence test) comes out the same on every computer.
+	*/
+	const integer numberOfLinesPerChunk = std::max (1_integer, 100'000 / std::max (1_integer, lineLength));
+	const integer numberOfChunks = (numberOfLines - 1) / numberOfLinesPerChunk + 1;
+	const integer numberOfThreads = MelderThread_getNumberOfThreadsToUse (numberOfChunks, 1);
+	autoMAT partialResults = zero_MAT (numberOfChunks, 3);
+	MelderThread_runChunks (numberOfThreads, numberOfChunks, [&] (integer /* ithread */, integer firstChunk, integer lastChunk) {
+		for (integer ichunk = firstChunk; ichunk <= lastChunk; ichunk ++) {
+			double *result = & partialResults [ichunk] [1];
+			const integer firstLine = 1 + (ichunk - 1) * numberOfLinesPerChunk;
+			const integer lastLine = std::min (ichunk * numberOfLinesPerChunk, numberOfLines);
+			const integer firstRow = ( byRows ? firstLine : 1 ), lastRow = ( byRows ? lastLine : m.nrow );
+			const integer firstColumn = ( byRows ? 1 : firstLine ), lastColumn = ( byRows ? m.ncol : lastLine );
+			update_part (m.part (firstRow, lastRow, firstColumn, lastColumn),
+					numer.part (firstRow, lastRow, firstColumn, lastColumn), denom.part (firstRow, lastRow, firstColumn, lastColumn),
+					zeroThreshold, divByZeroAvoidance, & result [0], & result [1], & result [2]);
 		}
+	});
+	double maximumOld = 0.0, maximumChange = 0.0, innerProduct = 0.0;
+	for (integer ichunk = 1; ichunk <= numberOfChunks; ichunk ++) {
+		maximumOld = std::max (maximumOld, partialResults [ichunk] [1]);
+		maximumChange = std::max (maximumChange, partialResults [ichunk] [2]);
+		innerProduct += partialResults [ichunk] [3];
+	}
+	if (out_innerProduct)
+		*out_innerProduct = innerProduct;
+	return maximumChange / (sqrteps + maximumOld);
 }
 
 /*
@@ -245,18 +295,14 @@ void NMF_improveFactorization_mu (NMF me, constMATVU const& data, integer maximu
 		
 		autoMAT productFtD = zero_MAT (my numberOfFeatures, my numberOfColumns); // calculations of F'D
 		autoMAT productFtFW = zero_MAT (my numberOfFeatures, my numberOfColumns); // calculations of F'F W
-		autoMAT weights0 = zero_MAT (my numberOfFeatures, my numberOfColumns);
 		
 		autoMAT productDWt = zero_MAT (my numberOfRows, my numberOfFeatures); // calculations of DW'
 		autoMAT productFWWt = zero_MAT (my numberOfRows, my numberOfFeatures); // calculations of FWW'
-		autoMAT features0 = zero_MAT (my numberOfRows, my numberOfFeatures);
 		
 		autoMAT productWWt = zero_MAT (my numberOfFeatures, my numberOfFeatures); // calculations of WW'
 		autoMAT productFtF = zero_MAT (my numberOfFeatures, my numberOfFeatures); // calculations of F'F
 		
 		const double traceDtD = NUMtrace2 (data.transpose(), data); // for distance calculation
-		features0.all()  <<=  my features.all();
-		weights0.all()  <<=  my weights.all();
 		
 		if (! NUMfpp)
 			NUMmachar ();
@@ -275,36 +321,39 @@ void NMF_improveFactorization_mu (NMF me, constMATVU const& data, integer maximu
 					(2) F = F .* (D*W') ./ (F*W*W' + 10^^−9^)
 					(3) test for convergence
 				endwhile
+				
+				The only products that involve the (large) data matrix are F'*D and D*W';
+				these are the only full passes over the data in an iteration,
+				and they go through the fast (blocked and multithreaded) matrix multiplication,
+				whose results do not depend on the number of threads.
+				The updates are done in place, because F'*D, F'*F*W, D*W' and F*W*W'
+				are computed before the matrix that they update is changed.
 			*/
 			
 			// 1. Update W matrix
-			features0.all()  <<=  my features.all();
-			weights0.all()  <<=  my weights.all();
-			mul_MAT_out (productFtD.get(), features0.transpose(), data);
-			mul_MAT_out (productFtF.get(), features0.transpose(), features0.get());
-			mul_MAT_out (productFtFW.get(), productFtF.get(), weights0.get());
-			update (my weights.get(), weights0.get(), productFtD.get(), productFtFW.get(), eps, maximum);
+			mul_fast_multithreaded_MAT_out (productFtD.get(), my features.transpose(), data);
+			mul_fast_multithreaded_MAT_out (productFtF.get(), my features.transpose(), my features.get());
+			mul_fast_multithreaded_MAT_out (productFtFW.get(), productFtF.get(), my weights.get());
+			double traceWtFtD;
+			const double dw = update (my weights.get(), productFtD.get(), productFtFW.get(), eps, maximum, sqrteps, & traceWtFtD);
 
 			// 2. Update F matrix
-			mul_MAT_out (productDWt.get(), data, my weights.transpose()); // productDWt = data*weights'
-			mul_MAT_out (productWWt.get(), my weights.get(), my weights.transpose()); // work1 = weights*weights'
-			mul_MAT_out (productFWWt.get(), features0.get(), productWWt.get()); // productFWWt = features0 * work1
-			update (my features.get(), features0.get(), productDWt.get(), productFWWt.get(), eps, maximum);
+			mul_fast_multithreaded_MAT_out (productDWt.get(), data, my weights.transpose()); // productDWt = data*weights'
+			mul_fast_multithreaded_MAT_out (productWWt.get(), my weights.get(), my weights.transpose()); // work1 = weights*weights'
+			mul_fast_multithreaded_MAT_out (productFWWt.get(), my features.get(), productWWt.get()); // productFWWt = features * work1
+			const double df = update (my features.get(), productDWt.get(), productFWWt.get(), eps, maximum, sqrteps, nullptr);
 			
 			/* 3. Convergence test:
 				The Frobenius norm ||D-FW|| of a matrix can be written as
 				||D-FW||=trace(D'D) − 2trace(W'F'D) + trace(W'F'FW)
 						=trace(D'D) - 2trace(W'(F'D))+trace((F'F)(WW'))
 				This saves us from explicitly calculating the reconstruction FW because we already have performed most of
-				the needed matrix multiplications in the update step.
+				the needed matrix multiplications in the update step; trace(W'(F'D)) was computed during the update of W.
 			*/
 			
-			const double traceWtFtD  = NUMtrace2 (my weights.transpose(), productFtD.get());
 			const double traceWtFtFW = NUMtrace2 (productFtF.get(), productWWt.get());
 			const double distance = sqrt (std::max (traceDtD - 2.0 * traceWtFtD + traceWtFtFW, 0.0)); // just in case
 			const double dnorm = distance / (my numberOfRows * my numberOfColumns);
-			const double df = getMaximumChange (my features.get(), features0.get(), sqrteps);
-			const double dw = getMaximumChange (my weights.get(), weights0.get(), sqrteps);
 			const double delta = std::max (df, dw);
 			convergence = ( iter > 1 && (delta < changeTolerance || dnorm < dnorm0 * approximationTolerance) );
 			if (info)
@@ -362,8 +411,8 @@ void NMF_improveFactorization_als (NMF me, constMATVU const& data, integer maxim
 				1. Solve equations for new W:  F´*F*W = F'*D
 			*/
 			weights0.all()  <<=  my weights.all();   // save previous weights for convergence test
-			mul_MAT_out (productFtD.get(), my features.transpose(), data);
-			mul_MAT_out (productFtF.get(), my features.transpose(), my features.get());
+			mul_fast_multithreaded_MAT_out (productFtD.get(), my features.transpose(), data);
+			mul_fast_multithreaded_MAT_out (productFtF.get(), my features.transpose(), my features.get());
 
 			svd_FtF -> u.all()  <<=  productFtF.all();
 			SVD_compute (svd_FtF.get());
@@ -374,8 +423,8 @@ void NMF_improveFactorization_als (NMF me, constMATVU const& data, integer maxim
 				2. Solve equations for new F:  W*W'*F' = W*D'
 			*/
 			features0.all()  <<=  my features.all();   // save previous features for convergence test
-			mul_MAT_out  (productWDt.get(), my weights.get(), data.transpose());
-			mul_MAT_out (productWWt.get(), my weights.get(), my weights.transpose());
+			mul_fast_multithreaded_MAT_out (productWDt.get(), my weights.get(), data.transpose());
+			mul_fast_multithreaded_MAT_out (productWWt.get(), my weights.get(), my weights.transpose());
 
 			svd_WWt -> u.all()  <<=  productWWt.all();
 			SVD_compute (svd_WWt.get());
@@ -405,12 +454,6 @@ void NMF_improveFactorization_als (NMF me, constMATVU const& data, integer maxim
 	}
 }
 
-static void VECinvertAndScale (VECVU const& target, constVECVU const& source, double scaleFactor) {
-	Melder_assert (target.size == source.size);
-	for (integer i = 1; i <= target.size; i ++)
-		target [i] = scaleFactor / source [i];
-}
-
 void NMF_improveFactorization_is (NMF me, constMATVU const& data, integer maximumNumberOfIterations, double changeTolerance, double approximationTolerance, bool info) {
 	try {
 		Melder_require (my numberOfColumns == data.ncol, U"The number of columns should be equal.");
@@ -419,14 +462,21 @@ void NMF_improveFactorization_is (NMF me, constMATVU const& data, integer maximu
 			U"The data matrix should not have cells that are zero.");
 		autoMAT vk = raw_MAT (data.nrow, data.ncol);
 		autoMAT fw = raw_MAT (data.nrow, data.ncol);
-		autoMAT fcol_x_wrow = raw_MAT (data.nrow, data.ncol);
-		autoVEC fcolumn_inv = raw_VEC (data.nrow); // feature column
-		autoVEC wrow_inv = raw_VEC (data.ncol); // weight row
-		mul_MAT_out (fw.get(), my features.get(), my weights.get());
+		autoVEC fcolumn_old = raw_VEC (data.nrow); // feature column
+		autoVEC wrow_old = raw_VEC (data.ncol); // weight row
+		autoVEC wrow_inv = raw_VEC (data.ncol);
+		mul_fast_multithreaded_MAT_out (fw.get(), my features.get(), my weights.get());
 		double divergence = MATgetDivergence_ItakuraSaito (data, fw.get());
 		const double divergence0 = divergence;
 		if (info)
 			MelderInfo_writeLine (U"Iteration: 0", U" divergence: ", divergence, U" delta: ", divergence);
+		/*
+			All passes over the data are divided over threads by rows.
+			The column sums in (3) are accumulated per thread and added afterwards.
+		*/
+		const integer numberOfThreads = MelderThread_getNumberOfThreadsToUse (data.nrow, std::max (1_integer, 20'000 / data.ncol));
+		autoMAT partialWrows = raw_MAT (numberOfThreads, data.ncol);
+		autoVEC partialDivergences = raw_VEC (numberOfThreads);
 		integer iter = 1;
 		bool convergence = false;
 		while (iter <= maximumNumberOfIterations && not convergence) {
@@ -444,33 +494,64 @@ void NMF_improveFactorization_is (NMF me, constMATVU const& data, integer maximu
 						F.H - old(fcol(k) x wrow (k)) + new(fcol(k) x wrow (k))    (6)
 					}
 				}
-				There is no need to calculate G(k) explicitly as in (1).
-				We can calculate the elements of G(k) while we are doing (2).
+				There is no need to calculate G(k) explicitly as in (1), nor the outer product fcol(k) x wrow (k):
+				we calculate their elements while we are doing (2) and (3) in a single pass,
+				and (6) in a second pass. For the last feature, the divergence is computed in that same pass.
 			*/
+			double divergence_update = divergence;
 			for (integer kf = 1; kf <= my numberOfFeatures; kf ++) {
-				// (1) and (2)
-				outer_MAT_out (fcol_x_wrow.get(), my features.column (kf), my weights.row (kf));
-				for (integer irow = 1; irow <= data.nrow; irow ++)
-					for (integer icol = 1; icol <= data.ncol; icol ++) {
-						double gk = fcol_x_wrow [irow] [icol] / fw [irow] [icol];
-						vk [irow] [icol] = gk * gk * data [irow] [icol] + (1.0 - gk) * fcol_x_wrow [irow] [icol];
+				fcolumn_old.all()  <<=  my features.column (kf);
+				wrow_old.all()  <<=  my weights.row (kf);
+				// (1), (2) and (3)
+				partialWrows.all()  <<=  0.0;
+				MelderThread_runChunks (numberOfThreads, data.nrow, [&] (integer ithread, integer firstRow, integer lastRow) {
+					VEC partialWrow = partialWrows.row (ithread);
+					for (integer irow = firstRow; irow <= lastRow; irow ++) {
+						const double fcol = fcolumn_old [irow];
+						const double fcolumn_inv = 1.0 / my numberOfRows / fcol;
+						for (integer icol = 1; icol <= data.ncol; icol ++) {
+							const double fcol_x_wrow = fcol * wrow_old [icol];
+							const double gk = fcol_x_wrow / fw [irow] [icol];
+							const double v = gk * gk * data [irow] [icol] + (1.0 - gk) * fcol_x_wrow;
+							vk [irow] [icol] = v;
+							partialWrow [icol] += fcolumn_inv * v;
+						}
 					}
-				// (3)
-				VECinvertAndScale (fcolumn_inv.get(), my features.column (kf), 1.0 / my numberOfRows);	
-				mul_VEC_out (my weights.row (kf), fcolumn_inv.get(), vk.get());
+				});
+				VEC wrow = my weights.row (kf);
+				wrow  <<=  partialWrows.row (1);
+				for (integer ithread = 2; ithread <= numberOfThreads; ithread ++)
+					wrow  +=  partialWrows.row (ithread);
 				// (4)
-				VECinvertAndScale (wrow_inv.get(), my weights.row (kf), 1.0 / my numberOfColumns);
-				mul_VEC_out (my features.column (kf), vk.get(), wrow_inv.get());
+				for (integer icol = 1; icol <= data.ncol; icol ++)
+					wrow_inv [icol] = 1.0 / my numberOfColumns / wrow [icol];
+				VECVU fcolumn = my features.column (kf);
+				MelderThread_runChunks (numberOfThreads, data.nrow, [&] (integer /* ithread */, integer firstRow, integer lastRow) {
+					mul_VEC_out (fcolumn.part (firstRow, lastRow), vk.horizontalBand (firstRow, lastRow), wrow_inv.get());
+				});
 				// (5)
-				double fcolumn_norm = NUMnorm (my features.column (kf), 2.0);
-				my features.column (kf)  /=  fcolumn_norm;
-				my weights.row (kf)  *=  fcolumn_norm;
+				double fcolumn_norm = NUMnorm (fcolumn, 2.0);
+				fcolumn  /=  fcolumn_norm;
+				wrow  *=  fcolumn_norm;
 				// (6)
-				fw.get()  -=  fcol_x_wrow.get();
-				outer_MAT_out (fcol_x_wrow.get(), my features.column (kf), my weights.row (kf));
-				fw.get()  +=  fcol_x_wrow.get();
+				const bool isLastFeature = ( kf == my numberOfFeatures );
+				MelderThread_runChunks (numberOfThreads, data.nrow, [&] (integer ithread, integer firstRow, integer lastRow) {
+					double partialDivergence = 0.0;
+					for (integer irow = firstRow; irow <= lastRow; irow ++) {
+						const double fcol = fcolumn [irow], fcol_old = fcolumn_old [irow];
+						for (integer icol = 1; icol <= data.ncol; icol ++) {
+							fw [irow] [icol] += fcol * wrow [icol] - fcol_old * wrow_old [icol];
+							if (isLastFeature) {
+								const double ratio = fw [irow] [icol] / data [irow] [icol];
+								partialDivergence += ratio - log (ratio) - 1.0;
+							}
+						}
+					}
+					partialDivergences [ithread] = partialDivergence;
+				});
+				if (isLastFeature)
+					divergence_update = NUMsum (partialDivergences.get());
 			}
-			const double divergence_update = MATgetDivergence_ItakuraSaito (data, fw.get());
 			const double delta = divergence - divergence_update;
 			convergence = ( iter > 1 && (fabs (delta) < changeTolerance || divergence_update < divergence0 * approximationTolerance) );
 			if (info)
@@ -23,6 +23,7 @@
 
 #include "Distance.h"
 #include "TableOfReal_extensions.h"
+#include "MelderThread.h"
 
 Thing_implement (Distance, Proximity, 0);
 
@@ -38,30 +39,91 @@ autoDistance Distance_create (integer numberOfPoints) {
 	}
 }
 
-static void VECpow (VECVU const& v, double power) {
-	for (integer i = 1; i <= v.size; i++)
-		v [i] = pow (v [i], power);
+/*
+	The Minkowski distance (sum (w [k] |x [k] - y [k]| ^ metric)) ^ (1 / metric),
+	scaled by the largest coordinate difference to prevent overflow.
+*/
+static double getDistance (constVEC const& x, constVEC const& y, constVEC const& w, integer metric) {
+	double dmax = 0.0;
+	for (integer k = 1; k <= x.size; k ++)
+		dmax = std::max (dmax, fabs (x [k] - y [k]));
+	if (dmax == 0.0)
+		return 0.0;
+	double d = 0.0;
+	if (metric == 1) {
+		for (integer k = 1; k <= x.size; k ++)
+			d += w [k] * fabs (x [k] - y [k]);
+		return d;
+	} else if (metric == 2) {
+		for (integer k = 1; k <= x.size; k ++) {
+			const double dk = (x [k] - y [k]) / dmax;
+			d += w [k] * dk * dk;
+		}
+		return dmax * sqrt (d);
+	}
+	for (integer k = 1; k <= x.size; k ++)
+		d += w [k] * pow (fabs (x [k] - y [k]) / dmax, metric);
+	return dmax * pow (d, 1.0 / metric);   // scale back
+}
+
+/*
+	Calls pair (i, j) for all 1 <= i < j <= numberOfPoints, divided over threads.
+	Row i has numberOfPoints - i pairs, so we hand out the rows in couples (m, numberOfPoints + 1 - m),
+	which together always have numberOfPoints - 1 pairs.
+*/
+template <typename Pair>
+static void forAllPairs (integer numberOfPoints, integer minimumNumberOfPairsPerThread, Pair const& pair) {
+	const integer numberOfCouples = (numberOfPoints + 1) / 2;
+	const integer numberOfThreads = MelderThread_getNumberOfThreadsToUse (numberOfCouples,
+			std::max (1_integer, minimumNumberOfPairsPerThread / std::max (1_integer, numberOfPoints - 1)));
+	MelderThread_runChunks (numberOfThreads, numberOfCouples, [&] (integer /* ithread */, integer firstCouple, integer lastCouple) {
+		for (integer m = firstCouple; m <= lastCouple; m ++) {
+			for (integer j = m + 1; j <= numberOfPoints; j ++)
+				pair (m, j);
+			const integer mirror = numberOfPoints + 1 - m;
+			if (mirror != m)
+				for (integer j = mirror + 1; j <= numberOfPoints; j ++)
+					pair (mirror, j);
+		}
+	});
+}
+
+/*
+	Euclidean distances for many dimensions, via d [i] [j] ^ 2 = |x [i]| ^ 2 + |x [j]| ^ 2 - 2 x [i] . x [j],
+	where all the inner products come from one (fast, multithreaded) matrix multiplication.
+	To limit cancellation, the points are centred first (which does not change their distances),
+	and distances that are small compared to the norms are computed directly.
+*/
+static void Distance_setEuclideanDistancesFromGramMatrix (Distance me, Configuration conf) {
+	const integer numberOfPoints = conf -> numberOfRows;
+	autoMAT x = copy_MAT (conf -> data.get());
+	centreEachColumn_MAT_inout (x.get());
+	for (integer k = 1; k <= x.ncol; k ++)
+		x.column (k)  *=  sqrt (conf -> w [k]);
+	autoVEC norm2 = raw_VEC (numberOfPoints);
+	for (integer i = 1; i <= numberOfPoints; i ++)
+		norm2 [i] = NUMsum2 (x.row (i));
+	mul_fast_MAT_out (my data.get(), x.get(), x.transpose());
+	forAllPairs (numberOfPoints, 10'000, [&] (integer i, integer j) {
+		const double d2 = norm2 [i] + norm2 [j] - 2.0 * my data [i] [j];
+		const double d = ( isfinite (d2) && d2 >= 1e-2 * (norm2 [i] + norm2 [j]) ? sqrt (d2) :
+				getDistance (conf -> data.row (i), conf -> data.row (j), conf -> w.get(), 2) );
+		my data [i] [j] = my data [j] [i] = d;
+	});
+	for (integer i = 1; i <= numberOfPoints; i ++)
+		my data [i] [i] = 0.0;
 }
 
 autoDistance Configuration_to_Distance (Configuration me) {
 	try {
 		autoDistance thee = Distance_create (my numberOfRows);
 		TableOfReal_copyLabels (me, thee.get(), 1, -1);
-		autoVEC dist = raw_VEC (my numberOfColumns);
-		for (integer i = 1; i <= thy numberOfRows - 1; i ++) {
-			for (integer j = i + 1; j <= thy numberOfColumns; j ++) {
-				dist.all()  <<=  my data.row (i)  -  my data.row (j);
-				VECabs_inplace (dist.get());
-				const double dmax = NUMmax_e (dist.get());
-				double d = 0.0;
-				if (dmax > 0.0) {
-					dist.all()  /=  dmax;   // prevent overflow
-					VECpow (dist.get(), my metric);
-					d = NUMinner (my w.all(), dist.get());
-					d = dmax * pow (d, 1.0 / my metric);   // scale back
-				}
-				thy data [i] [j] = thy data [j] [i] = d;
-			}
+		if (my metric == 2 && my numberOfColumns >= 16) {
+			Distance_setEuclideanDistancesFromGramMatrix (thee.get(), me);
+		} else {
+			forAllPairs (my numberOfRows, 10'000, [&] (integer i, integer j) {
+				thy data [i] [j] = thy data [j] [i] = getDistance (my data.row (i), my data.row (j), my w.get(), my metric);
+			});
 		}
 		return thee;
 	} catch (MelderError) {
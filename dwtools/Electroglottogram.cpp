@@ -121,6 +121,7 @@ void IntervalTier_setIntervalText (IntervalTier me, integer intervalNumber, cons
 		Melder_require (intervalNumber >= 1 && intervalNumber <= my intervals.size,
 			U"Interval ", intervalNumber, U" does not exist.");
 		const TextInterval interval = my intervals.at [intervalNumber];
+		IntervalTier_invalidateIndex (me);
 		TextInterval_setText (interval, text);
 	} catch (MelderError) {
 		Melder_throw (me, U": interval text not set.");
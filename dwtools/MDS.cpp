@@ -1159,11 +1159,10 @@ autoDissimilarityList DistanceList_to_DissimilarityList (DistanceList me) {
 
 /*****************  Kruskal *****************************************/
 
-static void smacof_guttmanTransform (Configuration cx, Configuration cz, Distance disp, Weight weight, constMAT vplus) {
-	const integer nPoints = cx -> numberOfRows, nDimensions = cx -> numberOfColumns;
+static void smacof_guttmanTransform (Configuration cx, Configuration cz, Distance distZ, Distance disp, Weight weight, constMAT vplus) {
+	const integer nPoints = cx -> numberOfRows;
 
 	autoMAT b = raw_MAT (nPoints, nPoints);
-	autoDistance distZ = Configuration_to_Distance (cz);
 	/*
 		compute B(Z) (eq. 8.25)
 	*/
@@ -1179,19 +1178,11 @@ static void smacof_guttmanTransform (Configuration cx, Configuration cz, Distanc
 		b [i] [i] = - (double) sum;
 	}
 	/*
-		Guttman transform: Xu = (V+)B(Z)Z (eq. 8.29)
+		Guttman transform: Xu = (V+)B(Z)Z (eq. 8.29),
+		as two matrix products of order nPoints^2 * nDimensions.
 	*/
-	for (integer i = 1; i <= nPoints; i ++) {
-		for (integer j = 1; j <= nDimensions; j ++) {
-			longdouble xij = 0.0;
-			for (integer k = 1;  k <= nPoints; k ++) {
-				for (integer l = 1; l <= nPoints; l ++) {
-					xij += vplus [i] [k] * b [k] [l] * cz -> data [l] [j];
-				}
-			}
-			cx -> data [i] [j] = (double) xij;
-		}
-	}
+	autoMAT bz = mul_MAT (b.get(), cz -> data.get());
+	mul_MAT_out (cx -> data.get(), vplus, bz.get());
 }
 
 double Distance_Weight_stress (Distance fit, Distance conf, Weight weight, kMDS_stressMeasure stressMeasure) {
@@ -1390,8 +1381,12 @@ autoConfiguration Dissimilarity_Configuration_Weight_Transformator_smacof (Dissi
 		constexpr double tol = 1e-6;
 		autoMAT vplus = newMATpseudoInverse (v.get(), tol);
 		double stressp = 1e308, stress = 0.0;
+		/*
+			At the start of each iteration Z equals X, so the distances of X serve as those of Z as well,
+			and the distances computed for the stress are those of the next iteration.
+		*/
+		autoDistance dist = Configuration_to_Distance (conf);
 		for (integer iter = 1; iter <= numberOfIterations; iter ++) {
-			autoDistance dist = Configuration_to_Distance (conf);
 			/*
 				transform & normalization
 			*/
@@ -1399,7 +1394,7 @@ autoConfiguration Dissimilarity_Configuration_Weight_Transformator_smacof (Dissi
 			/*
 				Make conf the Guttman transform of z
 			*/
-			smacof_guttmanTransform (conf, z.get(), fit.get(), weight, vplus.get());
+			smacof_guttmanTransform (conf, z.get(), dist.get(), fit.get(), weight, vplus.get());
 			/*
 				Compute stress
 			*/
@@ -1414,6 +1409,7 @@ autoConfiguration Dissimilarity_Configuration_Weight_Transformator_smacof (Dissi
 				Make Z = X
 			*/
 			z -> data.all()  <<=  conf -> data.all();
+			dist = cdist.move();
 
 			stressp = stress;
 			if (showProgress)
@@ -40,6 +40,17 @@ autoBarkSpectrogram Sound_to_BarkSpectrogram (Sound me, double analysisWidth, do
 autoMelSpectrogram Sound_to_MelSpectrogram (Sound me, double analysisWidth, double dt,
 	double f1_mel, double fmax_mel, double df_mel);
 
+integer MelSpectrogram_fixFilterbankSettings (double samplingFrequency, double *inout_f1_mel, double *inout_fmax_mel, double *inout_df_mel);
+/*
+	Replaces unusable filter bank settings by the defaults of Sound_to_MelSpectrogram,
+	adjusts fmax_mel to a whole number of filters, and returns that number of filters.
+*/
+
+double Spectrogram_getGaussianWindowCorrection (integer numberOfSamples_window);
+/*
+	The power of the Gaussian window of Sound_createGaussian relative to that of a rectangular window.
+*/
+
 autoSpectrogram Sound_to_Spectrogram_pitchDependent (Sound me, double analysisWidth,
 	double dt, double f1_hz, double fmax_hz, double df_hz, double relative_bw,
 	double minimumPitch, double maximumPitch);
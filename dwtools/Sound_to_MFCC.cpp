@@ -23,12 +23,202 @@
 
 #include "Sound_to_MFCC.h"
 #include "Sound_and_Spectrogram_extensions.h"
+#include "Sound_extensions.h"
+#include "Spectrum.h"
+#include "NUM2.h"
+#include "MelderThread.h"
+
+/*
+	Sound_to_MFCC computes the same as Sound_to_MelSpectrogram followed by MelSpectrogram_to_MFCC,
+	but without the intermediate MelSpectrogram: each frame goes from the windowed samples via the FFT,
+	the triangular filters and the conversion to dB directly to the cosine transform,
+	in buffers that belong to the thread that handles the frame.
+	The filter bank is precomputed in sparse form (for each filter the range of its frequency bins and their weights),
+	with the power scaling of the spectrum and the window correction included in the weights.
+*/
+struct MelFilterbankAnalysis {
+	double windowDuration, t1, dt, f1_mel, fmax_mel, df_mel;
+	integer numberOfFrames, numberOfFilters, numberOfCoefficients;
+	integer numberOfFourierSamples, numberOfFrequencies;
+	autoVEC window;
+	autoINTVEC firstBin, lastBin, firstWeight;
+	autoVEC weights;
+	autoMAT cosinesTable;
+};
+
+static void MelFilterbankAnalysis_init (MelFilterbankAnalysis *me, Sampled sound, integer numberOfCoefficients,
+	double analysisWidth, double dt, double f1_mel, double fmax_mel, double df_mel)
+{
+	const double samplingFrequency = 1.0 / sound -> dx;
+	my windowDuration = 2.0 * analysisWidth;   // Gaussian window
+	my numberOfFilters = MelSpectrogram_fixFilterbankSettings (samplingFrequency, & f1_mel, & fmax_mel, & df_mel);
+	Melder_require (my numberOfFilters > 1,
+		U"There should be at least two filters.");
+	my f1_mel = f1_mel;
+	my fmax_mel = fmax_mel;
+	my df_mel = df_mel;
+	my dt = dt;
+	Sampled_shortTermAnalysis (sound, my windowDuration, dt, & my numberOfFrames, & my t1);
+	if (numberOfCoefficients <= 0 || numberOfCoefficients > my numberOfFilters - 1)
+		numberOfCoefficients = my numberOfFilters - 1;
+	my numberOfCoefficients = numberOfCoefficients;
+
+	autoSound window = Sound_createGaussian (my windowDuration, samplingFrequency);
+	my window = copy_VEC (window -> z.row (1));
+	my numberOfFourierSamples = Melder_iroundUpToPowerOfTwo (my window.size);
+	my numberOfFrequencies = my numberOfFourierSamples / 2 + 1;
+	/*
+		The frequency bins as Sound_to_Spectrum would create them for a windowed frame.
+	*/
+	autoSpectrum spectrum = Spectrum_create (0.5 * samplingFrequency, my numberOfFrequencies);
+	spectrum -> dx = 1.0 / (sound -> dx * my numberOfFourierSamples);
+	/*
+		The power in a bin is 2 |X (f)|^2 df / windowDuration, where X (f) is the FFT value times dx;
+		the bins at 0 Hz and at the Nyquist frequency don't count for two.
+	*/
+	const double powerScale = 2.0 * spectrum -> dx / (window -> xmax - window -> xmin) * sound -> dx * sound -> dx /
+			Spectrogram_getGaussianWindowCorrection (window -> nx);
+	my firstBin = raw_INTVEC (my numberOfFilters);
+	my lastBin = raw_INTVEC (my numberOfFilters);
+	my firstWeight = raw_INTVEC (my numberOfFilters);
+	integer numberOfWeights = 0;
+	for (integer ifilter = 1; ifilter <= my numberOfFilters; ifilter ++) {
+		const double fc_mel = f1_mel + (ifilter - 1) * df_mel;
+		Sampled_getWindowSamples (spectrum.get(), NUMmelToHertz2 (fc_mel - df_mel), NUMmelToHertz2 (fc_mel + df_mel),
+				& my firstBin [ifilter], & my lastBin [ifilter]);
+		my firstWeight [ifilter] = numberOfWeights + 1;
+		numberOfWeights += std::max (my lastBin [ifilter] - my firstBin [ifilter] + 1, 0_integer);
+	}
+	my weights = raw_VEC (numberOfWeights);
+	for (integer ifilter = 1; ifilter <= my numberOfFilters; ifilter ++) {
+		const double fc_mel = f1_mel + (ifilter - 1) * df_mel;
+		const double fc_hz = NUMmelToHertz2 (fc_mel);
+		const double fl_hz = NUMmelToHertz2 (fc_mel - df_mel);
+		const double fh_hz = NUMmelToHertz2 (fc_mel + df_mel);
+		for (integer ibin = my firstBin [ifilter]; ibin <= my lastBin [ifilter]; ibin ++) {
+			const double f = spectrum -> x1 + (ibin - 1) * spectrum -> dx;
+			double weight = powerScale * NUMtriangularfilter_amplitude (fl_hz, fc_hz, fh_hz, f);
+			if (ibin == 1)
+				weight *= 0.5;
+			if (ibin == my numberOfFrequencies)
+				weight *= 0.5;
+			my weights [my firstWeight [ifilter] + ibin - my firstBin [ifilter]] = weight;
+		}
+	}
+	my cosinesTable = MATcosinesTable (my numberOfFilters);
+}
+
+static autoMFCC MelFilterbankAnalysis_createMFCC (const MelFilterbankAnalysis *me, Sampled sound) {
+	/*
+		As in MelSpectrogram_to_MFCC, the maximum number of coefficients is the number of filters minus one.
+		The frames are allocated here, so that the threads do not allocate per frame.
+	*/
+	autoMFCC thee = MFCC_create (sound -> xmin, sound -> xmax, my numberOfFrames, my dt, my t1,
+			my numberOfFilters - 1, 0.0, my fmax_mel);
+	for (integer iframe = 1; iframe <= my numberOfFrames; iframe ++)
+		CC_Frame_init (& thy frame [iframe], my numberOfCoefficients);
+	return thee;
+}
+
+/*
+	Analyses the frames fromFrame .. toFrame of thee.
+	The samples of channel 1 of the sound are in `samples`, starting at sample number firstSample;
+	they should cover all the windows of the frames, except where these extend beyond the sound,
+	where the samples count as zero.
+*/
+static void MelFilterbankAnalysis_analyseFrames (MelFilterbankAnalysis *me, Sampled sound,
+	constVEC const& samples, integer firstSample, MFCC thee, integer fromFrame, integer toFrame)
+{
+	const integer numberOfThreads = MelderThread_getNumberOfThreadsToUse (toFrame - fromFrame + 1, 100);
+	autoMAT fourierBuffers = raw_MAT (numberOfThreads, my numberOfFourierSamples);
+	autoMAT powerBuffers = raw_MAT (numberOfThreads, my numberOfFrequencies);
+	autoMAT filterBuffers = raw_MAT (numberOfThreads, my numberOfFilters);
+	autoMAT cosineBuffers = raw_MAT (numberOfThreads, my numberOfFilters);
+	std::vector <autoNUMfft_Table> fourierTables (integer_to_uinteger (numberOfThreads));   // one per thread, because a table contains workspace
+	for (autoNUMfft_Table& fourierTable : fourierTables)
+		NUMfft_Table_init (& fourierTable, my numberOfFourierSamples);
+	MelderThread_runChunks (numberOfThreads, toFrame - fromFrame + 1, [&] (integer ithread, integer first, integer last) {
+		VEC data = fourierBuffers.row (ithread), power = powerBuffers.row (ithread);
+		autoNUMfft_Table& fourierTable = fourierTables [integer_to_uinteger (ithread - 1)];
+		VEC x = filterBuffers.row (ithread), y = cosineBuffers.row (ithread);
+		for (integer iframe = fromFrame + first - 1; iframe <= fromFrame + last - 1; iframe ++) {
+			const double t = my t1 + (iframe - 1) * my dt;
+			const integer startSample = Sampled_xToNearestIndex (sound, t - 0.5 * my windowDuration);
+			for (integer i = 1; i <= my window.size; i ++) {
+				const integer isample = startSample - 1 + i;
+				if (isample < 1 || isample > sound -> nx) {
+					data [i] = 0.0;
+				} else {
+					Melder_assert (isample >= firstSample && isample - firstSample < samples.size);
+					data [i] = samples [isample - firstSample + 1] * my window [i];
+				}
+			}
+			data.part (my window.size + 1, data.size)  <<=  0.0;
+			NUMfft_forward (& fourierTable, data);
+			power [1] = data [1] * data [1];
+			for (integer i = 2; i < my numberOfFrequencies; i ++)
+				power [i] = data [i + i - 2] * data [i + i - 2] + data [i + i - 1] * data [i + i - 1];
+			if (my numberOfFrequencies > 1)
+				power [my numberOfFrequencies] = data [my numberOfFourierSamples] * data [my numberOfFourierSamples];
+			for (integer ifilter = 1; ifilter <= my numberOfFilters; ifilter ++) {
+				double filterPower = 0.0;
+				const double *weight = & my weights [my firstWeight [ifilter]];
+				for (integer ibin = my firstBin [ifilter]; ibin <= my lastBin [ifilter]; ibin ++)
+					filterPower += *weight ++ * power [ibin];
+				x [ifilter] = ( filterPower > 0.0 ? 10.0 * log10 (filterPower / 4e-10) : -300.0 );   // as BandFilterSpectrogram
+			}
+			VECcosineTransform_preallocated (y, x, my cosinesTable.get());
+			const CC_Frame ccframe = & thy frame [iframe];
+			ccframe -> c0 = y [1];
+			for (integer i = 1; i <= my numberOfCoefficients; i ++)
+				ccframe -> c [i] = y [i + 1];
+		}
+	});
+}
 
 autoMFCC Sound_to_MFCC (Sound me, integer numberOfCoefficients, double analysisWidth, double dt, double f1_mel, double fmax_mel, double df_mel) {
 	try {
-		autoMelSpectrogram mf = Sound_to_MelSpectrogram (me, analysisWidth, dt, f1_mel, fmax_mel, df_mel);
-		autoMFCC mfcc = MelSpectrogram_to_MFCC (mf.get(), numberOfCoefficients);
-		return mfcc;
+		MelFilterbankAnalysis analysis;
+		MelFilterbankAnalysis_init (& analysis, me, numberOfCoefficients, analysisWidth, dt, f1_mel, fmax_mel, df_mel);
+		autoMFCC thee = MelFilterbankAnalysis_createMFCC (& analysis, me);
+		autoMelderProgress progress (U"MFCC analysis");
+		constexpr integer numberOfFramesPerBlock = 10'000;
+		for (integer fromFrame = 1; fromFrame <= analysis.numberOfFrames; fromFrame += numberOfFramesPerBlock) {
+			const integer toFrame = std::min (fromFrame + numberOfFramesPerBlock - 1, analysis.numberOfFrames);
+			MelFilterbankAnalysis_analyseFrames (& analysis, me, my z.row (1), 1, thee.get(), fromFrame, toFrame);
+			Melder_progress ((double) toFrame / analysis.numberOfFrames, U"Frame ", toFrame, U" out of ", analysis.numberOfFrames, U".");
+		}
+		return thee;
+	} catch (MelderError) {
+		Melder_throw (me, U": no MFCC created.");
+	}
+}
+
+autoMFCC LongSound_to_MFCC (LongSound me, integer numberOfCoefficients, double analysisWidth, double dt, double f1_mel, double fmax_mel, double df_mel) {
+	try {
+		MelFilterbankAnalysis analysis;
+		MelFilterbankAnalysis_init (& analysis, me, numberOfCoefficients, analysisWidth, dt, f1_mel, fmax_mel, df_mel);
+		autoMFCC thee = MelFilterbankAnalysis_createMFCC (& analysis, me);
+		/*
+			Read the samples block by block, with as many frames per block as fit in about 10 seconds of sound;
+			consecutive blocks overlap by one window.
+		*/
+		const integer numberOfFramesPerBlock = std::max (1_integer, Melder_ifloor (10.0 / dt));
+		autoMelderProgress progress (U"MFCC analysis");
+		for (integer fromFrame = 1; fromFrame <= analysis.numberOfFrames; fromFrame += numberOfFramesPerBlock) {
+			const integer toFrame = std::min (fromFrame + numberOfFramesPerBlock - 1, analysis.numberOfFrames);
+			const double startTime = analysis.t1 + (fromFrame - 1) * dt - 0.5 * analysis.windowDuration;
+			const double endTime = analysis.t1 + (toFrame - 1) * dt - 0.5 * analysis.windowDuration;
+			integer firstSample = Sampled_xToNearestIndex (me, startTime);
+			integer lastSample = Sampled_xToNearestIndex (me, endTime) + analysis.window.size - 1;
+			Melder_clipLeft (1_integer, & firstSample);
+			Melder_clipRight (& lastSample, my nx);
+			autoMAT buffer = raw_MAT (my numberOfChannels, lastSample - firstSample + 1);
+			LongSound_readAudioToFloat (me, buffer.get(), firstSample);
+			MelFilterbankAnalysis_analyseFrames (& analysis, me, buffer.row (1), firstSample, thee.get(), fromFrame, toFrame);
+			Melder_progress ((double) toFrame / analysis.numberOfFrames, U"Frame ", toFrame, U" out of ", analysis.numberOfFrames, U".");
+		}
+		return thee;
 	} catch (MelderError) {
 		Melder_throw (me, U": no MFCC created.");
 	}
@@ -26,8 +26,19 @@
 
 #include "MFCC.h"
 #include "Sound.h"
+#include "LongSound.h"
 
 autoMFCC Sound_to_MFCC (Sound me, integer numberOfCoefficients, double analysisWidth,
 	double dt, double f1_mel, double fmax_mel, double df_mel);
+/*
+	The same as Sound_to_MelSpectrogram followed by MelSpectrogram_to_MFCC,
+	but without creating the MelSpectrogram.
+*/
+
+autoMFCC LongSound_to_MFCC (LongSound me, integer numberOfCoefficients, double analysisWidth,
+	double dt, double f1_mel, double fmax_mel, double df_mel);
+/*
+	The same as Sound_to_MFCC for the whole LongSound, reading the samples block by block.
+*/
 
 #endif /* _Sound_to_MFCC_h_ */
@@ -1,6 +1,6 @@
 /* Sound_to_Pitch2.c
  *
- * Copyright (C) 1993-2019 David Weenink
+ * Copyright (C) 1993-2019,2026 David Weenink
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -29,6 +29,7 @@
 #include "Sound_to_SPINET.h"
 #include "SPINET_to_Pitch.h"
 #include "NUM2.h"
+#include "MelderThread.h"
 
 static double Sound_approximateLocalSampleMean (Sound me, double fromTime, double toTime) {
 	const integer n1 = Melder_clippedLeft (1_integer, Sampled_xToNearestIndex (me, fromTime));
@@ -36,10 +37,9 @@ static double Sound_approximateLocalSampleMean (Sound me, double fromTime, doubl
 	return n1 <= n2 ? NUMmean (my z [1].part (n1, n2)) : undefined;
 }
 
-static void spec_enhance_SHS (VEC const & a) {
+static void spec_enhance_SHS (VEC const & a, INTVEC const& posmax) {
 	Melder_assert (a.size >= 2);
-
-	autoINTVEC posmax = raw_INTVEC ((a.size + 1) / 2);
+	Melder_assert (posmax.size >= (a.size + 1) / 2);
 	integer nmax = 0;
 	if (a [1] > a [2])
 		posmax [++ nmax] = 1;
@@ -101,8 +101,8 @@ autoPitch Sound_to_Pitch_shs (Sound me, double timeStep, double minimumPitch, do
 		
 		const integer nfft = Melder_clippedLeft (256_integer /* the minimum number of points for the FFT */, Melder_iroundUpToPowerOfTwo (numberOfSamples));
 		const integer nfft2 = nfft / 2 + 1;
-		const double fftframeDuration = nfft / newSamplingFrequency;
 		const double df = newSamplingFrequency / nfft;
+		const double spectrumScaling = 1.0 / newSamplingFrequency;   // the sampling period of the FFT frame
 		/*
 			The number of points on the octave scale.
 		*/
@@ -114,20 +114,13 @@ autoPitch Sound_to_Pitch_shs (Sound me, double timeStep, double minimumPitch, do
 		integer numberOfFrames;
 		double firstTime;
 		Sampled_shortTermAnalysis (sound.get(), windowDuration, timeStep, & numberOfFrames, & firstTime);
-		autoSound fftframe = Sound_createSimple (1, fftframeDuration, newSamplingFrequency);
-		autoSound analysisframe = Sound_createSimple (1, frameDuration, newSamplingFrequency);
 		autoSound hamming = Sound_createHamming (frameDuration, newSamplingFrequency);
 		autoPitch thee = Pitch_create (my xmin, my xmax, numberOfFrames, timeStep, firstTime, ceiling, maxnCandidates);
 		autoVEC cc = zero_VEC (numberOfFrames);
-		autoVEC specAmp = raw_VEC (nfft2);
 		autoVEC fl2 = raw_VEC (nfft2);
-		autoVEC yv2 = raw_VEC (nfft2);
 		autoVEC arctg = raw_VEC (numberOfFrequencyPoints);
-		autoVEC al2 = raw_VEC (numberOfFrequencyPoints);
 
-		Melder_assert (fftframe -> nx >= numberOfSamples);
 		Melder_assert (hamming -> nx == numberOfSamples);
-		Melder_assert (analysisframe -> nx == numberOfSamples);
 		/*
 			Compute the absolute value of the globally largest amplitude w.r.t. the global mean.
 		*/
@@ -148,108 +141,129 @@ autoPitch Sound_to_Pitch_shs (Sound me, double timeStep, double minimumPitch, do
 		for (integer i = 1; i <= numberOfFrequencyPoints; i ++)
 			arctg [i] = 0.5 + atan (3.0 * (i - atans) / numberOfPointsPerOctave) / NUMpi;
 		/*
-			Perform the analysis on all frames.
+			The frames are independent, so they are analysed in parallel.
+			The candidates of all frames, and the buffers of each thread, are allocated here,
+			so that the threads do not allocate per frame; each thread also gets its own FFT table,
+			because NUMfft_forward () uses part of the table as workspace.
 		*/
 		for (integer iframe = 1; iframe <= numberOfFrames; iframe ++) {
 			const Pitch_Frame pitchFrame = & thy frames [iframe];
-			const double tmid = Sampled_indexToX (thee.get(), iframe); // The center of this frame
-			/*
-				Copy a frame from the sound, apply a hamming window. Get local 'intensity'
-			*/
-			Sound_into_Sound (sound.get(), analysisframe.get(), tmid - halfWindow);
-			Sounds_multiply (analysisframe.get(), hamming.get());
-			const double localMean = Sound_approximateLocalSampleMean (sound.get(), tmid - 3.0 * halfWindow, tmid + 3.0 * halfWindow);
-			const double localPeak = Sound_localPeak (sound.get(), tmid - halfWindow, tmid + halfWindow, localMean);
-			pitchFrame -> intensity = localPeak > globalPeak ? 1.0 : localPeak / globalPeak;
-			/*
-				Get the Fourier spectrum.
-			*/
-			fftframe -> z [1].part (1, analysisframe -> nx)  <<=  analysisframe -> z [1]; // 
-			autoSpectrum spec = Sound_to_Spectrum (fftframe.get(), true);
-			Melder_assert (spec -> nx == nfft2);
-			/*
-				From complex spectrum to amplitude spectrum.
-			*/
-			for (integer j = 1; j <= nfft2; j ++) {
-				const double rs = spec -> z [1] [j], is = spec -> z [2] [j];
-				specAmp [j] = hypot (rs, is);
-			}
-			/*
-				Enhance the peaks in the spectrum.
-			*/
-			spec_enhance_SHS (specAmp.get());
-			/*
-				Smooth the enhanced spectrum.
-			*/
-			spec_smoooth_SHS (specAmp.get());
-			/*
-				Go to a logarithmic scale and perform cubic spline interpolation to get
-				spectral values for the increased number of frequency points.
-			*/
-			NUMcubicSplineInterpolation_getSecondDerivatives (yv2.get(), fl2.get(), specAmp.get(), 1e30, 1e30);
-			for (integer j = 1; j <= numberOfFrequencyPoints; j ++) {
-				const double f = fminl2 + (j - 1) * dfl2;
-				al2 [j] = NUMcubicSplineInterpolation (fl2.get(), specAmp.get(), yv2.get(), f);
-			}
-			/*
-				Multiply by frequency selectivity of the auditory system.
-			*/
-			for (integer j = 1; j <= numberOfFrequencyPoints; j ++)
-				al2 [j] = ( al2 [j] > 0.0 ? al2 [j] * arctg [j] : 0.0 );
-			/*
-				The subharmonic summation. Shift spectra in octaves and sum.
-			*/
 			Pitch_Frame_init (pitchFrame, maxnCandidates);
-			autoVEC sumspec = zero_VEC (numberOfFrequencyPoints);
-			pitchFrame -> candidates. resize (pitchFrame -> nCandidates = 0);   // !!!!!
-
-			double hm = 1.0;
-			for (integer m = 1; m <= maxnSubharmonics + 1; m ++) {
-				const integer kb = 1 + Melder_ifloor (numberOfPointsPerOctave * NUMlog2 (m));
-				for (integer k = kb; k <= numberOfFrequencyPoints; k ++)
-					sumspec [k - kb + 1] += al2 [k] * hm;
-				hm *= compressionFactor;
-			}
-			/*
-				First register the voiceless candidate (always present).
-			*/
-			Pitch_Frame_addPitch (pitchFrame, 0.0, 0.0, maxnCandidates);
-			/*
-				Get the best local estimates for the pitch as the maxima of the
-				subharmonic sum spectrum by parabolic interpolation on three points:
-				The formula for a parabola with a maximum is:
-					y(x) = a - b (x - c)^2 with a, b, c >= 0
-				The three points are (-x, y1), (0, y2) and (x, y3).
-				The solution for a (the maximum) and c (the position) is:
-				a = (2 y1 (4 y2 + y3) - y1^2 - (y3 - 4 y2)^2)/( 8 (y1 - 2 y2 + y3)
-				c = dx (y1 - y3) / (2 (y1 - 2 y2 + y3))
-				(b = (2 y2 - y1 - y3) / (2 dx^2) )
-			*/
-			for (integer k = 2; k <= numberOfFrequencyPoints - 1; k ++) {
-				const double y1 = sumspec [k - 1], y2 = sumspec [k], y3 = sumspec [k + 1];
-				if (y2 > y1 && y2 >= y3) {
-					const double denum = y1 - 2.0 * y2 + y3, tmp = y3 - 4.0 * y2;
-					const double x = dfl2 * (y1 - y3) / (2.0 * denum);
-					const double f = pow (2.0, fminl2 + (k - 1) * dfl2 + x);
-					const double strength = (2.0 * y1 * (4.0 * y2 + y3) - y1 * y1 - tmp * tmp) / (8.0 * denum);
-					Pitch_Frame_addPitch (pitchFrame, f, strength, maxnCandidates);
+			pitchFrame -> candidates. resize (pitchFrame -> nCandidates = 0);   // keeps the capacity for maxnCandidates
+		}
+		const integer numberOfThreads = MelderThread_getNumberOfThreadsToUse (numberOfFrames, 20);
+		std::vector <autoNUMfft_Table> fftTables (integer_to_uinteger (numberOfThreads));
+		for (autoNUMfft_Table& fftTable : fftTables)
+			NUMfft_Table_init (& fftTable, nfft);
+		autoMAT fourierBuffers = raw_MAT (numberOfThreads, nfft);
+		autoMAT amplitudeBuffers = raw_MAT (numberOfThreads, nfft2);
+		autoMAT secondDerivativeBuffers = raw_MAT (numberOfThreads, nfft2);
+		autoMAT octaveSpectrumBuffers = raw_MAT (numberOfThreads, numberOfFrequencyPoints);
+		autoMAT sumSpectrumBuffers = raw_MAT (numberOfThreads, numberOfFrequencyPoints);
+		autoINTMAT peakPositionBuffers = raw_INTMAT (numberOfThreads, (nfft2 + 1) / 2);
+		MelderThread_runChunks (numberOfThreads, numberOfFrames, [&] (integer ithread, integer firstFrame, integer lastFrame) {
+			const VEC data = fourierBuffers.row (ithread), specAmp = amplitudeBuffers.row (ithread);
+			const VEC yv2 = secondDerivativeBuffers.row (ithread);
+			const VEC al2 = octaveSpectrumBuffers.row (ithread), sumspec = sumSpectrumBuffers.row (ithread);
+			const INTVEC posmax = peakPositionBuffers.row (ithread);
+			autoNUMfft_Table& fftTable = fftTables [integer_to_uinteger (ithread - 1)];
+			for (integer iframe = firstFrame; iframe <= lastFrame; iframe ++) {
+				const Pitch_Frame pitchFrame = & thy frames [iframe];
+				const double tmid = Sampled_indexToX (thee.get(), iframe); // The center of this frame
+				/*
+					Copy a frame from the sound, apply a hamming window. Get local 'intensity'
+				*/
+				const integer startSample = Sampled_xToNearestIndex (sound.get(), tmid - halfWindow);
+				for (integer i = 1; i <= numberOfSamples; i ++) {
+					const integer j = startSample - 1 + i;
+					data [i] = ( j < 1 || j > sound -> nx ? 0.0 : sound -> z [1] [j] ) * hamming -> z [1] [i];
 				}
-			}
-			/*
-				Check whether f0 corresponds to an actual periodicity T = 1 / f0:
-				correlate two signal periods of duration T, one starting at the
-				middle of the interval and one starting T seconds before.
-				If there is periodicity the correlation coefficient should be high.
+				data.part (numberOfSamples + 1, nfft)  <<=  0.0;
+				const double localMean = Sound_approximateLocalSampleMean (sound.get(), tmid - 3.0 * halfWindow, tmid + 3.0 * halfWindow);
+				const double localPeak = Sound_localPeak (sound.get(), tmid - halfWindow, tmid + halfWindow, localMean);
+				pitchFrame -> intensity = localPeak > globalPeak ? 1.0 : localPeak / globalPeak;
+				/*
+					Get the amplitude spectrum (with the scaling of Sound_to_Spectrum).
+				*/
+				NUMfft_forward (& fftTable, data);
+				specAmp [1] = hypot (data [1] * spectrumScaling, 0.0);
+				for (integer j = 2; j < nfft2; j ++)
+					specAmp [j] = hypot (data [j + j - 2] * spectrumScaling, data [j + j - 1] * spectrumScaling);
+				specAmp [nfft2] = hypot (data [nfft] * spectrumScaling, 0.0);
+				/*
+					Enhance the peaks in the spectrum.
+				*/
+				spec_enhance_SHS (specAmp, posmax);
+				/*
+					Smooth the enhanced spectrum.
+				*/
+				spec_smoooth_SHS (specAmp);
+				/*
+					Go to a logarithmic scale and perform cubic spline interpolation to get
+					spectral values for the increased number of frequency points.
+				*/
+				NUMcubicSplineInterpolation_getSecondDerivatives (yv2, fl2.get(), specAmp, 1e30, 1e30);
+				for (integer j = 1; j <= numberOfFrequencyPoints; j ++) {
+					const double f = fminl2 + (j - 1) * dfl2;
+					al2 [j] = NUMcubicSplineInterpolation (fl2.get(), specAmp, yv2, f);
+				}
+				/*
+					Multiply by frequency selectivity of the auditory system.
+				*/
+				for (integer j = 1; j <= numberOfFrequencyPoints; j ++)
+					al2 [j] = ( al2 [j] > 0.0 ? al2 [j] * arctg [j] : 0.0 );
+				/*
+					The subharmonic summation. Shift spectra in octaves and sum.
+				*/
+				sumspec  <<=  0.0;
+				double hm = 1.0;
+				for (integer m = 1; m <= maxnSubharmonics + 1; m ++) {
+					const integer kb = 1 + Melder_ifloor (numberOfPointsPerOctave * NUMlog2 (m));
+					for (integer k = kb; k <= numberOfFrequencyPoints; k ++)
+						sumspec [k - kb + 1] += al2 [k] * hm;
+					hm *= compressionFactor;
+				}
+				/*
+					First register the voiceless candidate (always present).
+				*/
+				Pitch_Frame_addPitch (pitchFrame, 0.0, 0.0, maxnCandidates);
+				/*
+					Get the best local estimates for the pitch as the maxima of the
+					subharmonic sum spectrum by parabolic interpolation on three points:
+					The formula for a parabola with a maximum is:
+						y(x) = a - b (x - c)^2 with a, b, c >= 0
+					The three points are (-x, y1), (0, y2) and (x, y3).
+					The solution for a (the maximum) and c (the position) is:
+					a = (2 y1 (4 y2 + y3) - y1^2 - (y3 - 4 y2)^2)/( 8 (y1 - 2 y2 + y3)
+					c = dx (y1 - y3) / (2 (y1 - 2 y2 + y3))
+					(b = (2 y2 - y1 - y3) / (2 dx^2) )
+				*/
+				for (integer k = 2; k <= numberOfFrequencyPoints - 1; k ++) {
+					const double y1 = sumspec [k - 1], y2 = sumspec [k], y3 = sumspec [k + 1];
+					if (y2 > y1 && y2 >= y3) {
+						const double denum = y1 - 2.0 * y2 + y3, tmp = y3 - 4.0 * y2;
+						const double x = dfl2 * (y1 - y3) / (2.0 * denum);
+						const double f = pow (2.0, fminl2 + (k - 1) * dfl2 + x);
+						const double strength = (2.0 * y1 * (4.0 * y2 + y3) - y1 * y1 - tmp * tmp) / (8.0 * denum);
+						Pitch_Frame_addPitch (pitchFrame, f, strength, maxnCandidates);
+					}
+				}
+				/*
+					Check whether f0 corresponds to an actual periodicity T = 1 / f0:
+					correlate two signal periods of duration T, one starting at the
+					middle of the interval and one starting T seconds before.
+					If there is periodicity the correlation coefficient should be high.
 
-				However, some sounds do not show any regularity, or very low
-				frequency and regularity, and nevertheless have a definite
-				pitch, e.g. Shepard sounds.
-			*/
-			double pitch_strength, f0;
-			Pitch_Frame_getPitch (pitchFrame, & f0, & pitch_strength);
-			if (f0 > 0.0)
-				cc [iframe] = Sound_correlateParts (sound.get(), tmid - 1.0 / f0, tmid, 1.0 / f0);
-		}
+					However, some sounds do not show any regularity, or very low
+					frequency and regularity, and nevertheless have a definite
+					pitch, e.g. Shepard sounds.
+				*/
+				double pitch_strength, f0;
+				Pitch_Frame_getPitch (pitchFrame, & f0, & pitch_strength);
+				if (f0 > 0.0)
+					cc [iframe] = Sound_correlateParts (sound.get(), tmid - 1.0 / f0, tmid, 1.0 / f0);
+			}
+		});
 		/*
 			Base V/UV decision on correlation coefficients.
 			Resize the pitch strengths w.r.t. the cc.
@@ -1,6 +1,6 @@
 /* Sound_to_SPINET.cpp
  *
- * Copyright (C) 1993-2019 David Weenink
+ * Copyright (C) 1993-2019,2026 David Weenink
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -23,6 +23,7 @@
 
 #include "Sound_to_SPINET.h"
 #include "NUM2.h"
+#include "MelderThread.h"
 
 static double fgamma (double x, integer n) {
 	const double x2p1 = 1.0 + x * x;
@@ -51,11 +52,10 @@ autoSPINET Sound_to_SPINET (Sound me, double timeStep, double windowDuration, do
 		Sampled_shortTermAnalysis (me, windowDuration, timeStep, & numberOfFrames, & firstTime);
 		autoSPINET thee = SPINET_create (my xmin, my xmax, numberOfFrames, timeStep, firstTime, minimumFrequencyHz, maximumFrequencyHz, numberOfGammaFilters, excitationErbProportion, inhibitionErbProportion);
 		autoSound window = Sound_createGaussian (windowDuration, samplingFrequency);
-		autoSound frame = Sound_createSimple (1, windowDuration, samplingFrequency);
 		autoVEC f = raw_VEC (numberOfGammaFilters);
 		autoVEC bw = raw_VEC (numberOfGammaFilters);
-		autoVEC aex = raw_VEC (numberOfGammaFilters);
-		autoVEC ain = raw_VEC (numberOfGammaFilters);
+		autoVEC aex = zero_VEC (numberOfGammaFilters);
+		autoVEC ain = zero_VEC (numberOfGammaFilters);
 		/*
 			Cochlear filterbank: gammatone.
 		*/
@@ -63,51 +63,109 @@ autoSPINET Sound_to_SPINET (Sound me, double timeStep, double windowDuration, do
 			f [i] = NUMerbToHertz (thy y1 + (i - 1) * thy dy);
 			bw [i] = NUM2pi * b * (f [i] * (6.23e-6 * f [i] + 93.39e-3) + 28.52);
 		}
+		/*
+			The filters are applied by convolution via the FFT, as in Sounds_convolve ()
+			(only the first channel of the sound matters for the energy measure).
+			All gammatones have the same length, so the spectrum of the sound is computed only once,
+			and the filters themselves are applied in parallel. Each thread has its own buffers and its own FFT table
+			(a table contains workspace), all allocated here, so that no filter has to allocate anything.
+		*/
+		autoSound gammaToneShape = Sound_createGammaTone (0.0, 0.1, samplingFrequency, thy gamma, b, f [1], 0.0, 0.0, false);
+		const integer numberOfFilteredSamples = my nx + gammaToneShape -> nx - 1;
+		const integer nfft = Melder_iroundUpToPowerOfTwo (numberOfFilteredSamples);
+		const integer numberOfThreads = MelderThread_getNumberOfThreadsToUse (numberOfGammaFilters, 4);
+		std::vector <autoNUMfft_Table> fourierTables (integer_to_uinteger (numberOfThreads));
+		for (autoNUMfft_Table& fourierTable : fourierTables)
+			NUMfft_Table_init (& fourierTable, nfft);
+		autoVEC soundSpectrum = zero_VEC (nfft);
+		soundSpectrum.part (1, my nx)  <<=  my z.row (1);
+		NUMfft_forward (& fourierTables [0], soundSpectrum.get());
 
-		autoMelderProgress progress (U"SPINET analysis");
-
+		autoMAT fourierBuffers = raw_MAT (numberOfThreads, nfft);
+		autoSoundList filtered = SoundList_create (), frames = SoundList_create (), gammaTones = SoundList_create ();
+		for (integer ithread = 1; ithread <= numberOfThreads; ithread ++) {
+			filtered -> addItem_move (Sound_create (1, my xmin + gammaToneShape -> xmin, my xmax + gammaToneShape -> xmax,
+					numberOfFilteredSamples, my dx, my x1 + gammaToneShape -> x1));
+			frames -> addItem_move (Sound_createSimple (1, windowDuration, samplingFrequency));
+		}
 		for (integer i = 1; i <= numberOfGammaFilters; i ++) {
-			const double bb = (f [i] / 1000.0) * exp (- f [i] / 1000.0); // outer & middle ear and phase locking
-			const double tgammaMax = (thy gamma - 1) / bw [i]; // the time where the gamma function envelope has its maximum
-			const double gammaMaxAmplitude = pow ((thy gamma - 1) / (NUMe * bw [i]), thy gamma - 1);
-			const double timeCorrection = tgammaMax - windowDuration / 2.0;
-
 			autoSound gammaTone = Sound_createGammaTone (0.0, 0.1, samplingFrequency, thy gamma, b, f [i], 0.0, 0.0, false);
-			autoSound filtered = Sounds_convolve (me, gammaTone.get(), kSounds_convolve_scaling::SUM, kSounds_convolve_signalOutsideTimeDomain::ZERO);
-			/*
-				To energy measure: weigh with broad-band transfer function.
-			*/
-			for (integer j = 1; j <= numberOfFrames; j ++) {
-				Sound_into_Sound (filtered.get(), frame.get(), Sampled_indexToX (thee.get(), j) + timeCorrection);
-				Sounds_multiply (frame.get(), window.get());
-				thy y [i] [j] = Sound_power (frame.get()) * bb / gammaMaxAmplitude;
-			}
-			Melder_progress ((double) i / numberOfGammaFilters, U"SPINET: filter ", i, U" from ", numberOfGammaFilters, U".");
+			Melder_assert (gammaTone -> nx == gammaToneShape -> nx);
+			gammaTones -> addItem_move (gammaTone.move());
 		}
+
+		autoMelderProgress progress (U"SPINET analysis");
+		MelderThread_runChunks (numberOfThreads, numberOfGammaFilters, [&] (integer ithread, integer firstFilter, integer lastFilter) {
+			const VEC data = fourierBuffers.row (ithread);
+			autoNUMfft_Table& fourierTable = fourierTables [integer_to_uinteger (ithread - 1)];
+			const Sound filteredSound = filtered -> at [ithread], frame = frames -> at [ithread];
+			for (integer i = firstFilter; i <= lastFilter; i ++) {
+				const double bb = (f [i] / 1000.0) * exp (- f [i] / 1000.0); // outer & middle ear and phase locking
+				const double tgammaMax = (thy gamma - 1) / bw [i]; // the time where the gamma function envelope has its maximum
+				const double gammaMaxAmplitude = pow ((thy gamma - 1) / (NUMe * bw [i]), thy gamma - 1);
+				const double timeCorrection = tgammaMax - windowDuration / 2.0;
+				/*
+					Convolve (with "sum" scaling and zero signal outside the time domain).
+				*/
+				const constVEC gammaTone = gammaTones -> at [i] -> z.row (1);
+				data.part (1, gammaTone.size)  <<=  gammaTone;
+				data.part (gammaTone.size + 1, nfft)  <<=  0.0;
+				NUMfft_forward (& fourierTable, data);
+				data [1] *= soundSpectrum [1];   // direct current
+				data [nfft] *= soundSpectrum [nfft];   // Nyquist
+				for (integer k = 2; k < nfft; k += 2) {
+					const double temp = soundSpectrum [k] * data [k] - soundSpectrum [k + 1] * data [k + 1];
+					data [k + 1] = soundSpectrum [k] * data [k + 1] + soundSpectrum [k + 1] * data [k];
+					data [k] = temp;
+				}
+				NUMfft_backward (& fourierTable, data);
+				filteredSound -> z.row (1)  <<=  data.part (1, numberOfFilteredSamples);
+				filteredSound -> z.row (1)  *=  1.0 / nfft;
+				/*
+					To energy measure: weigh with broad-band transfer function.
+				*/
+				for (integer j = 1; j <= numberOfFrames; j ++) {
+					Sound_into_Sound (filteredSound, frame, Sampled_indexToX (thee.get(), j) + timeCorrection);
+					Sounds_multiply (frame, window.get());
+					thy y [i] [j] = Sound_power (frame) * bb / gammaMaxAmplitude;
+				}
+				if (ithread == numberOfThreads)
+					Melder_progress ((double) (i - firstFilter + 1) / (lastFilter - firstFilter + 1),
+							U"SPINET: filter ", i, U" from ", numberOfGammaFilters, U".");
+			}
+		});
 		/*
 			Excitatory and inhibitory area functions.
 		*/
+		autoMAT hex = raw_MAT (numberOfGammaFilters, numberOfGammaFilters);
+		autoMAT hin = raw_MAT (numberOfGammaFilters, numberOfGammaFilters);
 		for (integer i = 1; i <= numberOfGammaFilters; i ++) {
 			for (integer k = 1; k <= numberOfGammaFilters; k ++) {
 				const double fr = (f [k] - f [i]) / bw [i];
-				aex [i] += fgamma (fr / thy excitationErbProportion, thy gamma);
-				ain [i] += fgamma (fr / thy inhibitionErbProportion, thy gamma);
+				hex [i] [k] = fgamma (fr / thy excitationErbProportion, thy gamma);
+				hin [i] [k] = fgamma (fr / thy inhibitionErbProportion, thy gamma);
+				aex [i] += hex [i] [k];
+				ain [i] += hin [i] [k];
 			}
 		}
 		/*
-			On-center off-surround interactions
+			On-center off-surround interactions.
+			The weights do not depend on time, so they are computed only once.
 		*/
-		for (integer j = 1; j <= numberOfFrames; j ++)
-			for (integer i = 1; i <= numberOfGammaFilters; i ++) {
-				longdouble a = 0.0;
-				for (integer k = 1; k <= numberOfGammaFilters; k ++) {
-					const double fr = (f [k] - f [i]) / bw [i];
-					const double hexsq = fgamma (fr / thy excitationErbProportion, thy gamma);
-					const double hinsq = fgamma (fr / thy inhibitionErbProportion, thy gamma);
-					a += thy y [k] [j] * (hexsq / aex [i] - hinsq / ain [i]);
+		autoMAT weights = raw_MAT (numberOfGammaFilters, numberOfGammaFilters);
+		for (integer i = 1; i <= numberOfGammaFilters; i ++)
+			for (integer k = 1; k <= numberOfGammaFilters; k ++)
+				weights [i] [k] = hex [i] [k] / aex [i] - hin [i] [k] / ain [i];
+		const integer numberOfFrameThreads = MelderThread_getNumberOfThreadsToUse (numberOfFrames, 20);
+		MelderThread_runChunks (numberOfFrameThreads, numberOfFrames, [&] (integer /* ithread */, integer firstFrame, integer lastFrame) {
+			for (integer j = firstFrame; j <= lastFrame; j ++)
+				for (integer i = 1; i <= numberOfGammaFilters; i ++) {
+					longdouble a = 0.0;
+					for (integer k = 1; k <= numberOfGammaFilters; k ++)
+						a += thy y [k] [j] * weights [i] [k];
+					thy s [i] [j] = a > 0.0 ? (double) a : 0.0;
 				}
-				thy s [i] [j] = a > 0.0 ? (double) a : 0.0;
-			}
+		});
 		return thee;
 	} catch (MelderError) {
 		Melder_throw (me, U":  no SPINET created.");
@@ -1,6 +1,6 @@
 /* SpeechSynthesizer.cpp
  *
-//  * Copyright (C) 2011-2022 David Weenink
+//  * Copyright (C) 2011-2022,2026 David Weenink
  *
  * This code is free software; you can redistribute it and/or modify
  * it under the terms of the GNU General Public License as published by
@@ -23,11 +23,11 @@
 #include "SpeechSynthesizer.h"
 #include "Strings_extensions.h"
 #include "speak_lib.h"
+#include "translate.h"   // before synthdata.h, which would declare DeleteTranslator () as extern "C"
 #include "synthdata.h"
 #include "encoding.h"
 #include "dictionary.h"
 #include "string.h"
-#include "translate.h"
 
 #include "oo_DESTROY.h"
 #include "SpeechSynthesizer_def.h"
@@ -588,13 +588,217 @@ static autoTextGrid Table_to_TextGrid (Table me, conststring32 text, double xmin
 	}
 }
 
+/*
+	The espeak engine is initialized only once, and then stays alive between syntheses,
+	because initializing it (loading the phoneme tables) and selecting a voice (loading its dictionary)
+	take much longer than synthesizing a typical prompt.
+	We remember what was applied last, so that for the next text we change only what differs.
+
+	The voices selected so far stay loaded as well, keyed by their (language, voice) pair and phoneme set,
+	so that alternating between a few voices does not load their dictionaries again.
+	For each voice we keep what selecting it has set in the engine; its translator (which holds the dictionary)
+	then belongs to us and not to espeak, so we detach it before espeak can delete it.
+	Tagged text can select other voices itself, so for tagged text the voice is always selected from scratch
+	and its translator is left to espeak.
+*/
+constexpr integer theMaximumNumberOfEspeakVoices = 8;
+
+typedef struct structEspeakEngineVoice {
+	autostring32 voiceName, phonemeSet;   // the key; null if the slot is free
+	Translator *translator;
+	voice_t voiceData;
+	char dictionaryName [40];
+	int numberOfReplacePhonemes;
+	REPLACE_PHONEMES replacePhonemes [N_REPLACE_PHONEMES];
+	int toneFlags, fastSettings;
+	integer lastUse;
+} *EspeakEngineVoice;
+
+static struct {
+	bool isInitialized;
+	autostring32 voice, phonemeSet;   // as applied last, or null if the voice has to be (re)selected
+	bool parametersAreKnown;
+	int wordsPerMinute, pitchAdjustment_0_99, pitchRange_0_99, wordGap_10ms;
+	double internalSamplingFrequency;   // as last reported by the engine (only on a voice change)
+	structEspeakEngineVoice voices [1 + theMaximumNumberOfEspeakVoices];   // base 1
+	integer numberOfUses;
+} theEspeakEngine;
+
+static bool EspeakEngine_ownsTranslator (Translator *tr) {
+	for (integer ivoice = 1; ivoice <= theMaximumNumberOfEspeakVoices; ivoice ++)
+		if (theEspeakEngine.voices [ivoice]. translator == tr)
+			return true;
+	return false;
+}
+
+/*
+	To be called before espeak selects a voice or before we put a remembered voice in place.
+*/
+static void EspeakEngine_detachTranslator () {
+	if (translator && ! EspeakEngine_ownsTranslator (translator))
+		DeleteTranslator (translator);
+	translator = nullptr;
+}
+
+static void EspeakEngine_forgetVoices () {
+	for (integer ivoice = 1; ivoice <= theMaximumNumberOfEspeakVoices; ivoice ++) {
+		EspeakEngineVoice v = & theEspeakEngine.voices [ivoice];
+		DeleteTranslator (v -> translator);
+		v -> translator = nullptr;
+		v -> voiceName. reset ();
+		v -> phonemeSet. reset ();
+		v -> lastUse = 0;
+	}
+}
+
+static EspeakEngineVoice EspeakEngine_lookUpVoice (conststring32 voiceName, conststring32 phonemeSet) {
+	for (integer ivoice = 1; ivoice <= theMaximumNumberOfEspeakVoices; ivoice ++) {
+		EspeakEngineVoice v = & theEspeakEngine.voices [ivoice];
+		if (v -> voiceName && Melder_equ (v -> voiceName.get(), voiceName) && Melder_equ (v -> phonemeSet.get(), phonemeSet))
+			return v;
+	}
+	return nullptr;
+}
+
+/*
+	To be called right after espeak has selected the voice; the least recently used voice makes way.
+*/
+static void EspeakEngine_rememberVoice (conststring32 voiceName, conststring32 phonemeSet) {
+	if (! translator || ! voice)
+		return;   // espeak could not select the voice
+	EspeakEngineVoice v = & theEspeakEngine.voices [1];
+	for (integer ivoice = 2; ivoice <= theMaximumNumberOfEspeakVoices; ivoice ++)
+		if (theEspeakEngine.voices [ivoice]. lastUse < v -> lastUse)
+			v = & theEspeakEngine.voices [ivoice];   // a free slot has a `lastUse` of 0
+	DeleteTranslator (v -> translator);
+	v -> translator = translator;
+	v -> voiceData = *voice;
+	strcpy (v -> dictionaryName, dictionary_name);
+	v -> numberOfReplacePhonemes = n_replace_phonemes;
+	memcpy (v -> replacePhonemes, replace_phonemes, sizeof replace_phonemes);
+	v -> toneFlags = option_tone_flags;
+	v -> fastSettings = speed.fast_settings;
+	v -> voiceName = Melder_dup (voiceName);
+	v -> phonemeSet = Melder_dup (phonemeSet);
+	v -> lastUse = ++ theEspeakEngine.numberOfUses;
+}
+
+static void EspeakEngine_restoreVoice (EspeakEngineVoice v) {
+	Melder_assert (voice);   // the engine has selected a voice before, otherwise `v` would not exist
+	EspeakEngine_detachTranslator ();
+	translator = v -> translator;
+	*voice = v -> voiceData;
+	strcpy (dictionary_name, v -> dictionaryName);
+	n_replace_phonemes = v -> numberOfReplacePhonemes;
+	memcpy (replace_phonemes, v -> replacePhonemes, sizeof replace_phonemes);
+	option_tone_flags = v -> toneFlags;
+	speed.fast_settings = v -> fastSettings;
+	DoVoiceChange (voice);
+	v -> lastUse = ++ theEspeakEngine.numberOfUses;
+}
+
+static void EspeakEngine_terminate () {
+	if (theEspeakEngine.isInitialized) {
+		EspeakEngine_detachTranslator ();
+		espeak_Terminate ();
+	}
+	EspeakEngine_forgetVoices ();
+	theEspeakEngine.isInitialized = false;
+	theEspeakEngine.voice. reset ();
+	theEspeakEngine.phonemeSet. reset ();
+	theEspeakEngine.parametersAreKnown = false;
+}
+
+static void EspeakEngine_initialize () {
+	if (theEspeakEngine.isInitialized)
+		return;
+	espeak_ng_InitializePath (nullptr); // PATH_ESPEAK_DATA
+	espeak_ng_ERROR_CONTEXT context = { 0 };
+	espeak_ng_STATUS status = espeak_ng_Initialize (& context);
+	Melder_require (status == ENS_OK,
+		U"Internal espeak error. ", status);
+	status = espeak_ng_InitializeOutput (ENOUTPUT_MODE_SYNCHRONOUS, 2048, nullptr);
+	Melder_require (status == ENS_OK,
+		U"Internal espeak error. ", status);
+	espeak_SetSynthCallback (synthCallback);
+	theEspeakEngine.isInitialized = true;
+	theEspeakEngine.voice. reset ();
+	theEspeakEngine.phonemeSet. reset ();
+	theEspeakEngine.parametersAreKnown = false;
+	theEspeakEngine.internalSamplingFrequency = espeak_SAMPLINGFREQUENCY;
+}
+
+static void EspeakEngine_setParameter (espeak_PARAMETER parameter, int value, int *current) {
+	if (theEspeakEngine.parametersAreKnown && value == *current)
+		return;
+	espeak_ng_SetParameter (parameter, value, 0);
+	*current = value;
+}
+
+static void SpeechSynthesizer_applyToEspeakEngine (SpeechSynthesizer me) {
+	EspeakEngine_initialize ();
+	/*
+		pitchAdjustment_0_99 = a * log10 (my d_pitchAdjustment) + b,
+		where 0.5 <= my d_pitchAdjustment <= 2
+		pitchRange_0_99 = my d_pitchRange * 49.5,
+		where 0 <= my d_pitchRange <= 2
+	*/
+	const int wordsPerMinute = (int) my d_wordsPerMinute;
+	const int pitchAdjustment_0_99 = (int) ((49.5 / NUMlog10_2) * log10 (my d_pitchAdjustment) + 49.5);   // rounded towards zero
+	const int pitchRange_0_99 = (int) (my d_pitchRange * 49.5);   // rounded towards zero
+	const int wordGap_10ms = my d_wordGap * 100;   // espeak word gap is in units of 10 ms
+	const conststring32 languageCode = SpeechSynthesizer_getLanguageCode (me);
+	const conststring32 voiceCode = SpeechSynthesizer_getVoiceCode (me);
+	autostring32 voiceName = Melder_dup (Melder_cat (languageCode, U"+", voiceCode));
+	const bool textCanSelectVoices = ( my d_inputTextFormat == SpeechSynthesizer_INPUT_TAGGEDTEXT );
+	const bool voiceHasChanged = textCanSelectVoices || ! theEspeakEngine.voice ||
+			! Melder_equ (voiceName.get(), theEspeakEngine.voice.get()) ||
+			! Melder_equ (my d_phonemeSet.get(), theEspeakEngine.phonemeSet.get());
+	if (voiceHasChanged) {
+		theEspeakEngine.voice. reset ();   // in case of an error below
+		theEspeakEngine.parametersAreKnown = false;
+		EspeakEngineVoice rememberedVoice = ( textCanSelectVoices ? nullptr :
+				EspeakEngine_lookUpVoice (voiceName.get(), my d_phonemeSet.get()) );
+		if (rememberedVoice) {
+			EspeakEngine_restoreVoice (rememberedVoice);
+		} else {
+			EspeakEngine_detachTranslator ();
+			espeak_ng_SetVoiceByName (Melder_peek32to8 (voiceName.get()));
+			if (! Melder_equ (my d_phonemeSet.get(), my d_languageName.get())) {
+				const conststring32 phonemeCode = SpeechSynthesizer_getPhonemeCode (me);
+				const int index_phon_table_list = LookupPhonemeTable (Melder_peek32to8 (phonemeCode));
+				if (index_phon_table_list > 0) {
+					voice -> phoneme_tab_ix = index_phon_table_list;
+					DoVoiceChange (voice);
+				}
+			}
+			if (! textCanSelectVoices)
+				EspeakEngine_rememberVoice (voiceName.get(), my d_phonemeSet.get());
+		}
+		/*
+			Setting the rate after the voice is in place computes the speed from the new voice,
+			just as in a freshly initialized engine, whether the voice was loaded or remembered.
+		*/
+		EspeakEngine_setParameter (espeakRATE, wordsPerMinute, & theEspeakEngine.wordsPerMinute);
+		EspeakEngine_setParameter (espeakPITCH, pitchAdjustment_0_99, & theEspeakEngine.pitchAdjustment_0_99);
+		EspeakEngine_setParameter (espeakRANGE, pitchRange_0_99, & theEspeakEngine.pitchRange_0_99);
+		EspeakEngine_setParameter (espeakWORDGAP, wordGap_10ms, & theEspeakEngine.wordGap_10ms);
+		espeak_ng_SetParameter (espeakCAPITALS, 0, 0);
+		espeak_ng_SetParameter (espeakPUNCTUATION, espeakPUNCT_NONE, 0);
+		theEspeakEngine.parametersAreKnown = true;
+		theEspeakEngine.voice = voiceName.move();
+		theEspeakEngine.phonemeSet = Melder_dup (my d_phonemeSet.get());
+	} else {
+		EspeakEngine_setParameter (espeakRATE, wordsPerMinute, & theEspeakEngine.wordsPerMinute);
+		EspeakEngine_setParameter (espeakPITCH, pitchAdjustment_0_99, & theEspeakEngine.pitchAdjustment_0_99);
+		EspeakEngine_setParameter (espeakRANGE, pitchRange_0_99, & theEspeakEngine.pitchRange_0_99);
+		EspeakEngine_setParameter (espeakWORDGAP, wordGap_10ms, & theEspeakEngine.wordGap_10ms);
+	}
+}
+
 static void SpeechSynthesizer_generateSynthesisData (SpeechSynthesizer me, conststring32 text) {
 	try {
-		espeak_ng_InitializePath (nullptr); // PATH_ESPEAK_DATA
-		espeak_ng_ERROR_CONTEXT context = { 0 };
-		espeak_ng_STATUS status = espeak_ng_Initialize (& context);
-		Melder_require (status == ENS_OK,
-			U"Internal espeak error. ", status);
+		SpeechSynthesizer_applyToEspeakEngine (me);
 		int synth_flags = espeakCHARS_WCHAR;
 		if (my d_inputTextFormat == SpeechSynthesizer_INPUT_TAGGEDTEXT)
 			synth_flags |= espeakSSML;
@@ -604,40 +808,11 @@ static void SpeechSynthesizer_generateSynthesisData (SpeechSynthesizer me, const
 		if (my d_outputPhonemeCoding == SpeechSynthesizer_PHONEMECODINGS_IPA)
 			option_phoneme_events |= espeakINITIALIZE_PHONEME_IPA;
 
-		espeak_ng_SetParameter (espeakRATE, my d_wordsPerMinute, 0);
-		/*
-			pitchAdjustment_0_99 = a * log10 (my d_pitchAdjustment) + b,
-			where 0.5 <= my d_pitchAdjustment <= 2
-			pitchRange_0_99 = my d_pitchRange * 49.5,
-			where 0 <= my d_pitchRange <= 2
-		*/
-		const int pitchAdjustment_0_99 = (int) ((49.5 / NUMlog10_2) * log10 (my d_pitchAdjustment) + 49.5);   // rounded towards zero
-		espeak_ng_SetParameter (espeakPITCH, pitchAdjustment_0_99, 0);
-		const int pitchRange_0_99 = (int) (my d_pitchRange * 49.5);   // rounded towards zero
-		espeak_ng_SetParameter (espeakRANGE, pitchRange_0_99, 0);
-		const conststring32 languageCode = SpeechSynthesizer_getLanguageCode (me);
-		const conststring32 voiceCode = SpeechSynthesizer_getVoiceCode (me);
-		
-		espeak_ng_SetVoiceByName (Melder_peek32to8 (Melder_cat (languageCode, U"+", voiceCode)));
-		const int wordGap_10ms = my d_wordGap * 100;   // espeak word gap is in units of 10 ms
-		espeak_ng_SetParameter (espeakWORDGAP, wordGap_10ms, 0);
-		espeak_ng_SetParameter (espeakCAPITALS, 0, 0);
-		espeak_ng_SetParameter (espeakPUNCTUATION, espeakPUNCT_NONE, 0);
-		
-		status = espeak_ng_InitializeOutput (ENOUTPUT_MODE_SYNCHRONOUS, 2048, nullptr);
-		espeak_SetSynthCallback (synthCallback);
-		if (! Melder_equ (my d_phonemeSet.get(), my d_languageName.get())) {
-			const conststring32 phonemeCode = SpeechSynthesizer_getPhonemeCode (me);
-			const int index_phon_table_list = LookupPhonemeTable (Melder_peek32to8 (phonemeCode));
-			if (index_phon_table_list > 0) {
-				voice -> phoneme_tab_ix = index_phon_table_list;
-				DoVoiceChange(voice);
-			}
-		}
-
 		const conststring32 columnNames [] =
 				{ U"time", U"type", U"type-t", U"t-pos", U"length", U"a-pos", U"sample", U"id", U"uniq" };
 		my d_events = Table_createWithColumnNames (0, ARRAY_TO_STRVEC (columnNames));
+		my d_numberOfSamples = 0;
+		my d_internalSamplingFrequency = theEspeakEngine.internalSamplingFrequency;   // the engine reports it only on a voice change
 
 		#ifdef _WIN32
 			conststringW textW = Melder_peek32toW (text);
@@ -645,10 +820,18 @@ static void SpeechSynthesizer_generateSynthesisData (SpeechSynthesizer me, const
 		#else
 			espeak_ng_Synthesize (text, Melder_length (text) + 1, 0, POS_CHARACTER, 0, synth_flags, nullptr, me);
 		#endif
-				
-		espeak_ng_Terminate ();
+
+		theEspeakEngine.internalSamplingFrequency = my d_internalSamplingFrequency;
+		if (my d_inputTextFormat == SpeechSynthesizer_INPUT_TAGGEDTEXT) {
+			/*
+				SSML tags can change the voice and the parameters,
+				so we do not know the state of the engine anymore.
+			*/
+			theEspeakEngine.voice. reset ();
+			theEspeakEngine.parametersAreKnown = false;
+		}
 	} catch (MelderError) {
-		espeak_Terminate ();
+		EspeakEngine_terminate ();
 		Melder_throw (U"SpeechSynthesizer: synthesis data not generated.");
 	}	
 }
@@ -709,9 +892,24 @@ autoSound SpeechSynthesizer_to_Sound (SpeechSynthesizer me, conststring32 text,
 		my d_events.reset();
 		return thee;
 	} catch (MelderError) {
-		espeak_Terminate ();
+		EspeakEngine_terminate ();
 		Melder_throw (U"SpeechSynthesizer: text not converted to Sound.");
 	}
 }
 
+autoSoundList SpeechSynthesizer_to_Sounds (SpeechSynthesizer me, constSTRVEC const& texts) {
+	try {
+		autoSoundList thee = SoundList_create ();
+		autoMelderProgress progress (U"Synthesizing...");
+		for (integer itext = 1; itext <= texts.size; itext ++) {
+			autoSound sound = SpeechSynthesizer_to_Sound (me, texts [itext], nullptr, nullptr);
+			thy addItem_move (sound.move());
+			Melder_progress ((double) itext / texts.size, U"Synthesized text ", itext, U" of ", texts.size, U".");
+		}
+		return thee;
+	} catch (MelderError) {
+		Melder_throw (me, U": texts not converted to Sounds.");
+	}
+}
+
 /* End of file SpeechSynthesizer.cpp */
@@ -59,6 +59,12 @@ void SpeechSynthesizer_setSpeechOutputSettings (SpeechSynthesizer me, double sam
 
 autoSound SpeechSynthesizer_to_Sound (SpeechSynthesizer me, conststring32 text, autoTextGrid *tg, autoTable *events);
 
+/*
+	One Sound for each text. The espeak engine stays initialized between the texts,
+	so that a large batch of prompts does not reload the phoneme tables and the dictionary for each prompt.
+*/
+autoSoundList SpeechSynthesizer_to_Sounds (SpeechSynthesizer me, constSTRVEC const& texts);
+
 void SpeechSynthesizer_playText (SpeechSynthesizer me, conststring32 text);
 
 conststring32 SpeechSynthesizer_getPhonemesFromText (SpeechSynthesizer me, conststring32 text);
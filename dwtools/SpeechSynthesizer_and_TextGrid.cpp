@@ -133,6 +133,7 @@ void IntervalTier_splitInterval (IntervalTier me, double time, conststring32 lef
         if (index == 0 || TIMES_ARE_CLOSE(time, ti -> xmin) || TIMES_ARE_CLOSE(time, ti -> xmax))
             return;
         autoTextInterval newInterval = TextInterval_create (ti -> xmin, time, leftLabel);
+		IntervalTier_invalidateIndex (me);
         /*
 			Make start of current and begin of new interval equal
 		*/
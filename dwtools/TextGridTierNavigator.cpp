@@ -109,17 +109,17 @@ integer structTextGridTierNavigator :: v_getSize () {
 
 integer structTextGridTierNavigator :: v_timeToLowIndex (double time) {
 	return ( tier -> classInfo == classIntervalTier ? 
-		IntervalTier_timeToLowIndex ((IntervalTier) tier.get(), time) : 
+		IntervalTierIndex_timeToLowIndex (IntervalTier_getIndex ((IntervalTier) tier.get()), time) : 
 		AnyTier_timeToLowIndex ((AnyTier) tier.get(), time) );
 }
 
 integer structTextGridTierNavigator :: v_timeToIndex (double time) {
-	return ( tier -> classInfo == classIntervalTier ? IntervalTier_timeToIndex ((IntervalTier) tier.get(), time) : 
+	return ( tier -> classInfo == classIntervalTier ? IntervalTierIndex_timeToIndex (IntervalTier_getIndex ((IntervalTier) tier.get()), time) : 
 		AnyTier_timeToNearestIndex ((AnyTier) tier.get(), time) ); // TODO is that ok?
 }
 
 integer structTextGridTierNavigator :: v_timeToHighIndex (double time) {
-	return ( tier -> classInfo == classIntervalTier ? IntervalTier_timeToHighIndex ((IntervalTier) tier.get(), time) : 
+	return ( tier -> classInfo == classIntervalTier ? IntervalTierIndex_timeToHighIndex (IntervalTier_getIndex ((IntervalTier) tier.get()), time) : 
 		AnyTier_timeToHighIndex ((AnyTier)tier.get(), time) );
 }
 
@@ -139,6 +139,34 @@ conststring32 structTextGridTierNavigator :: v_getLabel (integer index) {
 }
 
 
+static void TextGridTierNavigator_forgetLabelMatches (TextGridTierNavigator me) {
+	my labelMatches. reset ();
+}
+
+static bool TextGridTierNavigator_isLabelMatch (TextGridTierNavigator me, integer index, kContext_where where) {
+	if (my tier -> classInfo == classIntervalTier) {
+		IntervalTierIndex tierIndex = IntervalTier_getIndex (static_cast <IntervalTier> (my tier.get()));
+		if (index >= 1 && index <= tierIndex -> labelNumbers.size) {
+			if (my labelMatches.ncol != tierIndex -> labels.size)
+				my labelMatches = zero_INTMAT (3, tierIndex -> labels.size);   // 0 = not yet known, 1 = no match, 2 = match
+			const integer labelNumber = tierIndex -> labelNumbers [index];
+			integer& labelMatch = my labelMatches [(int) where] [labelNumber];
+			if (labelMatch == 0) {
+				conststring32 label = tierIndex -> labels [labelNumber].get();
+				const bool isMatch = ( where == kContext_where::TOPIC ? NavigationContext_isTopicLabel (my navigationContext.get(), label) :
+					where == kContext_where::BEFORE ? NavigationContext_isBeforeLabel (my navigationContext.get(), label) :
+					NavigationContext_isAfterLabel (my navigationContext.get(), label) );
+				labelMatch = ( isMatch ? 2 : 1 );
+			}
+			return labelMatch == 2;
+		}
+	}
+	conststring32 label = my v_getLabel (index);
+	return ( where == kContext_where::TOPIC ? NavigationContext_isTopicLabel (my navigationContext.get(), label) :
+		where == kContext_where::BEFORE ? NavigationContext_isBeforeLabel (my navigationContext.get(), label) :
+		NavigationContext_isAfterLabel (my navigationContext.get(), label) );
+}
+
 void structTextGridTierNavigator :: v1_info () {
 	// skipping parent classes
 	const integer tierSize = our v_getSize ();
@@ -234,7 +262,8 @@ void TextGridTierNavigator_replaceNavigationContext (TextGridTierNavigator me, N
 		my navigationContext -> afterCriterion = thy afterCriterion;
 		my navigationContext -> afterMatchBoolean = thy afterMatchBoolean;
 		my navigationContext -> combinationCriterion = thy combinationCriterion;
-		my navigationContext -> excludeTopicMatch = thy excludeTopicMatch;		
+		my navigationContext -> excludeTopicMatch = thy excludeTopicMatch;
+		TextGridTierNavigator_forgetLabelMatches (me);
 	} catch (MelderError) {
 		Melder_throw (me, U": could not replace navigation context.");
 	}
@@ -266,6 +295,7 @@ void TextGridTierNavigator_replaceTier (TextGridTierNavigator me, TextGrid thee,
 		Melder_require (my tier -> classInfo == tier -> classInfo,
 			U"The tier should be of the same type as the one you want to replace.");
 		my tier = Data_copy (tier);
+		TextGridTierNavigator_forgetLabelMatches (me);
 		my xmin = thy xmin;
 		my xmax = thy xmax;
 		my currentTopicIndex = 0; // offLeft
@@ -290,14 +320,17 @@ void TextGridTierNavigator_modifyAfterRange (TextGridTierNavigator me, integer f
 
 void TextGridTierNavigator_modifyTopicCriterion (TextGridTierNavigator me, kMelder_string newCriterion, kMatchBoolean matchBoolean) {
 	NavigationContext_modifyTopicCriterion (my navigationContext.get(), newCriterion, matchBoolean);
+	TextGridTierNavigator_forgetLabelMatches (me);
 }
 
 void TextGridTierNavigator_modifyBeforeCriterion (TextGridTierNavigator me, kMelder_string newCriterion, kMatchBoolean matchBoolean) {
 	NavigationContext_modifyBeforeCriterion (my navigationContext.get(), newCriterion, matchBoolean);
+	TextGridTierNavigator_forgetLabelMatches (me);
 }
 
 void TextGridTierNavigator_modifyAfterCriterion (TextGridTierNavigator me, kMelder_string newCriterion, kMatchBoolean matchBoolean) {
 	NavigationContext_modifyAfterCriterion (my navigationContext.get(), newCriterion, matchBoolean);
+	TextGridTierNavigator_forgetLabelMatches (me);
 }
 
 void TextGridTierNavigator_modifyUseCriterion (TextGridTierNavigator me, kContext_combination newUse, bool excludeTopicMatch) {
@@ -305,8 +338,7 @@ void TextGridTierNavigator_modifyUseCriterion (TextGridTierNavigator me, kContex
 }
 
 static bool TextGridTierNavigator_isTopicMatch (TextGridTierNavigator me, integer index) {
-	conststring32 label = my v_getLabel (index);
-	return NavigationContext_isTopicLabel (my navigationContext.get(), label);
+	return TextGridTierNavigator_isLabelMatch (me, index, kContext_where::TOPIC);
 }
 
 integer TextGridTierNavigator_findBeforeIndex (TextGridTierNavigator me, integer topicIndex) {
@@ -317,8 +349,7 @@ integer TextGridTierNavigator_findBeforeIndex (TextGridTierNavigator me, integer
 	const integer startIndex = std::max (1_integer, topicIndex - my beforeRange.first);
 	const integer endIndex = std::max (1_integer, topicIndex - my beforeRange.last);
 	for (integer index = startIndex; index >= endIndex; index --) {
-		conststring32 label = my v_getLabel (index);
-		if (NavigationContext_isBeforeLabel (my navigationContext.get(), label))
+		if (TextGridTierNavigator_isLabelMatch (me, index, kContext_where::BEFORE))
 			return index;
 	}
 	return 0;
@@ -333,8 +364,7 @@ integer TextGridTierNavigator_findAfterIndex (TextGridTierNavigator me, integer
 	const integer startInterval = std::min (mySize, topicIndex + my afterRange.last);
 	const integer endInterval = std::min (mySize, topicIndex + my afterRange.last);
 	for (integer index = startInterval; index <= endInterval; index ++) {
-		conststring32 label = my v_getLabel (index);
-		if (NavigationContext_isAfterLabel (my navigationContext.get(), label))
+		if (TextGridTierNavigator_isLabelMatch (me, index, kContext_where::AFTER))
 			return index;
 	}
 	return 0;
@@ -345,8 +375,7 @@ integer TextGridTierNavigator_getNumberOfAfterMatches (TextGridTierNavigator me)
 		return 0;
 	integer numberOfMatches = 0;
 	for (integer index = 1; index <= my v_getSize (); index ++) {
-		conststring32 label = my v_getLabel (index);
-		if (NavigationContext_isAfterLabel (my navigationContext.get(), label))
+		if (TextGridTierNavigator_isLabelMatch (me, index, kContext_where::AFTER))
 			numberOfMatches ++;
 	}
 	return numberOfMatches;
@@ -357,8 +386,7 @@ integer TextGridTierNavigator_getNumberOfBeforeMatches (TextGridTierNavigator me
 		return 0;
 	integer numberOfMatches = 0;
 	for (integer index = 1; index <= my v_getSize (); index ++) {
-		conststring32 label = my v_getLabel (index);
-		if (NavigationContext_isBeforeLabel (my navigationContext.get(), label))
+		if (TextGridTierNavigator_isLabelMatch (me, index, kContext_where::BEFORE))
 			numberOfMatches ++;
 	}
 	return numberOfMatches;
@@ -369,8 +397,7 @@ integer TextGridTierNavigator_getNumberOfTopicOnlyMatches (TextGridTierNavigator
 		return 0;
 	integer numberOfMatches = 0;
 	for (integer index = 1; index <= my v_getSize (); index ++) {
-		conststring32 label = my v_getLabel (index);
-		if (NavigationContext_isTopicLabel (my navigationContext.get(), label))
+		if (TextGridTierNavigator_isLabelMatch (me, index, kContext_where::TOPIC))
 			numberOfMatches ++;
 	}
 	return numberOfMatches;
@@ -52,6 +52,13 @@ oo_DEFINE_CLASS (TextGridTierNavigator, Function)
 		virtual double v_getStartTime (integer index);
 		virtual double v_getEndTime (integer index);
 		virtual conststring32 v_getLabel (integer index);
+
+		/*
+			For an interval tier: whether each distinct label of the tier is a Topic, Before or After label
+			(0: not yet determined, 1: no match, 2: match), so that each distinct label is matched against the navigation context only once.
+			Not part of the data; to be forgotten whenever the tier or the navigation context changes.
+		*/
+		autoINTMAT labelMatches;   // 3 x number of distinct labels
 	#endif
 
 oo_END_CLASS (TextGridTierNavigator)
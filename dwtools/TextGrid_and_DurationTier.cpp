@@ -22,6 +22,7 @@
 void IntervalTier_DurationTier_scaleTimes (IntervalTier me, DurationTier thee) {
 	Melder_require (my xmin == thy xmin && my xmax == thy xmax,
 		U"The domains of the IntervalTier and the DurationTier should be equal.");
+	IntervalTier_invalidateIndex (me);
 	const double xmax_new = my xmin + RealTier_getArea (thee, my xmin, my xmax);
 	for (integer i = 1; i <= my intervals.size; i ++) {
 		const TextInterval segment = my intervals.at [i];
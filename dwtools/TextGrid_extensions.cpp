@@ -342,6 +342,7 @@ void IntervalTier_setLaterEndTime (IntervalTier me, double xmax, conststring32 m
 		if (xmax <= my xmax)
 			return; // nothing to be done
 		Melder_assert (my intervals.size > 0);
+		IntervalTier_invalidateIndex (me);
 		const TextInterval ti = my intervals.at [my intervals.size];
 		/*
 			The following assert signals that the IntervalTier is not correct:
@@ -368,6 +369,7 @@ void IntervalTier_setEarlierStartTime (IntervalTier me, double xmin, conststring
 		if (xmin >= my xmin)
 			return;
 		Melder_assert (my intervals.size > 0);
+		IntervalTier_invalidateIndex (me);
 		const TextInterval ti = my intervals.at [1];
 		Melder_assert (xmin < ti -> xmin);
 		if (mark) {
@@ -391,6 +393,7 @@ void IntervalTier_moveBoundary (IntervalTier me, integer iint, bool atStart, dou
             U"The interval number is out of the valid range.");
 		Melder_require (! ((iint == 1 && atStart) or (iint == my intervals.size && ! atStart)),
 			U"Cannot change the domain.");
+		IntervalTier_invalidateIndex (me);
         TextInterval interval = my intervals.at [iint];
         if (atStart) {
             const TextInterval pinterval = my intervals.at [iint-1];
@@ -530,6 +533,7 @@ static void IntervalTier_cutInterval (IntervalTier me, integer index, int extend
 	 */
 	if (size_pre == 1 || index > size_pre || index < 1)
 		return;
+	IntervalTier_invalidateIndex (me);
 
 	TextInterval ti = my intervals.at [index];
 	const double xmin = ti -> xmin;
@@ -617,6 +621,7 @@ void IntervalTier_changeLabels (IntervalTier me, integer from, integer to,
 			U"Incorrect specification of where to act.");
 		Melder_require (! (use_regexp && search [0] == U'\0'),
 			U"The regex search string cannot be empty.\nYou may search for an empty string with the expression \"^$\"");
+		IntervalTier_invalidateIndex (me);
 		const integer offset = from - 1, nlabels = to - offset;
 		autovector <conststring32> labels = newvectorzero <conststring32> (nlabels);
 		for (integer i = from; i <= to; i ++) {
@@ -672,6 +677,7 @@ static void IntervalTier_addInterval_force (IntervalTier me, double tmin, double
 		U"The interval should not be outside the domain.");
 	Melder_require (tmin < tmax,
 		U"The start time of the interval should be smaller than the end time.");
+	IntervalTier_invalidateIndex (me);
 	const integer oldSize = my intervals.size;
 	integer ileft = IntervalTier_timeToIndex (me, tmin);
 	TextInterval leftInterval = my intervals .at [ileft];
@@ -746,6 +752,7 @@ void IntervalTiers_append_inplace (IntervalTier me, IntervalTier thee, bool pres
 	try {
 		IntervalTier_checkStartAndEndTime (me); // start/end time of first/last interval should match with tier
 		IntervalTier_checkStartAndEndTime (thee);
+		IntervalTier_invalidateIndex (me);
 		const double time_shift = my xmax - thy xmin;
         double xmax_previous = my xmax;
 		if (preserveTimes && my xmax < thy xmin) {
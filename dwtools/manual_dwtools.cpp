@@ -4735,6 +4735,7 @@ LIST_ITEM (U"\\bu @@Create SpeechSynthesizer...@")
 NORMAL (U"Playing:")
 LIST_ITEM (U"\\bu @@SpeechSynthesizer: Play text...|Play text...@")
 LIST_ITEM (U"\\bu @@SpeechSynthesizer: To Sound...|To Sound...@")
+LIST_ITEM (U"\\bu @@SpeechSynthesizer & Strings: To Sounds@")
 NORMAL (U"Modification:")
 LIST_ITEM (U"\\bu @@SpeechSynthesizer: Set text input settings...|Set text input settings...@")
 LIST_ITEM (U"\\bu @@SpeechSynthesizer: Speech output settings...|Speech output settings...@")
@@ -4765,6 +4766,14 @@ TERM (U"##Create TextGrid with annotations#")
 DEFINITION (U"determines whether, besides the sound, a @@TextGrid@ with multiple-tier annotations will appear.")
 MAN_END
 
+MAN_BEGIN (U"SpeechSynthesizer & Strings: To Sounds", U"djmw", 20261019)
+INTRO (U"The selected @@SpeechSynthesizer@ converts each string of the selected @@Strings@ "
+	"to the corresponding speech sound, as with @@SpeechSynthesizer: To Sound...@.")
+NORMAL (U"The Sounds are named after the SpeechSynthesizer, followed by the number of the string.")
+NORMAL (U"This is the fastest way to synthesize a large number of prompts: "
+	"the synthesizer keeps its phoneme tables and its dictionary loaded from one text to the next.")
+MAN_END
+
 MAN_BEGIN (U"SpeechSynthesizer: Set text input settings...", U"djmw", 20171101)
 INTRO (U"A command available in the ##Modify# menu when you select a @@SpeechSynthesizer@.")
 ENTRY (U"Settings")
@@ -6451,6 +6451,14 @@ DO
 	CONVERT_EACH_TO_MULTIPLE_END
 }
 
+DIRECT (CONVERT_ONE_AND_ONE_TO_MULTIPLE__SpeechSynthesizer_Strings_to_Sounds) {
+	CONVERT_ONE_AND_ONE_TO_MULTIPLE (SpeechSynthesizer, Strings)
+		autoSoundList result = SpeechSynthesizer_to_Sounds (me, you -> strings.get());
+		for (integer isound = 1; isound <= result -> size; isound ++)
+			praat_new (result -> subtractItem_move (1), my name.get(), U"_", isound);
+	CONVERT_ONE_AND_ONE_TO_MULTIPLE_END
+}
+
 DIRECT (QUERY_ONE_FOR_STRING__SpeechSynthesizer_getLanguageName) {
 	QUERY_ONE_FOR_STRING (SpeechSynthesizer)
 		conststring32 result = my d_languageName.get();
@@ -10317,6 +10325,8 @@ void praat_David_init () {
 		praat_addAction1 (classSpeechSynthesizer, 0, U"Set speech output settings...", nullptr, GuiMenu_DEPTH_1 | GuiMenu_DEPRECATED_2017,
 				MODIFY_EACH__SpeechSynthesizer_setSpeechOutputSettings);
 
+	praat_addAction2 (classSpeechSynthesizer, 1, classStrings, 1, U"To Sounds", nullptr, 0,
+			CONVERT_ONE_AND_ONE_TO_MULTIPLE__SpeechSynthesizer_Strings_to_Sounds);
 	praat_addAction2 (classSpeechSynthesizer, 1, classTextGrid, 1, U"To Sound...", nullptr, 0,
 			CONVERT_ONE_AND_ONE_TO_ONE__SpeechSynthesizer_TextGrid_to_Sound);
 	praat_addAction3 (classSpeechSynthesizer, 1, classSound, 1, classTextGrid, 1, U"To TextGrid (align)...", nullptr, 0, 
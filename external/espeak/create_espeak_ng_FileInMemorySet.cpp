@@ -0,0 +1,5 @@
+/* local build stub: no espeak data */
+#include "espeakdata_FileInMemory.h"
+autoFileInMemorySet create_espeak_ng_FileInMemorySet () {
+	return FileInMemorySet_create ();
+}
@@ -0,0 +1,244 @@
+/* AnalysisCache.cpp
+ *
+ * Copyright (C) 2026 Paul Boersma
+ *
+ * This code is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this work. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AnalysisCache.h"
+#include "Pitch.h"
+#include "Intensity.h"
+#include "Formant.h"
+#include "Spectrogram.h"
+#include "Preferences.h"
+#include <list>
+#include <unordered_map>
+#include <mutex>
+
+constexpr integer defaultMemoryBudget = 0;   // megabytes; the cache is off unless the user switches it on
+constexpr integer maximumMemoryBudget = 100'000;   // megabytes
+
+static integer prefs_memoryBudget;   // guarded by theCache.mutex, except while the preferences are read at start-up
+
+void AnalysisCache_preferences () {
+	Preferences_addInteger (U"AnalysisCache.memoryBudget", & prefs_memoryBudget, defaultMemoryBudget);
+}
+
+/*
+	The hashes of the samples: four independent lanes of 64-bit multiply-rotate steps
+	(as in the "murmur" and "xx" families), so that hashing runs at memory speed,
+	which is far below the cost of any of the analyses that are cached.
+	Two such hashes, with different seeds, multipliers and rotations, are computed in the same pass,
+	so that two different Sounds with the same shape are taken to be equal
+	only if they agree in 128 well-mixed bits.
+*/
+static inline uint64 rotateLeft (uint64 x, int r) {
+	return (x << r) | (x >> (64 - r));
+}
+constexpr uint64 prime1 = 0x9E3779B185EBCA87ULL, prime2 = 0xC2B2AE3D27D4EB4FULL, prime3 = 0x165667B19E3779F9ULL;
+constexpr uint64 prime4 = 0x85EBCA77C2B2AE63ULL, prime5 = 0x27D4EB2F165667C5ULL;
+static inline uint64 mixWord (uint64 lane, uint64 word) {
+	return rotateLeft (lane + word * prime2, 31) * prime1;
+}
+static inline uint64 mixWord2 (uint64 lane, uint64 word) {
+	return rotateLeft (lane ^ word * prime4, 27) * prime5;
+}
+static uint64 finalHash (uint64 lane1, uint64 lane2, uint64 lane3, uint64 lane4) {
+	uint64 hash = rotateLeft (lane1, 1) + rotateLeft (lane2, 7) + rotateLeft (lane3, 12) + rotateLeft (lane4, 18);
+	hash ^= hash >> 33;
+	hash *= prime2;
+	hash ^= hash >> 29;
+	hash *= prime3;
+	hash ^= hash >> 32;
+	return hash;
+}
+static inline uint64 wordOfDouble (double x) {
+	uint64 word;
+	memcpy (& word, & x, sizeof (uint64));
+	return word;
+}
+static void hashesOfSamples (constMAT z, uint64 *out_hash1, uint64 *out_hash2) {
+	uint64 lane1 = prime1 + prime2, lane2 = prime2, lane3 = 0, lane4 = 0 - prime1;
+	uint64 lane5 = prime4, lane6 = prime5 + prime3, lane7 = prime1, lane8 = 0 - prime4;
+	for (integer ichan = 1; ichan <= z.nrow; ichan ++) {
+		const double *x = & z [ichan] [1];
+		const integer n = z.ncol, n4 = n - n % 4;
+		integer i = 0;
+		for (; i < n4; i += 4) {
+			const uint64 word1 = wordOfDouble (x [i]), word2 = wordOfDouble (x [i + 1]),
+					word3 = wordOfDouble (x [i + 2]), word4 = wordOfDouble (x [i + 3]);
+			lane1 = mixWord (lane1, word1);
+			lane2 = mixWord (lane2, word2);
+			lane3 = mixWord (lane3, word3);
+			lane4 = mixWord (lane4, word4);
+			lane5 = mixWord2 (lane5, word2);
+			lane6 = mixWord2 (lane6, word3);
+			lane7 = mixWord2 (lane7, word4);
+			lane8 = mixWord2 (lane8, word1);
+		}
+		for (; i < n; i ++) {
+			const uint64 word = wordOfDouble (x [i]);
+			lane1 = mixWord (lane1, word);
+			lane5 = mixWord2 (lane5, word);
+		}
+	}
+	*out_hash1 = finalHash (lane1, lane2, lane3, lane4);
+	*out_hash2 = finalHash (lane5, lane6, lane7, lane8);
+}
+
+struct AnalysisCacheKey_equal {
+	bool operator() (AnalysisCacheKey const& key1, AnalysisCacheKey const& key2) const {
+		if (key1.soundHash != key2.soundHash || key1.soundHash2 != key2.soundHash2 || ! str32equ (key1.analysis, key2.analysis) || key1.parameters.size () != key2.parameters.size ())
+			return false;
+		for (uinteger i = 0; i < key1.parameters.size (); i ++)
+			if (wordOfDouble (key1.parameters [i]) != wordOfDouble (key2.parameters [i]))   // bitwise, so that undefined equals undefined
+				return false;
+		return true;
+	}
+};
+
+struct AnalysisCacheKey_hasher {
+	size_t operator() (AnalysisCacheKey const& key) const {
+		uint64 hash = key.soundHash;
+		for (const char32 *p = key.analysis; *p != U'\0'; p ++)
+			hash = mixWord (hash, uint64 (*p));
+		for (double parameter : key.parameters)
+			hash = mixWord (hash, wordOfDouble (parameter));
+		return size_t (hash);
+	}
+};
+
+namespace {
+	struct Entry {
+		AnalysisCacheKey key;
+		autoDaata result;
+		double numberOfBytes;
+	};
+	struct AnalysisCache {
+		std::mutex mutex;
+		std::list <Entry> entries;   // the most recently used first
+		std::unordered_map <AnalysisCacheKey, std::list <Entry>::iterator, AnalysisCacheKey_hasher, AnalysisCacheKey_equal> index;
+		double numberOfBytes = 0.0;
+		integer numberOfHits = 0, numberOfMisses = 0, numberOfEvictions = 0;
+	};
+}
+static AnalysisCache theCache;   // guarded by theCache.mutex
+
+integer AnalysisCache_getMemoryBudgetPref_MB () {
+	std::lock_guard <std::mutex> lock (theCache.mutex);
+	return prefs_memoryBudget;
+}
+
+static double estimatedNumberOfBytes (constDaata result) {
+	if (result -> classInfo == classPitch) {
+		const constPitch pitch = static_cast <constPitch> (result);
+		double numberOfBytes = double (pitch -> nx) * sizeof (structPitch_Frame);
+		for (integer iframe = 1; iframe <= pitch -> nx; iframe ++)
+			numberOfBytes += double (pitch -> frames [iframe]. nCandidates) * sizeof (structPitch_Candidate);
+		return numberOfBytes;
+	}
+	if (result -> classInfo == classFormant) {
+		const constFormant formant = static_cast <constFormant> (result);
+		double numberOfBytes = double (formant -> nx) * sizeof (structFormant_Frame);
+		for (integer iframe = 1; iframe <= formant -> nx; iframe ++)
+			numberOfBytes += double (formant -> frames [iframe]. numberOfFormants) * sizeof (structFormant_Formant);
+		return numberOfBytes;
+	}
+	if (Thing_isa (const_cast <Daata> (result), classMatrix)) {   // Intensity, Spectrogram
+		const constMatrix matrix = static_cast <constMatrix> (result);
+		return double (matrix -> nx) * double (matrix -> ny) * sizeof (double);
+	}
+	Melder_fatal (U"AnalysisCache: unexpected class ", Thing_className (const_cast <Daata> (result)), U".");
+}
+
+static void AnalysisCache_evict_locked (double memoryBudget) {
+	while (theCache.numberOfBytes > memoryBudget && ! theCache.entries.empty ()) {
+		Entry& leastRecentlyUsed = theCache.entries.back ();
+		theCache.numberOfBytes -= leastRecentlyUsed.numberOfBytes;
+		theCache.index.erase (leastRecentlyUsed.key);
+		theCache.entries.pop_back ();
+		theCache.numberOfEvictions ++;
+	}
+	if (theCache.entries.empty ())
+		theCache.numberOfBytes = 0.0;   // no rounding drift
+}
+
+AnalysisCacheKey AnalysisCache_key (conststring32 analysis, constSound sound, std::initializer_list <double> parameters) {
+	AnalysisCacheKey key;
+	if (AnalysisCache_getMemoryBudgetPref_MB () <= 0 || Melder_debug != 0)   // some debug settings change the analyses
+		return key;
+	key.analysis = analysis;
+	hashesOfSamples (sound -> z.get(), & key.soundHash, & key.soundHash2);
+	key.parameters = { sound -> xmin, sound -> xmax, double (sound -> nx), sound -> dx, sound -> x1, double (sound -> ny) };
+	key.parameters.insert (key.parameters.end (), parameters);
+	return key;
+}
+
+autoDaata AnalysisCache_fetch (AnalysisCacheKey const& key) {
+	if (! key.isValid ())
+		return autoDaata ();
+	std::lock_guard <std::mutex> lock (theCache.mutex);
+	const auto found = theCache.index.find (key);
+	if (found == theCache.index.end ()) {
+		theCache.numberOfMisses ++;
+		return autoDaata ();
+	}
+	theCache.entries.splice (theCache.entries.begin (), theCache.entries, found -> second);   // now the most recently used
+	theCache.numberOfHits ++;
+	return Data_copy (found -> second -> result.get());
+}
+
+void AnalysisCache_store (AnalysisCacheKey const& key, constDaata result) {
+	if (! key.isValid () || ! result)
+		return;
+	const double numberOfBytes = estimatedNumberOfBytes (result);
+	if (numberOfBytes > AnalysisCache_getMemoryBudgetPref_MB () * 1e6)
+		return;   // would evict everything else, and then itself
+	autoDaata copy = Data_copy (result);   // outside the lock, because copying is slow
+	std::lock_guard <std::mutex> lock (theCache.mutex);
+	const double memoryBudget = prefs_memoryBudget * 1e6;   // it may have changed while we were copying
+	if (numberOfBytes > memoryBudget || theCache.index.count (key) > 0)
+		return;   // too big now, or another thread computed the same analysis in the meantime
+	theCache.entries.push_front (Entry { key, copy.move(), numberOfBytes });
+	theCache.index [key] = theCache.entries.begin ();
+	theCache.numberOfBytes += numberOfBytes;
+	AnalysisCache_evict_locked (memoryBudget);
+}
+
+void AnalysisCache_clear () {
+	std::lock_guard <std::mutex> lock (theCache.mutex);
+	AnalysisCache_evict_locked (-1.0);
+	theCache.numberOfEvictions = 0;
+	theCache.numberOfHits = theCache.numberOfMisses = 0;
+}
+
+void AnalysisCache_setMemoryBudgetPref_MB (integer budget) {
+	std::lock_guard <std::mutex> lock (theCache.mutex);
+	prefs_memoryBudget = Melder_clipped (0_integer, budget, maximumMemoryBudget);
+	AnalysisCache_evict_locked (prefs_memoryBudget * 1e6);
+}
+
+void AnalysisCache_info () {
+	std::lock_guard <std::mutex> lock (theCache.mutex);
+	MelderInfo_writeLine (U"Memory budget: ", prefs_memoryBudget, U" MB");
+	MelderInfo_writeLine (U"Number of cached analyses: ", integer (theCache.entries.size ()));
+	MelderInfo_writeLine (U"Memory in use: ", Melder_fixed (theCache.numberOfBytes / 1e6, 3), U" MB");
+	MelderInfo_writeLine (U"Number of hits: ", theCache.numberOfHits);
+	MelderInfo_writeLine (U"Number of misses: ", theCache.numberOfMisses);
+	MelderInfo_writeLine (U"Number of evictions: ", theCache.numberOfEvictions);
+	for (const Entry& entry : theCache.entries)
+		MelderInfo_writeLine (U"   ", entry.key.analysis, U": ", Melder_fixed (entry.numberOfBytes / 1e6, 3), U" MB");
+}
+
+/* End of file AnalysisCache.cpp */
@@ -0,0 +1,69 @@
+#ifndef _AnalysisCache_h_
+#define _AnalysisCache_h_
+/* AnalysisCache.h
+ *
+ * Copyright (C) 2026 Paul Boersma
+ *
+ * This code is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or (at
+ * your option) any later version.
+ *
+ * This code is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this work. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Sound.h"
+
+/*
+	A cache, shared by the whole session, of the results of the expensive analyses of a Sound
+	(Pitch, Intensity, Formant, Spectrogram), so that derived analyses that ask for the same base analysis
+	(e.g. Harmonicity, Manipulation and PointProcess all asking for a Pitch) do not compute it again.
+
+	The key consists of two independent 64-bit hashes of the samples, the shape of the Sound (xmin, xmax, nx, dx, x1, ny),
+	the name of the analysis, and all of its parameters; a Sound that has been modified will therefore simply miss the cache.
+	The cache stores a copy of each result, and hands out copies, so that callers can modify what they get.
+	When the total estimated size exceeds the memory budget, the least recently used results are evicted.
+	A budget of zero, which is the standard, switches the cache off, so that no analysis is copied
+	unless the user has asked for the cache.
+
+	Usage, in an analysis function:
+
+		const AnalysisCacheKey key = AnalysisCache_key (U"Pitch", me, { timeStep, minimumPitch, ... });
+		if (autoDaata cached = AnalysisCache_fetch (key))
+			return cached.static_cast_move <structPitch> ();
+		autoPitch result = ...;   // the real analysis
+		AnalysisCache_store (key, result.get());
+		return result;
+
+	The cache and the memory budget are guarded by a mutex, so several threads can use the cache at the same time.
+	However, AnalysisCache_fetch and AnalysisCache_store copy whole analyses, which allocates and can throw;
+	so call them only where the analysis function itself could allocate and throw,
+	not from inside a worker kernel that must not allocate.
+*/
+
+struct AnalysisCacheKey {
+	conststring32 analysis = nullptr;   // a string literal, such as U"Pitch"; null if the cache is off
+	uint64 soundHash = 0, soundHash2 = 0;
+	std::vector <double> parameters;   // the shape of the Sound first, then the parameters of the analysis
+	bool isValid () const { return !! analysis; }
+};
+
+AnalysisCacheKey AnalysisCache_key (conststring32 analysis, constSound sound, std::initializer_list <double> parameters);
+autoDaata AnalysisCache_fetch (AnalysisCacheKey const& key);   // a copy, or null if absent
+void AnalysisCache_store (AnalysisCacheKey const& key, constDaata result);
+
+void AnalysisCache_clear ();
+void AnalysisCache_info ();   // writes the statistics to the Info window
+
+void AnalysisCache_preferences ();
+integer AnalysisCache_getMemoryBudgetPref_MB ();
+void AnalysisCache_setMemoryBudgetPref_MB (integer budget);
+
+/* End of file AnalysisCache.h */
+#endif
@@ -46,6 +46,9 @@
 #define FLAC__NO_DLL
 #include "../external/flac/flac_FLAC_stream_decoder.h"
 #include "../external/mp3/mp3.h"
+#include <thread>
+#include <atomic>
+#include <system_error>
 
 Thing_implement (LongSound, SampledXY, 0);
 Thing_implement (SoundAndLongSoundList, Ordered, 0);
@@ -71,12 +74,125 @@ void LongSound_setBufferSizePref_seconds (const integer size) {
 	prefs_bufferLength = Melder_clipped (minimumBufferDuration, size, maximumBufferDuration);
 }
 
+/*
+	The peak pyramid. Level 0 contains, for every channel, the minimum and maximum of each block of 256 samples;
+	every next level combines pairs of blocks of the previous level, until a single block remains.
+	The pyramid is built only when a window longer than the buffer is first asked for (LongSound_requestPeaks),
+	by a background thread that reads the file through its own file pointer,
+	so that the buffer and the file pointer of the LongSound itself are not touched.
+	The pyramid lives in memory with the open LongSound; it is not saved next to the sound file,
+	because Praat does not write into the user's folders unasked.
+*/
+#define PEAKS_LOG2_BLOCK_SIZE  8
+#define PEAKS_NUMBER_OF_BLOCKS_PER_READ  256
+
+struct LongSoundPeaks {
+	std::vector <automatrix <int16>> minima, maxima;   // [level] [channel] [block]
+	autovector <int16> readBuffer;   // for the background thread
+	autovector <int16> edgeBuffer;   // for the main thread, which reads the partial blocks at the edges of a window
+	std::atomic <bool> ready { false }, finished { false }, cancelled { false };
+	std::thread builder;
+};
+
+static void LongSoundPeaks_build (LongSoundPeaks *me, FILE *f, integer numberOfChannels, int encoding, integer numberOfSamples) {
+	try {
+		constexpr integer blockSize = 1 << PEAKS_LOG2_BLOCK_SIZE;
+		const integer numberOfBlocks = my minima [0]. ncol;
+		for (integer firstBlock = 1; firstBlock <= numberOfBlocks; firstBlock += PEAKS_NUMBER_OF_BLOCKS_PER_READ) {
+			if (my cancelled)
+				break;
+			const integer lastBlock = std::min (firstBlock + PEAKS_NUMBER_OF_BLOCKS_PER_READ - 1, numberOfBlocks);
+			const integer firstSample = (firstBlock - 1) * blockSize + 1;
+			const integer numberOfSamplesToRead = std::min ((lastBlock - firstBlock + 1) * blockSize, numberOfSamples - firstSample + 1);
+			Melder_readAudioToShort (f, numberOfChannels, encoding, my readBuffer.asArgumentToFunctionThatExpectsZeroBasedArray(), numberOfSamplesToRead);
+			for (integer iblock = firstBlock; iblock <= lastBlock; iblock ++) {
+				const integer firstSampleInBuffer = (iblock - firstBlock) * blockSize;   // base 0
+				const integer lastSampleInBuffer = std::min (firstSampleInBuffer + blockSize, numberOfSamplesToRead) - 1;
+				for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
+					const int16 *sample = & my readBuffer [1 + firstSampleInBuffer * numberOfChannels + (ichan - 1)];
+					int16 minimum = *sample, maximum = *sample;
+					for (integer i = firstSampleInBuffer; i <= lastSampleInBuffer; i ++, sample += numberOfChannels) {
+						if (*sample < minimum)
+							minimum = *sample;
+						if (*sample > maximum)
+							maximum = *sample;
+					}
+					my minima [0] [ichan] [iblock] = minimum;
+					my maxima [0] [ichan] [iblock] = maximum;
+				}
+			}
+		}
+		for (uinteger level = 1; level < my minima.size() && ! my cancelled; level ++) {
+			const integer numberOfLowerBlocks = my minima [level - 1]. ncol;
+			for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
+				for (integer iblock = 1; iblock <= my minima [level]. ncol; iblock ++) {
+					const integer lower = 2 * iblock - 1, upper = std::min (2 * iblock, numberOfLowerBlocks);
+					my minima [level] [ichan] [iblock] = std::min (my minima [level - 1] [ichan] [lower], my minima [level - 1] [ichan] [upper]);
+					my maxima [level] [ichan] [iblock] = std::max (my maxima [level - 1] [ichan] [lower], my maxima [level - 1] [ichan] [upper]);
+				}
+			}
+		}
+		if (! my cancelled)
+			my ready = true;
+	} catch (MelderError) {
+		Melder_clearError ();   // no pyramid; the LongSound is drawn as before
+	}
+	fclose (f);
+	my finished = true;   // with or without a pyramid
+}
+
+void LongSound_requestPeaks (LongSound me) {
+	if (my peaks)
+		return;   // already being built, or ready
+	if (my encoding == Melder_FLAC_COMPRESSION_16 || my encoding == Melder_MPEG_COMPRESSION_16)
+		return;   // the decoders cannot be shared with a second thread
+	if (my nx <= my nmax)
+		return;   // every window fits into the buffer
+	/*
+		Allocate everything here, so that the background thread only reads and computes.
+	*/
+	auto peaks = std::make_unique <LongSoundPeaks> ();
+	integer numberOfBlocks = ((my nx - 1) >> PEAKS_LOG2_BLOCK_SIZE) + 1;
+	for (;;) {
+		peaks -> minima. push_back (newmatrixraw <int16> (my numberOfChannels, numberOfBlocks));
+		peaks -> maxima. push_back (newmatrixraw <int16> (my numberOfChannels, numberOfBlocks));
+		if (numberOfBlocks == 1)
+			break;
+		numberOfBlocks = (numberOfBlocks + 1) / 2;
+	}
+	peaks -> readBuffer = newvectorraw <int16> ((PEAKS_NUMBER_OF_BLOCKS_PER_READ << PEAKS_LOG2_BLOCK_SIZE) * my numberOfChannels);
+	peaks -> edgeBuffer = newvectorraw <int16> ((1 << PEAKS_LOG2_BLOCK_SIZE) * my numberOfChannels);
+	FILE *f = Melder_fopen (& my file, "rb");
+	if (fseek (f, my startOfData, SEEK_SET)) {
+		fclose (f);
+		Melder_throw (U"Cannot seek in file ", & my file, U".");
+	}
+	try {
+		peaks -> builder = std::thread (LongSoundPeaks_build, peaks.get(), f, my numberOfChannels, my encoding, my nx);
+	} catch (std::system_error const&) {
+		fclose (f);
+		Melder_throw (me, U": cannot start the computation of the waveform envelope.");
+	}
+	my peaks = peaks.release();
+}
+
+static void LongSound_forgetPeaks (LongSound me) noexcept {
+	if (! my peaks)
+		return;
+	my peaks -> cancelled = true;
+	if (my peaks -> builder.joinable ())
+		my peaks -> builder.join ();
+	delete my peaks;
+	my peaks = nullptr;
+}
+
 void structLongSound :: v9_destroy () noexcept {
 	/*
 		The play callback may contain a pointer to my buffer.
 		That pointer is about to dangle, so kill the playback.
 	*/
 	MelderAudio_stopPlaying (MelderAudio_IMPLICIT);
+	LongSound_forgetPeaks (this);
 	if (mp3f)
 		mp3f_delete (mp3f);
 	if (flacDecoder) {
@@ -241,6 +357,7 @@ static void LongSound_init (LongSound me, constMelderFile file) {
 	}
 	my imin = 1;
 	my imax = 0;
+	my peaks = nullptr;
 	my flacDecoder = nullptr;
 	if (my audioFileType == Melder_FLAC) {
 		my flacDecoder = FLAC__stream_decoder_new ();
@@ -262,6 +379,7 @@ void structLongSound :: v1_copy (Daata thee_Daata) const {
 	LongSound thee = static_cast <LongSound> (thee_Daata);
 	thy f = nullptr;
 	thy buffer.releaseToAmbiguousOwner();   // this may have been shallow-copied, so undangle and nullify
+	thy peaks = nullptr;   // idem
 	LongSound_init (thee, & our file);   // this recreates a new buffer
 }
 
@@ -516,17 +634,114 @@ bool LongSound_haveWindow (LongSound me, double tmin, double tmax) {
 	return true;
 }
 
+static integer LongSoundPeaks_chooseLevel (LongSoundPeaks *me, integer numberOfSamples, integer maximumNumberOfBlocks) {
+	integer level = 0;
+	while (level + 1 < (integer) my minima.size() && (numberOfSamples >> (PEAKS_LOG2_BLOCK_SIZE + level)) > maximumNumberOfBlocks)
+		level ++;
+	return level;
+}
+
+static void LongSoundPeaks_getExtrema (LongSoundPeaks *me, integer level, integer channel, integer firstSample, integer lastSample,
+	int16 *minimum, int16 *maximum)
+{
+	const automatrix <int16>& minima = my minima [(uinteger) level], & maxima = my maxima [(uinteger) level];
+	const integer firstBlock = std::max (((firstSample - 1) >> (PEAKS_LOG2_BLOCK_SIZE + level)) + 1, 1_integer);
+	const integer lastBlock = std::min (((lastSample - 1) >> (PEAKS_LOG2_BLOCK_SIZE + level)) + 1, minima.ncol);
+	*minimum = 32767;
+	*maximum = -32768;
+	for (integer iblock = firstBlock; iblock <= lastBlock; iblock ++) {
+		if (minima [channel] [iblock] < *minimum)
+			*minimum = minima [channel] [iblock];
+		if (maxima [channel] [iblock] > *maximum)
+			*maximum = maxima [channel] [iblock];
+	}
+}
+
+/*
+	The extrema of the whole level-0 blocks `firstBlock` through `lastBlock` (base 0),
+	from at most two blocks per level, as in a segment tree.
+*/
+static void LongSoundPeaks_getExtremaOfBlocks (LongSoundPeaks *me, integer channel, integer firstBlock, integer lastBlock,
+	int16 *minimum, int16 *maximum)
+{
+	auto include = [&] (uinteger level, integer block) {
+		Melder_clipRight (minimum, my minima [level] [channel] [block + 1]);
+		Melder_clipLeft (my maxima [level] [channel] [block + 1], maximum);
+	};
+	for (uinteger level = 0; firstBlock <= lastBlock; level ++) {
+		if (firstBlock % 2 == 1)
+			include (level, firstBlock ++);
+		if (lastBlock % 2 == 0)
+			include (level, lastBlock --);
+		firstBlock /= 2;
+		lastBlock = ( lastBlock < 0 ? -1 : lastBlock / 2 );
+	}
+}
+
+static void LongSound_getExtremaOfSamplesFromFile (LongSound me, integer channel, integer firstSample, integer lastSample,
+	int16 *minimum, int16 *maximum)
+{
+	constexpr integer blockSize = 1 << PEAKS_LOG2_BLOCK_SIZE;
+	for (integer first = firstSample; first <= lastSample; first += blockSize) {
+		const integer numberOfSamples = std::min (blockSize, lastSample - first + 1);
+		LongSound_readAudioToShort (me, my peaks -> edgeBuffer.asArgumentToFunctionThatExpectsZeroBasedArray(), first, numberOfSamples);
+		for (integer i = 0; i < numberOfSamples; i ++) {
+			const int16 value = my peaks -> edgeBuffer [1 + i * my numberOfChannels + (channel - 1)];
+			Melder_clipRight (minimum, value);
+			Melder_clipLeft (value, maximum);
+		}
+	}
+}
+
+/*
+	The exact extrema of the samples `firstSample` through `lastSample`:
+	the whole blocks come from the pyramid, the partial blocks at the two edges are read from the file.
+*/
+static void LongSound_getExtremaFromPeaks (LongSound me, integer channel, integer firstSample, integer lastSample,
+	int16 *minimum, int16 *maximum)
+{
+	constexpr integer blockSize = 1 << PEAKS_LOG2_BLOCK_SIZE;
+	const integer numberOfBlocks = my peaks -> minima [0]. ncol;
+	const integer firstWholeBlock = (firstSample - 1 + blockSize - 1) / blockSize;   // base 0
+	const integer lastWholeBlock = ( lastSample == my nx ? numberOfBlocks - 1 : lastSample / blockSize - 1 );
+	*minimum = 32767;
+	*maximum = -32768;
+	if (firstWholeBlock > lastWholeBlock) {
+		LongSound_getExtremaOfSamplesFromFile (me, channel, firstSample, lastSample, minimum, maximum);
+		return;
+	}
+	LongSoundPeaks_getExtremaOfBlocks (my peaks, channel, firstWholeBlock, lastWholeBlock, minimum, maximum);
+	LongSound_getExtremaOfSamplesFromFile (me, channel, firstSample, firstWholeBlock * blockSize, minimum, maximum);
+	LongSound_getExtremaOfSamplesFromFile (me, channel, (lastWholeBlock + 1) * blockSize + 1, lastSample, minimum, maximum);
+}
+
 void LongSound_getWindowExtrema (LongSound me, double tmin, double tmax, const integer channel, double *minimum, double *maximum) {
 	integer imin, imax;
 	(void) Sampled_getWindowSamples (me, tmin, tmax, & imin, & imax);
 	*minimum = 1.0;
 	*maximum = -1.0;
+	bool fits;
 	try {
-		LongSound_haveWindow (me, tmin, tmax);
+		fits = LongSound_haveWindow (me, tmin, tmax);
 	} catch (MelderError) {
 		Melder_clearError ();
 		return;
 	}
+	if (! fits) {
+		if (LongSound_havePeaks (me) && imax >= imin) {
+			int16 minimum_int, maximum_int;
+			try {
+				LongSound_getExtremaFromPeaks (me, channel, imin, imax, & minimum_int, & maximum_int);
+			} catch (MelderError) {
+				Melder_clearError ();   // the edges could not be read; use the whole blocks that overlap the window
+				const integer level = LongSoundPeaks_chooseLevel (my peaks, imax - imin + 1, 1000);
+				LongSoundPeaks_getExtrema (my peaks, level, channel, imin, imax, & minimum_int, & maximum_int);
+			}
+			*minimum = minimum_int / 32768.0;
+			*maximum = maximum_int / 32768.0;
+		}
+		return;
+	}
 	integer minimum_int = 32767, maximum_int = -32768;
 	for (integer i = imin; i <= imax; i ++) {
 		const integer value = my buffer [(i - my imin) * my numberOfChannels + channel];
@@ -539,6 +754,143 @@ void LongSound_getWindowExtrema (LongSound me, double tmin, double tmax, const i
 	*maximum = maximum_int / 32768.0;
 }
 
+void LongSound_getExtrema (LongSound me, double tmin, double tmax, integer channel, double *out_minimum, double *out_maximum) {
+	Function_unidirectionalAutowindow (me, & tmin, & tmax);
+	integer imin, imax;
+	if (Sampled_getWindowSamples (me, tmin, tmax, & imin, & imax) < 1) {
+		*out_minimum = *out_maximum = undefined;
+		return;
+	}
+	Melder_require (channel >= 1 && channel <= my numberOfChannels,
+		U"Channel number should be between 1 and ", my numberOfChannels, U".");
+	if (! LongSound_haveWindow (me, tmin, tmax)) {
+		LongSound_requestPeaks (me);
+		LongSound_waitForPeaks (me);
+		Melder_require (LongSound_havePeaks (me),
+			me, U": cannot compute the extrema of a window longer than ", my bufferLength, U" seconds in a compressed file.");
+	}
+	LongSound_getWindowExtrema (me, tmin, tmax, channel, out_minimum, out_maximum);
+}
+
+bool LongSound_havePeaks (LongSound me) {
+	return my peaks && my peaks -> ready;
+}
+
+bool LongSound_isBuildingPeaks (LongSound me) {
+	return my peaks && ! my peaks -> finished;
+}
+
+void LongSound_waitForPeaks (LongSound me) {
+	if (my peaks && my peaks -> builder.joinable ())
+		my peaks -> builder.join ();
+}
+
+void LongSound_getPeaks (LongSound me, double tmin, double tmax, integer channel, VEC const& minima, VEC const& maxima) {
+	Melder_assert (LongSound_havePeaks (me));
+	Melder_assert (maxima.size == minima.size);
+	const integer numberOfColumns = minima.size;
+	const double samplesPerColumn = (tmax - tmin) / my dx / numberOfColumns;
+	const integer level = LongSoundPeaks_chooseLevel (my peaks, Melder_ifloor (samplesPerColumn), 1);
+	for (integer icolumn = 1; icolumn <= numberOfColumns; icolumn ++) {
+		const double columnStartTime = tmin + (icolumn - 1) * (tmax - tmin) / numberOfColumns;
+		const double columnEndTime = tmin + icolumn * (tmax - tmin) / numberOfColumns;
+		const integer firstSample = std::max (1 + Melder_iceiling ((columnStartTime - my x1) / my dx), 1_integer);
+		const integer lastSample = std::min (1 + Melder_ifloor ((columnEndTime - my x1) / my dx), my nx);
+		if (lastSample < firstSample) {
+			minima [icolumn] = maxima [icolumn] = undefined;
+			continue;
+		}
+		int16 minimum, maximum;
+		LongSoundPeaks_getExtrema (my peaks, level, channel, firstSample, lastSample, & minimum, & maximum);
+		minima [icolumn] = minimum / 32768.0;
+		maxima [icolumn] = maximum / 32768.0;
+	}
+}
+
+void LongSound_drawPeaks (LongSound me, Graphics g, double tmin, double tmax, integer channel) {
+	const integer numberOfColumns = std::max (1_integer, Melder_iround (Graphics_dxWCtoMM (g, tmax - tmin) * g -> resolution / 25.4));
+	autoVEC minima = raw_VEC (numberOfColumns), maxima = raw_VEC (numberOfColumns);
+	LongSound_getPeaks (me, tmin, tmax, channel, minima.get(), maxima.get());
+	/*
+		A zigzag from the minimum to the maximum of each column; at one column per pixel, this fills the envelope.
+	*/
+	autoVEC x = raw_VEC (2 * numberOfColumns), y = raw_VEC (2 * numberOfColumns);
+	integer numberOfPoints = 0;
+	for (integer icolumn = 1; icolumn <= numberOfColumns; icolumn ++) {
+		if (isundef (minima [icolumn]))
+			continue;
+		const double time = tmin + (icolumn - 0.5) * (tmax - tmin) / numberOfColumns;
+		const bool upward = ( icolumn % 2 == 1 );
+		x [++ numberOfPoints] = time;
+		y [numberOfPoints] = ( upward ? minima [icolumn] : maxima [icolumn] );
+		x [++ numberOfPoints] = time;
+		y [numberOfPoints] = ( upward ? maxima [icolumn] : minima [icolumn] );
+	}
+	if (numberOfPoints > 1)
+		Graphics_polyline (g, numberOfPoints, & x [1], & y [1]);
+}
+
+void LongSound_draw (LongSound me, Graphics g, double tmin, double tmax, double minimum, double maximum, bool garnish) {
+	Function_unidirectionalAutowindow (me, & tmin, & tmax);
+	Melder_clipLeft (my xmin, & tmin);
+	Melder_clipRight (& tmax, my xmax);
+	integer imin, imax;
+	if (Sampled_getWindowSamples (me, tmin, tmax, & imin, & imax) < 1)
+		return;
+	/*
+		A window that fits into the buffer is drawn sample by sample, otherwise we draw the envelope from the peak pyramid.
+	*/
+	autoSound part;
+	if (tmax - tmin <= my bufferLength) {
+		part = LongSound_extractPart (me, tmin, tmax, true);
+	} else {
+		LongSound_requestPeaks (me);
+		LongSound_waitForPeaks (me);
+		if (! LongSound_havePeaks (me))
+			Melder_throw (me, U": cannot draw a window longer than ", my bufferLength, U" seconds from a compressed file.");
+	}
+	if (minimum == maximum) {
+		if (part) {
+			Matrix_getWindowExtrema (part.get(), 1, part -> nx, 1, part -> ny, & minimum, & maximum);
+		} else {
+			minimum = 1.0;
+			maximum = -1.0;
+			for (integer channel = 1; channel <= my numberOfChannels; channel ++) {
+				double channelMinimum, channelMaximum;
+				LongSound_getWindowExtrema (me, tmin, tmax, channel, & channelMinimum, & channelMaximum);
+				Melder_clipRight (& minimum, channelMinimum);
+				Melder_clipLeft (channelMaximum, & maximum);
+			}
+		}
+		if (minimum >= maximum) {
+			minimum -= 1.0;
+			maximum += 1.0;
+		}
+	}
+	Graphics_setInner (g);
+	for (integer channel = 1; channel <= my numberOfChannels; channel ++) {
+		Graphics_setWindow (g, tmin, tmax,
+			minimum - (my numberOfChannels - channel) * (maximum - minimum),
+			maximum + (channel - 1) * (maximum - minimum)
+		);
+		if (part)
+			Graphics_function (g, & part -> z [channel] [0], 1, part -> nx, Sampled_indexToX (part.get(), 1), Sampled_indexToX (part.get(), part -> nx));
+		else
+			LongSound_drawPeaks (me, g, tmin, tmax, channel);
+	}
+	Graphics_unsetInner (g);
+	if (garnish) {
+		Graphics_drawInnerBox (g);
+		Graphics_textBottom (g, true, U"Time (s)");
+		Graphics_marksBottom (g, 2, true, true, false);
+		Graphics_setWindow (g, tmin, tmax, minimum - (my numberOfChannels - 1) * (maximum - minimum), maximum);
+		Graphics_markLeft (g, minimum, true, true, false, nullptr);
+		Graphics_markLeft (g, maximum, true, true, false, nullptr);
+		if (minimum != 0.0 && maximum != 0.0 && (minimum > 0.0) != (maximum > 0.0))
+			Graphics_markLeft (g, 0.0, true, true, true, nullptr);
+	}
+}
+
 static struct LongSoundPlay {
 	integer numberOfSamples, i1, i2, silenceBefore, silenceAfter;
 	double startTime, endTime, dt, t1;
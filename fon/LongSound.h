@@ -27,6 +27,7 @@
 struct FLAC__StreamDecoder;
 struct FLAC__StreamEncoder;
 struct _MP3_FILE;
+struct LongSoundPeaks;
 
 Thing_define (LongSound, SampledXY) {
 	structMelderFile file;
@@ -49,6 +50,8 @@ Thing_define (LongSound, SampledXY) {
 	double *compressedFloats [2];
 	int16 *compressedShorts;
 
+	struct LongSoundPeaks *peaks;   // a min/max pyramid of the whole file, for windows longer than the buffer; built on request
+
 	void v9_destroy () noexcept
 		override;
 	void v1_info ()
@@ -71,6 +74,42 @@ bool LongSound_haveWindow (LongSound me, double tmin, double tmax);
  */
 
 void LongSound_getWindowExtrema (LongSound me, double tmin, double tmax, integer channel, double *minimum, double *maximum);
+/*
+	For windows that do not fit into the buffer, the extrema come from the peak pyramid if it is ready,
+	otherwise they are reported as minimum 1.0 and maximum -1.0. Does not throw.
+*/
+void LongSound_getExtrema (LongSound me, double tmin, double tmax, integer channel, double *out_minimum, double *out_maximum);
+/*
+	The exact extrema of the samples in the window, waiting for the peak pyramid if the window does not fit into the buffer.
+*/
+
+void LongSound_requestPeaks (LongSound me);
+/*
+	Starts the background pass over the file that builds the peak pyramid, unless it has been started before,
+	or the file is compressed or shorter than the buffer (then there will be no pyramid).
+*/
+bool LongSound_havePeaks (LongSound me);
+/*
+	Returns true once the background pass over the file has completed the peak pyramid.
+*/
+bool LongSound_isBuildingPeaks (LongSound me);
+/*
+	Returns true while the background pass over the file is still running;
+	once it returns false, LongSound_havePeaks () tells whether the pass succeeded.
+*/
+void LongSound_waitForPeaks (LongSound me);
+void LongSound_getPeaks (LongSound me, double tmin, double tmax, integer channel, VEC const& minima, VEC const& maxima);
+/*
+	Fills `minima` and `maxima` with the extrema of `channel` in `minima.size` equal parts of [tmin, tmax],
+	at a resolution of the pyramid level that contains about one block per part.
+	Precondition: LongSound_havePeaks (me).
+*/
+void LongSound_drawPeaks (LongSound me, Graphics g, double tmin, double tmax, integer channel);
+/*
+	Draws the min/max envelope of `channel` with one column per horizontal pixel, into the current world coordinates of `g`.
+	Precondition: LongSound_havePeaks (me).
+*/
+void LongSound_draw (LongSound me, Graphics g, double tmin, double tmax, double minimum, double maximum, bool garnish);
 
 void LongSound_playPart (LongSound me, double startTime, double endTime, Sound_PlayCallback playCallback, Thing playBoss);
 
@@ -707,6 +707,171 @@ void Matrix_writeToHeaderlessSpreadsheetFile (Matrix me, MelderFile file) {
 	}
 }
 
+/*
+	Mappable binary files.
+	The object is written in the usual binary format, except for its cells
+	(the fields of Function, Sampled and SampledXY are written and read explicitly here),
+	which come at the end, aligned at 64 kilobytes and in little-endian byte order,
+	so that a reader on a little-endian machine can map them into memory instead of reading them.
+	Layout (all numbers little-endian):
+		bytes 0..15: "ooMappableFile", padded with null bytes
+		bytes 16..19: version of this layout (1)
+		bytes 20..23: number of rows of the cells
+		bytes 24..27: number of columns of the cells
+		bytes 28..35: position of the cells in the file (a multiple of 65536)
+		bytes 36..: class name and the fields of the object, as in an ooBinaryFile, but without the cells
+		from the position of the cells onwards: the cells, row after row, as 64-bit IEEE floating-point numbers
+*/
+static const char mappableFileMagic [16] = "ooMappableFile";
+constexpr uint32 mappableFileVersion = 1;
+constexpr int64 mappableFileAlignment = 65536;
+
+static bool machineIsLittleEndian () {
+	const uint16 one = 1;
+	uint8 firstByte;
+	memcpy (& firstByte, & one, 1);
+	return firstByte == 1;
+}
+
+/*
+	Only Matrix and its subclasses that add no data (such as Sound and Spectrogram)
+	can be written to and read from mappable binary files,
+	because the fields other than the cells are written explicitly.
+*/
+static void checkThatClassAddsNoDataToMatrix (ClassInfo klas) {
+	Melder_require (klas -> size == classMatrix -> size,
+		U"A ", klas -> className, U" cannot be written to or read from a mappable binary file.");
+}
+
+static void writeMappableFields (Matrix me, FILE *f) {
+	binputr64 (my xmin, f);
+	binputr64 (my xmax, f);
+	binputinteger32BE (my nx, f);
+	binputr64 (my dx, f);
+	binputr64 (my x1, f);
+	binputr64 (my ymin, f);
+	binputr64 (my ymax, f);
+	binputinteger32BE (my ny, f);
+	binputr64 (my dy, f);
+	binputr64 (my y1, f);
+}
+
+static void readMappableFields (Matrix me, FILE *f) {
+	my xmin = bingetr64 (f);
+	my xmax = bingetr64 (f);
+	Melder_require (my xmin <= my xmax,
+		U"xmax should be at least as great as xmin.");
+	my nx = bingetinteger32BE (f);
+	my dx = bingetr64 (f);
+	my x1 = bingetr64 (f);
+	Melder_require (my nx >= 1,
+		U"nx should be at least 1.");
+	Melder_require (my dx > 0.0,
+		U"dx should be positive.");
+	my ymin = bingetr64 (f);
+	my ymax = bingetr64 (f);
+	Melder_require (my ymin <= my ymax,
+		U"ymax should be at least as great as ymin.");
+	my ny = bingetinteger32BE (f);
+	my dy = bingetr64 (f);
+	my y1 = bingetr64 (f);
+	Melder_require (my ny >= 1,
+		U"ny should be at least 1.");
+	Melder_require (my dy > 0.0,
+		U"dy should be positive.");
+}
+
+void Matrix_writeToMappableBinaryFile (Matrix me, MelderFile file) {
+	try {
+		Melder_require (my z.nrow == my ny && my z.ncol == my nx,
+			U"The cells should have ", my ny, U" rows and ", my nx, U" columns.");
+		Melder_require (my ny <= INT32_MAX && my nx <= INT32_MAX,
+			U"Too many rows or columns for a mappable binary file.");
+		checkThatClassAddsNoDataToMatrix (my classInfo);
+		autoMelderFile mfile = MelderFile_create (file);
+		FILE *f = file -> filePointer;
+		if (fwrite (mappableFileMagic, 1, 16, f) != 16)
+			Melder_throw (U"Cannot write first bytes of file.");
+		binputu32LE (mappableFileVersion, f);
+		binputu32LE (uint32 (my ny), f);
+		binputu32LE (uint32 (my nx), f);
+		const int64 positionOfCellsPosition = ftello (f);
+		binputu32LE (0, f);   // placeholder
+		binputu32LE (0, f);
+		binputw8 (
+			my classInfo -> version > 0 ?
+				Melder_cat (my classInfo -> className, U" ", my classInfo -> version) :
+				my classInfo -> className,
+			f);
+		writeMappableFields (me, f);
+		const int64 endOfObject = ftello (f);
+		const int64 positionOfCells = (endOfObject + mappableFileAlignment - 1) / mappableFileAlignment * mappableFileAlignment;
+		for (int64 ipad = endOfObject; ipad < positionOfCells; ipad ++)
+			binputu8 (0, f);
+		binputr64LE (constVECVU (my z.cells, my ny * my nx, 1), f);
+		if (fseeko (f, positionOfCellsPosition, SEEK_SET) != 0)
+			Melder_throw (U"Cannot go back to the header to write the position of the cells.");
+		binputu32LE (uint32 (positionOfCells & 0xFFFF'FFFF), f);
+		binputu32LE (uint32 (positionOfCells >> 32), f);
+		mfile.close ();
+	} catch (MelderError) {
+		Melder_throw (me, U": not written to mappable binary file ", file, U".");
+	}
+}
+
+bool Matrix_isMappableBinaryFileHeader (integer nread, const char *header) {
+	return nread >= 16 && memcmp (header, mappableFileMagic, 16) == 0;
+}
+
+autoMatrix Matrix_readFromMappableBinaryFile (MelderFile file) {
+	try {
+		autofile f = Melder_fopen (file, "rb");
+		char magic [16];
+		if (fread (magic, 1, 16, f) != 16 || ! Matrix_isMappableBinaryFileHeader (16, magic))
+			Melder_throw (U"Not a mappable binary file.");
+		const uint32 version = bingetu32LE (f);
+		if (version > mappableFileVersion)
+			Melder_throw (U"This Praat version cannot read this mappable binary file. Please download a newer version of Praat.");
+		const integer numberOfRows = bingetu32LE (f);
+		const integer numberOfColumns = bingetu32LE (f);
+		const uint32 positionOfCells_low = bingetu32LE (f);
+		const int64 positionOfCells = int64 (positionOfCells_low) | int64 (bingetu32LE (f)) << 32;
+		Melder_require (positionOfCells % mappableFileAlignment == 0,
+			U"The cells should be aligned.");
+		autostring8 klas = bingets8 (f);
+		autoDaata object = Thing_newFromClassName (Melder_peek8to32 (klas.get()), nullptr).static_cast_move <structDaata> ();
+		Melder_require (Thing_isa (object.get(), classMatrix),
+			U"A mappable binary file should contain a Matrix or an object derived from Matrix, not a ", Thing_className (object.get()), U".");
+		checkThatClassAddsNoDataToMatrix (object -> classInfo);
+		autoMatrix me = object.static_cast_move <structMatrix> ();
+		readMappableFields (me.get(), f);
+		if (feof ((FILE *) f) || ferror ((FILE *) f))
+			Melder_throw (U"Early end of file.");
+		Melder_require (my ny == numberOfRows && my nx == numberOfColumns,
+			U"The numbers of rows and columns in the header (", numberOfRows, U" and ", numberOfColumns,
+			U") should match those of the object (", my ny, U" and ", my nx, U").");
+		const integer numberOfCells = numberOfRows * numberOfColumns;
+		double *mappedCells = ( machineIsLittleEndian () && Melder_debug != 18 ?
+				MelderArray:: _map <double> (f, positionOfCells, numberOfCells) : nullptr );
+		if (mappedCells) {
+			my z. adoptFromAmbiguousOwner (MAT (mappedCells, numberOfRows, numberOfColumns));
+		} else {
+			/*
+				Big-endian machine, or a platform without memory mapping:
+				the cells are read in the usual way.
+			*/
+			my z = raw_MAT (numberOfRows, numberOfColumns);
+			if (fseeko (f, positionOfCells, SEEK_SET) != 0)
+				Melder_throw (U"Cannot find the cells.");
+			bingetr64LE (f, VECVU (my z.cells, numberOfCells, 1));
+		}
+		f.close (file);
+		return me;
+	} catch (MelderError) {
+		Melder_throw (U"Matrix not read from mappable binary file ", file, U".");
+	}
+}
+
 void Matrix_formula (Matrix me, conststring32 expression, Interpreter interpreter, Matrix target) {
 	try {
 		Formula_compile (interpreter, me, expression, kFormula_EXPRESSION_TYPE_NUMERIC, true);
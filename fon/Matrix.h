@@ -262,6 +262,17 @@ autoMatrix Table_to_Matrix (Table me);
 void Matrix_writeToMatrixTextFile (Matrix me, MelderFile file);
 void Matrix_writeToHeaderlessSpreadsheetFile (Matrix me, MelderFile file);
 
+void Matrix_writeToMappableBinaryFile (Matrix me, MelderFile file);
+bool Matrix_isMappableBinaryFileHeader (integer nread, const char *header);
+autoMatrix Matrix_readFromMappableBinaryFile (MelderFile file);
+/*
+	A mappable binary file contains a Matrix, or an object of a class derived from Matrix (e.g. a Sound or a Spectrogram),
+	with its cells aligned and in little-endian format at the end of the file.
+	On little-endian machines with memory mapping (macOS, Linux), reading does not copy the cells,
+	but maps them copy-on-write into memory, so that opening is almost instantaneous
+	and processes that open the same file share its memory until they change the values.
+*/
+
 autoMatrix TableOfReal_to_Matrix (TableOfReal me);
 autoTableOfReal Matrix_to_TableOfReal (Matrix me);
 
@@ -521,6 +521,174 @@ autoMAT Pitch_getAllCandidatesInFrame (Pitch me, integer frameNumber) {
 	}
 }
 
+/*
+	The Viterbi search in Pitch_pathFinder keeps only two frames of scores in memory,
+	and decides once per frame which candidates are voiced.
+	A voiced-to-voiced transition costs octaveJumpCost * |log2 (f1 / f2)|, computed exactly as before,
+	so that the chosen path does not change.
+*/
+struct Pitch_PathFinder_Frame {
+	integer numberOfCandidates;
+	autoVEC delta;   // the score of the best path that ends in each candidate
+	autoVEC frequency;
+	autoBOOLVEC voiced;
+};
+
+struct Pitch_PathFinder_Settings {
+	double silenceThreshold, voicingThreshold, octaveCost, octaveJumpCost, voicedUnvoicedCost, ceiling, ceiling2;
+};
+
+static void Pitch_PathFinder_Frame_init (Pitch_PathFinder_Frame *me, integer maxnCandidates) {
+	my delta = zero_VEC (maxnCandidates);
+	my frequency = zero_VEC (maxnCandidates);
+	my voiced = zero_BOOLVEC (maxnCandidates);
+	my numberOfCandidates = 0;
+}
+
+static void Pitch_PathFinder_Frame_setFrequencies (Pitch_PathFinder_Frame *me, Pitch_Frame frame, Pitch_PathFinder_Settings const& s) {
+	my numberOfCandidates = frame -> nCandidates;
+	for (integer icand = 1; icand <= frame -> nCandidates; icand ++) {
+		my frequency [icand] = frame -> candidates [icand]. frequency;
+		my voiced [icand] = Pitch_util_frequencyIsVoiced (my frequency [icand], s.ceiling2);
+	}
+}
+
+/*
+	Fill in the local scores of the candidates of one frame, before any transition costs are taken into account.
+*/
+static void Pitch_PathFinder_Frame_setLocalScores (Pitch_PathFinder_Frame *me, Pitch_Frame frame, Pitch_PathFinder_Settings const& s) {
+	Pitch_PathFinder_Frame_setFrequencies (me, frame, s);
+	double unvoicedStrength = ( s.silenceThreshold <= 0 ? 0.0 :
+		2.0 - frame -> intensity / (s.silenceThreshold / (1.0 + s.voicingThreshold)) );
+	unvoicedStrength = s.voicingThreshold + std::max (0.0, unvoicedStrength);
+	for (integer icand = 1; icand <= frame -> nCandidates; icand ++) {
+		const Pitch_Candidate candidate = & frame -> candidates [icand];
+		my delta [icand] = ( my voiced [icand] ? candidate -> strength - s.octaveCost * NUMlog2 (s.ceiling / candidate -> frequency) :
+				unvoicedStrength );
+	}
+}
+
+/*
+	The max-plus kernel: the scores of all paths that go from the previous frame to candidate `icand2` of the current frame,
+	not yet including the local score of `icand2` itself.
+	The loop has no branches that depend on data other than through a select.
+*/
+static void Pitch_PathFinder_getTransitionScores (const Pitch_PathFinder_Frame *prev, const Pitch_PathFinder_Frame *cur, integer icand2,
+	Pitch_PathFinder_Settings const& s, VEC const& scores)
+{
+	const integer numberOfPreviousCandidates = prev -> numberOfCandidates;
+	const double *prevDelta = & prev -> delta [1], *prevFrequency = & prev -> frequency [1];
+	const bool *prevVoiced = & prev -> voiced [1];
+	double *score = & scores [1];
+	if (cur -> voiced [icand2]) {
+		const double f2 = cur -> frequency [icand2];
+		for (integer i = 0; i < numberOfPreviousCandidates; i ++) {
+			const double transitionCost = ( prevVoiced [i] ?
+					s.octaveJumpCost * fabs (NUMlog2 (prevFrequency [i] / f2))   // both voiced
+				:
+					s.voicedUnvoicedCost   // unvoiced-to-voiced transition
+			);
+			score [i] = prevDelta [i] - transitionCost;
+		}
+	} else {
+		for (integer i = 0; i < numberOfPreviousCandidates; i ++) {
+			const double transitionCost = ( prevVoiced [i] ?
+					s.voicedUnvoicedCost   // voiced-to-unvoiced transition
+				:
+					0.0   // both voiceless
+			);
+			score [i] = prevDelta [i] - transitionCost;
+		}
+	}
+}
+
+/*
+	One step of the Viterbi recursion: turns the local scores of `cur` into path scores,
+	and records the best predecessor of each candidate in `psi`.
+	If `fullPsi` is not empty, it contains the predecessors of all earlier frames,
+	which is needed for the experimental jump-across-voiceless-stretches cost (Melder_debug 30).
+	Ties are reported (Melder_debug 33) only if `reportTies` is on,
+	so that the recomputation of a segment during checkpointed backtracking does not report them a second time.
+*/
+static void Pitch_PathFinder_step (Pitch me, integer iframe, const Pitch_PathFinder_Frame *prev, Pitch_PathFinder_Frame *cur,
+	Pitch_PathFinder_Settings const& s, INTVEC const& psi, constINTMAT const& fullPsi, VEC const& scores, bool reportTies)
+{
+	const integer numberOfPreviousCandidates = prev -> numberOfCandidates;
+	for (integer icand2 = 1; icand2 <= cur -> numberOfCandidates; icand2 ++) {
+		Pitch_PathFinder_getTransitionScores (prev, cur, icand2, s, scores);
+		if (Melder_debug == 30 && fullPsi.nrow > 0 && cur -> voiced [icand2]) {
+			/*
+				Try to take into account a frequency jump across a voiceless stretch.
+			*/
+			const double f2 = my frames [iframe]. candidates [icand2]. frequency;
+			for (integer icand1 = 1; icand1 <= numberOfPreviousCandidates; icand1 ++) {
+				if (prev -> voiced [icand1])
+					continue;
+				double transitionCost = s.voicedUnvoicedCost;
+				integer place1 = icand1;
+				for (integer jframe = iframe - 2; jframe >= 1; jframe --) {
+					place1 = fullPsi [jframe + 1] [place1];
+					const double f1 = my frames [jframe]. candidates [place1]. frequency;
+					if (Pitch_util_frequencyIsVoiced (f1, s.ceiling)) {
+						transitionCost += s.octaveJumpCost * fabs (NUMlog2 (f1 / f2)) / (iframe - jframe);
+						break;
+					}
+				}
+				scores [icand1] = prev -> delta [icand1] - transitionCost;
+			}
+		}
+		const double localScore = cur -> delta [icand2];
+		double maximum = -1e30;
+		integer place = 0;
+		for (integer icand1 = 1; icand1 <= numberOfPreviousCandidates; icand1 ++) {
+			const double value = scores [icand1] + localScore;
+			if (value > maximum) {
+				maximum = value;
+				place = icand1;
+			} else if (value == maximum) {
+				if (reportTies && Melder_debug == 33)
+					Melder_casual (
+						U"A tie in frame ", iframe,
+						U", current candidate ", icand2,
+						U", previous candidate ", icand1
+					);
+			}
+		}
+		cur -> delta [icand2] = maximum;
+		psi [icand2] = place;
+	}
+}
+
+static integer Pitch_PathFinder_getBestPlace (const Pitch_PathFinder_Frame *last) {
+	integer place = 1;
+	double maximum = last -> delta [place];
+	for (integer icand = 2; icand <= last -> numberOfCandidates; icand ++) {
+		if (last -> delta [icand] > maximum) {
+			place = icand;
+			maximum = last -> delta [place];
+		}
+	}
+	return place;
+}
+
+static void Pitch_PathFinder_swapIntoFirstPlace (Pitch me, integer iframe, integer place) {
+	if (Melder_debug == 33)
+		Melder_casual (
+			U"Frame ", iframe, U":",
+			U" swapping candidates 1 and ", place
+		);
+	const Pitch_Frame frame = & my frames [iframe];
+	std::swap (frame -> candidates [1], frame -> candidates [place]);
+}
+
+/*
+	Above this number of psi entries (nx * maxnCandidates), the path finder does not store the whole psi matrix,
+	but only the scores of every sqrt(nx)-th frame, from which it recomputes the psi values segment by segment
+	during backtracking. This costs a second forward pass but brings memory down from O(nx) to O(sqrt(nx)).
+	Setting Melder_debug to 59 forces this checkpointed mode, for testing.
+*/
+constexpr integer Pitch_PathFinder_MAXIMUM_NUMBER_OF_STORED_PSI_VALUES = 10'000'000;
+
 void Pitch_pathFinder (Pitch me, double silenceThreshold, double voicingThreshold,
 	double octaveCost, double octaveJumpCost, double voicedUnvoicedCost,
 	double ceiling, int pullFormants)
@@ -536,119 +704,89 @@ void Pitch_pathFinder (Pitch me, double silenceThreshold, double voicingThreshol
 			U"\nPull formants = ", pullFormants);
 	try {
 		const integer maxnCandidates = Pitch_getMaxnCandidates (me);
-		integer place;
-		volatile double maximum, value;
 		const double ceiling2 = ( pullFormants ? 2.0 * ceiling : ceiling );
 		/* Next three lines 20011015 */
 		const double timeStepCorrection = 0.01 / my dx;
 		octaveJumpCost *= timeStepCorrection;
 		voicedUnvoicedCost *= timeStepCorrection;
+		const Pitch_PathFinder_Settings settings { silenceThreshold, voicingThreshold,
+				octaveCost, octaveJumpCost, voicedUnvoicedCost, ceiling, ceiling2 };
 
 		my ceiling = ceiling;
-		autoMAT delta = zero_MAT (my nx, maxnCandidates);
-		autoINTMAT psi = zero_INTMAT (my nx, maxnCandidates);
-
-		for (integer iframe = 1; iframe <= my nx; iframe ++) {
-			const Pitch_Frame frame = & my frames [iframe];
-			double unvoicedStrength = ( silenceThreshold <= 0 ? 0.0 :
-				2.0 - frame -> intensity / (silenceThreshold / (1.0 + voicingThreshold)) );
-			unvoicedStrength = voicingThreshold + std::max (0.0, unvoicedStrength);
-			for (integer icand = 1; icand <= frame -> nCandidates; icand ++) {
-				const Pitch_Candidate candidate = & frame -> candidates [icand];
-				const bool voiceless = ! Pitch_util_frequencyIsVoiced (candidate -> frequency, ceiling2);
-				delta [iframe] [icand] = ( voiceless ? unvoicedStrength :
-					candidate -> strength - octaveCost * NUMlog2 (ceiling / candidate -> frequency) );
-			}
-		}
+		Pitch_PathFinder_Frame frameData [2];
+		Pitch_PathFinder_Frame_init (& frameData [0], maxnCandidates);
+		Pitch_PathFinder_Frame_init (& frameData [1], maxnCandidates);
+		autoVEC scores = zero_VEC (maxnCandidates);
 
 		/* Look for the most probable path through the maxima. */
 		/* There is a cost for the voiced/unvoiced transition, */
 		/* and a cost for a frequency jump. */
 
-		for (integer iframe = 2; iframe <= my nx; iframe ++) {
-			const Pitch_Frame prevFrame = & my frames [iframe - 1], curFrame = & my frames [iframe];
-			const constVEC prevDelta = delta [iframe - 1];
-			const VEC curDelta = delta [iframe];
-			const INTVEC curPsi = psi [iframe];
-			for (integer icand2 = 1; icand2 <= curFrame -> nCandidates; icand2 ++) {
-				const double f2 = curFrame -> candidates [icand2]. frequency;
-				maximum = -1e30;
-				place = 0;
-				for (integer icand1 = 1; icand1 <= prevFrame -> nCandidates; icand1 ++) {
-					double f1 = prevFrame -> candidates [icand1]. frequency;
-					double transitionCost;
-					const bool previousVoiceless = ! Pitch_util_frequencyIsVoiced (f1, ceiling2);
-					const bool currentVoiceless = ! Pitch_util_frequencyIsVoiced (f2, ceiling2);
-					if (currentVoiceless) {
-						if (previousVoiceless) {
-							transitionCost = 0.0;   // both voiceless
-						} else {
-							transitionCost = voicedUnvoicedCost;   // voiced-to-unvoiced transition
-						}
-					} else {
-						if (previousVoiceless) {
-							transitionCost = voicedUnvoicedCost;   // unvoiced-to-voiced transition
-							if (Melder_debug == 30) {
-								/*
-									Try to take into account a frequency jump across a voiceless stretch.
-								*/
-								integer place1 = icand1;
-								for (integer jframe = iframe - 2; jframe >= 1; jframe --) {
-									place1 = psi [jframe + 1] [place1];
-									f1 = my frames [jframe]. candidates [place1]. frequency;
-									if (Pitch_util_frequencyIsVoiced (f1, ceiling)) {
-										transitionCost += octaveJumpCost * fabs (NUMlog2 (f1 / f2)) / (iframe - jframe);
-										break;
-									}
-								}
-							}
-						} else {
-							transitionCost = octaveJumpCost * fabs (NUMlog2 (f1 / f2));   // both voiced
-						}
-					}
-					value = prevDelta [icand1] - transitionCost + curDelta [icand2];
-					//if (Melder_debug == 33) Melder_casual (U"Frame ", iframe, U", current candidate ", icand2,
-					//  U" (delta ", curDelta [icand2], U"), previous candidate ", icand1, U" (delta ", prevDelta [icand1], U"), ",
-					//	U"transition cost ", transitionCost, U", value ", value, U", maximum ", maximum);
-					if (value > maximum) {
-						maximum = value;
-						place = icand1;
-					} else if (value == maximum) {
-						if (Melder_debug == 33)
-							Melder_casual (
-								U"A tie in frame ", iframe,
-								U", current candidate ", icand2,
-								U", previous candidate ", icand1
-							);
-					}
-				}
-				curDelta [icand2] = maximum;
-				curPsi [icand2] = place;
+		const bool checkpointed = ( Melder_debug == 59 ||
+				(Melder_debug != 30 && my nx * maxnCandidates > Pitch_PathFinder_MAXIMUM_NUMBER_OF_STORED_PSI_VALUES) );
+		if (! checkpointed) {
+			autoINTMAT psi = zero_INTMAT (my nx, maxnCandidates);
+			Pitch_PathFinder_Frame_setLocalScores (& frameData [1], & my frames [1], settings);
+			for (integer iframe = 2; iframe <= my nx; iframe ++) {
+				const Pitch_PathFinder_Frame *prev = & frameData [(iframe - 1) % 2];
+				Pitch_PathFinder_Frame *cur = & frameData [iframe % 2];
+				Pitch_PathFinder_Frame_setLocalScores (cur, & my frames [iframe], settings);
+				Pitch_PathFinder_step (me, iframe, prev, cur, settings, psi [iframe], psi.get(), scores.get(), true);
 			}
-		}
 
-		/* Find the end of the most probable path. */
+			/* Find the end of the most probable path. */
 
-		place = 1;
-		maximum = delta [my nx] [place];
-		for (integer icand = 2; icand <= my frames [my nx]. nCandidates; icand ++) {
-			if (delta [my nx] [icand] > maximum) {
-				place = icand;
-				maximum = delta [my nx] [place];
-			}
-		}
+			integer place = Pitch_PathFinder_getBestPlace (& frameData [my nx % 2]);
 
-		/* Backtracking: follow the path backwards. */
+			/* Backtracking: follow the path backwards. */
 
-		for (integer iframe = my nx; iframe >= 1; iframe --) {
-			if (Melder_debug == 33)
-				Melder_casual (
-					U"Frame ", iframe, U":",
-					U" swapping candidates 1 and ", place
-				);
-			const Pitch_Frame frame = & my frames [iframe];
-			std::swap (frame -> candidates [1], frame -> candidates [place]);
-			place = psi [iframe] [place];
+			for (integer iframe = my nx; iframe >= 1; iframe --) {
+				Pitch_PathFinder_swapIntoFirstPlace (me, iframe, place);
+				place = psi [iframe] [place];
+			}
+		} else {
+			/*
+				Segment `isegment` covers the psi values of frames 2 + (isegment - 1) * segmentLength
+				up to and including 1 + isegment * segmentLength,
+				and starts from the scores of the frame just before it, which are stored as a checkpoint.
+			*/
+			const integer segmentLength = Melder_iroundUp (sqrt ((double) my nx));
+			const integer numberOfSegments = Melder_iroundUp ((double) (my nx - 1) / segmentLength);
+			autoMAT checkpoints = zero_MAT (std::max (numberOfSegments, 1_integer), maxnCandidates);
+			autoINTMAT segmentPsi = zero_INTMAT (segmentLength, maxnCandidates);
+			Pitch_PathFinder_Frame_setLocalScores (& frameData [1], & my frames [1], settings);
+			for (integer iframe = 2; iframe <= my nx; iframe ++) {
+				const Pitch_PathFinder_Frame *prev = & frameData [(iframe - 1) % 2];
+				Pitch_PathFinder_Frame *cur = & frameData [iframe % 2];
+				if ((iframe - 2) % segmentLength == 0)
+					checkpoints [1 + (iframe - 2) / segmentLength] <<= prev -> delta.all();
+				Pitch_PathFinder_Frame_setLocalScores (cur, & my frames [iframe], settings);
+				Pitch_PathFinder_step (me, iframe, prev, cur, settings, segmentPsi [1], constINTMAT (), scores.get(), true);
+			}
+			integer place = Pitch_PathFinder_getBestPlace (& frameData [my nx % 2]);
+
+			/*
+				Backtracking, segment by segment from the end.
+				Recomputing a segment only reads frames that have not been swapped yet.
+			*/
+			for (integer isegment = numberOfSegments; isegment >= 1; isegment --) {
+				const integer firstFrame = 2 + (isegment - 1) * segmentLength;
+				const integer lastFrame = std::min (1 + isegment * segmentLength, my nx);
+				Pitch_PathFinder_Frame *start = & frameData [(firstFrame - 1) % 2];
+				Pitch_PathFinder_Frame_setFrequencies (start, & my frames [firstFrame - 1], settings);
+				start -> delta.all() <<= checkpoints [isegment];
+				for (integer iframe = firstFrame; iframe <= lastFrame; iframe ++) {
+					const Pitch_PathFinder_Frame *prev = & frameData [(iframe - 1) % 2];
+					Pitch_PathFinder_Frame *cur = & frameData [iframe % 2];
+					Pitch_PathFinder_Frame_setLocalScores (cur, & my frames [iframe], settings);
+					Pitch_PathFinder_step (me, iframe, prev, cur, settings, segmentPsi [iframe - firstFrame + 1], constINTMAT (), scores.get(), false);
+				}
+				for (integer iframe = lastFrame; iframe >= firstFrame; iframe --) {
+					Pitch_PathFinder_swapIntoFirstPlace (me, iframe, place);
+					place = segmentPsi [iframe - firstFrame + 1] [place];
+				}
+			}
+			Pitch_PathFinder_swapIntoFirstPlace (me, 1, place);
 		}
 
 		/* Pull formants: devoice frames with frequencies between ceiling and ceiling2. */
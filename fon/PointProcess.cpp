@@ -380,7 +380,7 @@ MelderIntegerRange PointProcess_getWindowPoints (PointProcess me, double tmin, d
 	return { PointProcess_getHighIndex (me, tmin), PointProcess_getLowIndex (me, tmax) };
 }
 
-static bool PointProcess_isPeriod (PointProcess me, integer ileft, double minimumPeriod, double maximumPeriod, double maximumPeriodFactor) {
+bool PointProcess_isPeriod (PointProcess me, integer ileft, double minimumPeriod, double maximumPeriod, double maximumPeriodFactor) {
 	/*
 		This function answers the question: is the interval from point 'ileft' to point 'ileft+1' a period?
 	*/
@@ -29,6 +29,7 @@
 #include "praat.h"
 #include "NUM2.h"
 #include "Sound.h"
+#include "TextGrid.h"
 
 #include "enums_getText.h"
 #include "Praat_tests_enums.h"
@@ -61,6 +62,273 @@ static autoMAT constantHH (integer nrow, integer ncol, double value) {
 	return result;
 }
 
+/*
+	The bulk routines of abcio should write and read exactly the bytes and values
+	of the element-wise routines, under any Melder_debug setting (18 and 181 included).
+*/
+static autoVEC binaryFloats_testValues () {
+	const double specialValues [] = { 0.0, -0.0, 1.0, -2.5, 1.0 / 3.0, 0.1, -1e-40, 1e-310, -5e-324,
+		1e38, 3.4028234e38, 3.4028236e38, -1e39, 1e300, -1.7976931348623157e308,
+		INFINITY, -INFINITY, NAN, -NAN, undefined, 0x1p-126, 0x1p-149, 0x1.fffffep-127, 0x1p-150 };
+	const integer numberOfSpecialValues = std::size (specialValues);
+	autoVEC result = raw_VEC (3 * 4096 + 17);   // more than one chunk, and not a whole number of chunks
+	for (integer i = 1; i <= result.size; i ++) {
+		if (i <= numberOfSpecialValues)
+			result [i] = specialValues [i - 1];
+		else if (i % 3 == 0)
+			result [i] = NUMrandomGauss (0.0, 1.0) * pow (10.0, NUMrandomInteger (-50, 50));
+		else {
+			const uint64 bits = (uint64) NUMrandomInteger (0, 0x7FFF'FFFF) << 33 ^ (uint64) NUMrandomInteger (0, 0x7FFF'FFFF) << 2 ^
+					(uint64) NUMrandomInteger (0, 3);
+			if (i % 3 == 1)
+				memcpy (& result [i], & bits, 8);   // any 64-bit pattern, including NaNs with payloads
+			else {
+				const uint32 bits32 = (uint32) bits;
+				float x32;
+				memcpy (& x32, & bits32, 4);
+				result [i] = x32;   // any 32-bit pattern
+			}
+		}
+	}
+	return result;
+}
+
+static autoVEC binaryFloats_fileBytes (FILE *f) {
+	const integer numberOfBytes = ftell (f);
+	autoVEC result = raw_VEC (numberOfBytes);
+	rewind (f);
+	for (integer i = 1; i <= numberOfBytes; i ++)
+		result [i] = fgetc (f);
+	return result;
+}
+
+static bool binaryFloats_bitsAreEqual (constVECVU const& x, constVECVU const& y) {
+	if (x.size != y.size)
+		return false;
+	for (integer i = 1; i <= x.size; i ++)
+		if (memcmp (& x [i], & y [i], 8) != 0)
+			return false;
+	return true;
+}
+
+static void checkBinaryFloats () {
+	struct BinaryFloatFormat {
+		conststring32 name;
+		void (*binputElement) (double, FILE *);
+		void (*binputBulk) (constVECVU const&, FILE *);
+		double (*bingetElement) (FILE *);
+		void (*bingetBulk) (FILE *, VECVU const&);
+	} const formats [] = {
+		{ U"r32", binputr32, binputr32, bingetr32, bingetr32 },
+		{ U"r32LE", binputr32LE, binputr32LE, bingetr32LE, bingetr32LE },
+		{ U"r64", binputr64, binputr64, bingetr64, bingetr64 },
+		{ U"r64LE", binputr64LE, binputr64LE, bingetr64LE, bingetr64LE }
+	};
+	autoVEC const values = binaryFloats_testValues ();
+	autoMAT const interleaved = raw_MAT (values.size, 2);   // for a strided column
+	interleaved.column (2)  <<=  values.all();
+	for (const BinaryFloatFormat& format : formats) {
+		FILE *elementWiseFile = tmpfile (), *bulkFile = tmpfile (), *stridedFile = tmpfile ();
+		Melder_require (elementWiseFile && bulkFile && stridedFile,
+			U"Cannot create temporary files.");
+		for (integer i = 1; i <= values.size; i ++)
+			format.binputElement (values [i], elementWiseFile);
+		format.binputBulk (values.all(), bulkFile);
+		format.binputBulk (interleaved.column (2), stridedFile);
+		autoVEC const elementWiseBytes = binaryFloats_fileBytes (elementWiseFile);
+		Melder_require (NUMequal (binaryFloats_fileBytes (bulkFile).get(), elementWiseBytes.get()),
+			format.name, U": the bulk routine should write the same bytes as the element-wise routine.");
+		Melder_require (NUMequal (binaryFloats_fileBytes (stridedFile).get(), elementWiseBytes.get()),
+			format.name, U": the bulk routine should write the same bytes from a strided vector.");
+		/*
+			Read everything back, i.e. including the infinities and NaNs that the file contains on some paths.
+		*/
+		rewind (elementWiseFile);
+		rewind (bulkFile);
+		autoVEC const elementWise = raw_VEC (values.size), bulk = raw_VEC (values.size);
+		for (integer i = 1; i <= values.size; i ++)
+			elementWise [i] = format.bingetElement (elementWiseFile);
+		format.bingetBulk (bulkFile, bulk.all());
+		Melder_require (binaryFloats_bitsAreEqual (bulk.all(), elementWise.all()),
+			format.name, U": the bulk routine should read the same values as the element-wise routine.");
+		rewind (bulkFile);
+		autoMAT const readInterleaved = zero_MAT (values.size, 2);
+		format.bingetBulk (bulkFile, readInterleaved.column (2));
+		Melder_require (binaryFloats_bitsAreEqual (readInterleaved.column (2), elementWise.all()),
+			format.name, U": the bulk routine should read the same values into a strided vector.");
+		fclose (elementWiseFile);
+		fclose (bulkFile);
+		fclose (stridedFile);
+		MelderInfo_writeLine (format.name, U": OK");
+	}
+	/*
+		Pin a few bytes that are the same on every path
+		(except for 64-bit numbers under Melder_debug 181, which are written in the machine's own byte order).
+	*/
+	FILE *f = tmpfile ();
+	Melder_require (f,
+		U"Cannot create a temporary file.");
+	autoVEC const pinned = raw_VEC (3);
+	pinned [1] = 1.0;
+	pinned [2] = -2.5;
+	pinned [3] = 1.0 / 3.0;
+	binputr32 (pinned.part (1, 2), f);
+	binputr32LE (pinned.part (1, 2), f);
+	const bool pin64 = ( Melder_debug != 181 );
+	if (pin64) {
+		binputr64 (pinned.all(), f);
+		binputr64LE (pinned.all(), f);
+	}
+	autoVEC const bytes = binaryFloats_fileBytes (f);
+	fclose (f);
+	const double expectedBytes [] = {
+		0x3F, 0x80, 0x00, 0x00,   0xC0, 0x20, 0x00, 0x00,
+		0x00, 0x00, 0x80, 0x3F,   0x00, 0x00, 0x20, 0xC0,
+		0x3F, 0xF0, 0, 0, 0, 0, 0, 0,   0xC0, 0x04, 0, 0, 0, 0, 0, 0,   0x3F, 0xD5, 0x55, 0x55, 0x55, 0x55, 0x55, 0x55,
+		0, 0, 0, 0, 0, 0, 0xF0, 0x3F,   0, 0, 0, 0, 0, 0, 0x04, 0xC0,   0x55, 0x55, 0x55, 0x55, 0x55, 0x55, 0xD5, 0x3F
+	};
+	const integer numberOfExpectedBytes = ( pin64 ? std::size (expectedBytes) : 16 );
+	Melder_require (bytes.size == numberOfExpectedBytes,
+		U"Pinned bytes: wrong file size ", bytes.size, U".");
+	for (integer i = 1; i <= bytes.size; i ++)
+		Melder_require (bytes [i] == expectedBytes [i - 1],
+			U"Pinned bytes: byte ", i, U" is ", bytes [i], U" instead of ", expectedBytes [i - 1], U".");
+	MelderInfo_writeLine (U"pinned bytes: OK");
+}
+
+/*
+	Float samples in audio files should be written and read exactly as the element-wise abcio routines do,
+	for any number of channels (mono and stereo have their own unrolled loops).
+*/
+static void checkFloatSoundFiles () {
+	struct FloatEncoding {
+		conststring32 name;
+		int encoding;
+		void (*binputElement) (double, FILE *);
+		double (*bingetElement) (FILE *);
+	} const encodings [] = {
+		{ U"32-bit big-endian", Melder_IEEE_FLOAT_32_BIG_ENDIAN, binputr32, bingetr32 },
+		{ U"32-bit little-endian", Melder_IEEE_FLOAT_32_LITTLE_ENDIAN, binputr32LE, bingetr32LE },
+		{ U"64-bit big-endian", Melder_IEEE_FLOAT_64_BIG_ENDIAN, binputr64, bingetr64 },
+		{ U"64-bit little-endian", Melder_IEEE_FLOAT_64_LITTLE_ENDIAN, binputr64LE, bingetr64LE }
+	};
+	autoVEC const values = binaryFloats_testValues ();
+	for (integer numberOfChannels = 1; numberOfChannels <= 3; numberOfChannels ++) {
+		const integer numberOfSamples = values.size / numberOfChannels;
+		autoMAT const samples = raw_MAT (numberOfChannels, numberOfSamples);
+		for (integer ichan = 1; ichan <= numberOfChannels; ichan ++)
+			for (integer isamp = 1; isamp <= numberOfSamples; isamp ++)
+				samples [ichan] [isamp] = values [(isamp - 1) * numberOfChannels + ichan];
+		for (const FloatEncoding& encoding : encodings) {
+			FILE *elementWiseFile = tmpfile (), *audioFile = tmpfile ();
+			Melder_require (elementWiseFile && audioFile,
+				U"Cannot create temporary files.");
+			for (integer isamp = 1; isamp <= numberOfSamples; isamp ++)
+				for (integer ichan = 1; ichan <= numberOfChannels; ichan ++)
+					encoding.binputElement (samples [ichan] [isamp], elementWiseFile);
+			structMelderFile file { };
+			file. filePointer = audioFile;
+			MelderFile_writeFloatToAudio (& file, samples.all(), encoding.encoding, false);
+			autoVEC const elementWiseBytes = binaryFloats_fileBytes (elementWiseFile);
+			Melder_require (NUMequal (binaryFloats_fileBytes (audioFile).get(), elementWiseBytes.get()),
+				encoding.name, U", ", numberOfChannels, U" channels: the audio file should contain the same bytes as written element-wise.");
+			rewind (elementWiseFile);
+			rewind (audioFile);
+			autoMAT const elementWise = raw_MAT (numberOfChannels, numberOfSamples);
+			for (integer isamp = 1; isamp <= numberOfSamples; isamp ++)
+				for (integer ichan = 1; ichan <= numberOfChannels; ichan ++)
+					elementWise [ichan] [isamp] = encoding.bingetElement (elementWiseFile);
+			autoMAT const audio = zero_MAT (numberOfChannels, numberOfSamples);
+			Melder_readAudioToFloat (audioFile, encoding.encoding, audio.get());
+			for (integer ichan = 1; ichan <= numberOfChannels; ichan ++)
+				Melder_require (binaryFloats_bitsAreEqual (audio.row (ichan), elementWise.row (ichan)),
+					encoding.name, U", ", numberOfChannels, U" channels: the audio file should read as the same values as read element-wise.");
+			fclose (elementWiseFile);
+			fclose (audioFile);
+		}
+	}
+	MelderInfo_writeLine (U"float sound files: OK");
+}
+
+/*
+	The index of an IntervalTier should answer overlap and label queries as a loop over the intervals does,
+	also after the texts have been changed in place (as in an Inspect window) and the tier has been told so.
+*/
+static void checkIntervalTierIndex () {
+	const conststring32 texts [] = { U"a", U"b", U"ab", U"", U"ba", U"c" };
+	for (integer numberOfIntervals = 1; numberOfIntervals <= 60; numberOfIntervals ++) {
+		autoIntervalTier tier = IntervalTier_create (0.0, numberOfIntervals);
+		for (integer iinterval = 1; iinterval <= numberOfIntervals; iinterval ++) {
+			TextInterval interval = tier -> intervals.at [iinterval];
+			if (iinterval < numberOfIntervals) {
+				/*
+					Split the last interval at a random time, leaving room for the intervals still to come.
+				*/
+				const double boundary = NUMrandomUniform (interval -> xmin, interval -> xmin + 1.0);
+				autoTextInterval newInterval = TextInterval_create (boundary, interval -> xmax, U"");
+				interval -> xmax = boundary;
+				tier -> intervals. addItem_move (newInterval.move());
+			}
+			if (NUMrandomUniform (0.0, 1.0) < 0.9)
+				TextInterval_setText (interval, texts [NUMrandomInteger (0, std::size (texts) - 1)]);
+		}
+		IntervalTierIndex index = IntervalTier_getIndex (tier.get());
+		for (integer iquery = 1; iquery <= 200; iquery ++) {
+			double tmin, tmax;
+			if (iquery % 4 == 0) {
+				/*
+					Exactly at boundaries, where the intervals only touch.
+				*/
+				tmin = tier -> intervals.at [NUMrandomInteger (1, numberOfIntervals)] -> xmin;
+				tmax = tier -> intervals.at [NUMrandomInteger (1, numberOfIntervals)] -> xmax;
+			} else {
+				tmin = NUMrandomUniform (-1.0, numberOfIntervals + 1.0);
+				tmax = NUMrandomUniform (-1.0, numberOfIntervals + 1.0);
+			}
+			if (iquery % 3 == 0)
+				tmax = tmin;
+			integer expectedFirst = 0, expectedLast = -1;
+			for (integer iinterval = 1; iinterval <= numberOfIntervals; iinterval ++) {
+				TextInterval interval = tier -> intervals.at [iinterval];
+				if (interval -> xmax > tmin && interval -> xmin < tmax) {
+					if (expectedFirst == 0)
+						expectedFirst = iinterval;
+					expectedLast = iinterval;
+				}
+			}
+			integer first, last;
+			IntervalTierIndex_getOverlappingIntervals (index, tmin, tmax, & first, & last);
+			if (expectedFirst == 0)
+				Melder_require (first > last,
+					U"Overlapping intervals: ", numberOfIntervals, U" intervals, (", tmin, U", ", tmax, U"): none expected, but found ", first, U" .. ", last, U".");
+			else
+				Melder_require (first == expectedFirst && last == expectedLast,
+					U"Overlapping intervals: ", numberOfIntervals, U" intervals, (", tmin, U", ", tmax, U"): expected ",
+					expectedFirst, U" .. ", expectedLast, U", but found ", first, U" .. ", last, U".");
+		}
+		/*
+			Change a text in place, as the Inspect window does.
+		*/
+		TextInterval changedInterval = tier -> intervals.at [NUMrandomInteger (1, numberOfIntervals)];
+		changedInterval -> text = Melder_dup (U"changed");
+		tier -> v_invalidateAllDerivedDataCaches ();
+		index = IntervalTier_getIndex (tier.get());
+		for (integer itext = 0; itext <= std::size (texts); itext ++) {
+			const conststring32 text = ( itext < std::size (texts) ? texts [itext] : U"changed" );
+			integer expectedCount = 0;
+			for (integer iinterval = 1; iinterval <= numberOfIntervals; iinterval ++)
+				if (Melder_equ (tier -> intervals.at [iinterval] -> text.get(), text))   // a null text counts as ""
+					expectedCount += 1;
+			integer count = IntervalTierIndex_getNumberOfIntervalsWithLabel (index, IntervalTierIndex_getLabelNumber (index, text));
+			if (text [0] == U'\0')
+				count += IntervalTierIndex_getNumberOfIntervalsWithLabel (index, IntervalTierIndex_getLabelNumber (index, nullptr));
+			Melder_require (count == expectedCount,
+				U"Label \"", text, U"\" in ", numberOfIntervals, U" intervals: expected ", expectedCount, U", but found ", count, U".");
+		}
+	}
+	MelderInfo_writeLine (U"interval tier index: OK");
+}
+
 int Praat_tests (kPraatTests itest, conststring32 arg1, conststring32 arg2, conststring32 arg3, conststring32 arg4) {
 	int64 n = Melder_atoi (arg1);
 	double t = 0.0;
@@ -491,6 +759,34 @@ int Praat_tests (kPraatTests itest, conststring32 arg1, conststring32 arg2, cons
 			MelderInfo_writeLine (sum, U" should be ", size1 * size2 * size3 * 30.0);
 			//Melder_require (NUMequal (result.get(), constantHH (size, size, size * 30.0).get()), U"...");
 		} break;
+		case kPraatTests::TIME_MATMUL_FAST: {
+			/*
+				Reproduces the speed measurements in _mul_fast_MAT_out (MAT.cpp),
+				for square matrices of size arg2, with arg3 one of X.Y, X'.Y, X.Y', X'.Y'.
+			*/
+			const integer size = Melder_atoi (arg2);
+			Melder_require (size >= 1,
+				U"The size should be positive.");
+			const bool transposeX = Melder_startsWith (arg3, U"X'");
+			const bool transposeY = Melder_endsWith (arg3, U"'");
+			autoMAT const x = randomGauss_MAT (size, size, 0.0, 1.0);
+			autoMAT const y = randomGauss_MAT (size, size, 0.0, 1.0);
+			autoMAT const result = raw_MAT (size, size);
+			constMATVU const x_all = ( transposeX ? x.transpose() : x.all() );
+			constMATVU const y_all = ( transposeY ? y.transpose() : y.all() );
+			MATVU const result_all = result.all();
+			Melder_stopwatch ();
+			for (integer iteration = 1; iteration <= n; iteration ++)
+				_mul_fast_MAT_out (result_all, x_all, y_all);
+			t = Melder_stopwatch () / (2.0 * double (size) * double (size) * double (size));
+			autoMAT const multithreaded = raw_MAT (size, size);
+			_mul_fast_multithreaded_MAT_out (multithreaded.all(), x_all, y_all);
+			Melder_require (NUMequal (multithreaded.get(), result.get()),
+				U"The multithreaded product should be identical to the single-threaded product.");
+			autoMAT const reference = mul_MAT (x_all, y_all);
+			reference.all()  -=  result.all();
+			MelderInfo_writeLine (U"Maximum deviation from pairwise summation: ", NUMextremum_u (reference.get()));
+		} break;
 		case kPraatTests::THING_AUTO: {
 			integer numberOfThingsBefore = theTotalNumberOfThings;
 			{
@@ -662,6 +958,15 @@ int Praat_tests (kPraatTests itest, conststring32 arg1, conststring32 arg2, cons
 		case kPraatTests::FILEINMEMORYMANAGER_IO: {
 			test_FileInMemoryManager_io ();
 		} break;
+		case kPraatTests::CHECK_BINARY_FLOATS: {
+			checkBinaryFloats ();
+		} break;
+		case kPraatTests::CHECK_FLOAT_SOUND_FILES: {
+			checkFloatSoundFiles ();
+		} break;
+		case kPraatTests::CHECK_INTERVAL_TIER_INDEX: {
+			checkIntervalTierIndex ();
+		} break;
 	}
 	MelderInfo_writeLine (Melder_single (n / t * 1e-9), U" Gflop/s");
 	MelderInfo_close ();
@@ -62,6 +62,10 @@ enums_begin (kPraatTests, 0)
 	enums_add (kPraatTests, 42, TIME_MATMUL, U"TimeMatMul")
 	enums_add (kPraatTests, 43, THING_AUTO, U"ThingAuto")
 	enums_add (kPraatTests, 44, FILEINMEMORYMANAGER_IO, U"FileInMemoryManager_io")
-enums_end (kPraatTests, 44, CHECK_RANDOM_1009_2009)
+	enums_add (kPraatTests, 45, TIME_MATMUL_FAST, U"TimeMatMulFast")
+	enums_add (kPraatTests, 46, CHECK_BINARY_FLOATS, U"CheckBinaryFloats")
+	enums_add (kPraatTests, 47, CHECK_FLOAT_SOUND_FILES, U"CheckFloatSoundFiles")
+	enums_add (kPraatTests, 48, CHECK_INTERVAL_TIER_INDEX, U"CheckIntervalTierIndex")
+enums_end (kPraatTests, 48, CHECK_RANDOM_1009_2009)
 
 /* End of file Praat_tests_enums.h */
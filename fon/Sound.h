@@ -348,5 +348,11 @@ Collection_define (SoundList, OrderedOf, Sound) {
 autoSound Sounds_concatenate (SoundList list, double overlapTime);
 void SoundList_play (SoundList me, Sound_PlayCallback playCallback, Thing playClosure);
 
+void Sounds_readFromSoundFiles (constSTRVEC const& filePaths, OrderedOf<structSound>* addTo);
+/*
+	Reads the sound files (as Sound_readFromSoundFile does) and adds the Sounds, named after the files, to `addTo`.
+	The files are decoded in parallel, but errors and warnings are those of reading the files one by one.
+*/
+
 /* End of file Sound.h */
 #endif
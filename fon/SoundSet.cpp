@@ -20,6 +20,16 @@
 
 Thing_implement (SoundSet, Ordered, 0);
 
+autoSoundSet SoundSet_readFromSoundFiles (constSTRVEC const& filePaths) {
+	try {
+		autoSoundSet me = SoundSet_create ();
+		Sounds_readFromSoundFiles (filePaths, me.get());
+		return me;
+	} catch (MelderError) {
+		Melder_throw (U"SoundSet not read from sound files.");
+	}
+}
+
 integer SoundSet_getMinimumNumberOfSamples (SoundSet me) {
 	integer result = INTEGER_MAX;
 	for (integer isound = 1; isound <= my size; isound ++)
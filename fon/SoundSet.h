@@ -28,6 +28,8 @@
 Collection_define (SoundSet, OrderedOf, Sound) {
 };
 
+autoSoundSet SoundSet_readFromSoundFiles (constSTRVEC const& filePaths);   // decoded in parallel
+
 integer SoundSet_getMinimumNumberOfSamples (SoundSet me);
 autoMAT SoundSet_getRandomizedPatterns (SoundSet me, integer numberOfPatterns, integer patternSize);
 void SoundSet_Table_getRandomizedPatterns (SoundSet me, Table thee, conststring32 columnName, integer numberOfPatterns, integer inputSize, integer outputSize,
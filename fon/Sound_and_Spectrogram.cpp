@@ -18,13 +18,14 @@
 
 #include "Sound_and_Spectrogram.h"
 #include "NUM2.h"
+#include "AnalysisCache.h"
 
 #include "enums_getText.h"
 #include "Sound_and_Spectrogram_enums.h"
 #include "enums_getValue.h"
 #include "Sound_and_Spectrogram_enums.h"
 
-autoSpectrogram Sound_to_Spectrogram (Sound me, double effectiveAnalysisWidth, double fmax,
+static autoSpectrogram Sound_to_Spectrogram_ (Sound me, double effectiveAnalysisWidth, double fmax,
 	double minimumTimeStep1, double minimumFreqStep1, kSound_to_Spectrogram_windowShape windowType,
 	double maximumTimeOversampling, double maximumFreqOversampling)
 {
@@ -187,6 +188,20 @@ autoSpectrogram Sound_to_Spectrogram (Sound me, double effectiveAnalysisWidth, d
 	}
 }
 
+autoSpectrogram Sound_to_Spectrogram (Sound me, double effectiveAnalysisWidth, double fmax,
+	double minimumTimeStep1, double minimumFreqStep1, kSound_to_Spectrogram_windowShape windowType,
+	double maximumTimeOversampling, double maximumFreqOversampling)
+{
+	const AnalysisCacheKey key = AnalysisCache_key (U"Spectrogram", me, { effectiveAnalysisWidth, fmax,
+			minimumTimeStep1, minimumFreqStep1, double (windowType), maximumTimeOversampling, maximumFreqOversampling });
+	if (autoDaata cached = AnalysisCache_fetch (key))
+		return cached.static_cast_move <structSpectrogram> ();
+	autoSpectrogram result = Sound_to_Spectrogram_ (me, effectiveAnalysisWidth, fmax,
+			minimumTimeStep1, minimumFreqStep1, windowType, maximumTimeOversampling, maximumFreqOversampling);
+	AnalysisCache_store (key, result.get());
+	return result;
+}
+
 autoSound Spectrogram_to_Sound (Spectrogram me, double fsamp) {
 	try {
 		const double dt = 1.0 / fsamp;
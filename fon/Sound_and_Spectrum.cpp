@@ -18,6 +18,7 @@
 
 #include "Sound_and_Spectrum.h"
 #include "NUM2.h"
+#include "MelderThread.h"
 
 autoSpectrum Sound_to_Spectrum (Sound me, bool fast) {
 	try {
@@ -159,23 +160,159 @@ autoSound Sound_filter_formula (Sound me, conststring32 formula, Interpreter int
 	}
 }
 
+/*
+	The gains that `bands` impose on a sound with `numberOfFourierSamples` (a power of two) samples,
+	in the layout of NUMfft_forward (), and multiplied by `scaling`.
+	The gains are computed by filtering a flat spectrum, so that they are exactly those of Spectrum_passHannBand/stopHannBand.
+*/
+static autoVEC getHannBandsGains (double samplingPeriod, integer numberOfFourierSamples,
+	std::initializer_list <SpectrumHannBand> bands, double scaling)
+{
+	const integer numberOfFrequencies = numberOfFourierSamples / 2 + 1;
+	autoSpectrum flat = Spectrum_create (0.5 / samplingPeriod, numberOfFrequencies);
+	flat -> dx = 1.0 / (samplingPeriod * numberOfFourierSamples);   // as in Sound_to_Spectrum ()
+	flat -> z.row (1)  <<=  1.0;
+	for (const SpectrumHannBand& band : bands) {
+		if (band.stop)
+			Spectrum_stopHannBand (flat.get(), band.fmin, band.fmax, band.smooth);
+		else
+			Spectrum_passHannBand (flat.get(), band.fmin, band.fmax, band.smooth);
+	}
+	const constVEC gain = flat -> z.row (1);
+	autoVEC result = raw_VEC (numberOfFourierSamples);
+	result [1] = gain [1] * scaling;
+	for (integer i = 2; i < numberOfFrequencies; i ++)
+		result [i + i - 2] = result [i + i - 1] = gain [i] * scaling;
+	result [numberOfFourierSamples] = gain [numberOfFrequencies] * scaling;
+	return result;
+}
+
+static void filterWholeChannels (Sound me, integer numberOfChannels, std::initializer_list <SpectrumHannBand> bands) {
+	const integer numberOfFourierSamples = Melder_iroundUpToPowerOfTwo (my nx);
+	autoVEC gains = getHannBandsGains (my dx, numberOfFourierSamples, bands, 1.0 / numberOfFourierSamples);
+	const integer numberOfThreads = MelderThread_getNumberOfThreadsToUse (numberOfChannels, 1);
+	autoMAT buffers = raw_MAT (numberOfThreads, numberOfFourierSamples);   // one per thread
+	std::vector <autoNUMfft_Table> fourierTables (integer_to_uinteger (numberOfThreads));   // one per thread, because a table contains workspace
+	for (autoNUMfft_Table& table : fourierTables)
+		NUMfft_Table_init (& table, numberOfFourierSamples);
+	MelderThread_runChunks (numberOfThreads, numberOfChannels, [&] (integer ithread, integer firstChannel, integer lastChannel) {
+		const VEC data = buffers.row (ithread);
+		autoNUMfft_Table& fourierTable = fourierTables [integer_to_uinteger (ithread - 1)];
+		for (integer ichan = firstChannel; ichan <= lastChannel; ichan ++) {
+			data.part (1, my nx)  <<=  my z.row (ichan);
+			data.part (my nx + 1, numberOfFourierSamples)  <<=  0.0;
+			NUMfft_forward (& fourierTable, data);
+			data  *=  gains.get();
+			NUMfft_backward (& fourierTable, data);
+			my z.row (ichan)  <<=  data.part (1, my nx);
+		}
+	});
+}
+
+/*
+	Overlap-save: the impulse response is truncated to `kernelLength` samples (centred around time zero),
+	and every block of `blockSize` = 4 * kernelLength samples yields blockSize - kernelLength output samples.
+	The output overwrites the input, so each block first saves the input samples that the next block still needs.
+*/
+static void filterChannelsInBlocks (Sound me, integer numberOfChannels, std::initializer_list <SpectrumHannBand> bands, integer kernelLength) {
+	const integer halfKernelLength = kernelLength / 2, blockSize = 4 * kernelLength, blockStep = blockSize - kernelLength;
+	/*
+		The impulse response, as a circular sequence of `kernelLength` samples.
+	*/
+	autoVEC kernel = getHannBandsGains (my dx, kernelLength, bands, 1.0 / kernelLength);
+	for (integer i = 3; i < kernelLength; i += 2)
+		kernel [i] = 0.0;   // the gains form a real spectrum
+	{
+		autoNUMfft_Table kernelTable;
+		NUMfft_Table_init (& kernelTable, kernelLength);
+		NUMfft_backward (& kernelTable, kernel.get());
+	}
+	/*
+		The transfer function of the truncated impulse response, at the resolution of the blocks.
+	*/
+	const integer numberOfThreads = MelderThread_getNumberOfThreadsToUse (numberOfChannels, 1);
+	std::vector <autoNUMfft_Table> fourierTables (integer_to_uinteger (numberOfThreads));   // one per thread, because a table contains workspace
+	for (autoNUMfft_Table& table : fourierTables)
+		NUMfft_Table_init (& table, blockSize);
+	autoVEC transfer = zero_VEC (blockSize);
+	transfer.part (1, halfKernelLength)  <<=  kernel.part (1, halfKernelLength);   // time 0 and the positive times
+	transfer.part (blockSize - halfKernelLength + 1, blockSize)  <<=  kernel.part (halfKernelLength + 1, kernelLength);   // the negative times
+	NUMfft_forward (& fourierTables [0], transfer.get());
+	transfer.get()  *=  1.0 / blockSize;
+
+	autoMAT buffers = raw_MAT (numberOfThreads, blockSize);   // one per thread
+	autoMAT savedInputs = raw_MAT (numberOfThreads, halfKernelLength);
+	MelderThread_runChunks (numberOfThreads, numberOfChannels, [&] (integer ithread, integer firstChannel, integer lastChannel) {
+		const VEC data = buffers.row (ithread), saved = savedInputs.row (ithread);
+		autoNUMfft_Table& fourierTable = fourierTables [integer_to_uinteger (ithread - 1)];
+		for (integer ichan = firstChannel; ichan <= lastChannel; ichan ++) {
+			const VEC channel = my z.row (ichan);
+			saved  <<=  0.0;   // the signal is zero before the start
+			for (integer firstSample = 1; firstSample <= my nx; firstSample += blockStep) {
+				/*
+					data [i] is the input at sample number firstSample - halfKernelLength + i - 1.
+				*/
+				const integer numberOfAvailableSamples = std::min (blockSize - halfKernelLength, my nx - firstSample + 1);
+				data.part (1, halfKernelLength)  <<=  saved;
+				data.part (halfKernelLength + 1, halfKernelLength + numberOfAvailableSamples)  <<=
+						channel.part (firstSample, firstSample + numberOfAvailableSamples - 1);
+				data.part (halfKernelLength + numberOfAvailableSamples + 1, blockSize)  <<=  0.0;
+				saved  <<=  data.part (blockStep + 1, blockStep + halfKernelLength);   // the input just before the next block
+				NUMfft_forward (& fourierTable, data);
+				data [1] *= transfer [1];
+				for (integer i = 2; i < blockSize; i += 2) {
+					const double re = data [i], im = data [i + 1];
+					data [i] = re * transfer [i] - im * transfer [i + 1];
+					data [i + 1] = re * transfer [i + 1] + im * transfer [i];
+				}
+				data [blockSize] *= transfer [blockSize];
+				NUMfft_backward (& fourierTable, data);
+				const integer numberOfOutputSamples = std::min (blockStep, my nx - firstSample + 1);
+				channel.part (firstSample, firstSample + numberOfOutputSamples - 1)  <<=
+						data.part (halfKernelLength + 1, halfKernelLength + numberOfOutputSamples);
+			}
+		}
+	});
+}
+
+void Sound_filterHannBands_inplace (Sound me, integer numberOfChannels, std::initializer_list <SpectrumHannBand> bands) {
+	Melder_assert (numberOfChannels >= 0 && numberOfChannels <= my ny);
+	if (numberOfChannels == 0 || bands.size () == 0)
+		return;
+	/*
+		The narrowest edge determines how long the impulse response is:
+		a Hann edge of half-width `smooth` makes it decay as 1 / (smooth * t)^3,
+		so that truncating it at 16 / smooth seconds on either side gives errors of the order of 1e-6 of the input amplitude
+		(1e-4 if an edge extends beyond 0 Hz or the Nyquist frequency, where the response gets a kink).
+		A sharp edge (smooth = 0), or a band so narrow that its two edges overlap, makes the response discontinuous;
+		its impulse response then decays too slowly to be truncated.
+	*/
+	const integer numberOfFourierSamples = Melder_iroundUpToPowerOfTwo (my nx);
+	const double nyquistFrequency = 0.5 / my dx;
+	double narrowestSmoothing = undefined;
+	for (const SpectrumHannBand& band : bands) {
+		const double fmax = ( band.fmax == 0.0 ? nyquistFrequency : band.fmax );   // as in Spectrum_passHannBand ()
+		const bool edgesOverlap = ( band.fmin > 0.0 && fmax < nyquistFrequency && band.fmin + band.smooth > fmax - band.smooth );
+		const double smoothing = ( edgesOverlap ? 0.0 : band.smooth );
+		if (isundef (narrowestSmoothing) || smoothing < narrowestSmoothing)
+			narrowestSmoothing = smoothing;
+	}
+	constexpr double kernelHalfDurationTimesSmoothing = 16.0;
+	const double kernelLength_real = ( narrowestSmoothing > 0.0 ? 2.0 * kernelHalfDurationTimesSmoothing / narrowestSmoothing / my dx : undefined );
+	if (isdefined (kernelLength_real) && 4.0 * kernelLength_real <= numberOfFourierSamples) {
+		const integer kernelLength = Melder_iroundUpToPowerOfTwo (Melder_iceiling (kernelLength_real));
+		if (4 * kernelLength <= numberOfFourierSamples) {
+			filterChannelsInBlocks (me, numberOfChannels, bands, kernelLength);
+			return;
+		}
+	}
+	filterWholeChannels (me, numberOfChannels, bands);
+}
+
 autoSound Sound_filter_passHannBand (Sound me, double fmin, double fmax, double smooth) {
 	try {
 		autoSound thee = Data_copy (me);
-		if (my ny == 1) {
-			autoSpectrum spec = Sound_to_Spectrum (me, true);
-			Spectrum_passHannBand (spec.get(), fmin, fmax, smooth);
-			autoSound him = Spectrum_to_Sound (spec.get());
-			thy z.row (1)  <<=  his z.row (1).part (1, thy nx);
-		} else {
-			for (integer ichan = 1; ichan <= my ny; ichan ++) {
-				autoSound channel = Sound_extractChannel (me, ichan);
-				autoSpectrum spec = Sound_to_Spectrum (channel.get(), true);
-				Spectrum_passHannBand (spec.get(), fmin, fmax, smooth);
-				autoSound him = Spectrum_to_Sound (spec.get());
-				thy z.row (ichan)  <<=  his z.row (1).part (1, thy nx);
-			}
-		}
+		Sound_filterHannBands_inplace (thee.get(), thy ny, { { false, fmin, fmax, smooth } });
 		return thee;
 	} catch (MelderError) {
 		Melder_throw (me, U": not filtered (pass Hann band).");
@@ -185,20 +322,7 @@ autoSound Sound_filter_passHannBand (Sound me, double fmin, double fmax, double
 autoSound Sound_filter_stopHannBand (Sound me, double fmin, double fmax, double smooth) {
 	try {
 		autoSound thee = Data_copy (me);
-		if (my ny == 1) {
-			autoSpectrum spec = Sound_to_Spectrum (me, true);
-			Spectrum_stopHannBand (spec.get(), fmin, fmax, smooth);
-			autoSound him = Spectrum_to_Sound (spec.get());
-			thy z.row (1)  <<=  his z.row (1).part (1, thy nx);
-		} else {
-			for (integer ichan = 1; ichan <= my ny; ichan ++) {
-				autoSound channel = Sound_extractChannel (me, ichan);
-				autoSpectrum spec = Sound_to_Spectrum (channel.get(), true);
-				Spectrum_stopHannBand (spec.get(), fmin, fmax, smooth);
-				autoSound him = Spectrum_to_Sound (spec.get());
-				thy z.row (ichan)  <<=  his z.row (1).part (1, thy nx);
-			}
-		}
+		Sound_filterHannBands_inplace (thee.get(), thy ny, { { true, fmin, fmax, smooth } });
 		return thee;
 	} catch (MelderError) {
 		Melder_throw (me, U": not filtered (stop Hann band).");
@@ -16,6 +16,9 @@
  * along with this work. If not, see <http://www.gnu.org/licenses/>.
  */
 
+#ifndef _Sound_and_Spectrum_h_
+#define _Sound_and_Spectrum_h_
+
 #include "Sound.h"
 #include "Spectrum.h"
 Thing_declare (Interpreter);
@@ -27,8 +30,25 @@ autoSound Spectrum_to_Sound (Spectrum me);
 
 autoSpectrum Spectrum_lpcSmoothing (Spectrum me, int numberOfPeaks, double preemphasisFrequency);
 
+/*
+	A pass band or stop band with Hann-shaped edges, as in Spectrum_passHannBand () and Spectrum_stopHannBand ().
+*/
+struct SpectrumHannBand {
+	bool stop;
+	double fmin, fmax, smooth;
+};
+/*
+	Filters channels 1 .. numberOfChannels of `me` in place with the product of the responses of `bands`,
+	with the same result as Sound_to_Spectrum (fast) + Spectrum_passHannBand/stopHannBand + Spectrum_to_Sound,
+	except near the edges of the sound and except for truncation of the impulse response,
+	which is longer than 32 / smooth seconds. Long sounds are filtered with overlap-save block convolution,
+	so that memory use does not grow with the duration. Channels are filtered in parallel.
+*/
+void Sound_filterHannBands_inplace (Sound me, integer numberOfChannels, std::initializer_list <SpectrumHannBand> bands);
+
 autoSound Sound_filter_passHannBand (Sound me, double fmin, double fmax, double smooth);
 autoSound Sound_filter_stopHannBand (Sound me, double fmin, double fmax, double smooth);
 autoSound Sound_filter_formula (Sound me, conststring32 formula, Interpreter interpreter);
 
 /* End of file Sound_and_Spectrum.h */
+#endif
@@ -63,25 +63,40 @@ static void Sound_alawDecode (Sound me) {
 */
 
 #include <time.h>
+#include <atomic>
 #include "Sound.h"
+#include "MelderThread.h"
+
+/*
+	Everything that precedes the decoding of the samples:
+	check the header, create a Sound of the right size, and go to the start of the samples.
+*/
+static autoSound Sound_createFromSoundFileHeader (MelderFile file, int *out_encoding, integer *out_startOfData) {
+	int encoding;
+	double sampleRate;
+	integer startOfData, numberOfSamples, numberOfChannels;
+	int fileType = MelderFile_checkSoundFile (file, & numberOfChannels, & encoding, & sampleRate, & startOfData, & numberOfSamples);
+	if (fileType == 0)
+		Melder_throw (U"Not an audio file.");
+	if (fseek (file -> filePointer, startOfData, SEEK_SET) == EOF)   // start from beginning of Data Chunk
+		Melder_throw (U"No data in audio file.");
+	if (numberOfSamples < 1)
+		Melder_throw (U"Audio file contains 0 samples.");
+	autoSound me = Sound_createSimple (numberOfChannels, numberOfSamples / sampleRate, sampleRate);
+	Melder_assert (my z.ncol == numberOfSamples);
+	if (encoding == Melder_SHORTEN || encoding == Melder_POLYPHONE)
+		Melder_throw (U"Cannot unshorten. Write to paul.boersma@uva.nl for more information.");
+	*out_encoding = encoding;
+	*out_startOfData = startOfData;
+	return me;
+}
 
 autoSound Sound_readFromSoundFile (MelderFile file) {
 	try {
 		autoMelderFile mfile = MelderFile_open (file);
 		int encoding;
-		double sampleRate;
-		integer startOfData, numberOfSamples, numberOfChannels;
-		int fileType = MelderFile_checkSoundFile (file, & numberOfChannels, & encoding, & sampleRate, & startOfData, & numberOfSamples);
-		if (fileType == 0)
-			Melder_throw (U"Not an audio file.");
-		if (fseek (file -> filePointer, startOfData, SEEK_SET) == EOF)   // start from beginning of Data Chunk
-			Melder_throw (U"No data in audio file.");
-		if (numberOfSamples < 1)
-			Melder_throw (U"Audio file contains 0 samples.");
-		autoSound me = Sound_createSimple (numberOfChannels, numberOfSamples / sampleRate, sampleRate);
-		Melder_assert (my z.ncol == numberOfSamples);
-		if (encoding == Melder_SHORTEN || encoding == Melder_POLYPHONE)
-			Melder_throw (U"Cannot unshorten. Write to paul.boersma@uva.nl for more information.");
+		integer startOfData;
+		autoSound me = Sound_createFromSoundFileHeader (file, & encoding, & startOfData);
 		Melder_readAudioToFloat (file -> filePointer, encoding, my z.get());
 		mfile.close ();
 		return me;
@@ -90,6 +105,106 @@ autoSound Sound_readFromSoundFile (MelderFile file) {
 	}
 }
 
+/*
+	Reading many sound files.
+	The headers are read, and the Sounds created, one file after another in the calling thread.
+	The samples, which take most of the time (especially for FLAC and MP3), are then decoded in parallel,
+	each worker thread taking the next file that no other thread has taken yet.
+	Worker threads cannot use Melder_fopen or issue warnings, so they open the files by a path
+	that was converted in advance, and a file that fails or would warn is simply marked;
+	such files are read again in the calling thread, which produces exactly the errors and warnings
+	of reading the files one by one, in the same order.
+*/
+struct SoundFileToDecode {
+	autoSound sound;
+	int encoding;
+	integer startOfData;
+	#if defined (_WIN32)
+		autostringW path;
+	#else
+		autostring8 path;
+	#endif
+	bool hasToBeReadAgain;
+};
+
+static void SoundFileToDecode_decode (SoundFileToDecode *me) {
+	#if defined (_WIN32)
+		FILE *f = _wfopen (my path.get(), L"rb");
+	#else
+		FILE *f = fopen (my path.get(), "rb");
+	#endif
+	if (! f) {
+		my hasToBeReadAgain = true;
+		return;
+	}
+	try {
+		if (fseek (f, my startOfData, SEEK_SET) == EOF || ! Melder_readAudioToFloat_quietly (f, my encoding, my sound -> z.get()))
+			my hasToBeReadAgain = true;
+	} catch (MelderError) {
+		Melder_clearError ();   // this is the error buffer of the worker thread
+		my hasToBeReadAgain = true;
+	}
+	fclose (f);
+}
+
+void Sounds_readFromSoundFiles (constSTRVEC const& filePaths, OrderedOf<structSound>* addTo) {
+	const integer numberOfFiles = filePaths.size;
+	std::vector <SoundFileToDecode> files (integer_to_uinteger (numberOfFiles));
+	integer numberOfFilesWithHeader = 0;
+	for (integer ifile = 1; ifile <= numberOfFiles; ifile ++) {
+		SoundFileToDecode& soundFile = files [integer_to_uinteger (ifile - 1)];
+		structMelderFile file { };
+		Melder_relativePathToFile (filePaths [ifile], & file);
+		try {
+			autoMelderFile mfile = MelderFile_open (& file);
+			soundFile.sound = Sound_createFromSoundFileHeader (& file, & soundFile.encoding, & soundFile.startOfData);
+			mfile.close ();
+		} catch (MelderError) {
+			Melder_clearError ();
+			break;   // the error will be reported below, unless an earlier file fails as well
+		}
+		#if defined (_WIN32)
+			soundFile.path = Melder_32toW_fileSystem (file. path);
+		#else
+			char utf8path [kMelder_MAXPATH+1];
+			Melder_32to8_fileSystem_inplace (file. path, utf8path);
+			soundFile.path = autostring8 (uinteger_to_integer (strlen (utf8path)));
+			strcpy (soundFile.path.get(), utf8path);
+		#endif
+		char32 name [300];
+		Melder_sprint (name,300, MelderFile_name (& file));
+		char32 *lastPeriod = str32rchr (name, U'.');
+		if (lastPeriod)
+			*lastPeriod = U'\0';
+		Thing_setName (soundFile.sound.get(), name);
+		numberOfFilesWithHeader = ifile;
+	}
+
+	std::atomic <integer> numberOfFilesTaken { 0 };
+	const integer numberOfThreads = MelderThread_getNumberOfThreadsToUse (numberOfFilesWithHeader, 2);
+	MelderThread_runChunks (numberOfThreads, numberOfThreads, [&] (integer, integer, integer) {
+		for (;;) {
+			const integer ifile = ++ numberOfFilesTaken;
+			if (ifile > numberOfFilesWithHeader)
+				break;
+			SoundFileToDecode_decode (& files [integer_to_uinteger (ifile - 1)]);
+		}
+	});
+
+	for (integer ifile = 1; ifile <= numberOfFiles; ifile ++) {
+		SoundFileToDecode& soundFile = files [integer_to_uinteger (ifile - 1)];
+		if (ifile > numberOfFilesWithHeader || soundFile.hasToBeReadAgain) {
+			structMelderFile file { };
+			Melder_relativePathToFile (filePaths [ifile], & file);
+			autoSound sound = Sound_readFromSoundFile (& file);   // throws the error, or issues the warning
+			Thing_setName (sound.get(), soundFile.sound ? soundFile.sound -> name.get() : MelderFile_name (& file));
+			soundFile.sound = sound.move();
+		}
+	}
+	for (integer ifile = 1; ifile <= numberOfFiles; ifile ++)
+		addTo -> addItem_move (files [integer_to_uinteger (ifile - 1)].sound.move());
+}
+
 autoSound Sound_readFromSesamFile (MelderFile file) {
 	try {
 		autofile f = Melder_fopen (file, "rb");
@@ -32,6 +32,7 @@
 #include "NUM2.h"
 #include "Polynomial.h"
 #include "Roots.h"
+#include "AnalysisCache.h"
 
 static void burg (constVEC samples, VEC coefficients,
 	Formant_Frame frame, double nyquistFrequency, double safetyMargin)
@@ -374,6 +375,10 @@ static autoFormant Sound_to_Formant_any_inplace (Sound me, double dt_in, integer
 autoFormant Sound_to_Formant_any (Sound me, double dt, integer numberOfPoles, double maximumFrequency,
 	double halfdt_window, int which, double preemphasisFrequency, double safetyMargin)
 {
+	const AnalysisCacheKey key = AnalysisCache_key (U"Formant", me, { dt, double (numberOfPoles), maximumFrequency,
+			halfdt_window, double (which), preemphasisFrequency, safetyMargin });
+	if (autoDaata cached = AnalysisCache_fetch (key))
+		return cached.static_cast_move <structFormant> ();
 	const double nyquist = 0.5 / my dx;
 	autoSound sound;
 	if (maximumFrequency <= 0.0 || fabs (maximumFrequency / nyquist - 1) < 1.0e-12) {
@@ -381,7 +386,9 @@ autoFormant Sound_to_Formant_any (Sound me, double dt, integer numberOfPoles, do
 	} else {
 		sound = Sound_resample (me, maximumFrequency * 2, 50);
 	}
-	return Sound_to_Formant_any_inplace (sound.get(), dt, numberOfPoles, halfdt_window, which, preemphasisFrequency, safetyMargin);
+	autoFormant result = Sound_to_Formant_any_inplace (sound.get(), dt, numberOfPoles, halfdt_window, which, preemphasisFrequency, safetyMargin);
+	AnalysisCache_store (key, result.get());
+	return result;
 }
 
 autoFormant Sound_to_Formant_burg (Sound me, double dt, double nFormants, double maximumFrequency, double halfdt_window, double preemphasisFrequency) {
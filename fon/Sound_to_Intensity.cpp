@@ -32,6 +32,8 @@
  */
 
 #include "Sound_to_Intensity.h"
+#include "MelderThread.h"
+#include "AnalysisCache.h"
 
 static autoIntensity Sound_to_Intensity_ (Sound me, double minimumPitch, double timeStep, bool subtractMeanPressure) {
 	try {
@@ -64,7 +66,6 @@ static autoIntensity Sound_to_Intensity_ (Sound me, double minimumPitch, double
 		const double halfWindowDuration = 0.5 * physicalWindowDuration;
 		const integer halfWindowSamples = Melder_ifloor (halfWindowDuration / my dx);
 		const integer windowNumberOfSamples = 2 * halfWindowSamples + 1;
-		autoVEC amplitude = zero_VEC (windowNumberOfSamples);
 		autoVEC window = zero_VEC (windowNumberOfSamples);
 		const integer windowCentreSampleNumber = halfWindowSamples + 1;
 
@@ -85,41 +86,69 @@ static autoIntensity Sound_to_Intensity_ (Sound me, double minimumPitch, double
 				U"i.e. at least ", physicalWindowDuration, U" s, instead of ", physicalSoundDuration, U" s.");
 		}
 		autoIntensity thee = Intensity_create (my xmin, my xmax, numberOfFrames, timeStep, thyFirstTime);
-		for (integer iframe = 1; iframe <= numberOfFrames; iframe ++) {
-			const double midTime = Sampled_indexToX (thee.get(), iframe);
-			const integer soundCentreSampleNumber = Sampled_xToNearestIndex (me, midTime);   // time accuracy is half a sampling period
+		/*
+			The frames are independent, so they are analysed in parallel.
+			Each frame reads its samples directly from the sound (there is no copy into a buffer)
+			and sums the windowed squares with pairwise summation in long double.
+			The terms are computed exactly as when we used to sum them sequentially in long double
+			(first the mean is subtracted, then the difference is squared and multiplied by the window, all in double),
+			so that only the order of summation differs.
+			All terms are non-negative, so with m = ny * n terms (n samples per channel)
+			and the unit roundoff e of longdouble, the sequential sums had a relative error of at most (m - 1) e,
+			and the new sums have one of at most (ceiling (log2 (n)) + ny) e
+			(pairwise within each channel, then sequentially over the channels, or times ny for sumw).
+			With the rounding of the division, the two mean squared pressures therefore differ relatively
+			by at most about 2 (m + log2 (n) + ny) e, before both are rounded to double.
+			For a mono sound with a window of 4000 samples (e.g. 75 Hz at 44.1 kHz) and an x87 longdouble (e = 2^-64),
+			this is 4.4e-16, i.e. at most five ulps in double after rounding (or 2e-15 dB);
+			where longdouble is double (e = 2^-53), the bound is 9e-13 (4e-12 dB).
+		*/
+		const integer numberOfThreads = MelderThread_getNumberOfThreadsToUse (numberOfFrames,
+				std::max (1_integer, 100'000 / windowNumberOfSamples));
+		MelderThread_runChunks (numberOfThreads, numberOfFrames, [&] (integer /* ithread */, integer firstFrame, integer lastFrame) {
+			for (integer iframe = firstFrame; iframe <= lastFrame; iframe ++) {
+				const double midTime = Sampled_indexToX (thee.get(), iframe);
+				const integer soundCentreSampleNumber = Sampled_xToNearestIndex (me, midTime);   // time accuracy is half a sampling period
 
-			integer leftSample = soundCentreSampleNumber - halfWindowSamples;
-			integer rightSample = soundCentreSampleNumber + halfWindowSamples;
-			/*
-				Catch some edge cases, which are uncommon because Sampled_shortTermAnalysis() filtered out most problems.
-			*/
-			Melder_clipLeft (1_integer, & leftSample);
-			Melder_clipRight (& rightSample, my nx);
-			Melder_require (rightSample >= leftSample,
-				U"Unexpected edge case: right sample (", rightSample, U") less than left sample (", leftSample, U").");
+				integer leftSample = soundCentreSampleNumber - halfWindowSamples;
+				integer rightSample = soundCentreSampleNumber + halfWindowSamples;
+				/*
+					Catch some edge cases, which are uncommon because Sampled_shortTermAnalysis() filtered out most problems.
+				*/
+				Melder_clipLeft (1_integer, & leftSample);
+				Melder_clipRight (& rightSample, my nx);
+				Melder_require (rightSample >= leftSample,
+					U"Unexpected edge case: right sample (", rightSample, U") less than left sample (", leftSample, U").");
 
-			const integer windowFromSoundOffset = windowCentreSampleNumber - soundCentreSampleNumber;
-			VEC amplitudePart = amplitude.part (windowFromSoundOffset + leftSample, windowFromSoundOffset + rightSample);
-			constVEC windowPart = window.part (windowFromSoundOffset + leftSample, windowFromSoundOffset + rightSample);
-			longdouble sumxw = 0.0, sumw = 0.0;
-			for (integer ichan = 1; ichan <= my ny; ichan ++) {
-				amplitudePart  <<=  my z [ichan].part (leftSample, rightSample);
-				if (subtractMeanPressure)
-					centre_VEC_inout (amplitudePart);
-				for (integer isamp = 1; isamp <= amplitudePart.size; isamp ++) {
-					sumxw += sqr (amplitudePart [isamp]) * windowPart [isamp];
-					sumw += windowPart [isamp];
+				const integer windowFromSoundOffset = windowCentreSampleNumber - soundCentreSampleNumber;
+				constVEC windowPart = window.part (windowFromSoundOffset + leftSample, windowFromSoundOffset + rightSample);
+				PAIRWISE_SUM (longdouble, sumw, integer, windowPart.size,
+					const double *w = & windowPart [1],
+					*w,
+					w += 1
+				)
+				sumw *= my ny;
+				longdouble sumxw = 0.0;
+				for (integer ichan = 1; ichan <= my ny; ichan ++) {
+					constVEC amplitudePart = my z [ichan].part (leftSample, rightSample);
+					const double mean = ( subtractMeanPressure ? NUMmean (amplitudePart) : 0.0 );
+					PAIRWISE_SUM (longdouble, channelSumxw, integer, amplitudePart.size,
+						const double *x = & amplitudePart [1];
+						const double *w = & windowPart [1],
+						sqr (*x - mean) * *w,
+						(x += 1, w += 1)
+					)
+					sumxw += channelSumxw;
 				}
+				const double intensity_in_Pa2 = double (sumxw / sumw);
+				constexpr double hearingThreshold_in_Pa = 2.0e-5;
+				constexpr double hearingThreshold_in_Pa2 = sqr (hearingThreshold_in_Pa);
+				const double intensity_re_hearingThreshold = intensity_in_Pa2 / hearingThreshold_in_Pa2;
+				const double intensity_in_dB_re_hearingThreshold = ( intensity_re_hearingThreshold < 1.0e-30 ? -300.0 :
+						10.0 * log10 (intensity_re_hearingThreshold) );
+				thy z [1] [iframe] = intensity_in_dB_re_hearingThreshold;
 			}
-			const double intensity_in_Pa2 = double (sumxw / sumw);
-			constexpr double hearingThreshold_in_Pa = 2.0e-5;
-			constexpr double hearingThreshold_in_Pa2 = sqr (hearingThreshold_in_Pa);
-			const double intensity_re_hearingThreshold = intensity_in_Pa2 / hearingThreshold_in_Pa2;
-			const double intensity_in_dB_re_hearingThreshold = ( intensity_re_hearingThreshold < 1.0e-30 ? -300.0 :
-					10.0 * log10 (intensity_re_hearingThreshold) );
-			thy z [1] [iframe] = intensity_in_dB_re_hearingThreshold;
-		}
+		});
 		return thee;
 	} catch (MelderError) {
 		Melder_throw (me, U": intensity analysis not performed.");
@@ -127,13 +156,19 @@ static autoIntensity Sound_to_Intensity_ (Sound me, double minimumPitch, double
 }
 
 autoIntensity Sound_to_Intensity (Sound me, double minimumPitch, double timeStep, bool subtractMeanPressure) {
+	const AnalysisCacheKey key = AnalysisCache_key (U"Intensity", me, { minimumPitch, timeStep, double (subtractMeanPressure) });
+	if (autoDaata cached = AnalysisCache_fetch (key))
+		return cached.static_cast_move <structIntensity> ();
+	autoIntensity result;
 	const bool veryAccurate = false;
 	if (veryAccurate) {
 		autoSound up = Sound_upsample (me);   // because squaring doubles the frequency content, i.e. you get super-Nyquist components
-		return Sound_to_Intensity_ (up.get(), minimumPitch, timeStep, subtractMeanPressure);
+		result = Sound_to_Intensity_ (up.get(), minimumPitch, timeStep, subtractMeanPressure);
 	} else {
-		return Sound_to_Intensity_ (me, minimumPitch, timeStep, subtractMeanPressure);
+		result = Sound_to_Intensity_ (me, minimumPitch, timeStep, subtractMeanPressure);
 	}
+	AnalysisCache_store (key, result.get());
+	return result;
 }
 
 autoIntensityTier Sound_to_IntensityTier (Sound me, double minimumPitch, double timeStep, bool subtractMean) {
@@ -35,6 +35,7 @@
 #include "Sound_to_Pitch.h"
 #include "NUM2.h"
 #include "MelderThread.h"
+#include "AnalysisCache.h"
 
 #define AC_HANNING  0
 #define AC_GAUSS  1
@@ -306,7 +307,7 @@ static void Sound_into_Pitch (Sound_into_Pitch_Args me)
 	}
 }
 
-autoPitch Sound_to_Pitch_any (Sound me,
+static autoPitch Sound_to_Pitch_any_ (Sound me,
 	double dt, double minimumPitch, double periodsPerWindow, integer maxnCandidates,
 	int method,
 	double silenceThreshold, double voicingThreshold,
@@ -546,6 +547,23 @@ autoPitch Sound_to_Pitch_any (Sound me,
 	}
 }
 
+autoPitch Sound_to_Pitch_any (Sound me,
+	double dt, double minimumPitch, double periodsPerWindow, integer maxnCandidates,
+	int method,
+	double silenceThreshold, double voicingThreshold,
+	double octaveCost, double octaveJumpCost, double voicedUnvoicedCost, double ceiling)
+{
+	const double effectiveTimeStep = ( dt > 0.0 ? dt : periodsPerWindow / minimumPitch / 4.0 );   // so that "0" and "0.01" share an entry
+	const AnalysisCacheKey key = AnalysisCache_key (U"Pitch", me, { effectiveTimeStep, minimumPitch, periodsPerWindow, double (maxnCandidates),
+			double (method), silenceThreshold, voicingThreshold, octaveCost, octaveJumpCost, voicedUnvoicedCost, ceiling });
+	if (autoDaata cached = AnalysisCache_fetch (key))
+		return cached.static_cast_move <structPitch> ();
+	autoPitch result = Sound_to_Pitch_any_ (me, dt, minimumPitch, periodsPerWindow, maxnCandidates, method,
+			silenceThreshold, voicingThreshold, octaveCost, octaveJumpCost, voicedUnvoicedCost, ceiling);
+	AnalysisCache_store (key, result.get());
+	return result;
+}
+
 autoPitch Sound_to_Pitch (Sound me, double timeStep, double minimumPitch, double maximumPitch) {
 	return Sound_to_Pitch_ac (me, timeStep, minimumPitch,
 		3.0, 15, false, 0.03, 0.45, 0.01, 0.35, 0.14, maximumPitch);
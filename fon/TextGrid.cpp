@@ -18,6 +18,7 @@
 
 #include "TextGrid.h"
 #include "../kar/longchar.h"
+#include "../kar/UnicodeData.h"
 
 #include "oo_DESTROY.h"
 #include "TextGrid_def.h"
@@ -39,6 +40,7 @@
 #include "TextGrid_def.h"
 
 #include "TextGrid_extensions.h"
+#include <unordered_map>
 
 Thing_implement (TextPoint, AnyPoint, 0);
 
@@ -108,6 +110,7 @@ void TextTier_addPoint (TextTier me, double time, conststring32 mark) {
 Thing_implement (IntervalTier, Function, 0);
 
 void structIntervalTier :: v_shiftX (double xfrom, double xto) {
+	IntervalTier_invalidateIndex (this);
 	IntervalTier_Parent :: v_shiftX (xfrom, xto);
 	for (integer i = 1; i <= our intervals.size; i ++) {
 		TextInterval interval = our intervals.at [i];
@@ -116,6 +119,7 @@ void structIntervalTier :: v_shiftX (double xfrom, double xto) {
 }
 
 void structIntervalTier :: v_scaleX (double xminfrom, double xmaxfrom, double xminto, double xmaxto) {
+	IntervalTier_invalidateIndex (this);
 	IntervalTier_Parent :: v_scaleX (xminfrom, xmaxfrom, xminto, xmaxto);
 	for (integer i = 1; i <= our intervals.size; i ++) {
 		TextInterval interval = our intervals.at [i];
@@ -136,6 +140,198 @@ autoIntervalTier IntervalTier_create (double tmin, double tmax) {
 	}
 }
 
+Thing_implement (IntervalTierIndex, Thing, 0);
+
+static autoIntervalTierIndex IntervalTierIndex_create (IntervalTier tier) {
+	try {
+		autoIntervalTierIndex me = Thing_new (IntervalTierIndex);
+		const integer numberOfIntervals = tier -> intervals.size;
+		my startTimes = raw_VEC (numberOfIntervals);
+		my endTimes = raw_VEC (numberOfIntervals);
+		my labelNumbers = raw_INTVEC (numberOfIntervals);
+		autoINTVEC numberOfIntervalsWithLabel;
+		integer numberOfLabels = 0;
+		std::unordered_map <std::u32string, integer> labelNumberOfText;   // only while numbering the labels
+		for (integer iinterval = 1; iinterval <= numberOfIntervals; iinterval ++) {
+			TextInterval interval = tier -> intervals.at [iinterval];
+			my startTimes [iinterval] = interval -> xmin;
+			my endTimes [iinterval] = interval -> xmax;
+			integer labelNumber;
+			if (! interval -> text) {
+				if (my labelNumberOfNull == 0) {
+					my labelNumberOfNull = ++ numberOfLabels;
+					my labels. insert (numberOfLabels, nullptr);
+					numberOfIntervalsWithLabel. insert (numberOfLabels, 0);
+				}
+				labelNumber = my labelNumberOfNull;
+			} else {
+				const auto [it, isNew] = labelNumberOfText. emplace (std::u32string (interval -> text.get()), numberOfLabels + 1);
+				if (isNew) {
+					numberOfLabels += 1;
+					my labels. insert (numberOfLabels, interval -> text.get());
+					numberOfIntervalsWithLabel. insert (numberOfLabels, 0);
+				}
+				labelNumber = it -> second;
+			}
+			my labelNumbers [iinterval] = labelNumber;
+			numberOfIntervalsWithLabel [labelNumber] += 1;
+		}
+		my labelNumbersInTextOrder = raw_INTVEC (numberOfLabels - ( my labelNumberOfNull != 0 ));
+		integer numberOfTexts = 0;
+		for (integer ilabel = 1; ilabel <= numberOfLabels; ilabel ++)
+			if (ilabel != my labelNumberOfNull)
+				my labelNumbersInTextOrder [++ numberOfTexts] = ilabel;
+		std::sort (my labelNumbersInTextOrder.begin(), my labelNumbersInTextOrder.end(),
+			[&] (integer ilabel, integer jlabel) {
+				return str32cmp (my labels [ilabel].get(), my labels [jlabel].get()) < 0;
+			}
+		);
+		/*
+			Counting sort of the interval numbers by label, which keeps them in time order within each label.
+		*/
+		my labelOffsets = raw_INTVEC (numberOfLabels + 1);
+		my labelOffsets [1] = 0;
+		for (integer ilabel = 1; ilabel <= numberOfLabels; ilabel ++)
+			my labelOffsets [ilabel + 1] = my labelOffsets [ilabel] + numberOfIntervalsWithLabel [ilabel];
+		my intervalNumbers = raw_INTVEC (numberOfIntervals);
+		autoINTVEC fillPosition = copy_INTVEC (my labelOffsets.part (1, numberOfLabels));
+		for (integer iinterval = 1; iinterval <= numberOfIntervals; iinterval ++)
+			my intervalNumbers [++ fillPosition [my labelNumbers [iinterval]]] = iinterval;
+		return me;
+	} catch (MelderError) {
+		Melder_throw (tier, U": index not created.");
+	}
+}
+
+IntervalTierIndex IntervalTier_getIndex (IntervalTier me) {
+	if (! my index || my index -> labelNumbers.size != my intervals.size)   // the size check is only a safety net
+		my index = IntervalTierIndex_create (me);
+	return my index.get();
+}
+
+void IntervalTier_invalidateIndex (IntervalTier me) {
+	my index. reset();
+}
+
+void TextGrid_invalidateIndexes (TextGrid me) {
+	for (integer itier = 1; itier <= my tiers->size; itier ++) {
+		Function anyTier = my tiers->at [itier];
+		if (anyTier -> classInfo == classIntervalTier)
+			IntervalTier_invalidateIndex (static_cast <IntervalTier> (anyTier));
+	}
+}
+
+void structIntervalTier :: v_invalidateAllDerivedDataCaches () {
+	IntervalTier_invalidateIndex (this);
+	IntervalTier_Parent :: v_invalidateAllDerivedDataCaches ();
+}
+
+void structTextGrid :: v_invalidateAllDerivedDataCaches () {
+	TextGrid_invalidateIndexes (this);
+	TextGrid_Parent :: v_invalidateAllDerivedDataCaches ();
+}
+
+integer IntervalTierIndex_getLabelNumber (IntervalTierIndex me, conststring32 text) {
+	if (! text)
+		return my labelNumberOfNull;
+	integer ileft = 1, iright = my labelNumbersInTextOrder.size;
+	while (ileft <= iright) {
+		const integer imid = (ileft + iright) / 2;
+		const integer labelNumber = my labelNumbersInTextOrder [imid];
+		const int comparison = str32cmp (text, my labels [labelNumber].get());
+		if (comparison == 0)
+			return labelNumber;
+		if (comparison < 0)
+			iright = imid - 1;
+		else
+			ileft = imid + 1;
+	}
+	return 0;
+}
+
+integer IntervalTierIndex_getNumberOfIntervalsWithLabel (IntervalTierIndex me, integer labelNumber) {
+	if (labelNumber == 0)
+		return 0;
+	return my labelOffsets [labelNumber + 1] - my labelOffsets [labelNumber];
+}
+
+autoBOOLVEC IntervalTierIndex_getLabelsWhere (IntervalTierIndex me, kMelder_string which, conststring32 criterion) {
+	autoBOOLVEC result = raw_BOOLVEC (my labels.size);
+	for (integer ilabel = 1; ilabel <= my labels.size; ilabel ++)
+		result [ilabel] = Melder_stringMatchesCriterion (my labels [ilabel].get(), which, criterion, true);
+	return result;
+}
+
+/*
+	The following three functions do exactly what IntervalTier_timeToLowIndex, IntervalTier_timeToIndex
+	and IntervalTier_timeToHighIndex do, but without visiting the TextInterval objects.
+*/
+integer IntervalTierIndex_timeToLowIndex (IntervalTierIndex me, double t) {
+	integer ileft = 1, iright = my endTimes.size;
+	if (iright < 1)
+		return 0;   // empty tier
+	if (t < my startTimes [ileft])
+		return 0;   // very small t
+	if (t >= my endTimes [iright])
+		return 0;   // very large t
+	while (ileft < iright) {
+		const integer imid = (ileft + iright) / 2;
+		if (t >= my endTimes [imid])
+			ileft = imid + 1;
+		else
+			iright = imid;
+	}
+	return ileft;
+}
+
+integer IntervalTierIndex_timeToIndex (IntervalTierIndex me, double t) {
+	integer ileft = 1, iright = my endTimes.size;
+	if (iright < 1)
+		return 0;   // empty tier
+	if (t < my startTimes [ileft])
+		return 0;   // very small t
+	if (t > my endTimes [iright])
+		return 0;   // very large t
+	while (ileft < iright) {
+		const integer imid = (ileft + iright) / 2;
+		if (t >= my endTimes [imid])
+			ileft = imid + 1;
+		else
+			iright = imid;
+	}
+	return ileft;
+}
+
+integer IntervalTierIndex_timeToHighIndex (IntervalTierIndex me, double t) {
+	integer ileft = 1, iright = my endTimes.size;
+	if (iright < 1)
+		return 0;   // empty tier
+	if (t <= my startTimes [ileft])
+		return 0;   // very small t
+	if (t > my endTimes [iright])
+		return 0;   // very large t
+	while (ileft < iright) {
+		const integer imid = (ileft + iright) / 2;
+		if (t > my endTimes [imid])
+			ileft = imid + 1;
+		else
+			iright = imid;
+	}
+	return ileft;
+}
+
+void IntervalTierIndex_getOverlappingIntervals (IntervalTierIndex me, double tmin, double tmax,
+	integer *out_firstIntervalNumber, integer *out_lastIntervalNumber)
+{
+	/*
+		The intervals that overlap (tmin, tmax) are those with an end time above tmin and a starting time below tmax.
+	*/
+	const integer numberOfIntervals = my endTimes.size;
+	const double *endTimes = & my endTimes [1], *startTimes = & my startTimes [1];
+	*out_firstIntervalNumber = 1 + (std::upper_bound (endTimes, endTimes + numberOfIntervals, tmin) - endTimes);
+	*out_lastIntervalNumber = std::lower_bound (startTimes, startTimes + numberOfIntervals, tmax) - startTimes;
+}
+
 integer IntervalTier_timeToLowIndex (IntervalTier me, double t) {
 	integer ileft = 1, iright = my intervals.size;
 	if (iright < 1)
@@ -442,11 +638,9 @@ integer TextGrid_countLabels (TextGrid me, integer tierNumber, conststring32 tex
 		integer count = 0;
 		if (anyTier -> classInfo == classIntervalTier) {
 			IntervalTier tier = static_cast <IntervalTier> (anyTier);
-			for (integer i = 1; i <= tier -> intervals.size; i ++) {
-				TextInterval segment = tier -> intervals.at [i];
-				if (segment -> text && str32equ (segment -> text.get(), text))
-					count ++;
-			}
+			IntervalTierIndex index = IntervalTier_getIndex (tier);
+			if (text)   // intervals without text are not counted, not even if `text` is null
+				count = IntervalTierIndex_getNumberOfIntervalsWithLabel (index, IntervalTierIndex_getLabelNumber (index, text));
 		} else {
 			TextTier tier = static_cast <TextTier> (anyTier);
 			for (integer i = 1; i <= tier -> points.size; i ++) {
@@ -465,11 +659,11 @@ integer TextGrid_countIntervalsWhere (TextGrid me, integer tierNumber, kMelder_s
 	try {
 		integer count = 0;
 		IntervalTier tier = TextGrid_checkSpecifiedTierIsIntervalTier (me, tierNumber);
-		for (integer iinterval = 1; iinterval <= tier -> intervals.size; iinterval ++) {
-			TextInterval interval = tier -> intervals.at [iinterval];
-			if (Melder_stringMatchesCriterion (interval -> text.get(), which, criterion, true))
-				count ++;
-		}
+		IntervalTierIndex index = IntervalTier_getIndex (tier);
+		autoBOOLVEC labelMatches = IntervalTierIndex_getLabelsWhere (index, which, criterion);
+		for (integer ilabel = 1; ilabel <= labelMatches.size; ilabel ++)
+			if (labelMatches [ilabel])
+				count += IntervalTierIndex_getNumberOfIntervalsWithLabel (index, ilabel);
 		return count;
 	} catch (MelderError) {
 		Melder_throw (me, U": intervals not counted.");
@@ -694,11 +888,11 @@ autoPointProcess TextGrid_getStartingPoints (TextGrid me, integer tierNumber, kM
 	try {
 		IntervalTier tier = TextGrid_checkSpecifiedTierIsIntervalTier (me, tierNumber);
 		autoPointProcess thee = PointProcess_create (my xmin, my xmax, 10);
-		for (integer iinterval = 1; iinterval <= tier -> intervals.size; iinterval ++) {
-			TextInterval interval = tier -> intervals.at [iinterval];
-			if (Melder_stringMatchesCriterion (interval -> text.get(), which, criterion, true))
-				PointProcess_addPoint (thee.get(), interval -> xmin);
-		}
+		IntervalTierIndex index = IntervalTier_getIndex (tier);
+		autoBOOLVEC labelMatches = IntervalTierIndex_getLabelsWhere (index, which, criterion);
+		for (integer iinterval = 1; iinterval <= tier -> intervals.size; iinterval ++)
+			if (labelMatches [index -> labelNumbers [iinterval]])
+				PointProcess_addPoint (thee.get(), index -> startTimes [iinterval]);
 		return thee;
 	} catch (MelderError) {
 		Melder_throw (me, U": starting points not converted to PointProcess.");
@@ -709,11 +903,11 @@ autoPointProcess TextGrid_getEndPoints (TextGrid me, integer tierNumber, kMelder
 	try {
 		IntervalTier tier = TextGrid_checkSpecifiedTierIsIntervalTier (me, tierNumber);
 		autoPointProcess thee = PointProcess_create (my xmin, my xmax, 10);
-		for (integer iinterval = 1; iinterval <= tier -> intervals.size; iinterval ++) {
-			TextInterval interval = tier -> intervals.at [iinterval];
-			if (Melder_stringMatchesCriterion (interval -> text.get(), which, criterion, true))
-				PointProcess_addPoint (thee.get(), interval -> xmax);
-		}
+		IntervalTierIndex index = IntervalTier_getIndex (tier);
+		autoBOOLVEC labelMatches = IntervalTierIndex_getLabelsWhere (index, which, criterion);
+		for (integer iinterval = 1; iinterval <= tier -> intervals.size; iinterval ++)
+			if (labelMatches [index -> labelNumbers [iinterval]])
+				PointProcess_addPoint (thee.get(), index -> endTimes [iinterval]);
 		return thee;
 	} catch (MelderError) {
 		Melder_throw (me, U": end points not converted to PointProcess.");
@@ -724,11 +918,11 @@ autoPointProcess TextGrid_getCentrePoints (TextGrid me, integer tierNumber, kMel
 	try {
 		IntervalTier tier = TextGrid_checkSpecifiedTierIsIntervalTier (me, tierNumber);
 		autoPointProcess thee = PointProcess_create (my xmin, my xmax, 10);
-		for (integer iinterval = 1; iinterval <= tier -> intervals.size; iinterval ++) {
-			TextInterval interval = tier -> intervals.at [iinterval];
-			if (Melder_stringMatchesCriterion (interval -> text.get(), which, criterion, true))
-				PointProcess_addPoint (thee.get(), 0.5 * (interval -> xmin + interval -> xmax));
-		}
+		IntervalTierIndex index = IntervalTier_getIndex (tier);
+		autoBOOLVEC labelMatches = IntervalTierIndex_getLabelsWhere (index, which, criterion);
+		for (integer iinterval = 1; iinterval <= tier -> intervals.size; iinterval ++)
+			if (labelMatches [index -> labelNumbers [iinterval]])
+				PointProcess_addPoint (thee.get(), 0.5 * (index -> startTimes [iinterval] + index -> endTimes [iinterval]));
 		return thee;
 	} catch (MelderError) {
 		Melder_throw (me, U": centre points not converted to PointProcess.");
@@ -1056,6 +1250,7 @@ static void genericize (autostring32& stringRef, mutablestring32 buffer) {
 void TextGrid_convertToBackslashTrigraphs (TextGrid me) {
 	try {
 		autostring32 buffer (TextGrid_maximumLabelLength (me) * 3);   // OPTIMIZE: use only one allocation if more are not necessary
+		TextGrid_invalidateIndexes (me);
 		for (integer itier = 1; itier <= my tiers->size; itier ++) {
 			Function anyTier = my tiers->at [itier];
 			if (anyTier -> classInfo == classIntervalTier) {
@@ -1080,6 +1275,7 @@ void TextGrid_convertToBackslashTrigraphs (TextGrid me) {
 void TextGrid_convertToUnicode (TextGrid me) {
 	try {
 		autostring32 buffer (TextGrid_maximumLabelLength (me));
+		TextGrid_invalidateIndexes (me);
 		for (integer itier = 1; itier <= my tiers->size; itier ++) {
 			Function anyTier = my tiers->at [itier];
 			if (anyTier -> classInfo == classIntervalTier) {
@@ -1116,6 +1312,7 @@ void TextPoint_removeText (TextPoint me) {
 }
 
 void IntervalTier_removeText (IntervalTier me) {
+	IntervalTier_invalidateIndex (me);
 	integer numberOfIntervals = my intervals.size;
 	for (integer iinterval = 1; iinterval <= numberOfIntervals; iinterval ++)
 		TextInterval_removeText (my intervals.at [iinterval]);
@@ -1139,6 +1336,7 @@ void TextGrid_insertBoundary (TextGrid me, integer tierNumber, double t) {
 		if (intervalNumber == 0)
 			Melder_throw (U"Cannot add a boundary at ", Melder_fixed (t, 6), U" seconds, because this is outside the time domain of the intervals.");
 		TextInterval interval = intervalTier -> intervals.at [intervalNumber];
+		IntervalTier_invalidateIndex (intervalTier);
 		/*
 			Move the text to the left of the boundary.
 		*/
@@ -1156,6 +1354,7 @@ void IntervalTier_removeLeftBoundary (IntervalTier me, integer intervalNumber) {
 		Melder_assert (intervalNumber <= my intervals.size);
 		TextInterval left = my intervals.at [intervalNumber - 1];
 		TextInterval right = my intervals.at [intervalNumber];
+		IntervalTier_invalidateIndex (me);
 		/*
 			Move the text to the left of the boundary.
 		*/
@@ -1195,6 +1394,7 @@ void TextGrid_setIntervalText (TextGrid me, integer tierNumber, integer interval
 		if (intervalNumber < 1 || intervalNumber > intervalTier -> intervals.size)
 			Melder_throw (U"Interval ", intervalNumber, U" does not exist on tier ", tierNumber, U".");
 		TextInterval interval = intervalTier -> intervals.at [intervalNumber];
+		IntervalTier_invalidateIndex (intervalTier);
 		TextInterval_setText (interval, text);
 	} catch (MelderError) {
 		Melder_throw (me, U": interval text not set.");
@@ -1302,6 +1502,249 @@ static void sgmlToPraat (char *text) {
 	*praat = '\0';
 }
 
+/*
+	Fast reading of the intervals and points of tiers in text files.
+
+	Most of the time needed for reading a TextGrid text file goes into the intervals or points of its tiers,
+	of which TextGrids from forced aligners can have hundreds of thousands.
+	The generic code (oo_COLLECTION_OF in oo_READ_TEXT.h) reads every number and string
+	character by character with MelderReadText_getChar (), decoding UTF-8 on the fly,
+	and composes every string in a MelderString before duplicating it.
+	The tokenizer below works directly on the UTF-8 or UTF-32 buffer of the MelderReadText.
+	It accepts the syntax of texgetinteger (), texgetr64 () and texgetw16 () in abcio.cpp,
+	i.e. both the long text format, with its labels ("xmin =", "intervals [1]:") and comments,
+	and the short text format. Anything it is not sure about
+	(fractions, non-ASCII characters outside strings, other encodings, syntax errors)
+	makes it give up and restore the read position, after which the generic code reads the tier again,
+	so that the usual error messages (with line numbers) are generated.
+*/
+
+static inline char32 fastText_char (char kar) { return (char32) (char8) kar; }
+static inline char32 fastText_char (char32 kar) { return kar; }
+
+static inline char32 fastText_decode (char **p) {   // as MelderReadText_getChar () for valid UTF-8
+	const char32 kar1 = (char32) (char8) * (*p) ++;
+	if (kar1 <= 0x00'007F)
+		return kar1;
+	if (kar1 <= 0x00'00DF) {
+		const char32 kar2 = (char32) (char8) * (*p) ++;
+		return ((kar1 & 0x00'001F) << 6) | (kar2 & 0x00'003F);
+	}
+	if (kar1 <= 0x00'00EF) {
+		const char32 kar2 = (char32) (char8) * (*p) ++;
+		const char32 kar3 = (char32) (char8) * (*p) ++;
+		return ((kar1 & 0x00'000F) << 12) | ((kar2 & 0x00'003F) << 6) | (kar3 & 0x00'003F);
+	}
+	if (kar1 <= 0x00'00F4) {
+		const char32 kar2 = (char32) (char8) * (*p) ++;
+		const char32 kar3 = (char32) (char8) * (*p) ++;
+		const char32 kar4 = (char32) (char8) * (*p) ++;
+		return ((kar1 & 0x00'0007) << 18) | ((kar2 & 0x00'003F) << 12) | ((kar3 & 0x00'003F) << 6) | (kar4 & 0x00'003F);
+	}
+	return UNICODE_REPLACEMENT_CHARACTER;
+}
+static inline char32 fastText_decode (char32 **p) { return * (*p) ++; }
+
+static inline bool fastText_isFirstByteOfCharacter (char kar) { return ((char8) kar & 0xC0) != 0x80; }
+static inline bool fastText_isFirstByteOfCharacter (char32 /* kar */) { return true; }
+
+/*
+	Skips labels, comments and white space, up to the first character of the next number
+	(if `lookingForString` is false) or to the opening quote of the next string (if `lookingForString` is true).
+*/
+template <typename CHAR>
+static bool fastText_skipToToken (CHAR **inout_p, bool lookingForString) {
+	CHAR *p = *inout_p;
+	for (;;) {
+		char32 kar = fastText_char (*p);
+		const bool isStartOfNumber = ( kar == U'-' || kar == U'+' || Melder_isAsciiDecimalNumber (kar) );
+		if (lookingForString ? kar == U'\"' : isStartOfNumber) {
+			*inout_p = p;
+			return true;
+		}
+		if (kar == U'\0' || kar > 127 || kar == U'<' || (lookingForString ? isStartOfNumber : kar == U'\"'))
+			return false;
+		if (kar == U'!') {   // end-of-line comment
+			do {
+				kar = fastText_char (* ++ p);
+				if (kar == U'\0')
+					return false;
+			} while (kar != U'\n' && kar != U'\r');
+		} else {
+			while (! Melder_isAsciiHorizontalOrVerticalSpace (kar)) {   // skip the rest of the label
+				kar = fastText_char (* ++ p);
+				if (kar == U'\0' || kar > 127)
+					return false;
+			}
+		}
+		p ++;   // skip the white space that ends the label or comment
+	}
+}
+
+/*
+	Copies the next number into `buffer`, as getInteger () and getReal () in abcio.cpp do.
+*/
+template <typename CHAR>
+static bool fastText_getNumber (CHAR **inout_p, char buffer [41]) {
+	CHAR *p = *inout_p;
+	if (! fastText_skipToToken (& p, false))
+		return false;
+	integer length = 0;
+	for (;;) {
+		const char32 kar = fastText_char (*p);
+		if (kar == U'\0')
+			break;   // the number is the last thing in the text
+		if (Melder_isAsciiHorizontalOrVerticalSpace (kar)) {
+			p ++;
+			break;
+		}
+		if (kar > 127 || kar == U'/' || length >= 40)
+			return false;
+		buffer [length ++] = (char) kar;
+		p ++;
+	}
+	if (length == 1 && buffer [0] == '+')
+		return false;
+	buffer [length] = '\0';
+	*inout_p = p;
+	return true;
+}
+
+/*
+	Reads the next string, as texgetw16 () does: in two passes,
+	the first of which counts the characters, so that the string can be allocated only once.
+*/
+template <typename CHAR>
+static bool fastText_getString (CHAR **inout_p, autostring32 *out_string) {
+	CHAR *p = *inout_p;
+	if (! fastText_skipToToken (& p, true))
+		return false;
+	p ++;   // skip the opening quote
+	integer length = 0;
+	CHAR *closingQuote = p;
+	for (;; closingQuote ++) {
+		const char32 kar = fastText_char (*closingQuote);
+		if (kar == U'\0')
+			return false;
+		if (kar == U'\"') {
+			if (fastText_char (closingQuote [1]) != U'\"')
+				break;
+			closingQuote ++;   // a doubled quote stands for a single quote
+		}
+		if (fastText_isFirstByteOfCharacter (*closingQuote))
+			length ++;
+	}
+	const char32 next = fastText_char (closingQuote [1]);
+	if (next != U'\0' && (next > 127 || ! Melder_isAsciiHorizontalOrVerticalSpace (next)))
+		return false;
+	autostring32 string (length);
+	char32 *to = & string [0];
+	while (p < closingQuote) {
+		if (fastText_char (*p) == U'\"') {
+			* to ++ = U'\"';
+			p += 2;
+		} else {
+			* to ++ = fastText_decode (& p);
+		}
+	}
+	Melder_assert (to - & string [0] == length);
+	*to = U'\0';
+	*out_string = string.move();
+	*inout_p = closingQuote + ( next == U'\0' ? 1 : 2 );
+	return true;
+}
+
+/*
+	Reads the size of a collection, and checks that the text is long enough
+	to contain that many items of at least `minimumNumberOfCharactersPerItem` characters each,
+	so that the collection can safely be allocated in one go.
+*/
+template <typename CHAR>
+static bool fastText_getSize (CHAR **inout_p, integer minimumNumberOfCharactersPerItem, integer *out_size) {
+	char buffer [41];
+	if (! fastText_getNumber (inout_p, buffer))
+		return false;
+	const int64 size = strtoll (buffer, nullptr, 10);
+	if (size < 0 || size > INT32_MAX)
+		return false;
+	const CHAR *p = *inout_p;
+	for (int64 i = 0; i < size * minimumNumberOfCharactersPerItem; i ++)
+		if (p [i] == 0)
+			return false;
+	*out_size = (integer) size;
+	return true;
+}
+
+template <typename CHAR>
+static bool fastText_readIntervals (IntervalTier me, CHAR **inout_p) {
+	CHAR *p = *inout_p;
+	integer numberOfIntervals;
+	if (! fastText_getSize (& p, 6, & numberOfIntervals))   // at least "0 1 \"\""
+		return false;
+	my intervals._grow (numberOfIntervals);
+	char buffer [41];
+	for (integer iinterval = 1; iinterval <= numberOfIntervals; iinterval ++) {
+		autoTextInterval interval = Thing_new (TextInterval);
+		if (! fastText_getNumber (& p, buffer))
+			return false;
+		interval -> xmin = Melder_a8tof (buffer);
+		if (! fastText_getNumber (& p, buffer))
+			return false;
+		interval -> xmax = Melder_a8tof (buffer);
+		if (interval -> xmin > interval -> xmax)
+			return false;
+		if (! fastText_getString (& p, & interval -> text))
+			return false;
+		my intervals. addItem_move (interval.move());
+	}
+	*inout_p = p;
+	return true;
+}
+
+template <typename CHAR>
+static bool fastText_readPoints (TextTier me, CHAR **inout_p) {
+	CHAR *p = *inout_p;
+	integer numberOfPoints;
+	if (! fastText_getSize (& p, 4, & numberOfPoints))   // at least "0 \"\""
+		return false;
+	my points._grow (numberOfPoints);
+	char buffer [41];
+	for (integer ipoint = 1; ipoint <= numberOfPoints; ipoint ++) {
+		autoTextPoint point = Thing_new (TextPoint);
+		if (! fastText_getNumber (& p, buffer))
+			return false;
+		point -> number = Melder_a8tof (buffer);
+		if (! fastText_getString (& p, & point -> mark))
+			return false;
+		my points. addItem_move (point.move());
+	}
+	*inout_p = p;
+	return true;
+}
+
+template <typename Reader>
+static bool fastText_read (MelderReadText text, Reader const& read) {
+	if (text -> string32)
+		return read (& text -> readPointer32);
+	if (text -> input8Encoding == kMelder_textInputEncoding::UTF8)
+		return read (& text -> readPointer8);
+	return false;   // other 8-bit encodings are left to MelderReadText_getChar ()
+}
+
+bool IntervalTier_readIntervalsFromText (IntervalTier me, MelderReadText text) {
+	const bool ok = fastText_read (text, [&] (auto readPointer) { return fastText_readIntervals (me, readPointer); });
+	if (! ok)
+		my intervals. removeAllItems ();
+	return ok;
+}
+
+bool TextTier_readPointsFromText (TextTier me, MelderReadText text) {
+	const bool ok = fastText_read (text, [&] (auto readPointer) { return fastText_readPoints (me, readPointer); });
+	if (! ok)
+		my points. removeAllItems ();
+	return ok;
+}
+
 autoTextGrid TextGrid_readFromChronologicalTextFile (MelderFile file) {
 	try {
 		int formatVersion = 0;
@@ -1792,6 +2235,7 @@ void TextGrid_list (TextGrid me, bool includeLineNumbers, integer timeDecimals,
 }
 
 void TextGrid_correctRoundingErrors (TextGrid me) {
+	TextGrid_invalidateIndexes (me);
 	for (integer itier = 1; itier <= my tiers->size; itier ++) {
 		Function anyTier = my tiers->at [itier];
 		if (anyTier -> classInfo == classIntervalTier) {
@@ -27,6 +27,25 @@
 Collection_define (FunctionList, OrderedOf, Function) {
 };
 
+/*
+	An index on an IntervalTier, for scripts and navigators that query the same tier many times.
+	It is built on first use (by IntervalTier_getIndex) and thrown away by IntervalTier_invalidateIndex,
+	which every function that changes the times or texts of an existing tier should call.
+	The labels are numbered in order of first appearance, so that a criterion has to be checked
+	only once per distinct label instead of once per interval.
+	Because the intervals of a tier partition its time domain, time and overlap queries need no interval tree:
+	a binary search in the contiguous arrays of starting and end times suffices.
+*/
+Thing_define (IntervalTierIndex, Thing) {
+	autoVEC startTimes, endTimes;   // one per interval
+	autoINTVEC labelNumbers;   // one per interval: the number of its text in `labels`
+	autoSTRVEC labels;   // the distinct texts; null for intervals without text
+	autoINTVEC labelOffsets;   // the intervals with label `ilabel` are intervalNumbers [labelOffsets [ilabel] + 1 .. labelOffsets [ilabel + 1]]
+	autoINTVEC intervalNumbers;   // grouped by label, in time order within each label
+	autoINTVEC labelNumbersInTextOrder;   // the numbers of the labels that are not null, sorted by their texts, for a binary search
+	integer labelNumberOfNull;   // 0 if every interval has a text
+};
+
 #include "TextGrid_def.h"
 
 autoTextPoint TextPoint_create (double time, conststring32 mark);
@@ -47,6 +66,27 @@ autoIntervalTier IntervalTier_create (double tmin, double tmax);
 autoIntervalTier IntervalTier_readFromXwaves (MelderFile file);
 void IntervalTier_writeToXwaves (IntervalTier me, MelderFile file);
 
+/*
+	Fast readers for the bulk of a tier in a text file, used by the reading code generated from TextGrid_def.h.
+	They return false if they are not sure they can read the text correctly;
+	the read position is then unchanged, and the tier should be read by the generic code.
+*/
+bool IntervalTier_readIntervalsFromText (IntervalTier me, MelderReadText text);
+bool TextTier_readPointsFromText (TextTier me, MelderReadText text);
+
+IntervalTierIndex IntervalTier_getIndex (IntervalTier me);   // builds the index if necessary
+void IntervalTier_invalidateIndex (IntervalTier me);
+void TextGrid_invalidateIndexes (TextGrid me);
+
+integer IntervalTierIndex_getLabelNumber (IntervalTierIndex me, conststring32 text);   // 0 if no interval has exactly this text
+integer IntervalTierIndex_getNumberOfIntervalsWithLabel (IntervalTierIndex me, integer labelNumber);
+autoBOOLVEC IntervalTierIndex_getLabelsWhere (IntervalTierIndex me, kMelder_string which, conststring32 criterion);
+integer IntervalTierIndex_timeToLowIndex (IntervalTierIndex me, double t);   // as IntervalTier_timeToLowIndex
+integer IntervalTierIndex_timeToIndex (IntervalTierIndex me, double t);
+integer IntervalTierIndex_timeToHighIndex (IntervalTierIndex me, double t);
+void IntervalTierIndex_getOverlappingIntervals (IntervalTierIndex me, double tmin, double tmax,
+	integer *out_firstIntervalNumber, integer *out_lastIntervalNumber);   // none if first > last
+
 integer IntervalTier_timeToLowIndex (IntervalTier me, double t);
 integer IntervalTier_timeToIndex (IntervalTier me, double t);   // obsolete
 integer IntervalTier_timeToHighIndex (IntervalTier me, double t);
@@ -47,6 +47,7 @@ static void IntervalTier_insertIntervalDestructively (IntervalTier me, double tm
 	Melder_assert (tmin < tmax);
 	Melder_assert (tmin >= my xmin);
 	Melder_assert (tmax <= my xmax);
+	IntervalTier_invalidateIndex (me);
 	/*
 	 * Make sure that the tier has boundaries at the edges of the interval.
 	 */
@@ -148,6 +149,7 @@ void TextGrid_anySound_alignInterval (TextGrid me, Function anySound, integer ti
 		IntervalTier headTier = TextGrid_checkSpecifiedTierIsIntervalTier (me, tierNumber);
 		if (intervalNumber < 1 || intervalNumber > headTier -> intervals.size)
 			Melder_throw (U"Interval ", intervalNumber, U" does not exist.");
+		TextGrid_invalidateIndexes (me);
 		TextInterval interval = headTier -> intervals.at [intervalNumber];
 		if (! includeWords && ! includePhonemes)
 			Melder_throw (U"Nothing to be done, because you asked neither for word alignment nor for phoneme alignment.");
@@ -43,7 +43,12 @@ oo_END_CLASS (TextInterval)
 #define ooSTRUCT TextTier
 oo_DEFINE_CLASS (TextTier, Function)   // a kind of AnyTier though
 
-	oo_COLLECTION_OF (SortedSetOfDoubleOf, points, TextPoint, 0)
+	#if oo_READING_TEXT
+		if (! TextTier_readPointsFromText (this, _textSource_))
+			oo_COLLECTION_OF (SortedSetOfDoubleOf, points, TextPoint, 0)
+	#else
+		oo_COLLECTION_OF (SortedSetOfDoubleOf, points, TextPoint, 0)
+	#endif
 
 	#if oo_DECLARING
 		AnyTier_METHODS
@@ -59,15 +64,24 @@ oo_END_CLASS (TextTier)
 #define ooSTRUCT IntervalTier
 oo_DEFINE_CLASS (IntervalTier, Function)
 
-	oo_COLLECTION_OF (SortedSetOfDoubleOf, intervals, TextInterval, 0)
+	#if oo_READING_TEXT
+		if (! IntervalTier_readIntervalsFromText (this, _textSource_))
+			oo_COLLECTION_OF (SortedSetOfDoubleOf, intervals, TextInterval, 0)
+	#else
+		oo_COLLECTION_OF (SortedSetOfDoubleOf, intervals, TextInterval, 0)
+	#endif
 
 	#if oo_DECLARING
+		autoIntervalTierIndex index;   // not part of the data; see IntervalTier_getIndex ()
+
 		int v_domainQuantity () const
 			override { return MelderQuantity_TIME_SECONDS; }
 		void v_shiftX (double xfrom, double xto)
 			override;
 		void v_scaleX (double xminfrom, double xmaxfrom, double xminto, double xmaxto)
 			override;
+		void v_invalidateAllDerivedDataCaches ()
+			override;
 	#endif
 
 oo_END_CLASS (IntervalTier)
@@ -90,6 +104,8 @@ oo_DEFINE_CLASS (TextGrid, Function)
 			override;
 		void v_scaleX (double xminfrom, double xmaxfrom, double xminto, double xmaxto)
 			override;
+		void v_invalidateAllDerivedDataCaches ()
+			override;
 
 		IntervalTier intervalTier_cast (int32 tierNumber) {
 			return static_cast <IntervalTier> (our tiers -> at [tierNumber]);
@@ -260,101 +260,349 @@ void PointProcess_Sound_getShimmer_multi (PointProcess me, Sound thee, double tm
 	}
 }
 
-void Sound_Pitch_PointProcess_voiceReport (Sound sound, Pitch pitch, PointProcess pulses, double tmin, double tmax,
+/*
+	The periods of the window, walked through once.
+	A pair of consecutive periods is "regular" under the same conditions as in PointProcess_getJitter_local
+	and in PointProcess_Sound_to_AmplitudeTier_period; rap needs two regular pairs in a row, ppq5 four.
+	The sums run in the same order as in the separate functions, so that the results are identical.
+*/
+static void VoiceReport_computePeriodMeasures (VoiceReport *report, PointProcess me, Sound sound,
+	MelderIntegerRange pulseNumbers, double pmin, double pmax, double maximumPeriodFactor, VEC peakTimes, VEC peaks, integer *numberOfPeaks)
+{
+	/*
+		Mean and standard deviation of the periods (as in PointProcess_getMeanPeriod and PointProcess_getStdevPeriod).
+	*/
+	autoVEC periods = raw_VEC (std::max (pulseNumbers.size() - 1, 0_integer));
+	integer numberOfPeriods = 0;
+	longdouble sum = 0.0;
+	for (integer ipoint = pulseNumbers.first; ipoint < pulseNumbers.last; ipoint ++) {
+		if (PointProcess_isPeriod (me, ipoint, pmin, pmax, maximumPeriodFactor)) {
+			const double period = my t [ipoint + 1] - my t [ipoint];
+			periods [++ numberOfPeriods] = period;
+			sum += period;
+		}
+	}
+	report -> numberOfPeriods = numberOfPeriods;
+	report -> meanPeriod = ( numberOfPeriods > 0 ? double (sum / numberOfPeriods) : undefined );
+	if (numberOfPeriods >= 2) {
+		const double mean = double (sum / numberOfPeriods);
+		longdouble sum2 = 0.0;
+		for (integer iperiod = 1; iperiod <= numberOfPeriods; iperiod ++) {
+			const double dperiod = periods [iperiod] - mean;
+			sum2 += dperiod * dperiod;
+		}
+		report -> stdevPeriod = sqrt (double (sum2 / (numberOfPeriods - 1)));
+	}
+	/*
+		Jitter, and the peak amplitudes for shimmer.
+	*/
+	longdouble sumOfLocal = 0.0, sumOfRap = 0.0, sumOfPpq5 = 0.0;
+	integer numberOfLocal = 0, numberOfRap = 0, numberOfPpq5 = 0;
+	integer numberOfRegularPairsInARow = 0;
+	*numberOfPeaks = 0;
+	for (integer i = pulseNumbers.first + 1; i < pulseNumbers.last; i ++) {
+		const double p1 = my t [i] - my t [i - 1], p2 = my t [i + 1] - my t [i];
+		const double intervalFactor = p1 > p2 ? p1 / p2 : p2 / p1;
+		const bool pairIsRegular = ( pmin == pmax ||
+				(p1 >= pmin && p1 <= pmax && p2 >= pmin && p2 <= pmax && intervalFactor <= maximumPeriodFactor) );
+		if (! pairIsRegular) {
+			numberOfRegularPairsInARow = 0;
+			continue;
+		}
+		numberOfRegularPairsInARow ++;
+		sumOfLocal += fabs (p1 - p2);
+		numberOfLocal ++;
+		if (numberOfRegularPairsInARow >= 2) {
+			const double p0 = my t [i - 1] - my t [i - 2];
+			sumOfRap += fabs (p1 - (p0 + p1 + p2) / 3.0);
+			numberOfRap ++;
+		}
+		if (numberOfRegularPairsInARow >= 4) {
+			const double
+				q1 = my t [i - 3] - my t [i - 4],
+				q2 = my t [i - 2] - my t [i - 3],
+				q3 = my t [i - 1] - my t [i - 2],
+				q4 = my t [i] - my t [i - 1],
+				q5 = my t [i + 1] - my t [i];
+			sumOfPpq5 += fabs (q3 - (q1 + q2 + q3 + q4 + q5) / 5.0);
+			numberOfPpq5 ++;
+		}
+		const double peak = Sound_getHannWindowedRms (sound, my t [i], 0.2 * p1, 0.2 * p2);
+		if (isdefined (peak) && peak > 0.0) {
+			++ *numberOfPeaks;
+			peakTimes [*numberOfPeaks] = my t [i];
+			peaks [*numberOfPeaks] = peak;
+		}
+	}
+	const double meanPeriod = report -> meanPeriod;
+	if (numberOfLocal >= 1) {
+		report -> jitter_local_absolute = double (sumOfLocal / numberOfLocal);
+		report -> jitter_local = report -> jitter_local_absolute / meanPeriod;
+	}
+	if (numberOfRap >= 1) {
+		report -> jitter_rap = double (sumOfRap / numberOfRap) / meanPeriod;
+		report -> jitter_ddp = ( isdefined (report -> jitter_rap) ? 3.0 * report -> jitter_rap : undefined );
+	}
+	if (numberOfPpq5 >= 1)
+		report -> jitter_ppq5 = double (sumOfPpq5 / numberOfPpq5) / meanPeriod;
+}
+
+/*
+	The peak amplitudes, walked through once (as in AmplitudeTier_getShimmer_xxx).
+	A "link" between consecutive peaks is regular if both its period and its amplitude factor are within range;
+	apq3 needs two regular links in a row, apq5 four, apq11 ten.
+*/
+static void VoiceReport_computeShimmer (VoiceReport *report, constVEC times, constVEC peaks,
+	double pmin, double pmax, double maximumAmplitudeFactor)
+{
+	const integer numberOfPeaks = times.size;
+	longdouble sumOfLocal = 0.0, sumOfLocal_dB = 0.0, sumOfApq3 = 0.0, sumOfApq5 = 0.0, sumOfApq11 = 0.0;
+	integer numberOfLocal = 0, numberOfApq3 = 0, numberOfApq5 = 0, numberOfApq11 = 0;
+	integer numberOfRegularLinksInARow = 0;
+	for (integer i = 2; i <= numberOfPeaks; i ++) {
+		const double p = times [i] - times [i - 1];
+		const double a1 = peaks [i - 1], a2 = peaks [i];
+		const double amplitudeFactor = a1 > a2 ? a1 / a2 : a2 / a1;
+		const bool linkIsRegular = ( pmin == pmax || (p >= pmin && p <= pmax) ) && amplitudeFactor <= maximumAmplitudeFactor;
+		if (! linkIsRegular) {
+			numberOfRegularLinksInARow = 0;
+			continue;
+		}
+		numberOfRegularLinksInARow ++;
+		sumOfLocal += fabs (a1 - a2);
+		sumOfLocal_dB += fabs (log10 (a1 / a2));
+		numberOfLocal ++;
+		if (numberOfRegularLinksInARow >= 2) {
+			const double b1 = peaks [i - 2], b2 = peaks [i - 1], b3 = peaks [i];
+			const double threePointAverage = (b1 + b2 + b3) / 3.0;
+			sumOfApq3 += fabs (b2 - threePointAverage);
+			numberOfApq3 ++;
+		}
+		if (numberOfRegularLinksInARow >= 4) {
+			const double b1 = peaks [i - 4], b2 = peaks [i - 3], b3 = peaks [i - 2], b4 = peaks [i - 1], b5 = peaks [i];
+			const double fivePointAverage = ((b1 + b2 + b3) + (b4 + b5)) / 5.0;
+			sumOfApq5 += fabs (b3 - fivePointAverage);
+			numberOfApq5 ++;
+		}
+		if (numberOfRegularLinksInARow >= 10) {
+			const double b1 = peaks [i - 10], b2 = peaks [i - 9], b3 = peaks [i - 8], b4 = peaks [i - 7],
+				b5 = peaks [i - 6], b6 = peaks [i - 5], b7 = peaks [i - 4], b8 = peaks [i - 3],
+				b9 = peaks [i - 2], b10 = peaks [i - 1], b11 = peaks [i];
+			const double elevenPointAverage = (((b1 + b2 + b3) + (b4 + b5 + b6)) + ((b7 + b8 + b9) + (b10 + b11))) / 11.0;
+			sumOfApq11 += fabs (b6 - elevenPointAverage);
+			numberOfApq11 ++;
+		}
+	}
+	if (numberOfLocal < 1)
+		return;   // all shimmer measures stay undefined
+	longdouble meanAmplitude = 0.0;
+	for (integer i = 1; i < numberOfPeaks; i ++)
+		meanAmplitude += peaks [i];
+	meanAmplitude /= numberOfPeaks - 1;
+	const auto relative = [meanAmplitude] (longdouble sum, integer n) -> double {
+		if (n < 1 || meanAmplitude == 0.0)
+			return undefined;
+		return double ((sum / n) / meanAmplitude);
+	};
+	report -> shimmer_local = relative (sumOfLocal, numberOfLocal);
+	report -> shimmer_local_dB = double (20.0 * (sumOfLocal_dB / numberOfLocal));
+	report -> shimmer_apq3 = relative (sumOfApq3, numberOfApq3);
+	report -> shimmer_apq5 = relative (sumOfApq5, numberOfApq5);
+	report -> shimmer_apq11 = relative (sumOfApq11, numberOfApq11);
+	report -> shimmer_dda = ( isdefined (report -> shimmer_apq3) ? 3.0 * report -> shimmer_apq3 : undefined );
+}
+
+VoiceReport Sound_Pitch_PointProcess_getVoiceReport (Sound sound, Pitch pitch, PointProcess pulses, double tmin, double tmax,
 	double floor, double ceiling, double maximumPeriodFactor, double maximumAmplitudeFactor, double silenceThreshold, double voicingThreshold)
 {
 	try {
 		Function_unidirectionalAutowindow (sound, & tmin, & tmax);
-		/*
-			Time domain. Should be preceded by something like "Time range of SELECTION:" or so.
-		*/
-		MelderInfo_writeLine (U"   From ", Melder_fixed (tmin, 6), U" to ", Melder_fixed (tmax, 6), U" seconds",
-			U" (duration: ", Melder_fixed (tmax - tmin, 6), U" seconds)"
-		);
+		VoiceReport report;
+		report.tmin = tmin;
+		report.tmax = tmax;
 		/*
 			Pitch statistics.
 		*/
-		const double medianPitch = Pitch_getQuantile (pitch, tmin, tmax, 0.50, kPitch_unit::HERTZ);
-		const double meanPitch = Pitch_getMean (pitch, tmin, tmax, kPitch_unit::HERTZ);
-		const double stdevPitch = Pitch_getStandardDeviation (pitch, tmin, tmax, kPitch_unit::HERTZ);
-		const double minimumPitch = Pitch_getMinimum (pitch, tmin, tmax, kPitch_unit::HERTZ, 1);
-		const double maximumPitch = Pitch_getMaximum (pitch, tmin, tmax, kPitch_unit::HERTZ, 1);
-		MelderInfo_writeLine (U"Pitch:");
-		MelderInfo_writeLine (U"   Median pitch: ", Melder_fixed (medianPitch, 3), U" Hz");
-		MelderInfo_writeLine (U"   Mean pitch: ", Melder_fixed (meanPitch, 3), U" Hz");
-		MelderInfo_writeLine (U"   Standard deviation: ", Melder_fixed (stdevPitch, 3), U" Hz");
-		MelderInfo_writeLine (U"   Minimum pitch: ", Melder_fixed (minimumPitch, 3), U" Hz");
-		MelderInfo_writeLine (U"   Maximum pitch: ", Melder_fixed (maximumPitch, 3), U" Hz");
+		report.medianPitch = Pitch_getQuantile (pitch, tmin, tmax, 0.50, kPitch_unit::HERTZ);
+		report.meanPitch = Pitch_getMean (pitch, tmin, tmax, kPitch_unit::HERTZ);
+		report.stdevPitch = Pitch_getStandardDeviation (pitch, tmin, tmax, kPitch_unit::HERTZ);
+		report.minimumPitch = Pitch_getMinimum (pitch, tmin, tmax, kPitch_unit::HERTZ, 1);
+		report.maximumPitch = Pitch_getMaximum (pitch, tmin, tmax, kPitch_unit::HERTZ, 1);
 		/*
-			Pulses statistics.
+			Pulses, jitter and shimmer.
 		*/
 		const double pmin = 0.8 / ceiling, pmax = 1.25 / floor;   // minimum period, maximum period (abbreviated for space)
 		const MelderIntegerRange pulseNumbers = PointProcess_getWindowPoints (pulses, tmin, tmax);
-		const integer numberOfPeriods = PointProcess_getNumberOfPeriods (pulses, tmin, tmax, pmin, pmax, maximumPeriodFactor);
-		const double meanPeriod = PointProcess_getMeanPeriod (pulses, tmin, tmax, pmin, pmax, maximumPeriodFactor);
-		const double stdevPeriod = PointProcess_getStdevPeriod (pulses, tmin, tmax, pmin, pmax, maximumPeriodFactor);
-		MelderInfo_writeLine (U"Pulses:");
-		MelderInfo_writeLine (U"   Number of pulses: ", pulseNumbers.size());
-		MelderInfo_writeLine (U"   Number of periods: ", numberOfPeriods);
-		MelderInfo_writeLine (U"   Mean period: ", Melder_fixedExponent (meanPeriod, -3, 6), U" seconds");
-		MelderInfo_writeLine (U"   Standard deviation of period: ", Melder_fixedExponent (stdevPeriod, -3, 6), U" seconds");
+		report.numberOfPulses = pulseNumbers.size();
+		autoVEC peakTimes = raw_VEC (report.numberOfPulses), peaks = raw_VEC (report.numberOfPulses);
+		integer numberOfPeaks = 0;
+		VoiceReport_computePeriodMeasures (& report, pulses, sound, pulseNumbers, pmin, pmax, maximumPeriodFactor,
+				peakTimes.get(), peaks.get(), & numberOfPeaks);
+		if (report.numberOfPulses >= 3)   // otherwise, PointProcess_Sound_getShimmer_xxx would report "too few pulses"
+			VoiceReport_computeShimmer (& report, peakTimes.part (1, numberOfPeaks), peaks.part (1, numberOfPeaks),
+					pmin, pmax, maximumAmplitudeFactor);
 		/*
 			Voicing.
 		*/
-		const MelderFraction unvoicedFraction =
-				Pitch_getFractionOfLocallyUnvoicedFrames (pitch, tmin, tmax, ceiling, silenceThreshold, voicingThreshold);
-		const MelderCountAndFraction breaks =
-				PointProcess_getCountAndFractionOfVoiceBreaks (pulses, tmin, tmax, pmax);
-		MelderInfo_writeLine (U"Voicing:");
-		MelderInfo_writeLine (U"   Fraction of locally unvoiced frames: ", Melder_percent (unvoicedFraction.get(), 3),
-			U"   (", unvoicedFraction.numerator, U" / ", unvoicedFraction.denominator, U")"
-		);
-		MelderInfo_writeLine (U"   Number of voice breaks: ", breaks.count);
-		MelderInfo_writeLine (U"   Degree of voice breaks: ", Melder_percent (breaks.getFraction (), 3),
-			U"   (", Melder_fixed (breaks.numerator, 6), U" seconds / ", Melder_fixed (breaks.denominator, 6), U" seconds)"
-		);
-		/*
-			Jitter.
-		*/
-		const double jitterLocal = PointProcess_getJitter_local (pulses, tmin, tmax, pmin, pmax, maximumPeriodFactor);
-		const double jitterLocal_s = PointProcess_getJitter_local_absolute (pulses, tmin, tmax, pmin, pmax, maximumPeriodFactor);
-		const double rap = PointProcess_getJitter_rap (pulses, tmin, tmax, pmin, pmax, maximumPeriodFactor);
-		const double ppq5 = PointProcess_getJitter_ppq5 (pulses, tmin, tmax, pmin, pmax, maximumPeriodFactor);
-		const double ddp = PointProcess_getJitter_ddp (pulses, tmin, tmax, pmin, pmax, maximumPeriodFactor);
-		MelderInfo_writeLine (U"Jitter:");
-		MelderInfo_writeLine (U"   Jitter (local): ", Melder_percent (jitterLocal, 3));
-		MelderInfo_writeLine (U"   Jitter (local, absolute): ", Melder_fixedExponent (jitterLocal_s, -6, 3), U" seconds");
-		MelderInfo_writeLine (U"   Jitter (rap): ", Melder_percent (rap, 3));
-		MelderInfo_writeLine (U"   Jitter (ppq5): ", Melder_percent (ppq5, 3));
-		MelderInfo_writeLine (U"   Jitter (ddp): ", Melder_percent (ddp, 3));
-		/*
-			Shimmer.
-		*/
-		double shimmerLocal, shimmerLocal_dB, apq3, apq5, apq11, dda;
-		PointProcess_Sound_getShimmer_multi (pulses, sound, tmin, tmax, pmin, pmax,
-			maximumPeriodFactor, maximumAmplitudeFactor,
-			& shimmerLocal, & shimmerLocal_dB, & apq3, & apq5, & apq11, & dda
-		);
-		MelderInfo_writeLine (U"Shimmer:");
-		MelderInfo_writeLine (U"   Shimmer (local): ", Melder_percent (shimmerLocal, 3));
-		MelderInfo_writeLine (U"   Shimmer (local, dB): ", Melder_fixed (shimmerLocal_dB, 3), U" dB");
-		MelderInfo_writeLine (U"   Shimmer (apq3): ", Melder_percent (apq3, 3));
-		MelderInfo_writeLine (U"   Shimmer (apq5): ", Melder_percent (apq5, 3));
-		MelderInfo_writeLine (U"   Shimmer (apq11): ", Melder_percent (apq11, 3));
-		MelderInfo_writeLine (U"   Shimmer (dda): ", Melder_percent (dda, 3));
+		report.unvoicedFraction = Pitch_getFractionOfLocallyUnvoicedFrames (pitch, tmin, tmax, ceiling, silenceThreshold, voicingThreshold);
+		report.voiceBreaks = PointProcess_getCountAndFractionOfVoiceBreaks (pulses, tmin, tmax, pmax);
 		/*
 			Harmonicity.
 		*/
-		const double meanAutocorrelation = Pitch_getMeanStrength (pitch, tmin, tmax, Pitch_STRENGTH_UNIT_AUTOCORRELATION);
-		const double meanNHR = Pitch_getMeanStrength (pitch, tmin, tmax, Pitch_STRENGTH_UNIT_NOISE_HARMONICS_RATIO);
-		const double meanHNR_dB = Pitch_getMeanStrength (pitch, tmin, tmax, Pitch_STRENGTH_UNIT_HARMONICS_NOISE_DB);
-		MelderInfo_writeLine (U"Harmonicity of the voiced parts only:");
-		MelderInfo_writeLine (U"   Mean autocorrelation: ", Melder_fixed (meanAutocorrelation, 6));
-		MelderInfo_writeLine (U"   Mean noise-to-harmonics ratio: ", Melder_fixed (meanNHR, 6));
-		MelderInfo_writeLine (U"   Mean harmonics-to-noise ratio: ", Melder_fixed (meanHNR_dB, 3), U" dB");
+		report.meanAutocorrelation = Pitch_getMeanStrength (pitch, tmin, tmax, Pitch_STRENGTH_UNIT_AUTOCORRELATION);
+		report.meanNoiseToHarmonicsRatio = Pitch_getMeanStrength (pitch, tmin, tmax, Pitch_STRENGTH_UNIT_NOISE_HARMONICS_RATIO);
+		report.meanHarmonicsToNoiseRatio_dB = Pitch_getMeanStrength (pitch, tmin, tmax, Pitch_STRENGTH_UNIT_HARMONICS_NOISE_DB);
+		return report;
 	} catch (MelderError) {
 		Melder_throw (sound, U" & ", pitch, U" & ", pulses, U": voice report not computed.");
 	}
 }
 
+void Sound_Pitch_PointProcess_voiceReport (Sound sound, Pitch pitch, PointProcess pulses, double tmin, double tmax,
+	double floor, double ceiling, double maximumPeriodFactor, double maximumAmplitudeFactor, double silenceThreshold, double voicingThreshold)
+{
+	const VoiceReport report = Sound_Pitch_PointProcess_getVoiceReport (sound, pitch, pulses, tmin, tmax,
+			floor, ceiling, maximumPeriodFactor, maximumAmplitudeFactor, silenceThreshold, voicingThreshold);
+	/*
+		Time domain. Should be preceded by something like "Time range of SELECTION:" or so.
+	*/
+	MelderInfo_writeLine (U"   From ", Melder_fixed (report.tmin, 6), U" to ", Melder_fixed (report.tmax, 6), U" seconds",
+		U" (duration: ", Melder_fixed (report.tmax - report.tmin, 6), U" seconds)"
+	);
+	MelderInfo_writeLine (U"Pitch:");
+	MelderInfo_writeLine (U"   Median pitch: ", Melder_fixed (report.medianPitch, 3), U" Hz");
+	MelderInfo_writeLine (U"   Mean pitch: ", Melder_fixed (report.meanPitch, 3), U" Hz");
+	MelderInfo_writeLine (U"   Standard deviation: ", Melder_fixed (report.stdevPitch, 3), U" Hz");
+	MelderInfo_writeLine (U"   Minimum pitch: ", Melder_fixed (report.minimumPitch, 3), U" Hz");
+	MelderInfo_writeLine (U"   Maximum pitch: ", Melder_fixed (report.maximumPitch, 3), U" Hz");
+	MelderInfo_writeLine (U"Pulses:");
+	MelderInfo_writeLine (U"   Number of pulses: ", report.numberOfPulses);
+	MelderInfo_writeLine (U"   Number of periods: ", report.numberOfPeriods);
+	MelderInfo_writeLine (U"   Mean period: ", Melder_fixedExponent (report.meanPeriod, -3, 6), U" seconds");
+	MelderInfo_writeLine (U"   Standard deviation of period: ", Melder_fixedExponent (report.stdevPeriod, -3, 6), U" seconds");
+	MelderInfo_writeLine (U"Voicing:");
+	MelderInfo_writeLine (U"   Fraction of locally unvoiced frames: ", Melder_percent (report.unvoicedFraction.get(), 3),
+		U"   (", report.unvoicedFraction.numerator, U" / ", report.unvoicedFraction.denominator, U")"
+	);
+	MelderInfo_writeLine (U"   Number of voice breaks: ", report.voiceBreaks.count);
+	MelderInfo_writeLine (U"   Degree of voice breaks: ", Melder_percent (report.voiceBreaks.getFraction (), 3),
+		U"   (", Melder_fixed (report.voiceBreaks.numerator, 6), U" seconds / ", Melder_fixed (report.voiceBreaks.denominator, 6), U" seconds)"
+	);
+	MelderInfo_writeLine (U"Jitter:");
+	MelderInfo_writeLine (U"   Jitter (local): ", Melder_percent (report.jitter_local, 3));
+	MelderInfo_writeLine (U"   Jitter (local, absolute): ", Melder_fixedExponent (report.jitter_local_absolute, -6, 3), U" seconds");
+	MelderInfo_writeLine (U"   Jitter (rap): ", Melder_percent (report.jitter_rap, 3));
+	MelderInfo_writeLine (U"   Jitter (ppq5): ", Melder_percent (report.jitter_ppq5, 3));
+	MelderInfo_writeLine (U"   Jitter (ddp): ", Melder_percent (report.jitter_ddp, 3));
+	MelderInfo_writeLine (U"Shimmer:");
+	MelderInfo_writeLine (U"   Shimmer (local): ", Melder_percent (report.shimmer_local, 3));
+	MelderInfo_writeLine (U"   Shimmer (local, dB): ", Melder_fixed (report.shimmer_local_dB, 3), U" dB");
+	MelderInfo_writeLine (U"   Shimmer (apq3): ", Melder_percent (report.shimmer_apq3, 3));
+	MelderInfo_writeLine (U"   Shimmer (apq5): ", Melder_percent (report.shimmer_apq5, 3));
+	MelderInfo_writeLine (U"   Shimmer (apq11): ", Melder_percent (report.shimmer_apq11, 3));
+	MelderInfo_writeLine (U"   Shimmer (dda): ", Melder_percent (report.shimmer_dda, 3));
+	MelderInfo_writeLine (U"Harmonicity of the voiced parts only:");
+	MelderInfo_writeLine (U"   Mean autocorrelation: ", Melder_fixed (report.meanAutocorrelation, 6));
+	MelderInfo_writeLine (U"   Mean noise-to-harmonics ratio: ", Melder_fixed (report.meanNoiseToHarmonicsRatio, 6));
+	MelderInfo_writeLine (U"   Mean harmonics-to-noise ratio: ", Melder_fixed (report.meanHarmonicsToNoiseRatio_dB, 3), U" dB");
+}
+
+static autoTable VoiceReport_tabulate (Sound sound, Pitch pitch, PointProcess pulses,
+	constVEC tmins, constVEC tmaxs, constSTRVEC texts,
+	double floor, double ceiling, double maximumPeriodFactor, double maximumAmplitudeFactor, double silenceThreshold, double voicingThreshold)
+{
+	Melder_assert (tmaxs.size == tmins.size);
+	const conststring32 columnNames [] = { U"tmin", U"tmax", U"text",
+		U"medianPitch", U"meanPitch", U"stdevPitch", U"minimumPitch", U"maximumPitch",
+		U"numberOfPulses", U"numberOfPeriods", U"meanPeriod", U"stdevPeriod",
+		U"fractionOfLocallyUnvoicedFrames", U"numberOfVoiceBreaks", U"degreeOfVoiceBreaks",
+		U"jitter_local", U"jitter_local_absolute", U"jitter_rap", U"jitter_ppq5", U"jitter_ddp",
+		U"shimmer_local", U"shimmer_local_dB", U"shimmer_apq3", U"shimmer_apq5", U"shimmer_apq11", U"shimmer_dda",
+		U"meanAutocorrelation", U"meanNoiseToHarmonicsRatio", U"meanHarmonicsToNoiseRatio"
+	};
+	autoTable thee = Table_createWithColumnNames (tmins.size, ARRAY_TO_STRVEC (columnNames));
+	if (texts.size == 0)
+		Table_removeColumn (thee.get(), 3);
+	for (integer irow = 1; irow <= tmins.size; irow ++) {
+		const VoiceReport report = Sound_Pitch_PointProcess_getVoiceReport (sound, pitch, pulses, tmins [irow], tmaxs [irow],
+				floor, ceiling, maximumPeriodFactor, maximumAmplitudeFactor, silenceThreshold, voicingThreshold);
+		integer icol = 0;
+		Table_setNumericValue (thee.get(), irow, ++ icol, report.tmin);
+		Table_setNumericValue (thee.get(), irow, ++ icol, report.tmax);
+		if (texts.size > 0)
+			Table_setStringValue (thee.get(), irow, ++ icol, texts [irow]);
+		Table_setNumericValue (thee.get(), irow, ++ icol, report.medianPitch);
+		Table_setNumericValue (thee.get(), irow, ++ icol, report.meanPitch);
+		Table_setNumericValue (thee.get(), irow, ++ icol, report.stdevPitch);
+		Table_setNumericValue (thee.get(), irow, ++ icol, report.minimumPitch);
+		Table_setNumericValue (thee.get(), irow, ++ icol, report.maximumPitch);
+		Table_setNumericValue (thee.get(), irow, ++ icol, report.numberOfPulses);
+		Table_setNumericValue (thee.get(), irow, ++ icol, report.numberOfPeriods);
+		Table_setNumericValue (thee.get(), irow, ++ icol, report.meanPeriod);
+		Table_setNumericValue (thee.get(), irow, ++ icol, report.stdevPeriod);
+		Table_setNumericValue (thee.get(), irow, ++ icol, report.unvoicedFraction.get());
+		Table_setNumericValue (thee.get(), irow, ++ icol, report.voiceBreaks.count);
+		Table_setNumericValue (thee.get(), irow, ++ icol, report.voiceBreaks.getFraction ());
+		Table_setNumericValue (thee.get(), irow, ++ icol, report.jitter_local);
+		Table_setNumericValue (thee.get(), irow, ++ icol, report.jitter_local_absolute);
+		Table_setNumericValue (thee.get(), irow, ++ icol, report.jitter_rap);
+		Table_setNumericValue (thee.get(), irow, ++ icol, report.jitter_ppq5);
+		Table_setNumericValue (thee.get(), irow, ++ icol, report.jitter_ddp);
+		Table_setNumericValue (thee.get(), irow, ++ icol, report.shimmer_local);
+		Table_setNumericValue (thee.get(), irow, ++ icol, report.shimmer_local_dB);
+		Table_setNumericValue (thee.get(), irow, ++ icol, report.shimmer_apq3);
+		Table_setNumericValue (thee.get(), irow, ++ icol, report.shimmer_apq5);
+		Table_setNumericValue (thee.get(), irow, ++ icol, report.shimmer_apq11);
+		Table_setNumericValue (thee.get(), irow, ++ icol, report.shimmer_dda);
+		Table_setNumericValue (thee.get(), irow, ++ icol, report.meanAutocorrelation);
+		Table_setNumericValue (thee.get(), irow, ++ icol, report.meanNoiseToHarmonicsRatio);
+		Table_setNumericValue (thee.get(), irow, ++ icol, report.meanHarmonicsToNoiseRatio_dB);
+		Melder_assert (icol == thy numberOfColumns);
+	}
+	return thee;
+}
+
+autoTable Sound_Pitch_PointProcess_to_Table_voiceReport (Sound sound, Pitch pitch, PointProcess pulses,
+	constVEC tmins, constVEC tmaxs,
+	double floor, double ceiling, double maximumPeriodFactor, double maximumAmplitudeFactor, double silenceThreshold, double voicingThreshold)
+{
+	try {
+		Melder_require (tmaxs.size == tmins.size,
+			U"The number of start times (", tmins.size, U") should equal the number of end times (", tmaxs.size, U").");
+		return VoiceReport_tabulate (sound, pitch, pulses, tmins, tmaxs, constSTRVEC (),
+				floor, ceiling, maximumPeriodFactor, maximumAmplitudeFactor, silenceThreshold, voicingThreshold);
+	} catch (MelderError) {
+		Melder_throw (sound, U" & ", pitch, U" & ", pulses, U": voice reports not tabulated.");
+	}
+}
+
+autoTable Sound_Pitch_PointProcess_TextGrid_to_Table_voiceReport (Sound sound, Pitch pitch, PointProcess pulses,
+	TextGrid textgrid, integer tierNumber,
+	double floor, double ceiling, double maximumPeriodFactor, double maximumAmplitudeFactor, double silenceThreshold, double voicingThreshold)
+{
+	try {
+		const IntervalTier tier = TextGrid_checkSpecifiedTierIsIntervalTier (textgrid, tierNumber);
+		integer numberOfLabelledIntervals = 0;
+		for (integer iinterval = 1; iinterval <= tier -> intervals.size; iinterval ++)
+			if (Melder_length (tier -> intervals.at [iinterval] -> text.get()) > 0)
+				numberOfLabelledIntervals ++;
+		autoVEC tmins = raw_VEC (numberOfLabelledIntervals), tmaxs = raw_VEC (numberOfLabelledIntervals);
+		autoSTRVEC texts (numberOfLabelledIntervals);
+		integer ilabelled = 0;
+		for (integer iinterval = 1; iinterval <= tier -> intervals.size; iinterval ++) {
+			const TextInterval interval = tier -> intervals.at [iinterval];
+			if (Melder_length (interval -> text.get()) > 0) {
+				ilabelled ++;
+				tmins [ilabelled] = interval -> xmin;
+				tmaxs [ilabelled] = interval -> xmax;
+				texts [ilabelled] = Melder_dup (interval -> text.get());
+			}
+		}
+		return VoiceReport_tabulate (sound, pitch, pulses, tmins.get(), tmaxs.get(), texts.get(),
+				floor, ceiling, maximumPeriodFactor, maximumAmplitudeFactor, silenceThreshold, voicingThreshold);
+	} catch (MelderError) {
+		Melder_throw (sound, U" & ", pitch, U" & ", pulses, U" & ", textgrid, U": voice reports not tabulated.");
+	}
+}
+
 /* End of file VoiceAnalysis.cpp */
@@ -1,3 +1,5 @@
+#ifndef _VoiceAnalysis_h_
+#define _VoiceAnalysis_h_
 /* VoiceAnalysis.h
  *
  * Copyright (C) 1992-2011 Paul Boersma
@@ -19,6 +21,7 @@
 #include "Sound.h"
 #include "PointProcess.h"
 #include "Pitch.h"
+#include "TextGrid.h"
 
 double PointProcess_getJitter_local (PointProcess me, double tmin, double tmax,
 	double minimumPeriod, double maximumPeriod, double maximumPeriodFactor);
@@ -52,4 +55,44 @@ void Sound_Pitch_PointProcess_voiceReport (Sound sound, Pitch pitch, PointProces
 	double floor, double ceiling, double maximumPeriodFactor, double maximumAmplitudeFactor,
 	double silenceThreshold, double voicingThreshold);
 
+/*
+	All the measures of a voice report.
+	They are computed from a single pass through the periods in the window,
+	and a single pass through the peak amplitudes of those periods,
+	with the same results as the separate PointProcess_getJitter_xxx and PointProcess_Sound_getShimmer_xxx.
+*/
+struct VoiceReport {
+	double tmin = 0.0, tmax = 0.0;
+	double medianPitch = undefined, meanPitch = undefined, stdevPitch = undefined, minimumPitch = undefined, maximumPitch = undefined;   // Hz
+	integer numberOfPulses = 0, numberOfPeriods = 0;
+	double meanPeriod = undefined, stdevPeriod = undefined;   // seconds
+	MelderFraction unvoicedFraction;
+	MelderCountAndFraction voiceBreaks;
+	double jitter_local = undefined, jitter_local_absolute = undefined, jitter_rap = undefined, jitter_ppq5 = undefined, jitter_ddp = undefined;
+	double shimmer_local = undefined, shimmer_local_dB = undefined, shimmer_apq3 = undefined, shimmer_apq5 = undefined,
+		shimmer_apq11 = undefined, shimmer_dda = undefined;
+	double meanAutocorrelation = undefined, meanNoiseToHarmonicsRatio = undefined, meanHarmonicsToNoiseRatio_dB = undefined;
+};
+
+VoiceReport Sound_Pitch_PointProcess_getVoiceReport (Sound sound, Pitch pitch, PointProcess pulses,
+	double tmin, double tmax,
+	double floor, double ceiling, double maximumPeriodFactor, double maximumAmplitudeFactor,
+	double silenceThreshold, double voicingThreshold);
+
+/*
+	One row per window (tmins [i], tmaxs [i]), with one column per measure of the voice report.
+*/
+autoTable Sound_Pitch_PointProcess_to_Table_voiceReport (Sound sound, Pitch pitch, PointProcess pulses,
+	constVEC tmins, constVEC tmaxs,
+	double floor, double ceiling, double maximumPeriodFactor, double maximumAmplitudeFactor,
+	double silenceThreshold, double voicingThreshold);
+/*
+	One row per labelled (i.e. non-empty) interval of the interval tier, with the label in the column "text".
+*/
+autoTable Sound_Pitch_PointProcess_TextGrid_to_Table_voiceReport (Sound sound, Pitch pitch, PointProcess pulses,
+	TextGrid textgrid, integer tierNumber,
+	double floor, double ceiling, double maximumPeriodFactor, double maximumAmplitudeFactor,
+	double silenceThreshold, double voicingThreshold);
+
 /* End of file VoiceAnalysis.h */
+#endif
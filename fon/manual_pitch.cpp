@@ -635,6 +635,25 @@ NORMAL (U"The algorithm performs an acoustic periodicity detection on the basis
 	"For information on the settings, see @@Sound: To Harmonicity (ac)...@.")
 MAN_END
 
+MAN_BEGIN (U"Analysis cache settings...", U"ppgb", 20261019)
+INTRO (U"A command in the #Settings submenu of the #Praat menu.")
+NORMAL (U"If you switch it on, Praat keeps the results of the @Pitch, @Intensity, @Formant and @Spectrogram analyses of Sounds in memory, "
+	"so that asking again for the same analysis of the same Sound with the same settings costs almost nothing. "
+	"This helps especially if several commands need the same pitch analysis, "
+	"as with @@Sound: To Pitch...@ followed by @@Sound: To PointProcess (periodic, cc)...@, "
+	"or in scripts that measure the same Sound in several ways.")
+NORMAL (U"A Sound that has been changed (e.g. with @@Formula...@) will be analysed anew, "
+	"because the cache recognizes Sounds by their samples, not by their names.")
+ENTRY (U"Setting")
+TERM (U"##Memory budget (MB)# (standard value: 0)")
+DEFINITION (U"the maximum amount of memory used by the cache. If the cache grows larger, "
+	"the analyses that have not been used for the longest time are forgotten. "
+	"A value of 0 switches the cache off; it is off by default, because storing a copy of every analysis "
+	"costs memory and time that are wasted if the same analysis is never asked for again.")
+NORMAL (U"You can see what the cache contains with ##Report analysis cache# from the #Technical menu, "
+	"and empty it with ##Clear analysis cache#.")
+MAN_END
+
 MAN_BEGIN (U"Sound: To Pitch...", U"ppgb", 20030916)
 INTRO (U"A command that creates a @Pitch object from every selected @Sound object.")
 ENTRY (U"Purpose")
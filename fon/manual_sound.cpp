@@ -229,6 +229,17 @@ INTRO (U"A command in the @@Open menu@ of the #Objects window. "
 	"If the file name is `hello.wav`, Praat will name the channels `hello_ch1`, `hello_ch2`, and so on.")
 MAN_END
 
+MAN_BEGIN (U"Read Sounds from sound files...", U"ppgb", 20261019)
+INTRO (U"A command in the @@Open menu@ of the #Objects window. "
+	"You use this to read all the sound files in a folder whose names match a pattern (such as `*.wav`) "
+	"as separate @Sound objects in the list, in alphabetical order. "
+	"If a file name is `hello.wav`, Praat will call the Sound `hello`.")
+NORMAL (U"The files are decoded in parallel, so that reading a folder with many short files "
+	"goes much faster than reading the files one by one with @@Read from file...@. "
+	"If a file cannot be read, you get the same message as with ##Read from file...#.")
+NORMAL (U"The similar command ##Read SoundSet from sound files...# puts the Sounds into a single SoundSet object instead.")
+MAN_END
+
 MAN_BEGIN (U"Record mono Sound...", U"ppgb", 20201120)
 INTRO (U"A command in the @@New menu@ to record a @Sound. Creates a @SoundRecorder window.")
 MAN_END
@@ -2584,6 +2584,28 @@ NORMAL (U"These files are in a device-independent binary format, "
 	"and can be written and read on any machine.")
 MAN_END
 
+MAN_BEGIN (U"Save as mappable binary file...", U"agent", 20261019)
+INTRO (U"One of the commands in the @@Save menu@, available for a @Sound, a @Spectrogram, or a @Matrix.")
+ENTRY (U"Behaviour")
+NORMAL (U"The Objects window will ask you for a file name. "
+	"After you click OK, the object will be written to a binary file on disk.")
+ENTRY (U"Usage")
+NORMAL (U"The file can be read again with @@Read from file...@. "
+	"On Macintosh and Linux computers, reading does not copy the samples or cells into memory; "
+	"instead, they are %mapped into memory directly from the file, so that opening even a file of several gigabytes "
+	"is nearly instantaneous, and all Praat processes that open the same file share the same memory. "
+	"If you modify the object, the modified parts are copied first; the file itself never changes.")
+NORMAL (U"If you save anything to the file from Praat while the object is still open, "
+	"Praat first copies the samples or cells of the object into memory, so that the object does not change. "
+	"Other programs, however, should not change or truncate the file while the object is open in Praat: "
+	"Praat would crash (with a message that says why) as soon as it tries to use the missing samples.")
+ENTRY (U"File format")
+NORMAL (U"The object is written in the format of @@Save as binary file...@, "
+	"except that the samples or cells are written at the end, in little-endian order, "
+	"starting at a multiple of 65536 bytes from the start of the file. "
+	"On big-endian computers, or on Windows, the samples are simply read from the file.")
+MAN_END
+
 MAN_BEGIN (U"Save as short text file...", U"ppgb", 20110129)
 INTRO (U"One of the commands in the @@Save menu@.")
 ENTRY (U"Availability")
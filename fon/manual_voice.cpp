@@ -254,6 +254,10 @@ CODE (U"voiceReport$ = Voice report: 0, 0, 75, 500, 1.3, 1.6, 0.03, 0.45")
 CODE (U"jitter = extractNumber (voiceReport$, \"Jitter (local): \")")
 CODE (U"shimmer = extractNumber (voiceReport$, \"Shimmer (local): \")")
 CODE (U"writeInfoLine: \"Jitter = \", percent$ (jitter, 3), \", shimmer = \", percent$ (shimmer, 3)")
+NORMAL (U"If you also select a TextGrid (so that four objects are selected), the button ##Voice report to Table...# "
+	"gives you a @Table with one row for each labelled interval on the interval tier that you specify, "
+	"and one column for each measure of the voice report (unrounded). "
+	"This is much faster than asking for a voice report for each interval in a loop.")
 ENTRY (U"5. Disadvantage of automating voice analysis")
 NORMAL (U"In all the commands mentioned above, you have to guess the time range, "
 	"and you would usually supply \"0.0\" and \"0.0\", in which case "
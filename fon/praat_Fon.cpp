@@ -2148,6 +2148,22 @@ DO
 	INFO_ONE_AND_ONE_AND_ONE_END
 }
 
+FORM (NEW1_Sound_Pitch_PointProcess_TextGrid_to_Table_voiceReport, U"Voice report to Table", U"Voice") {
+	NATURAL (tierNumber, U"Tier number", U"1")
+	POSITIVE (fromPitch, U"left Pitch range (Hz)", U"75.0")
+	POSITIVE (toPitch, U"right Pitch range (Hz)", U"600.0")
+	POSITIVE (maximumPeriodFactor, U"Maximum period factor", U"1.3")
+	POSITIVE (maximumAmplitudeFactor, U"Maximum amplitude factor", U"1.6")
+	REAL (silenceThreshold, U"Silence threshold", U"0.03")
+	REAL (voicingThreshold, U"Voicing threshold", U"0.45")
+	OK
+DO
+	CONVERT_ONE_AND_ONE_AND_ONE_AND_ONE_TO_ONE (Sound, Pitch, PointProcess, TextGrid)
+		autoTable result = Sound_Pitch_PointProcess_TextGrid_to_Table_voiceReport (me, you, him, she, tierNumber,
+				fromPitch, toPitch, maximumPeriodFactor, maximumAmplitudeFactor, silenceThreshold, voicingThreshold);
+	CONVERT_ONE_AND_ONE_AND_ONE_AND_ONE_TO_ONE_END (my name.get())
+}
+
 // MARK: - SOUND & POINTPROCESS & PITCHTIER & DURATIONTIER
 
 FORM (NEW1_Sound_Point_Pitch_Duration_to_Sound, U"To Sound", nullptr) {
@@ -2212,6 +2228,12 @@ DIRECT (MOVIE_Spectrogram_playMovie) {
 	MOVIE_ONE_END
 }
 
+FORM_SAVE (SAVE_Spectrogram_saveAsMappableBinaryFile, U"Save as mappable binary file", nullptr, U"Spectrogram") {
+	SAVE_ONE (Spectrogram)
+		Matrix_writeToMappableBinaryFile (me, file);
+	SAVE_ONE_END
+}
+
 DIRECT (NEW_Spectrogram_to_Matrix) {
 	CONVERT_EACH_TO_ONE (Spectrogram)
 		autoMatrix result = Spectrogram_to_Matrix (me);
@@ -3539,6 +3561,8 @@ praat_addAction1 (classParamCurve, 0, U"Draw", nullptr, 0, nullptr);
 			nullptr, 0, EDITOR_ONE_Spectrogram_view);
 	praat_addAction1 (classSpectrogram, 1, U"Play movie || Movie",
 			nullptr, 0, MOVIE_Spectrogram_playMovie);
+	praat_addAction1 (classSpectrogram, 1, U"Save as mappable binary file...",
+			nullptr, 0, SAVE_Spectrogram_saveAsMappableBinaryFile);
 	praat_addAction1 (classSpectrogram, 0, U"Query -", nullptr, 0, nullptr);
 		praat_TimeFrameSampled_query_init (classSpectrogram);
 		praat_addAction1 (classSpectrogram, 1, U"Get power at...",
@@ -3758,6 +3782,8 @@ praat_addAction2 (classIntensity, 1, classPitch, 1, U"Query", nullptr, 0, nullpt
 			nullptr, 0, NEW1_Pitch_PointProcess_to_PitchTier);
 	praat_addAction3 (classPitch, 1, classPointProcess, 1, classSound, 1, U"Voice report...",
 			nullptr, 0, INFO_Sound_Pitch_PointProcess_voiceReport);
+	praat_addAction4 (classPitch, 1, classPointProcess, 1, classSound, 1, classTextGrid, 1, U"Voice report to Table...",
+			nullptr, 0, NEW1_Sound_Pitch_PointProcess_TextGrid_to_Table_voiceReport);
 	praat_addAction2 (classPitch, 1, classSound, 1, U"To PointProcess (cc)",
 			nullptr, 0, NEW1_Sound_Pitch_to_PointProcess_cc);
 	praat_addAction2 (classPitch, 1, classSound, 1, U"To PointProcess (peaks)...",
@@ -110,6 +110,12 @@ FORM_SAVE (SAVE_Matrix_writeToMatrixTextFile, U"Save Matrix as matrix text file"
 	SAVE_ONE_END
 }
 
+FORM_SAVE (SAVE_Matrix_writeToMappableBinaryFile, U"Save as mappable binary file", nullptr, nullptr) {
+	SAVE_ONE (Matrix)
+		Matrix_writeToMappableBinaryFile (me, file);
+	SAVE_ONE_END
+}
+
 FORM_SAVE (SAVE_Matrix_writeToHeaderlessSpreadsheetFile, U"Save Matrix as spreadsheet", nullptr, U"txt") {
 	SAVE_ONE (Matrix)
 		Matrix_writeToHeaderlessSpreadsheetFile (me, file);
@@ -827,12 +833,19 @@ static autoDaata imageFileRecognizer (integer /* nread */, const char * /* heade
 	return autoDaata ();
 }
 
+static autoDaata mappableBinaryFileRecognizer (integer nread, const char *header, MelderFile file) {
+	if (Matrix_isMappableBinaryFileHeader (nread, header))
+		return Matrix_readFromMappableBinaryFile (file);
+	return autoDaata ();
+}
+
 // MARK: - buttons
 
 void praat_Matrix_init () {
 	Thing_recognizeClassesByName (classMatrix, classPhoto, classMovie, nullptr);
 
 	Data_recognizeFileType (imageFileRecognizer);
+	Data_recognizeFileType (mappableBinaryFileRecognizer);
 
 	praat_addMenuCommand (U"Objects", U"New", U"Matrix", nullptr, 1, nullptr);
 		praat_addMenuCommand (U"Objects", U"New", U"Create Matrix...", nullptr, 2, NEW1_Matrix_create);
@@ -850,6 +863,7 @@ void praat_Matrix_init () {
 
 	praat_addAction1 (classMatrix, 0, U"Matrix help", nullptr, 0, HELP_Matrix_help);
 	praat_addAction1 (classMatrix, 1, U"Save as matrix text file...", nullptr, 0, SAVE_Matrix_writeToMatrixTextFile);
+	praat_addAction1 (classMatrix, 1, U"Save as mappable binary file...", nullptr, 0, SAVE_Matrix_writeToMappableBinaryFile);
 	praat_addAction1 (classMatrix, 1,   U"Write to matrix text file...", U"*Save as matrix text file...", GuiMenu_DEPRECATED_2011, SAVE_Matrix_writeToMatrixTextFile);
 	praat_addAction1 (classMatrix, 1, U"Save as headerless spreadsheet file...", nullptr, 0, SAVE_Matrix_writeToHeaderlessSpreadsheetFile);
 	praat_addAction1 (classMatrix, 1,   U"Write to headerless spreadsheet file...", nullptr, GuiMenu_DEPRECATED_2011, SAVE_Matrix_writeToHeaderlessSpreadsheetFile);
@@ -19,6 +19,7 @@
 #include "Ltas.h"
 #include "Manipulation.h"
 #include "ParamCurve.h"
+#include "AnalysisCache.h"
 #include "Sound_and_Spectrogram.h"
 #include "Sound_and_Spectrum.h"
 #include "Sound_extensions.h"
@@ -95,10 +96,49 @@ DIRECT (INTEGER_LongSound_getNumberOfSamples) {
 	QUERY_ONE_FOR_REAL_END (U" samples")
 }
 
+FORM (REAL_LongSound_getMinimum, U"LongSound: Get minimum", nullptr) {
+	REAL (fromTime, U"left Time range (s)", U"0.0")
+	REAL (toTime, U"right Time range", U"0.0 (= all)")
+	NATURAL (channel, U"Channel", U"1")
+	OK
+DO
+	QUERY_ONE_FOR_REAL (LongSound)
+		double minimum, maximum;
+		LongSound_getExtrema (me, fromTime, toTime, channel, & minimum, & maximum);
+		const double result = minimum;
+	QUERY_ONE_FOR_REAL_END (U" (minimum)")
+}
+
+FORM (REAL_LongSound_getMaximum, U"LongSound: Get maximum", nullptr) {
+	REAL (fromTime, U"left Time range (s)", U"0.0")
+	REAL (toTime, U"right Time range", U"0.0 (= all)")
+	NATURAL (channel, U"Channel", U"1")
+	OK
+DO
+	QUERY_ONE_FOR_REAL (LongSound)
+		double minimum, maximum;
+		LongSound_getExtrema (me, fromTime, toTime, channel, & minimum, & maximum);
+		const double result = maximum;
+	QUERY_ONE_FOR_REAL_END (U" (maximum)")
+}
+
 DIRECT (HELP__LongSound_help) {
 	HELP (U"LongSound")
 }
 
+FORM (GRAPHICS_EACH__LongSound_draw, U"LongSound: Draw", nullptr) {
+	REAL (fromTime, U"left Time range (s)", U"0.0")
+	REAL (toTime, U"right Time range", U"0.0 (= all)")
+	REAL (fromAmplitude, U"left Amplitude range", U"0.0")
+	REAL (toAmplitude, U"right Amplitude range", U"0.0 (= auto)")
+	BOOLEAN (garnish, U"Garnish", true)
+	OK
+DO
+	GRAPHICS_EACH (LongSound)
+		LongSound_draw (me, GRAPHICS, fromTime, toTime, fromAmplitude, toAmplitude, garnish);
+	GRAPHICS_EACH_END
+}
+
 FORM_READ (READ1_LongSound_open, U"Open long sound file", nullptr, true) {
 	READ_ONE
 		autoLongSound result = LongSound_open (file);
@@ -271,6 +311,35 @@ DO
 	PREFS_END
 }
 
+/********** ANALYSIS CACHE **********/
+
+FORM (SETTINGS__AnalysisCacheSettings, U"Analysis cache settings", U"Analysis cache settings...") {
+	LABEL (U"Pitch, Intensity, Formant and Spectrogram analyses of Sounds can be kept in memory,")
+	LABEL (U"so that asking for the same analysis of the same sound again costs nothing.")
+	INTEGER (memoryBudget, U"Memory budget (MB)", U"0")
+	LABEL (U"A memory budget of 0 switches the cache off.")
+OK
+	SET_INTEGER (memoryBudget, AnalysisCache_getMemoryBudgetPref_MB ())
+DO
+	PREFS
+		AnalysisCache_setMemoryBudgetPref_MB (memoryBudget);
+	PREFS_END
+}
+
+DIRECT (INFO_NONE__Praat_reportAnalysisCache) {
+	INFO_NONE
+		MelderInfo_open ();
+		AnalysisCache_info ();
+		MelderInfo_close ();
+	INFO_NONE_END
+}
+
+DIRECT (PRAAT__clearAnalysisCache) {
+	PRAAT
+		AnalysisCache_clear ();
+	PRAAT_END
+}
+
 /********** LONGSOUND & SOUND **********/
 
 FORM_SAVE (SAVE_ALL__LongSound_Sound_saveAsAifcFile, U"Save as AIFC file", nullptr, U"aifc") {
@@ -1175,6 +1244,44 @@ FORM_READ (READ_MULTIPLE__Sound_readSeparateChannelsFromSoundFile, U"Read separa
 	READ_MULTIPLE_END
 }
 
+static autoSTRVEC soundFilePathsInFolder (conststring32 folderPath, conststring32 fileGlobber) {
+	autoSTRVEC fileNames = fileNames_STRVEC (Melder_cat (folderPath, U"/", fileGlobber));
+	Melder_require (fileNames.size > 0,
+		U"No files in folder \"", folderPath, U"\" match \"", fileGlobber, U"\".");
+	structMelderDir folder { };
+	Melder_pathToDir (folderPath, & folder);
+	autoSTRVEC filePaths (fileNames.size);
+	for (integer ifile = 1; ifile <= fileNames.size; ifile ++) {
+		structMelderFile file { };
+		MelderDir_getFile (& folder, fileNames [ifile].get(), & file);
+		filePaths [ifile] = Melder_dup (Melder_fileToPath (& file));
+	}
+	return filePaths;
+}
+
+FORM (READ_MULTIPLE__Sounds_readFromSoundFiles, U"Read Sounds from sound files", U"Read Sounds from sound files...") {
+	FOLDER (folder, U"Folder", U".")
+	WORD (fileGlobber, U"Only files that match pattern", U"*.wav")
+	OK
+DO
+	CREATE_ONE
+		autoSoundList result = SoundList_create ();
+		Sounds_readFromSoundFiles (soundFilePathsInFolder (folder, fileGlobber).get(), result.get());
+		result -> classInfo = classCollection;   // YUCK, in order to force automatic unpacking
+	CREATE_ONE_END (U"dummy")
+}
+
+FORM (READ1_SoundSet_readFromSoundFiles, U"Read SoundSet from sound files", U"Read Sounds from sound files...") {
+	SENTENCE (name, U"Name", U"ensemble")
+	FOLDER (folder, U"Folder", U".")
+	WORD (fileGlobber, U"Only files that match pattern", U"*.wav")
+	OK
+DO
+	CREATE_ONE
+		autoSoundSet result = SoundSet_readFromSoundFiles (soundFilePathsInFolder (folder, fileGlobber).get());
+	CREATE_ONE_END (name)
+}
+
 FORM_READ (READ1_Sound_readFromRawAlawFile, U"Read Sound from raw Alaw file", nullptr, true) {
 	READ_ONE
 		autoSound result = Sound_readFromRawAlawFile (file);
@@ -1886,6 +1993,12 @@ FORM_SAVE (SAVE_ONE__Sound_saveAsRaw32bitLittleEndianFile, U"Save as raw 32-bit
 	SAVE_ONE_END
 }
 
+FORM_SAVE (SAVE_ONE__Sound_saveAsMappableBinaryFile, U"Save as mappable binary file", nullptr, U"Sound") {
+	SAVE_ONE (Sound)
+		Matrix_writeToMappableBinaryFile (me, file);
+	SAVE_ONE_END
+}
+
 FORM_SAVE (SAVE_ONE__Sound_saveAsSesamFile, U"Save as Sesam file", nullptr, U"sdf") {
 	SAVE_ONE (Sound)
 		Sound_saveAsSesamFile (me, file);
@@ -2113,6 +2226,7 @@ void praat_Sound_init () {
 	structSoundRecorder           :: f_preferences ();
 	structFunctionEditor          :: f_preferences ();
 	LongSound_preferences ();
+	AnalysisCache_preferences ();
 
 	Melder_setRecordProc (recordProc);
 	Melder_setRecordFromFileProc (recordFromFileProc);
@@ -2143,6 +2257,10 @@ void praat_Sound_init () {
 	praat_addMenuCommand (U"Objects", U"Open", U"Open long sound file...", nullptr, 'L', READ1_LongSound_open);
 	praat_addMenuCommand (U"Objects", U"Open", U"Read separate channels from sound file...", nullptr, 0,
 			READ_MULTIPLE__Sound_readSeparateChannelsFromSoundFile);
+	praat_addMenuCommand (U"Objects", U"Open", U"Read Sounds from sound files...", nullptr, 0,
+			READ_MULTIPLE__Sounds_readFromSoundFiles);
+	praat_addMenuCommand (U"Objects", U"Open", U"Read SoundSet from sound files...", nullptr, 0,
+			READ1_SoundSet_readFromSoundFiles);
 	praat_addMenuCommand (U"Objects", U"Open", U"Read two Sounds from stereo file...", nullptr, GuiMenu_DEPRECATED_2010,
 			READ_MULTIPLE__Sound_readSeparateChannelsFromSoundFile);
 	praat_addMenuCommand (U"Objects", U"Open", U"Read from special sound file", nullptr, 0, nullptr);
@@ -2158,6 +2276,12 @@ void praat_Sound_init () {
 			SETTINGS__SoundPlayingSettings);   // alternative GuiMenu_DEPRECATED_2023
 	praat_addMenuCommand (U"Objects", U"Settings", U"LongSound settings... || LongSound preferences...", nullptr, 0,
 			SETTINGS__LongSoundSettings);   // alternative GuiMenu_DEPRECATED_2023
+	praat_addMenuCommand (U"Objects", U"Settings", U"Analysis cache settings...", nullptr, 0,
+			SETTINGS__AnalysisCacheSettings);
+	praat_addMenuCommand (U"Objects", U"Technical", U"Report analysis cache", U"Report memory use", 0,
+			INFO_NONE__Praat_reportAnalysisCache);
+	praat_addMenuCommand (U"Objects", U"Technical", U"Clear analysis cache", U"Report analysis cache", 0,
+			PRAAT__clearAnalysisCache);
 #ifdef HAVE_PULSEAUDIO
 	praat_addMenuCommand (U"Objects", U"Technical", U"Report sound server properties", U"Report system properties", 0,
 			INFO_NONE__Praat_reportSoundServerProperties);
@@ -2170,6 +2294,7 @@ void praat_Sound_init () {
 	praat_addAction1 (classLongSound, 1,   U"Open", U"*View", GuiMenu_DEPRECATED_2011,
 			EDITOR_ONE__LongSound_view);
 	praat_addAction1 (classLongSound, 0, U"Play part...", nullptr, 0, PLAY_LongSound_playPart);
+	praat_addAction1 (classLongSound, 0, U"Draw...", nullptr, 0, GRAPHICS_EACH__LongSound_draw);
 	praat_addAction1 (classLongSound, 1, U"Query -", nullptr, 0, nullptr);
 		praat_TimeFunction_query_init (classLongSound);
 		praat_addAction1 (classLongSound, 1, U"Sampling", nullptr, 1, nullptr);
@@ -2183,6 +2308,9 @@ void praat_Sound_init () {
 				nullptr, 2, REAL_LongSound_getTimeFromIndex);   // alternative GuiMenu_DEPRECATED_2004
 		praat_addAction1 (classLongSound, 1, U"Get sample number from time... || Get index from time...",
 				nullptr, 2, REAL_LongSound_getIndexFromTime);   // alternative GuiMenu_DEPRECATED_2004
+		praat_addAction1 (classLongSound, 1, U"Amplitude", nullptr, 1, nullptr);
+		praat_addAction1 (classLongSound, 1, U"Get minimum...", nullptr, 2, REAL_LongSound_getMinimum);
+		praat_addAction1 (classLongSound, 1, U"Get maximum...", nullptr, 2, REAL_LongSound_getMaximum);
 	praat_addAction1 (classLongSound, 0, U"Annotate -", nullptr, 0, nullptr);
 		praat_addAction1 (classLongSound, 0, U"Annotation tutorial", nullptr, 1,
 				HELP__AnnotationTutorial);
@@ -2282,6 +2410,8 @@ void praat_Sound_init () {
 			SAVE_ONE__Sound_saveAsRaw32bitBigEndianFile);
 	praat_addAction1 (classSound, 1, U"Save as raw 32-bit little-endian file...", nullptr, 0,
 			SAVE_ONE__Sound_saveAsRaw32bitLittleEndianFile);
+	praat_addAction1 (classSound, 1, U"Save as mappable binary file...", nullptr, 0,
+			SAVE_ONE__Sound_saveAsMappableBinaryFile);
 	praat_addAction1 (classSound, 0, U"Sound help", nullptr, 0,
 			HELP__Sound_help);
 	praat_addAction1 (classSound, 1, U"View & Edit || Edit || Open",
@@ -27,6 +27,16 @@
 #include "EditorM.h"
 #include "praat_script.h"
 
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <set>
+#include <tuple>
+#include <functional>
+#include <system_error>
+
 Thing_implement (SoundAnalysisArea, FunctionArea, 0);
 
 #include "enums_getText.h"
@@ -49,12 +59,548 @@ void structSoundAnalysisArea :: v_reset_analysis () {
 	our d_pulses. reset();
 }
 
+#pragma mark - SoundAnalysisArea tiles
+
+/*
+	The analyses are computed in tiles: stretches of the sound with a fixed duration,
+	namely the power of two that is at least one eighth of the duration of the window.
+	Each tile is analysed separately, with the same margins as the whole window was analysed with before,
+	so that scrolling requires only the analysis of the tiles that come into view.
+
+	The tiles are cached per analysis, together with the settings they were computed with;
+	if the settings change (including the time step and the tile duration, which can depend on the zoom level),
+	the tiles of that analysis are thrown away. If the data change, all tiles are thrown away.
+
+	The tiles are computed by a background thread. Tiles that have gone out of view
+	before they could be computed are taken off the queue. A timer on the main thread collects the finished tiles
+	and redraws the editor window, so that the analyses appear tile by tile.
+
+	For display in the editor window, d_spectrogram, d_pitch, d_intensity, d_formant and d_pulses are assembled from the tiles,
+	on a time grid that is anchored at the start of the sound (so that it does not shift when the window scrolls),
+	by taking for every frame the nearest frame of the tile that contains its time.
+	Such an assembled analysis is close to, but not identical to, the analysis of the whole window,
+	so it is used for nothing but drawing into the editor window.
+	Queries, extractions and drawing to the Picture window analyse the whole window synchronously and exactly,
+	and so does the editor window in batch mode, where no background thread is used.
+*/
+
+#define TILES_IN_BACKGROUND  (gtk || motif || cocoa)
+
+enum {
+	TILE_SPECTROGRAM, TILE_PITCH, TILE_INTENSITY, TILE_FORMANT, TILE_PULSES,
+	NUMBER_OF_TILE_ANALYSES
+};
+
+#define MAXIMUM_NUMBER_OF_CACHED_TILES  64   // per analysis
+
+using SoundAnalysisTileFunction = std::function <autoDaata (Sound sound, Pitch pitch)>;
+
+struct SoundAnalysisTileJob {
+	int analysis;
+	integer tileNumber;
+	integer generation;
+	std::vector <double> settings;
+	SoundAnalysisTileFunction compute;   // must not refer to the SoundAnalysisArea, because it runs in the background thread
+	autoSound sound;
+	autoPitch pitch;   // only for pulses
+	autoDaata result;   // null if the analysis failed
+};
+
+struct SoundAnalysisTileCache {
+	std::vector <double> settings;   // the tile duration first
+	std::map <integer, autoDaata> tiles;   // null if the analysis of that tile failed
+	bool analysisIsAssembled;   // whether the current analysis (e.g. d_pitch) was assembled from tiles rather than computed exactly
+};
+
+struct SoundAnalysisTiles {
+	SoundAnalysisTileCache caches [NUMBER_OF_TILE_ANALYSES];
+	integer generation = 1;   // raised whenever the data change
+	/*
+		The tiles that are queued or being computed, by analysis, tile number, generation and settings,
+		so that a stale job that finishes cannot remove the entry of the job that replaced it.
+	*/
+	std::set <std::tuple <int, integer, integer, std::vector <double>>> requested;
+
+	/*
+		Shared with the background thread.
+	*/
+	std::mutex mutex;
+	std::condition_variable jobAvailable;
+	std::deque <std::unique_ptr <SoundAnalysisTileJob>> queue;
+	std::vector <std::unique_ptr <SoundAnalysisTileJob>> finished;
+	bool stopping = false;
+	std::thread worker;
+
+	bool timerIsRunning = false;
+	#if cocoa
+		CFRunLoopTimerRef cocoaTimer;
+	#elif gtk
+		guint gtkTimer;
+	#elif motif
+		XtIntervalId motifTimer;
+	#endif
+};
+
+static void SoundAnalysisTileJob_run (SoundAnalysisTileJob *me) {
+	try {
+		my result = my compute (my sound.get(), my pitch.get());
+	} catch (MelderError) {
+		Melder_clearError ();   // a failed tile stays null, just as a failed analysis of the whole window does
+	}
+}
+
+static void SoundAnalysisTiles_work (SoundAnalysisTiles *me) {
+	for (;;) {
+		std::unique_ptr <SoundAnalysisTileJob> job;
+		{
+			std::unique_lock <std::mutex> lock (my mutex);
+			my jobAvailable.wait (lock, [me] { return my stopping || ! my queue.empty (); });
+			if (my stopping)
+				return;
+			job = std::move (my queue.front ());
+			my queue.pop_front ();
+		}
+		SoundAnalysisTileJob_run (job.get());
+		std::lock_guard <std::mutex> lock (my mutex);
+		my finished.push_back (std::move (job));
+	}
+}
+
+static bool analysisIsAssembled (SoundAnalysisArea me, int analysis) {
+	return my d_tiles && my d_tiles -> caches [analysis]. analysisIsAssembled;
+}
+
+static void SoundAnalysisArea_setAnalysisIsAssembled (SoundAnalysisArea me, int analysis, bool assembled) {
+	if (my d_tiles)
+		my d_tiles -> caches [analysis]. analysisIsAssembled = assembled;
+}
+
+static bool SoundAnalysisArea_collectTiles (SoundAnalysisArea me);
+
+#if cocoa
+	static void tilesTimer_cocoa (CFRunLoopTimerRef timer, void *void_me);
+#elif gtk
+	static gboolean tilesTimer_gtk (gpointer void_me);
+#elif motif
+	static void tilesTimer_motif (XtPointer void_me, XtIntervalId *id);
+#endif
+
+static void SoundAnalysisArea_startTilesTimer (SoundAnalysisArea me) {
+	if (my d_tiles -> timerIsRunning)
+		return;
+	my d_tiles -> timerIsRunning = true;
+	#if cocoa
+		CFRunLoopTimerContext context = { 0, me, nullptr, nullptr, nullptr };
+		my d_tiles -> cocoaTimer = CFRunLoopTimerCreate (nullptr, CFAbsoluteTimeGetCurrent () + 0.05,
+				0.05, 0, 0, tilesTimer_cocoa, & context);
+		CFRunLoopAddTimer (CFRunLoopGetCurrent (), my d_tiles -> cocoaTimer, kCFRunLoopCommonModes);
+	#elif gtk
+		my d_tiles -> gtkTimer = g_timeout_add (50, tilesTimer_gtk, me);
+	#elif motif
+		my d_tiles -> motifTimer = GuiAddTimeOut (50, tilesTimer_motif, me);
+	#endif
+}
+
+static void SoundAnalysisArea_stopTilesTimer (SoundAnalysisArea me) {
+	if (! my d_tiles -> timerIsRunning)
+		return;
+	#if cocoa
+		CFRunLoopTimerInvalidate (my d_tiles -> cocoaTimer);
+		CFRelease (my d_tiles -> cocoaTimer);
+	#elif gtk
+		g_source_remove (my d_tiles -> gtkTimer);
+	#elif motif
+		XtRemoveTimeOut (my d_tiles -> motifTimer);
+	#endif
+	my d_tiles -> timerIsRunning = false;
+}
+
+#if TILES_IN_BACKGROUND
+static void SoundAnalysisArea_forgetAssembledAnalyses (SoundAnalysisArea me) {
+	if (analysisIsAssembled (me, TILE_SPECTROGRAM))
+		my d_spectrogram. reset();
+	if (analysisIsAssembled (me, TILE_PITCH))
+		my d_pitch. reset();
+	if (analysisIsAssembled (me, TILE_INTENSITY))
+		my d_intensity. reset();
+	if (analysisIsAssembled (me, TILE_FORMANT))
+		my d_formant. reset();
+	if (analysisIsAssembled (me, TILE_PULSES))
+		my d_pulses. reset();
+}
+
+/*
+	Called by the timer: returns whether there are still tiles to wait for.
+*/
+static bool SoundAnalysisArea_pollTiles (SoundAnalysisArea me) {
+	if (SoundAnalysisArea_collectTiles (me)) {
+		SoundAnalysisArea_forgetAssembledAnalyses (me);   // so that they are assembled anew, now with the new tiles
+		FunctionEditor_redraw (my functionEditor());
+	}
+	return ! my d_tiles -> requested.empty ();
+}
+#endif
+
+#if cocoa
+	static void tilesTimer_cocoa (CFRunLoopTimerRef /* timer */, void *void_me) {
+		SoundAnalysisArea me = (SoundAnalysisArea) void_me;
+		if (! SoundAnalysisArea_pollTiles (me))
+			SoundAnalysisArea_stopTilesTimer (me);
+	}
+#elif gtk
+	static gboolean tilesTimer_gtk (gpointer void_me) {
+		SoundAnalysisArea me = (SoundAnalysisArea) void_me;
+		const bool waitForMore = SoundAnalysisArea_pollTiles (me);
+		if (! waitForMore)
+			my d_tiles -> timerIsRunning = false;   // returning false removes the timer
+		return waitForMore;
+	}
+#elif motif
+	static void tilesTimer_motif (XtPointer void_me, XtIntervalId * /* id */) {
+		SoundAnalysisArea me = (SoundAnalysisArea) void_me;
+		if (SoundAnalysisArea_pollTiles (me))
+			my d_tiles -> motifTimer = GuiAddTimeOut (50, tilesTimer_motif, me);   // a one-shot timer
+		else
+			my d_tiles -> timerIsRunning = false;
+	}
+#endif
+
+void structSoundAnalysisArea :: v9_destroy () noexcept {
+	if (our d_tiles) {
+		SoundAnalysisArea_stopTilesTimer (this);
+		if (our d_tiles -> worker.joinable ()) {
+			{
+				std::lock_guard <std::mutex> lock (our d_tiles -> mutex);
+				our d_tiles -> stopping = true;
+			}
+			our d_tiles -> jobAvailable.notify_one ();
+			our d_tiles -> worker.join ();   // waits for at most one tile
+		}
+		delete our d_tiles;
+		our d_tiles = nullptr;
+	}
+	SoundAnalysisArea_Parent :: v9_destroy ();
+}
+
+void SoundAnalysisArea_forgetTiles (SoundAnalysisArea me) {
+	if (! my d_tiles)
+		return;
+	my d_tiles -> generation += 1;   // so that the tile that may still be being computed will be ignored
+	{
+		std::lock_guard <std::mutex> lock (my d_tiles -> mutex);
+		my d_tiles -> queue.clear ();
+	}
+	my d_tiles -> requested.clear ();
+	for (int analysis = 0; analysis < NUMBER_OF_TILE_ANALYSES; analysis ++) {
+		my d_tiles -> caches [analysis]. settings.clear ();
+		my d_tiles -> caches [analysis]. tiles.clear ();
+		my d_tiles -> caches [analysis]. analysisIsAssembled = false;
+	}
+}
+
+static bool SoundAnalysisArea_collectTiles (SoundAnalysisArea me) {
+	std::vector <std::unique_ptr <SoundAnalysisTileJob>> finished;
+	{
+		std::lock_guard <std::mutex> lock (my d_tiles -> mutex);
+		finished.swap (my d_tiles -> finished);
+	}
+	for (auto& job : finished) {
+		my d_tiles -> requested.erase ({ job -> analysis, job -> tileNumber, job -> generation, job -> settings });
+		SoundAnalysisTileCache *cache = & my d_tiles -> caches [job -> analysis];
+		if (job -> generation == my d_tiles -> generation && job -> settings == cache -> settings)
+			cache -> tiles [job -> tileNumber] = std::move (job -> result);
+		/*
+			Else the tile is stale; a job for the current data and settings has an entry of its own in `requested`,
+			or will be queued by the redraw that follows.
+		*/
+	}
+	return ! finished.empty ();
+}
+
+static double SoundAnalysisArea_tileDuration (SoundAnalysisArea me) {
+	return pow (2.0, ceil (log2 ((my endWindow() - my startWindow()) / 8.0)));
+}
+
+static void SoundAnalysisArea_getVisibleTiles (SoundAnalysisArea me, double tileDuration, integer *firstTile, integer *lastTile) {
+	const double origin = my soundOrLongSound() -> xmin;
+	*firstTile = Melder_ifloor ((my startWindow() - origin) / tileDuration);
+	*lastTile = Melder_iceiling ((my endWindow() - origin) / tileDuration) - 1;
+	Melder_clipLeft (*firstTile, lastTile);
+}
+
+static void SoundAnalysisArea_getTileDomain (SoundAnalysisArea me, double tileDuration, integer tileNumber, double *tmin, double *tmax) {
+	*tmin = my soundOrLongSound() -> xmin + tileNumber * tileDuration;
+	*tmax = std::min (*tmin + tileDuration, my soundOrLongSound() -> xmax);
+}
+
+static void SoundAnalysisTileCache_evict (SoundAnalysisTileCache *me, integer firstVisibleTile, integer lastVisibleTile) {
+	while ((integer) my tiles.size () > MAXIMUM_NUMBER_OF_CACHED_TILES) {
+		/*
+			Throw away the tile that is farthest away from the window.
+		*/
+		const auto first = my tiles.begin (), last = std::prev (my tiles.end ());
+		if (firstVisibleTile - first -> first > last -> first - lastVisibleTile)
+			my tiles.erase (first);
+		else
+			my tiles.erase (last);
+	}
+}
+
+static autoSound extractSound (SoundAnalysisArea me, double tmin, double tmax);
+
+/*
+	Makes sure that the visible tiles of `analysis` are cached, or queued for the background thread.
+*/
+static void SoundAnalysisArea_haveTiles (SoundAnalysisArea me, int analysis, std::vector <double> const& settings,
+	double margin, SoundAnalysisTileFunction const& compute)
+{
+	if (! my d_tiles)
+		my d_tiles = new SoundAnalysisTiles;
+	SoundAnalysisTiles *tiles = my d_tiles;
+	SoundAnalysisArea_collectTiles (me);
+	SoundAnalysisTileCache *cache = & tiles -> caches [analysis];
+	if (settings != cache -> settings) {
+		cache -> settings = settings;
+		cache -> tiles.clear ();
+	}
+	const double tileDuration = settings [0];
+	integer firstTile, lastTile;
+	SoundAnalysisArea_getVisibleTiles (me, tileDuration, & firstTile, & lastTile);
+	/*
+		Take stale jobs off the queue.
+	*/
+	{
+		std::lock_guard <std::mutex> lock (tiles -> mutex);
+		for (auto job = tiles -> queue.begin (); job != tiles -> queue.end (); ) {
+			if ((*job) -> analysis == analysis && ((*job) -> tileNumber < firstTile || (*job) -> tileNumber > lastTile ||
+					(*job) -> settings != settings))
+			{
+				tiles -> requested.erase ({ analysis, (*job) -> tileNumber, (*job) -> generation, (*job) -> settings });
+				job = tiles -> queue.erase (job);
+			} else
+				job ++;
+		}
+	}
+	for (integer tileNumber = firstTile; tileNumber <= lastTile; tileNumber ++) {
+		if (cache -> tiles.count (tileNumber) > 0)
+			continue;
+		if (tiles -> requested.count ({ analysis, tileNumber, tiles -> generation, settings }) > 0)
+			continue;
+		auto job = std::make_unique <SoundAnalysisTileJob> ();
+		job -> analysis = analysis;
+		job -> tileNumber = tileNumber;
+		job -> generation = tiles -> generation;
+		job -> settings = settings;
+		job -> compute = compute;
+		if (analysis == TILE_PULSES) {
+			const auto pitchTile = tiles -> caches [TILE_PITCH]. tiles.find (tileNumber);
+			if (pitchTile == tiles -> caches [TILE_PITCH]. tiles.end ())
+				continue;   // not yet computed; this tile will be requested again after the pitch tile arrives
+			if (! pitchTile -> second) {
+				cache -> tiles [tileNumber] = autoDaata ();   // no pitch, so no pulses either
+				continue;
+			}
+			job -> pitch = Data_copy (static_cast <Pitch> (pitchTile -> second.get()));
+		}
+		double tmin, tmax;
+		SoundAnalysisArea_getTileDomain (me, tileDuration, tileNumber, & tmin, & tmax);
+		/*
+			A tile at the edge of the sound, where (part of) a margin is missing, is analysed together with
+			the stretch of sound next to it, so that it is never shorter than a tile with its margins.
+		*/
+		double from = tmin - margin, to = tmin + tileDuration + margin;
+		if (to > my soundOrLongSound() -> xmax) {
+			from -= to - my soundOrLongSound() -> xmax;
+			to = my soundOrLongSound() -> xmax;
+		}
+		if (from < my soundOrLongSound() -> xmin) {
+			to += my soundOrLongSound() -> xmin - from;
+			from = my soundOrLongSound() -> xmin;
+		}
+		job -> sound = extractSound (me, from, to);   // clips to the sound
+		{
+			std::lock_guard <std::mutex> lock (tiles -> mutex);
+			tiles -> queue.push_back (std::move (job));
+		}
+		tiles -> requested.insert ({ analysis, tileNumber, tiles -> generation, settings });
+		tiles -> jobAvailable.notify_one ();
+		if (! tiles -> worker.joinable ()) {
+			try {
+				tiles -> worker = std::thread (SoundAnalysisTiles_work, tiles);
+			} catch (std::system_error const& exception) {
+				Melder_throw (U"Cannot start the analysis thread: ", Melder_peek8to32 (exception.what ()), U".");
+			}
+		}
+		SoundAnalysisArea_startTilesTimer (me);
+	}
+	SoundAnalysisTileCache_evict (cache, firstTile, lastTile);
+}
+
+/*
+	The tile that contains the time `t`, or null if that tile is not (yet) available.
+*/
+static Sampled SoundAnalysisArea_getTile (SoundAnalysisArea me, int analysis, double t) {
+	SoundAnalysisTileCache *cache = & my d_tiles -> caches [analysis];
+	const double tileDuration = cache -> settings [0];
+	integer firstTile, lastTile;
+	SoundAnalysisArea_getVisibleTiles (me, tileDuration, & firstTile, & lastTile);
+	const integer tileNumber = Melder_clipped (firstTile,
+			Melder_ifloor ((t - my soundOrLongSound() -> xmin) / tileDuration), lastTile);
+	const auto tile = cache -> tiles.find (tileNumber);
+	return ( tile == cache -> tiles.end () ? nullptr : static_cast <Sampled> (tile -> second.get()) );
+}
+
+/*
+	The frame of `tile` nearest to `t`, or 0 if `t` lies outside the frames of `tile`.
+*/
+static integer Sampled_nearestFrame (Sampled tile, double t) {
+	if (! tile)
+		return 0;
+	const integer iframe = Melder_iround (Sampled_xToIndex (tile, t));
+	return ( iframe >= 1 && iframe <= tile -> nx ? iframe : 0 );
+}
+
+/*
+	Computes the time grid of the assembled analysis; returns a tile to take the time step and other attributes from,
+	or null if no visible tile is available.
+*/
+static Sampled SoundAnalysisArea_getAssemblyGrid (SoundAnalysisArea me, int analysis, integer *numberOfFrames, double *firstTime) {
+	SoundAnalysisTileCache *cache = & my d_tiles -> caches [analysis];
+	integer firstTile, lastTile;
+	SoundAnalysisArea_getVisibleTiles (me, cache -> settings [0], & firstTile, & lastTile);
+	Sampled model = nullptr;
+	for (auto tile = cache -> tiles.lower_bound (firstTile); tile != cache -> tiles.end () && tile -> first <= lastTile; tile ++) {
+		if (tile -> second) {
+			model = static_cast <Sampled> (tile -> second.get());
+			break;
+		}
+	}
+	if (! model)
+		return nullptr;
+	const double origin = my soundOrLongSound() -> xmin;
+	const integer firstFrame = Melder_iceiling ((my startWindow() - origin) / model -> dx);
+	const integer lastFrame = Melder_ifloor ((my endWindow() - origin) / model -> dx);
+	if (lastFrame < firstFrame)
+		return nullptr;
+	*numberOfFrames = lastFrame - firstFrame + 1;
+	*firstTime = origin + firstFrame * model -> dx;
+	return model;
+}
+
+static autoSpectrogram SoundAnalysisArea_assembleSpectrogram (SoundAnalysisArea me) {
+	integer numberOfFrames;
+	double firstTime;
+	const Spectrogram model = static_cast <Spectrogram> (SoundAnalysisArea_getAssemblyGrid (me, TILE_SPECTROGRAM, & numberOfFrames, & firstTime));
+	if (! model)
+		return autoSpectrogram ();
+	autoSpectrogram thee = Spectrogram_create (my startWindow(), my endWindow(), numberOfFrames, model -> dx, firstTime,
+			model -> ymin, model -> ymax, model -> ny, model -> dy, model -> y1);
+	for (integer iframe = 1; iframe <= numberOfFrames; iframe ++) {
+		const double t = Sampled_indexToX (thee.get(), iframe);
+		const Spectrogram tile = static_cast <Spectrogram> (SoundAnalysisArea_getTile (me, TILE_SPECTROGRAM, t));
+		const integer tileFrame = Sampled_nearestFrame (tile, t);
+		if (tileFrame != 0 && tile -> ny == thy ny)
+			thy z.column (iframe)  <<=  tile -> z.column (tileFrame);
+	}
+	return thee;
+}
+
+static autoPitch SoundAnalysisArea_assemblePitch (SoundAnalysisArea me) {
+	integer numberOfFrames;
+	double firstTime;
+	const Pitch model = static_cast <Pitch> (SoundAnalysisArea_getAssemblyGrid (me, TILE_PITCH, & numberOfFrames, & firstTime));
+	if (! model)
+		return autoPitch ();
+	autoPitch thee = Pitch_create (my startWindow(), my endWindow(), numberOfFrames, model -> dx, firstTime,
+			model -> ceiling, model -> maxnCandidates);
+	for (integer iframe = 1; iframe <= numberOfFrames; iframe ++) {
+		const double t = Sampled_indexToX (thee.get(), iframe);
+		const Pitch tile = static_cast <Pitch> (SoundAnalysisArea_getTile (me, TILE_PITCH, t));
+		const integer tileFrame = Sampled_nearestFrame (tile, t);
+		if (tileFrame != 0)
+			tile -> frames [tileFrame]. copy (& thy frames [iframe]);
+	}
+	return thee;
+}
+
+static autoIntensity SoundAnalysisArea_assembleIntensity (SoundAnalysisArea me) {
+	integer numberOfFrames;
+	double firstTime;
+	const Intensity model = static_cast <Intensity> (SoundAnalysisArea_getAssemblyGrid (me, TILE_INTENSITY, & numberOfFrames, & firstTime));
+	if (! model)
+		return autoIntensity ();
+	autoIntensity thee = Intensity_create (my startWindow(), my endWindow(), numberOfFrames, model -> dx, firstTime);
+	for (integer iframe = 1; iframe <= numberOfFrames; iframe ++) {
+		const double t = Sampled_indexToX (thee.get(), iframe);
+		const Intensity tile = static_cast <Intensity> (SoundAnalysisArea_getTile (me, TILE_INTENSITY, t));
+		const integer tileFrame = Sampled_nearestFrame (tile, t);
+		thy z [1] [iframe] = ( tileFrame != 0 ? tile -> z [1] [tileFrame] : undefined );
+	}
+	return thee;
+}
+
+static autoFormant SoundAnalysisArea_assembleFormant (SoundAnalysisArea me) {
+	integer numberOfFrames;
+	double firstTime;
+	const Formant model = static_cast <Formant> (SoundAnalysisArea_getAssemblyGrid (me, TILE_FORMANT, & numberOfFrames, & firstTime));
+	if (! model)
+		return autoFormant ();
+	autoFormant thee = Formant_create (my startWindow(), my endWindow(), numberOfFrames, model -> dx, firstTime,
+			model -> maxnFormants);
+	for (integer iframe = 1; iframe <= numberOfFrames; iframe ++) {
+		const double t = Sampled_indexToX (thee.get(), iframe);
+		const Formant tile = static_cast <Formant> (SoundAnalysisArea_getTile (me, TILE_FORMANT, t));
+		const integer tileFrame = Sampled_nearestFrame (tile, t);
+		if (tileFrame != 0)
+			tile -> frames [tileFrame]. copy (& thy frames [iframe]);
+	}
+	return thee;
+}
+
+static autoPointProcess SoundAnalysisArea_assemblePulses (SoundAnalysisArea me) {
+	SoundAnalysisTileCache *cache = & my d_tiles -> caches [TILE_PULSES];
+	const double tileDuration = cache -> settings [0];
+	integer firstTile, lastTile;
+	SoundAnalysisArea_getVisibleTiles (me, tileDuration, & firstTile, & lastTile);
+	autoPointProcess thee = PointProcess_create (my startWindow(), my endWindow(), 0);
+	bool pending = false, anyTile = false;
+	for (integer tileNumber = firstTile; tileNumber <= lastTile; tileNumber ++) {
+		const auto tile = cache -> tiles.find (tileNumber);
+		if (tile == cache -> tiles.end ()) {
+			pending = true;
+			continue;
+		}
+		if (! tile -> second)
+			continue;
+		anyTile = true;
+		double tmin, tmax;
+		SoundAnalysisArea_getTileDomain (me, tileDuration, tileNumber, & tmin, & tmax);
+		Melder_clipLeft (my startWindow(), & tmin);
+		Melder_clipRight (& tmax, my endWindow());
+		const PointProcess pulses = static_cast <PointProcess> (tile -> second.get());
+		for (integer ipoint = 1; ipoint <= pulses -> nt; ipoint ++) {
+			const double t = pulses -> t [ipoint];
+			if (t >= tmin && (t < tmax || (t == tmax && tmax == my endWindow())))
+				PointProcess_addPoint (thee.get(), t);
+		}
+	}
+	if (! anyTile && ! pending)
+		return autoPointProcess ();   // every tile failed
+	return thee;
+}
+
+
+#pragma mark - SoundAnalysisArea analysis
+
 /*
 	Some tryToCompute<Analysis>() functions.
 	The "try" means that any exceptions that are generated, will be ignored;
 	this is necessary because these functions have to be used in an editor window,
 	where they have to work in the background,
 	because they are not explicly called by a user action.
+	If `synchronous` is false (i.e. for drawing into the editor window), tiles that are not available yet
+	are left to the background thread, and the <Analysis> is assembled from the tiles that are available;
+	otherwise, the <Analysis> of the whole window is computed exactly.
 
 	Postcondition:
 		- If a tryToCompute<Analysis>() function fails, the <Analysis> should be null;
@@ -73,103 +619,177 @@ static autoSound extractSound (SoundAnalysisArea me, double tmin, double tmax) {
 	}
 	return sound;
 }
-static void tryToComputeSpectrogram (SoundAnalysisArea me) {
+/*
+	Whether the <Analysis> is to be assembled from tiles computed in the background (for display in the editor window),
+	rather than computed exactly for the whole window (for queries, extractions and drawing to the Picture window).
+*/
+static bool analysisComesFromTiles (bool synchronous) {
+	return TILES_IN_BACKGROUND && ! synchronous && ! Melder_batch;
+}
+static void tryToComputeSpectrogram (SoundAnalysisArea me, bool synchronous) {
 	autoMelderProgressOff progress;
 	const double margin = ( my instancePref_spectrogram_windowShape() == kSound_to_Spectrogram_windowShape::GAUSSIAN ?
 			my instancePref_spectrogram_windowLength() : 0.5 * my instancePref_spectrogram_windowLength() );
+	const double windowLength = my instancePref_spectrogram_windowLength();
+	const double maximumFrequency = my instancePref_spectrogram_viewTo();
+	const double timeStep = (my endWindow() - my startWindow()) / my instancePref_spectrogram_timeSteps();
+	const double frequencyStep = my instancePref_spectrogram_viewTo() / my instancePref_spectrogram_frequencySteps();
+	const kSound_to_Spectrogram_windowShape windowShape = my instancePref_spectrogram_windowShape();
 	try {
-		autoSound sound = extractSound (me, my startWindow() - margin, my endWindow() + margin);
-		my d_spectrogram = Sound_to_Spectrogram (sound.get(),
-			my instancePref_spectrogram_windowLength(),
-			my instancePref_spectrogram_viewTo(),
-			(my endWindow() - my startWindow()) / my instancePref_spectrogram_timeSteps(),
-			my instancePref_spectrogram_viewTo() / my instancePref_spectrogram_frequencySteps(),
-			my instancePref_spectrogram_windowShape(), 8.0, 8.0
-		);
-		my d_spectrogram -> xmin = my startWindow();
-		my d_spectrogram -> xmax = my endWindow();
+		if (analysisComesFromTiles (synchronous)) {
+			SoundAnalysisArea_haveTiles (me, TILE_SPECTROGRAM,
+				{ SoundAnalysisArea_tileDuration (me), windowLength, maximumFrequency, timeStep, frequencyStep, (double) (int) windowShape },
+				margin,
+				[=] (Sound sound, Pitch /* pitch */) -> autoDaata {
+					return Sound_to_Spectrogram (sound, windowLength, maximumFrequency, timeStep, frequencyStep, windowShape, 8.0, 8.0);
+				}
+			);
+			my d_spectrogram = SoundAnalysisArea_assembleSpectrogram (me);
+		} else {
+			autoSound sound = extractSound (me, my startWindow() - margin, my endWindow() + margin);
+			my d_spectrogram = Sound_to_Spectrogram (sound.get(), windowLength, maximumFrequency, timeStep, frequencyStep, windowShape, 8.0, 8.0);
+			my d_spectrogram -> xmin = my startWindow();
+			my d_spectrogram -> xmax = my endWindow();
+		}
+		SoundAnalysisArea_setAnalysisIsAssembled (me, TILE_SPECTROGRAM, analysisComesFromTiles (synchronous));
 	} catch (MelderError) {
 		my d_spectrogram. reset();   // signal a failure
 		Melder_clearError ();
 	}
 }
-static void tryToComputePitch (SoundAnalysisArea me) {
+static void tryToComputePitch (SoundAnalysisArea me, bool synchronous) {
 	autoMelderProgressOff progress;
 	const double margin = ( my instancePref_pitch_veryAccurate() ? 3.0 / my instancePref_pitch_floor() : 1.5 / my instancePref_pitch_floor() );
+	const double pitchTimeStep = (
+		my instancePref_timeStepStrategy() == kSoundAnalysisArea_timeStepStrategy::FIXED_ ? my instancePref_fixedTimeStep() :
+		my instancePref_timeStepStrategy() == kSoundAnalysisArea_timeStepStrategy::VIEW_DEPENDENT ? (my endWindow() - my startWindow()) / my instancePref_numberOfTimeStepsPerView() :
+		0.0   // the default: determined by pitch floor
+	);
+	const double pitchFloor = my instancePref_pitch_floor();
+	const double periodsPerWindow = ( my instancePref_pitch_method() == kSoundAnalysisArea_pitch_analysisMethod::AUTOCORRELATION ? 3.0 : 1.0 );
+	const integer maximumNumberOfCandidates = my instancePref_pitch_maximumNumberOfCandidates();
+	const int method = ((int) my instancePref_pitch_method() - 1) * 2 + my instancePref_pitch_veryAccurate();
+	const double silenceThreshold = my instancePref_pitch_silenceThreshold(), voicingThreshold = my instancePref_pitch_voicingThreshold();
+	const double octaveCost = my instancePref_pitch_octaveCost(), octaveJumpCost = my instancePref_pitch_octaveJumpCost();
+	const double voicedUnvoicedCost = my instancePref_pitch_voicedUnvoicedCost(), pitchCeiling = my instancePref_pitch_ceiling();
 	try {
-		autoSound sound = extractSound (me, my startWindow() - margin, my endWindow() + margin);
-		const double pitchTimeStep = (
-			my instancePref_timeStepStrategy() == kSoundAnalysisArea_timeStepStrategy::FIXED_ ? my instancePref_fixedTimeStep() :
-			my instancePref_timeStepStrategy() == kSoundAnalysisArea_timeStepStrategy::VIEW_DEPENDENT ? (my endWindow() - my startWindow()) / my instancePref_numberOfTimeStepsPerView() :
-			0.0   // the default: determined by pitch floor
-		);
-		my d_pitch = Sound_to_Pitch_any (sound.get(), pitchTimeStep,
-			my instancePref_pitch_floor(),
-			my instancePref_pitch_method() == kSoundAnalysisArea_pitch_analysisMethod::AUTOCORRELATION ? 3.0 : 1.0,
-			my instancePref_pitch_maximumNumberOfCandidates(),
-			((int) my instancePref_pitch_method() - 1) * 2 + my instancePref_pitch_veryAccurate(),
-			my instancePref_pitch_silenceThreshold(), my instancePref_pitch_voicingThreshold(),
-			my instancePref_pitch_octaveCost(), my instancePref_pitch_octaveJumpCost(),
-			my instancePref_pitch_voicedUnvoicedCost(), my instancePref_pitch_ceiling()
-		);
-		my d_pitch -> xmin = my startWindow();
-		my d_pitch -> xmax = my endWindow();
+		if (analysisComesFromTiles (synchronous)) {
+			SoundAnalysisArea_haveTiles (me, TILE_PITCH,
+				{ SoundAnalysisArea_tileDuration (me), pitchTimeStep, pitchFloor, periodsPerWindow, double (maximumNumberOfCandidates), double (method),
+					silenceThreshold, voicingThreshold, octaveCost, octaveJumpCost, voicedUnvoicedCost, pitchCeiling },
+				margin,
+				[=] (Sound sound, Pitch /* pitch */) -> autoDaata {
+					return Sound_to_Pitch_any (sound, pitchTimeStep, pitchFloor, periodsPerWindow, maximumNumberOfCandidates, method,
+							silenceThreshold, voicingThreshold, octaveCost, octaveJumpCost, voicedUnvoicedCost, pitchCeiling);
+				}
+			);
+			my d_pitch = SoundAnalysisArea_assemblePitch (me);
+		} else {
+			autoSound sound = extractSound (me, my startWindow() - margin, my endWindow() + margin);
+			my d_pitch = Sound_to_Pitch_any (sound.get(), pitchTimeStep, pitchFloor, periodsPerWindow, maximumNumberOfCandidates, method,
+					silenceThreshold, voicingThreshold, octaveCost, octaveJumpCost, voicedUnvoicedCost, pitchCeiling);
+			my d_pitch -> xmin = my startWindow();
+			my d_pitch -> xmax = my endWindow();
+		}
+		SoundAnalysisArea_setAnalysisIsAssembled (me, TILE_PITCH, analysisComesFromTiles (synchronous));
 	} catch (MelderError) {
 		my d_pitch. reset();   // signal a failure
 		Melder_clearError ();
 	}
 }
-static void tryToComputeIntensity (SoundAnalysisArea me) {
+static void tryToComputeIntensity (SoundAnalysisArea me, bool synchronous) {
 	autoMelderProgressOff progress;
 	const double margin = 3.2 / my instancePref_pitch_floor();
+	const double minimumPitch = my instancePref_pitch_floor();
+	const double timeStep = ( my endWindow() - my startWindow() > my instancePref_longestAnalysis() ? (my endWindow() - my startWindow()) / 100 : 0.0 );
+	const bool subtractMeanPressure = my instancePref_intensity_subtractMeanPressure();
 	try {
-		autoSound sound = extractSound (me, my startWindow() - margin, my endWindow() + margin);
-		my d_intensity = Sound_to_Intensity (sound.get(), my instancePref_pitch_floor(),
-			my endWindow() - my startWindow() > my instancePref_longestAnalysis() ? (my endWindow() - my startWindow()) / 100 : 0.0,
-			my instancePref_intensity_subtractMeanPressure()
-		);
-		my d_intensity -> xmin = my startWindow();
-		my d_intensity -> xmax = my endWindow();
+		if (analysisComesFromTiles (synchronous)) {
+			SoundAnalysisArea_haveTiles (me, TILE_INTENSITY,
+				{ SoundAnalysisArea_tileDuration (me), minimumPitch, timeStep, double (subtractMeanPressure) },
+				margin,
+				[=] (Sound sound, Pitch /* pitch */) -> autoDaata {
+					return Sound_to_Intensity (sound, minimumPitch, timeStep, subtractMeanPressure);
+				}
+			);
+			my d_intensity = SoundAnalysisArea_assembleIntensity (me);
+		} else {
+			autoSound sound = extractSound (me, my startWindow() - margin, my endWindow() + margin);
+			my d_intensity = Sound_to_Intensity (sound.get(), minimumPitch, timeStep, subtractMeanPressure);
+			my d_intensity -> xmin = my startWindow();
+			my d_intensity -> xmax = my endWindow();
+		}
+		SoundAnalysisArea_setAnalysisIsAssembled (me, TILE_INTENSITY, analysisComesFromTiles (synchronous));
 	} catch (MelderError) {
 		my d_intensity. reset();   // signal a failure
 		Melder_clearError ();
 	}
 }
-static void tryToComputeFormants (SoundAnalysisArea me) {
+static void tryToComputeFormants (SoundAnalysisArea me, bool synchronous) {
 	autoMelderProgressOff progress;
 	const double margin = my instancePref_formant_windowLength();
+	const double formantTimeStep = (
+		my instancePref_timeStepStrategy() == kSoundAnalysisArea_timeStepStrategy::FIXED_ ? my instancePref_fixedTimeStep() :
+		my instancePref_timeStepStrategy() == kSoundAnalysisArea_timeStepStrategy::VIEW_DEPENDENT ? (my endWindow() - my startWindow()) / my instancePref_numberOfTimeStepsPerView() :
+		0.0   // the default: determined by analysis window length
+	);
+	const integer numberOfPoles = Melder_iround (my instancePref_formant_numberOfFormants() * 2.0);
+	const double ceiling = my instancePref_formant_ceiling(), windowLength = my instancePref_formant_windowLength();
+	const int method = (int) my instancePref_formant_method();
+	const double preemphasisFrom = my instancePref_formant_preemphasisFrom();
 	try {
-		autoSound sound = ( my endWindow() - my startWindow() > my instancePref_longestAnalysis() ?
-			extractSound (me,
-				0.5 * (my startWindow() + my endWindow() - my instancePref_longestAnalysis()) - margin,
-				0.5 * (my startWindow() + my endWindow() + my instancePref_longestAnalysis()) + margin
-			) :
-			extractSound (me, my startWindow() - margin, my endWindow() + margin)
-		);
-		const double formantTimeStep = (
-			my instancePref_timeStepStrategy() == kSoundAnalysisArea_timeStepStrategy::FIXED_ ? my instancePref_fixedTimeStep() :
-			my instancePref_timeStepStrategy() == kSoundAnalysisArea_timeStepStrategy::VIEW_DEPENDENT ? (my endWindow() - my startWindow()) / my instancePref_numberOfTimeStepsPerView() :
-			0.0   // the default: determined by analysis window length
-		);
-		my d_formant = Sound_to_Formant_any (sound.get(), formantTimeStep,
-			Melder_iround (my instancePref_formant_numberOfFormants() * 2.0), my instancePref_formant_ceiling(),
-			my instancePref_formant_windowLength(), (int) my instancePref_formant_method(), my instancePref_formant_preemphasisFrom(), 50.0
-		);
-		my d_formant -> xmin = my startWindow();
-		my d_formant -> xmax = my endWindow();
+		if (analysisComesFromTiles (synchronous)) {
+			SoundAnalysisArea_haveTiles (me, TILE_FORMANT,
+				{ SoundAnalysisArea_tileDuration (me), formantTimeStep, double (numberOfPoles), ceiling, windowLength, double (method), preemphasisFrom },
+				margin,
+				[=] (Sound sound, Pitch /* pitch */) -> autoDaata {
+					return Sound_to_Formant_any (sound, formantTimeStep, numberOfPoles, ceiling, windowLength, method, preemphasisFrom, 50.0);
+				}
+			);
+			my d_formant = SoundAnalysisArea_assembleFormant (me);
+		} else {
+			autoSound sound = ( my endWindow() - my startWindow() > my instancePref_longestAnalysis() ?
+				extractSound (me,
+					0.5 * (my startWindow() + my endWindow() - my instancePref_longestAnalysis()) - margin,
+					0.5 * (my startWindow() + my endWindow() + my instancePref_longestAnalysis()) + margin
+				) :
+				extractSound (me, my startWindow() - margin, my endWindow() + margin)
+			);
+			my d_formant = Sound_to_Formant_any (sound.get(), formantTimeStep, numberOfPoles, ceiling, windowLength, method, preemphasisFrom, 50.0);
+			my d_formant -> xmin = my startWindow();
+			my d_formant -> xmax = my endWindow();
+		}
+		SoundAnalysisArea_setAnalysisIsAssembled (me, TILE_FORMANT, analysisComesFromTiles (synchronous));
 	} catch (MelderError) {
 		my d_formant. reset();   // signal a failure
 		Melder_clearError ();
 	}
 }
-static void tryToComputePulses (SoundAnalysisArea me) {
-	if (! my d_pitch)
-		tryToComputePitch (me);
+static void tryToComputePulses (SoundAnalysisArea me, bool synchronous) {
+	const bool fromTiles = analysisComesFromTiles (synchronous);
+	/*
+		Pulses from tiles need pitch tiles; exact pulses need the exact pitch.
+	*/
+	if (! my d_pitch || analysisIsAssembled (me, TILE_PITCH) != fromTiles)
+		tryToComputePitch (me, synchronous);
 	if (my d_pitch) {
 		autoMelderProgressOff progress;
+		const double margin = ( my instancePref_pitch_veryAccurate() ? 3.0 / my instancePref_pitch_floor() : 1.5 / my instancePref_pitch_floor() );
 		try {
-			autoSound sound = extractSound (me, my startWindow(), my endWindow());
-			my d_pulses = Sound_Pitch_to_PointProcess_cc (sound.get(), my d_pitch.get());
+			if (fromTiles) {
+				SoundAnalysisArea_haveTiles (me, TILE_PULSES,
+					my d_tiles -> caches [TILE_PITCH]. settings,   // the pulses depend on nothing but the pitch tiles
+					margin,
+					[] (Sound sound, Pitch pitch) -> autoDaata {
+						return Sound_Pitch_to_PointProcess_cc (sound, pitch);
+					}
+				);
+				my d_pulses = SoundAnalysisArea_assemblePulses (me);
+			} else {
+				autoSound sound = extractSound (me, my startWindow(), my endWindow());
+				my d_pulses = Sound_Pitch_to_PointProcess_cc (sound.get(), my d_pitch.get());
+			}
+			SoundAnalysisArea_setAnalysisIsAssembled (me, TILE_PULSES, fromTiles);
 		} catch (MelderError) {
 			my d_pulses. reset();   // signal a failure
 			Melder_clearError ();
@@ -183,26 +803,32 @@ static void tryToComputePulses (SoundAnalysisArea me) {
 	failure is again signalled by the Analysis being null.
 	The "have" means that these functions do nothing if the Analysis already exists,
 	but will (try to) create an Analysis if it does not exist.
+	If `synchronous` is true, an Analysis that was assembled from tiles is replaced with the exact Analysis.
 */
-static void tryToHaveSpectrogram (SoundAnalysisArea me) {
-	if (! my d_spectrogram && my endWindow() - my startWindow() <= my instancePref_longestAnalysis())
-		tryToComputeSpectrogram (me);
+static void tryToHaveSpectrogram (SoundAnalysisArea me, bool synchronous) {
+	if ((! my d_spectrogram || (synchronous && analysisIsAssembled (me, TILE_SPECTROGRAM))) &&
+			my endWindow() - my startWindow() <= my instancePref_longestAnalysis())
+		tryToComputeSpectrogram (me, synchronous);
 }
-static void tryToHavePitch (SoundAnalysisArea me) {
-	if (! my d_pitch && my endWindow() - my startWindow() <= my instancePref_longestAnalysis())
-		tryToComputePitch (me);
+static void tryToHavePitch (SoundAnalysisArea me, bool synchronous) {
+	if ((! my d_pitch || (synchronous && analysisIsAssembled (me, TILE_PITCH))) &&
+			my endWindow() - my startWindow() <= my instancePref_longestAnalysis())
+		tryToComputePitch (me, synchronous);
 }
-static void tryToHaveIntensity (SoundAnalysisArea me) {
-	if (! my d_intensity && my endWindow() - my startWindow() <= my instancePref_longestAnalysis())
-		tryToComputeIntensity (me);
+static void tryToHaveIntensity (SoundAnalysisArea me, bool synchronous) {
+	if ((! my d_intensity || (synchronous && analysisIsAssembled (me, TILE_INTENSITY))) &&
+			my endWindow() - my startWindow() <= my instancePref_longestAnalysis())
+		tryToComputeIntensity (me, synchronous);
 }
-static void tryToHaveFormants (SoundAnalysisArea me) {
-	if (! my d_formant && my endWindow() - my startWindow() <= my instancePref_longestAnalysis())
-		tryToComputeFormants (me);
+static void tryToHaveFormants (SoundAnalysisArea me, bool synchronous) {
+	if ((! my d_formant || (synchronous && analysisIsAssembled (me, TILE_FORMANT))) &&
+			my endWindow() - my startWindow() <= my instancePref_longestAnalysis())
+		tryToComputeFormants (me, synchronous);
 }
-static void tryToHavePulses (SoundAnalysisArea me) {
-	if (! my d_pulses && my endWindow() - my startWindow() <= my instancePref_longestAnalysis())
-		tryToComputePulses (me);
+static void tryToHavePulses (SoundAnalysisArea me, bool synchronous) {
+	if ((! my d_pulses || (synchronous && analysisIsAssembled (me, TILE_PULSES))) &&
+			my endWindow() - my startWindow() <= my instancePref_longestAnalysis())
+		tryToComputePulses (me, synchronous);
 }
 
 /*
@@ -219,35 +845,35 @@ static void tryToHavePulses (SoundAnalysisArea me) {
 void SoundAnalysisArea_haveVisibleSpectrogram (SoundAnalysisArea me) {
 	if (! my instancePref_spectrogram_show())
 		Melder_throw (U"No spectrogram is visible.\nFirst choose \"Show spectrogram\" from the Spectrogram menu.");
-	tryToHaveSpectrogram (me);
+	tryToHaveSpectrogram (me, true);
 	if (! my d_spectrogram)
 		Melder_throw (U"The spectrogram is not defined at the edge of the sound.");
 }
 void SoundAnalysisArea_haveVisiblePitch (SoundAnalysisArea me) {
 	if (! my instancePref_pitch_show())
 		Melder_throw (U"No pitch contour is visible.\nFirst choose \"Show pitch\" from the Pitch menu.");
-	tryToHavePitch (me);
+	tryToHavePitch (me, true);
 	if (! my d_pitch)
 		Melder_throw (U"The pitch contour is not defined at the edge of the sound.");
 }
 void SoundAnalysisArea_haveVisibleIntensity (SoundAnalysisArea me) {
 	if (! my instancePref_intensity_show())
 		Melder_throw (U"No intensity contour is visible.\nFirst choose \"Show intensity\" from the Intensity menu.");
-	tryToHaveIntensity (me);
+	tryToHaveIntensity (me, true);
 	if (! my d_intensity)
 		Melder_throw (U"The intensity curve is not defined at the edge of the sound.");
 }
 void SoundAnalysisArea_haveVisibleFormants (SoundAnalysisArea me) {
 	if (! my instancePref_formant_show())
 		Melder_throw (U"No formant contour is visible.\nFirst choose \"Show formants\" from the Formants menu.");
-	tryToHaveFormants (me);
+	tryToHaveFormants (me, true);
 	if (! my d_formant)
 		Melder_throw (U"The formants are not defined at the edge of the sound.");
 }
 void SoundAnalysisArea_haveVisiblePulses (SoundAnalysisArea me) {
 	if (! my instancePref_pulses_show())
 		Melder_throw (U"No pulses are visible.\nFirst choose \"Show pulses\" from the Pulses menu.");
-	tryToHavePulses (me);
+	tryToHavePulses (me, true);
 	if (! my d_pulses)
 		Melder_throw (U"The pulses are not defined at the edge of the sound.");
 }
@@ -1784,7 +2410,7 @@ static void SoundAnalysisArea_v_draw_analysis (SoundAnalysisArea me) {
 		return;
 	}
 	if (my instancePref_spectrogram_show())
-		tryToHaveSpectrogram (me);
+		tryToHaveSpectrogram (me, false);
 	if (my instancePref_spectrogram_show() && my d_spectrogram) {
 		Spectrogram_paintInside (my d_spectrogram.get(), my graphics(), my startWindow(), my endWindow(),
 			my instancePref_spectrogram_viewFrom(), my instancePref_spectrogram_viewTo(),
@@ -1794,7 +2420,7 @@ static void SoundAnalysisArea_v_draw_analysis (SoundAnalysisArea me) {
 		);
 	}
 	if (my instancePref_pitch_show())
-		tryToHavePitch (me);
+		tryToHavePitch (me, false);
 	if (my instancePref_pitch_show() && my d_pitch) {
 		const double periodsPerAnalysisWindow = ( my instancePref_pitch_method() == kSoundAnalysisArea_pitch_analysisMethod::AUTOCORRELATION ? 3.0 : 1.0 );
 		const double greatestNonUndersamplingTimeStep = 0.5 * periodsPerAnalysisWindow / my instancePref_pitch_floor();
@@ -1833,7 +2459,7 @@ static void SoundAnalysisArea_v_draw_analysis (SoundAnalysisArea me) {
 		Graphics_setColour (my graphics(), Melder_BLACK);
 	}
 	if (my instancePref_intensity_show())
-		tryToHaveIntensity (me);
+		tryToHaveIntensity (me, false);
 	if (my instancePref_intensity_show() && my d_intensity) {
 		Graphics_setColour (my graphics(), my instancePref_spectrogram_show() ? Melder_YELLOW : Melder_LIME);
 		Graphics_setLineWidth (my graphics(), my instancePref_spectrogram_show() ? 1.0 : 3.0);
@@ -1988,7 +2614,7 @@ void structSoundAnalysisArea :: v_draw_analysis () {
 
 void structSoundAnalysisArea :: v_draw_analysis_formants () {
 	if (our instancePref_formant_show())
-		tryToHaveFormants (this);
+		tryToHaveFormants (this, false);
 	if (our instancePref_formant_show() && our d_formant) {
 		Graphics_setSpeckleSize (our graphics(), our instancePref_formant_dotSize());
 		Formant_drawSpeckles_inside (our d_formant.get(), our graphics(), our startWindow(), our endWindow(),
@@ -2001,7 +2627,7 @@ void structSoundAnalysisArea :: v_draw_analysis_formants () {
 
 void structSoundAnalysisArea :: v_draw_analysis_pulses () {
 	if (our instancePref_pulses_show())
-		tryToHavePulses (this);
+		tryToHavePulses (this, false);
 	if (our instancePref_pulses_show() && our endWindow() - our startWindow() <= our instancePref_longestAnalysis() && our d_pulses) {
 		PointProcess point = our d_pulses.get();
 		Graphics_setWindow (our graphics(), our startWindow(), our endWindow(), -1.0, 1.0);
@@ -28,6 +28,11 @@
 
 #include "SoundAnalysisArea_enums.h"
 
+struct SoundAnalysisTiles;   // defined in SoundAnalysisArea.cpp
+
+Thing_declare (SoundAnalysisArea);
+void SoundAnalysisArea_forgetTiles (SoundAnalysisArea me);   // after a change in the data
+
 Thing_define (SoundAnalysisArea, FunctionArea) {
 	SampledXY soundOrLongSound() const { return static_cast <SampledXY> (our function()); }
 	Sound sound() const {
@@ -44,6 +49,7 @@ Thing_define (SoundAnalysisArea, FunctionArea) {
 	autoFormant d_formant;
 	autoPointProcess d_pulses;
 	GuiMenuItem spectrogramToggle, pitchToggle, intensityToggle, formantToggle, pulsesToggle;
+	SoundAnalysisTiles *d_tiles;   // the tiles from which the above analyses are assembled; created on first use
 
 	virtual bool v_hasSpectrogram () { return true; }
 	virtual bool v_hasPitch       () { return true; }
@@ -58,8 +64,11 @@ Thing_define (SoundAnalysisArea, FunctionArea) {
 	virtual void v_formantsInfo    () const;
 	virtual void v_pulsesInfo      () const;
 
+	void v9_destroy () noexcept
+		override;
 protected:
 	void v_computeAuxiliaryData () override {
+		SoundAnalysisArea_forgetTiles (this);
 		our v_reset_analysis ();
 	}
 
@@ -59,6 +59,101 @@ void structSoundArea :: v_drawInside () {
 	SoundArea_draw (this);
 }
 
+struct SoundAreaPeaksTimer {
+	bool isRunning = false;
+	#if cocoa
+		CFRunLoopTimerRef cocoaTimer;
+	#elif gtk
+		guint gtkTimer;
+	#elif motif
+		XtIntervalId motifTimer;
+	#endif
+};
+
+#if cocoa
+	static void peaksTimer_cocoa (CFRunLoopTimerRef timer, void *void_me);
+#elif gtk
+	static gboolean peaksTimer_gtk (gpointer void_me);
+#elif motif
+	static void peaksTimer_motif (XtPointer void_me, XtIntervalId *id);
+#endif
+
+static void SoundArea_startPeaksTimer (SoundArea me) {
+	if (! my d_peaksTimer)
+		my d_peaksTimer = new SoundAreaPeaksTimer;
+	if (my d_peaksTimer -> isRunning)
+		return;
+	my d_peaksTimer -> isRunning = true;
+	#if cocoa
+		CFRunLoopTimerContext context = { 0, me, nullptr, nullptr, nullptr };
+		my d_peaksTimer -> cocoaTimer = CFRunLoopTimerCreate (nullptr, CFAbsoluteTimeGetCurrent () + 0.1,
+				0.1, 0, 0, peaksTimer_cocoa, & context);
+		CFRunLoopAddTimer (CFRunLoopGetCurrent (), my d_peaksTimer -> cocoaTimer, kCFRunLoopCommonModes);
+	#elif gtk
+		my d_peaksTimer -> gtkTimer = g_timeout_add (100, peaksTimer_gtk, me);
+	#elif motif
+		my d_peaksTimer -> motifTimer = GuiAddTimeOut (100, peaksTimer_motif, me);
+	#endif
+}
+
+static void SoundArea_stopPeaksTimer (SoundArea me) {
+	if (! my d_peaksTimer || ! my d_peaksTimer -> isRunning)
+		return;
+	#if cocoa
+		CFRunLoopTimerInvalidate (my d_peaksTimer -> cocoaTimer);
+		CFRelease (my d_peaksTimer -> cocoaTimer);
+	#elif gtk
+		g_source_remove (my d_peaksTimer -> gtkTimer);
+	#elif motif
+		XtRemoveTimeOut (my d_peaksTimer -> motifTimer);
+	#endif
+	my d_peaksTimer -> isRunning = false;
+}
+
+/*
+	Called by the timer: returns whether the pyramid is still being built.
+*/
+static bool SoundArea_pollPeaks (SoundArea me) {
+	if (my longSound() && LongSound_isBuildingPeaks (my longSound()))
+		return true;
+	if (my longSound() && LongSound_havePeaks (my longSound()))
+		FunctionEditor_redraw (my functionEditor());   // replaces "(window longer than ... seconds)" with the envelope
+	return false;
+}
+
+#if cocoa
+	static void peaksTimer_cocoa (CFRunLoopTimerRef /* timer */, void *void_me) {
+		SoundArea me = (SoundArea) void_me;
+		if (! SoundArea_pollPeaks (me))
+			SoundArea_stopPeaksTimer (me);
+	}
+#elif gtk
+	static gboolean peaksTimer_gtk (gpointer void_me) {
+		SoundArea me = (SoundArea) void_me;
+		const bool waitForMore = SoundArea_pollPeaks (me);
+		if (! waitForMore)
+			my d_peaksTimer -> isRunning = false;   // returning false removes the timer
+		return waitForMore;
+	}
+#elif motif
+	static void peaksTimer_motif (XtPointer void_me, XtIntervalId * /* id */) {
+		SoundArea me = (SoundArea) void_me;
+		if (SoundArea_pollPeaks (me))
+			my d_peaksTimer -> motifTimer = GuiAddTimeOut (100, peaksTimer_motif, me);   // a one-shot timer
+		else
+			my d_peaksTimer -> isRunning = false;
+	}
+#endif
+
+void structSoundArea :: v9_destroy () noexcept {
+	if (our d_peaksTimer) {
+		SoundArea_stopPeaksTimer (this);
+		delete our d_peaksTimer;
+		our d_peaksTimer = nullptr;
+	}
+	SoundArea_Parent :: v9_destroy ();
+}
+
 void SoundArea_draw (SoundArea me) {
 	Melder_assert (!! my sound() != !! my longSound());
 
@@ -74,7 +169,22 @@ void SoundArea_draw (SoundArea me) {
 	const bool cursorVisible = ( my startSelection() == my endSelection() &&
 			my startSelection() >= my startWindow() && my startSelection() <= my endWindow() );
 	Graphics_setColour (my graphics(), Melder_BLACK);
-	if (my longSound() && my endWindow() - my startWindow() > my longSound() -> bufferLength) {
+	/*
+		A window longer than the buffer can still be drawn as an envelope,
+		once the LongSound has finished its peak pyramid, which we ask for here the first time such a window is shown.
+	*/
+	const bool windowIsLongerThanBuffer = my longSound() && my endWindow() - my startWindow() > my longSound() -> bufferLength;
+	if (windowIsLongerThanBuffer) {
+		try {
+			LongSound_requestPeaks (my longSound());
+		} catch (MelderError) {
+			Melder_clearError ();   // no envelope; we say that the window is too long
+		}
+	}
+	const bool usePeaks = windowIsLongerThanBuffer && LongSound_havePeaks (my longSound());
+	if (windowIsLongerThanBuffer && ! usePeaks && LongSound_isBuildingPeaks (my longSound()))
+		SoundArea_startPeaksTimer (me);   // redraws when the pyramid is ready
+	if (windowIsLongerThanBuffer && ! usePeaks) {
 		Graphics_setWindow (my graphics(), 0.0, 1.0, 0.0, 1.0);
 		Graphics_setColour (my graphics(), Melder_BLACK);
 		Graphics_setTextAlignment (my graphics(), Graphics_CENTRE, Graphics_BOTTOM);
@@ -86,7 +196,7 @@ void SoundArea_draw (SoundArea me) {
 	}
 	bool fits;
 	try {
-		fits = ( my sound() ? true : LongSound_haveWindow (my longSound(), my startWindow(), my endWindow()) );
+		fits = ( my sound() || usePeaks ? true : LongSound_haveWindow (my longSound(), my startWindow(), my endWindow()) );
 	} catch (MelderError) {
 		const bool outOfMemory = !! str32str (Melder_getError (), U"memory");
 		if (Melder_debug == 9)
@@ -250,6 +360,10 @@ void SoundArea_draw (SoundArea me) {
 			Graphics_setColour (my graphics(), DataGui_defaultForegroundColour (me, false));
 			Graphics_function (my graphics(), & my sound() -> z [ichan] [0], first, last,
 					Sampled_indexToX (my sound(), first), Sampled_indexToX (my sound(), last));
+		} else if (usePeaks) {
+			Graphics_setWindow (my graphics(), my startWindow(), my endWindow(), minimum, maximum);
+			Graphics_setColour (my graphics(), DataGui_defaultForegroundColour (me, false));
+			LongSound_drawPeaks (my longSound(), my graphics(), my startWindow(), my endWindow(), ichan);
 		} else {
 			Graphics_setWindow (my graphics(), my startWindow(), my endWindow(), minimum * 32768, maximum * 32768);
 			Graphics_setColour (my graphics(), DataGui_defaultForegroundColour (me, false));
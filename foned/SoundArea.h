@@ -53,6 +53,8 @@ private:
 	}
 };
 
+struct SoundAreaPeaksTimer;   // defined in SoundArea.cpp
+
 Thing_define (SoundArea, FunctionArea) {
 	/*
 		Accessors.
@@ -129,6 +131,13 @@ protected:
 		_computeMuteChannels ();
 	}
 
+	/*
+		While the peak pyramid of a LongSound is being built in the background,
+		a timer waits for it, so that the envelope is drawn as soon as it is ready.
+	*/
+public:
+	SoundAreaPeaksTimer *d_peaksTimer;   // created on first use
+
 public:
 	virtual conststring32 v_getChannelName (integer /* channelNumber */) { return nullptr; }
 
@@ -138,6 +147,8 @@ protected:
 public:
 	void v1_info ()
 		override;
+	void v9_destroy () noexcept
+		override;
 	bool v_mouse (GuiDrawingArea_MouseEvent event, double x_world, double localY_fraction)
 		override;
 	void v_createMenuItems_save (EditorMenu menu)
@@ -70,6 +70,11 @@ public:
 		return 30.0;
 	}
 	void v_updateText () override;
+	void v_invalidateAllDerivedDataCaches () override {
+		if (our textGrid())
+			TextGrid_invalidateIndexes (our textGrid());   // the data may have been edited in this editor or elsewhere
+		TextGridArea_Parent :: v_invalidateAllDerivedDataCaches ();
+	}
 
 	#include "TextGridArea_prefs.h"
 };
@@ -30,6 +30,7 @@
 #include "Network.h"
 #include "Matrix.h"
 #include "Formula.h"
+#include "MelderThread.h"
 
 #include "oo_DESTROY.h"
 #include "Network_def.h"
@@ -189,57 +190,119 @@ void Network_setClamping (Network me, integer nodeNumber, bool clamped) {
 	}
 }
 
+static void Network_updateIncidences (Network me) {
+	if (my numberOfIncidenceRows == my numberOfNodes + 1 && my numberOfIncidences == 2 * my numberOfConnections)
+		return;
+	autoINTVEC firstIncidence = zero_INTVEC (my numberOfNodes + 1);
+	for (integer iconn = 1; iconn <= my numberOfConnections; iconn ++) {
+		const NetworkConnection connection = & my connections [iconn];
+		Melder_require (connection -> nodeFrom >= 1 && connection -> nodeFrom <= my numberOfNodes &&
+				connection -> nodeTo >= 1 && connection -> nodeTo <= my numberOfNodes,
+			me, U": connection ", iconn, U" refers to a node that does not exist.");
+		firstIncidence [connection -> nodeFrom] += 1;
+		firstIncidence [connection -> nodeTo] += 1;
+	}
+	/*
+		Turn the counts into the starting positions of the rows.
+	*/
+	integer position = 1;
+	for (integer inode = 1; inode <= my numberOfNodes + 1; inode ++) {
+		const integer numberOfIncidencesOfThisNode = firstIncidence [inode];
+		firstIncidence [inode] = position;
+		position += numberOfIncidencesOfThisNode;
+	}
+	Melder_assert (position == 2 * my numberOfConnections + 1);
+	/*
+		Fill the rows in the order of the connection list,
+		so that the excitation of each node receives its contributions in the same order as before.
+	*/
+	autoINTVEC incidentConnection = raw_INTVEC (2 * my numberOfConnections);
+	autoINTVEC incidentNode = raw_INTVEC (2 * my numberOfConnections);
+	autoINTVEC nextIncidence = copy_INTVEC (firstIncidence.all());
+	for (integer iconn = 1; iconn <= my numberOfConnections; iconn ++) {
+		const NetworkConnection connection = & my connections [iconn];
+		const integer fromPosition = nextIncidence [connection -> nodeFrom] ++;
+		incidentConnection [fromPosition] = iconn;
+		incidentNode [fromPosition] = connection -> nodeTo;
+		const integer toPosition = nextIncidence [connection -> nodeTo] ++;
+		incidentConnection [toPosition] = iconn;
+		incidentNode [toPosition] = connection -> nodeFrom;
+	}
+	my firstIncidence = firstIncidence.move();
+	my incidentConnection = incidentConnection.move();
+	my incidentNode = incidentNode.move();
+	my numberOfIncidenceRows = my numberOfNodes + 1;
+	my numberOfIncidences = 2 * my numberOfConnections;
+}
+
+static inline double Network_clipActivity (Network me, double excitation, double activity) {
+	switch (my activityClippingRule) {
+		case kNetwork_activityClippingRule::SIGMOID:
+			return my minimumActivity +
+				(my maximumActivity - my minimumActivity) * NUMsigmoid (excitation - 0.5 * (my minimumActivity + my maximumActivity));
+		case kNetwork_activityClippingRule::LINEAR:
+			if (excitation < my minimumActivity)
+				return my minimumActivity;
+			if (excitation > my maximumActivity)
+				return my maximumActivity;
+			return excitation;
+		case kNetwork_activityClippingRule::TOP_SIGMOID:
+			if (excitation <= my minimumActivity)
+				return my minimumActivity;
+			return my minimumActivity +
+				(my maximumActivity - my minimumActivity) * (2.0 * NUMsigmoid (2.0 * (excitation - my minimumActivity) / (my maximumActivity - my minimumActivity)) - 1.0);
+		case kNetwork_activityClippingRule::UNDEFINED:
+			return activity;
+	}
+	return activity;
+}
+
 void Network_spreadActivities (Network me, integer numberOfSteps) {
+	if (numberOfSteps < 1 || my numberOfNodes < 1)
+		return;
+	Network_updateIncidences (me);
+	/*
+		The update is synchronous: every step reads the activities of the previous step
+		and writes the new ones into the other buffer, so that the nodes can be handled in parallel.
+		The excitation of a node is touched only by the thread that handles that node.
+	*/
+	autoVEC activityBuffer1 = raw_VEC (my numberOfNodes), activityBuffer2 = raw_VEC (my numberOfNodes);
+	for (integer inode = 1; inode <= my numberOfNodes; inode ++)
+		activityBuffer1 [inode] = my nodes [inode]. activity;
+	VEC activities = activityBuffer1.get(), newActivities = activityBuffer2.get();
+	/*
+		Copy the settings into locals: the compiler cannot keep them in registers by itself,
+		because the stores into the excitations might alias them.
+	*/
+	const double spreadingRate = my spreadingRate, activityDecay = my spreadingRate * my activityLeak;
+	const double shuntingBySign [2] = { 0.0, my shunting };   // only for excitatory connections; a lookup, because a branch on the sign of the weight is unpredictable
+	const constINTVEC firstIncidence = my firstIncidence.get(), incidentConnection = my incidentConnection.get(), incidentNode = my incidentNode.get();
+	const auto connections = my connections.get();
+	const integer numberOfThreads = MelderThread_getNumberOfThreadsToUse (my numberOfNodes, 10000);
 	for (integer istep = 1; istep <= numberOfSteps; istep ++) {
-		for (integer inode = 1; inode <= my numberOfNodes; inode ++) {
-			NetworkNode node = & my nodes [inode];
-			if (! node -> clamped)
-				node -> excitation -= my spreadingRate * my activityLeak * node -> excitation;
-		}
-		for (integer iconn = 1; iconn <= my numberOfConnections; iconn ++) {
-			NetworkConnection connection = & my connections [iconn];
-			NetworkNode nodeFrom = & my nodes [connection -> nodeFrom];
-			NetworkNode nodeTo = & my nodes [connection -> nodeTo];
-			const double shunting = ( my connections [iconn]. weight >= 0.0 ? my shunting : 0.0 );   // only for excitatory connections
-			if (! nodeFrom -> clamped)
-				nodeFrom -> excitation += my spreadingRate * nodeTo -> activity *
-						(my connections [iconn]. weight - shunting * nodeFrom -> excitation);
-			if (! nodeTo -> clamped)
-				nodeTo -> excitation += my spreadingRate * nodeFrom -> activity *
-						(my connections [iconn]. weight - shunting * nodeTo -> excitation);
-		}
-		for (integer inode = 1; inode <= my numberOfNodes; inode ++) {
-			NetworkNode node = & my nodes [inode];
-			if (! node -> clamped) {
-				switch (my activityClippingRule) {
-					case kNetwork_activityClippingRule::SIGMOID:
-						node -> activity = my minimumActivity +
-							(my maximumActivity - my minimumActivity) * NUMsigmoid (node -> excitation - 0.5 * (my minimumActivity + my maximumActivity));
-					break;
-					case kNetwork_activityClippingRule::LINEAR:
-						if (node -> excitation < my minimumActivity) {
-							node -> activity = my minimumActivity;
-						} else if (node -> excitation > my maximumActivity) {
-							node -> activity = my maximumActivity;
-						} else {
-							node -> activity = node -> excitation;
-						}
-					break;
-					case kNetwork_activityClippingRule::TOP_SIGMOID:
-						if (node -> excitation <= my minimumActivity) {
-							node -> activity = my minimumActivity;
-						} else {
-							node -> activity = my minimumActivity +
-								(my maximumActivity - my minimumActivity) * (2.0 * NUMsigmoid (2.0 * (node -> excitation - my minimumActivity) / (my maximumActivity - my minimumActivity)) - 1.0);
-							trace (U"excitation ", node -> excitation, U", activity ", node -> activity);
-						}
-					break;
-					case kNetwork_activityClippingRule::UNDEFINED:
-					break;
+		MelderThread_runChunks (numberOfThreads, my numberOfNodes, [&] (integer /* ithread */, integer firstNode, integer lastNode) {
+			for (integer inode = firstNode; inode <= lastNode; inode ++) {
+				NetworkNode node = & my nodes [inode];
+				if (node -> clamped) {
+					newActivities [inode] = activities [inode];
+					continue;
+				}
+				double excitation = node -> excitation;
+				excitation -= activityDecay * excitation;
+				const integer endOfRow = firstIncidence [inode + 1];
+				for (integer incidence = firstIncidence [inode]; incidence < endOfRow; incidence ++) {
+					const double weight = connections [incidentConnection [incidence]]. weight;
+					const double shunting = shuntingBySign [weight >= 0.0];
+					excitation += spreadingRate * activities [incidentNode [incidence]] * (weight - shunting * excitation);
 				}
+				node -> excitation = excitation;
+				newActivities [inode] = Network_clipActivity (me, excitation, activities [inode]);
 			}
-		}
+		});
+		std::swap (activities, newActivities);
 	}
+	for (integer inode = 1; inode <= my numberOfNodes; inode ++)
+		my nodes [inode]. activity = activities [inode];
 }
 
 void Network_zeroActivities (Network me, integer fromNode, integer toNode) {
@@ -263,15 +326,19 @@ void Network_normalizeActivities (Network me, integer fromNode, integer toNode)
 }
 
 void Network_updateWeights (Network me) {
-	for (integer iconn = 1; iconn <= my numberOfConnections; iconn ++) {
-		NetworkConnection connection = & my connections [iconn];
-		NetworkNode nodeFrom = & my nodes [connection -> nodeFrom];
-		NetworkNode nodeTo = & my nodes [connection -> nodeTo];
-		connection -> weight += connection -> plasticity * my learningRate *
-				(nodeFrom -> activity * nodeTo -> activity -
-				 (my instar * nodeTo -> activity + my outstar * nodeFrom -> activity + my weightLeak) * connection -> weight);
-		Melder_clip (my minimumWeight, & connection -> weight, my maximumWeight);
-	}
+	Network_updateIncidences (me);   // checks that every connection refers to existing nodes (a Network read from a file may not)
+	const integer numberOfThreads = MelderThread_getNumberOfThreadsToUse (my numberOfConnections, 10000);
+	MelderThread_runChunks (numberOfThreads, my numberOfConnections, [&] (integer /* ithread */, integer firstConnection, integer lastConnection) {
+		for (integer iconn = firstConnection; iconn <= lastConnection; iconn ++) {
+			NetworkConnection connection = & my connections [iconn];
+			NetworkNode nodeFrom = & my nodes [connection -> nodeFrom];
+			NetworkNode nodeTo = & my nodes [connection -> nodeTo];
+			connection -> weight += connection -> plasticity * my learningRate *
+					(nodeFrom -> activity * nodeTo -> activity -
+					 (my instar * nodeTo -> activity + my outstar * nodeFrom -> activity + my weightLeak) * connection -> weight);
+			Melder_clip (my minimumWeight, & connection -> weight, my maximumWeight);
+		}
+	});
 }
 
 void Network_normalizeWeights (Network me, integer fromNode, integer toNode, integer nodeFromMin, integer nodeFromMax, double newSum) {
@@ -468,6 +535,8 @@ void Network_addNode (Network me, double x, double y, double activity, bool clam
 
 void Network_addConnection (Network me, integer nodeFrom, integer nodeTo, double weight, double plasticity) {
 	try {
+		my checkNodeNumber (nodeFrom);
+		my checkNodeNumber (nodeTo);
 		Melder_assert (my connections.size == my numberOfConnections);
 		NetworkConnection connection = my connections. append ();
 		my numberOfConnections += 1;   // maintain invariant
@@ -110,6 +110,20 @@ oo_DEFINE_CLASS (Network, Daata)
 	oo_INTEGER (numberOfConnections)
 	oo_STRUCTVEC (NetworkConnection, connections, numberOfConnections)
 
+	#if ! oo_READING && ! oo_WRITING && ! oo_COMPARING
+		/*
+			The connections of each node, in compressed sparse row layout:
+			the connections that touch node `inode` are incidentConnection [firstIncidence [inode] .. firstIncidence [inode + 1] - 1],
+			in the order of the connection list, and incidentNode contains the nodes at their other ends.
+			The lists are up to date if there are numberOfNodes + 1 rows and 2 * numberOfConnections incidences.
+		*/
+		oo_INTEGER (numberOfIncidenceRows)
+		oo_INTVEC (firstIncidence, numberOfIncidenceRows)
+		oo_INTEGER (numberOfIncidences)
+		oo_INTVEC (incidentConnection, numberOfIncidences)
+		oo_INTVEC (incidentNode, numberOfIncidences)
+	#endif
+
 	#if oo_DECLARING
 		void v1_info ()
 			override;
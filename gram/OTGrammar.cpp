@@ -73,6 +73,10 @@
  */
 
 #include "OTGrammar.h"
+#include "Distributions_and_Strings.h"
+#include "MelderThread.h"
+#include <atomic>
+#include <map>
 
 #include "oo_DESTROY.h"
 #include "OTGrammar_def.h"
@@ -458,6 +462,177 @@ int OTGrammar_compareCandidates (OTGrammar me, integer itab1, integer icand1, in
 	return 0;   // the two total disharmonies are equal
 }
 
+/*
+	Rank-ordered keys.
+
+	Under OPTIMALITY_THEORY, comparing two candidates means comparing their numbers of violations
+	stratum by stratum (tied constraints count as one stratum), from the highest-ranked stratum downward.
+	For a given stratification, we pack each candidate's violation counts into a few 63-bit words,
+	with the highest-ranked stratum in the most significant bits of the first word,
+	so that comparing two candidates becomes comparing a few integers.
+	Every stratum gets just enough bits for the largest number of violations that any candidate can incur in it.
+
+	The layout of the keys changes only if the stratification changes, which is checked in O(numberOfConstraints)
+	at the start of every evaluation; the keys of a tableau are recomputed
+	only when the tableau is evaluated under a different layout than the one they were computed for.
+	Computing the keys of a tableau costs a few evaluations the old way, so as long as the stratification
+	keeps changing (as with evaluation noise between closely ranked constraints),
+	the candidates are compared the old way instead, by OTGrammar_compareCandidates ().
+*/
+#define OTGrammar_MINIMUM_KEY_LAYOUT_AGE  4
+static bool OTGrammar_updateKeyLayout (OTGrammar me) {
+	if (my decisionStrategy != kOTGrammar_decisionStrategy::OPTIMALITY_THEORY)
+		return false;
+	const integer numberOfConstraints = my numberOfConstraints;
+	if (my maximumMarks.size != numberOfConstraints) {
+		my maximumMarks = zero_INTVEC (numberOfConstraints);
+		for (integer itab = 1; itab <= my numberOfTableaus; itab ++) {
+			const OTGrammarTableau tableau = & my tableaus [itab];
+			for (integer icand = 1; icand <= tableau -> numberOfCandidates; icand ++) {
+				constINTVEC marks = tableau -> candidates [icand]. marks.get();
+				for (integer icons = 1; icons <= numberOfConstraints; icons ++)
+					if (my maximumMarks [icons] >= 0)
+						my maximumMarks [icons] = ( marks [icons] < 0 ? -1 : std::max (my maximumMarks [icons], marks [icons]) );
+			}
+		}
+		my keyIndex. reset ();   // force a new layout
+	}
+	for (integer icons = 1; icons <= numberOfConstraints; icons ++)
+		if (my maximumMarks [icons] < 0)
+			return false;   // negative violations (never in practice)
+	bool layoutHasChanged = ( my keyIndex.size != numberOfConstraints );
+	for (integer icons = 1; icons <= numberOfConstraints && ! layoutHasChanged; icons ++)
+		layoutHasChanged = ( my keyIndex [icons] != my index [icons] ||
+				my keyTiedToTheRight [icons] != my constraints [my index [icons]]. tiedToTheRight );
+	if (! layoutHasChanged) {
+		my keyLayoutAge += 1;
+		return true;
+	}
+	if (my keyIndex.size != numberOfConstraints) {
+		my keyIndex = raw_INTVEC (numberOfConstraints);
+		my keyTiedToTheRight = raw_BOOLVEC (numberOfConstraints);
+		my keyWord = raw_INTVEC (numberOfConstraints);
+		my keyShift = raw_INTVEC (numberOfConstraints);
+	}
+	integer numberOfWords = 0, numberOfFreeBits = 0, maximumStratumMarks = 0;
+	for (integer icons = 1; icons <= numberOfConstraints; icons ++) {
+		my keyIndex [icons] = my index [icons];
+		my keyTiedToTheRight [icons] = my constraints [my index [icons]]. tiedToTheRight;
+		my keyWord [icons] = 0;
+		my keyShift [icons] = 0;
+		maximumStratumMarks += my maximumMarks [my index [icons]];
+		if (my keyTiedToTheRight [icons])
+			continue;   // not the last constraint of its stratum
+		integer numberOfBits = 0;
+		while ((integer (1) << numberOfBits) <= maximumStratumMarks)   // numberOfBits < 63 guaranteed because marks are 16-bit
+			numberOfBits ++;
+		if (numberOfBits > 0) {
+			if (numberOfBits > numberOfFreeBits) {
+				numberOfWords += 1;
+				numberOfFreeBits = 63;
+			}
+			numberOfFreeBits -= numberOfBits;
+			my keyWord [icons] = numberOfWords;
+			my keyShift [icons] = numberOfFreeBits;
+		}
+		maximumStratumMarks = 0;
+	}
+	my numberOfKeyWords = numberOfWords;
+	my keyStamp += 1;
+	my keyLayoutAge = 0;
+	return true;
+}
+
+static void OTGrammar_updateKeys (OTGrammar me, integer itab) {
+	const OTGrammarTableau tableau = & my tableaus [itab];
+	const integer numberOfWords = my numberOfKeyWords, numberOfKeys = tableau -> numberOfCandidates * numberOfWords;
+	if (tableau -> keyStamp == my keyStamp && tableau -> numberOfKeys == numberOfKeys)
+		return;
+	if (tableau -> keys.size != numberOfKeys) {
+		tableau -> keys = raw_INTVEC (numberOfKeys);
+		tableau -> numberOfKeys = numberOfKeys;
+	}
+	integer *key = tableau -> keys.cells;
+	for (integer icand = 1; icand <= tableau -> numberOfCandidates; icand ++, key += numberOfWords) {
+		constINTVEC marks = tableau -> candidates [icand]. marks.get();
+		for (integer iword = 0; iword < numberOfWords; iword ++)
+			key [iword] = 0;
+		integer stratumMarks = 0;
+		for (integer icons = 1; icons <= my numberOfConstraints; icons ++) {
+			stratumMarks += marks [my keyIndex [icons]];
+			if (! my keyTiedToTheRight [icons]) {
+				if (my keyWord [icons] != 0)
+					key [my keyWord [icons] - 1] |= stratumMarks << my keyShift [icons];
+				stratumMarks = 0;
+			}
+		}
+	}
+	tableau -> keyStamp = my keyStamp;
+}
+
+/*
+	Calls `function` with a fast comparison function for the candidates of tableau `itab`,
+	equivalent to OTGrammar_compareCandidates () for the current rankings and disharmonies:
+	rank-ordered keys under OPTIMALITY_THEORY (if the stratification has been stable for a while),
+	and under the weighted decision strategies
+	the total disharmony of each candidate, computed once (with the same arithmetic as in OTGrammar_compareCandidates ())
+	into buffers that the grammar keeps, so that no memory is allocated once their sizes are known.
+	The comparison function is valid only until the next change in the disharmonies.
+*/
+template <typename Function>
+static auto OTGrammar_withCandidateComparison (OTGrammar me, integer itab, Function const& function) {
+	const OTGrammarTableau tableau = & my tableaus [itab];
+	if (OTGrammar_updateKeyLayout (me) &&
+		(tableau -> keyStamp == my keyStamp || my keyLayoutAge >= OTGrammar_MINIMUM_KEY_LAYOUT_AGE))
+	{
+		OTGrammar_updateKeys (me, itab);
+		const integer numberOfWords = my numberOfKeyWords;
+		const integer *keys = tableau -> keys.cells;
+		if (numberOfWords == 1)
+			return function ([keys] (integer icand1, integer icand2) -> int {
+				const integer key1 = keys [icand1 - 1], key2 = keys [icand2 - 1];
+				return ( key1 < key2 ? -1 : key1 > key2 ? +1 : 0 );
+			});
+		return function ([keys, numberOfWords] (integer icand1, integer icand2) -> int {
+			const integer *key1 = keys + (icand1 - 1) * numberOfWords, *key2 = keys + (icand2 - 1) * numberOfWords;
+			for (integer iword = 0; iword < numberOfWords; iword ++)
+				if (key1 [iword] != key2 [iword])
+					return ( key1 [iword] < key2 [iword] ? -1 : +1 );
+			return 0;
+		});
+	}
+	if (my decisionStrategy == kOTGrammar_decisionStrategy::OPTIMALITY_THEORY)
+		return function ([me, itab] (integer icand1, integer icand2) -> int {
+			return OTGrammar_compareCandidates (me, itab, icand1, itab, icand2);
+		});
+	if (my weights.size != my numberOfConstraints)
+		my weights = raw_VEC (my numberOfConstraints);
+	VEC weights = my weights.get();
+	for (integer icons = 1; icons <= my numberOfConstraints; icons ++) {
+		const double disharmony = my constraints [icons]. disharmony;
+		weights [icons] =
+			my decisionStrategy == kOTGrammar_decisionStrategy::LINEAR_OT ? ( disharmony > 0.0 ? disharmony : 0.0 ) :
+			my decisionStrategy == kOTGrammar_decisionStrategy::EXPONENTIAL_HG ||
+			my decisionStrategy == kOTGrammar_decisionStrategy::EXPONENTIAL_MAXIMUM_ENTROPY ? exp (disharmony) :
+			my decisionStrategy == kOTGrammar_decisionStrategy::POSITIVE_HG ? std::max (disharmony, 1.0) :
+			disharmony;
+	}
+	if (tableau -> disharmonies.size != tableau -> numberOfCandidates)
+		tableau -> disharmonies = raw_VEC (tableau -> numberOfCandidates);
+	VEC disharmonies = tableau -> disharmonies.get();
+	for (integer icand = 1; icand <= tableau -> numberOfCandidates; icand ++) {
+		constINTVEC marks = tableau -> candidates [icand]. marks.get();
+		double disharmony = 0.0;
+		for (integer icons = 1; icons <= my numberOfConstraints; icons ++)
+			disharmony += weights [icons] * marks [icons];
+		disharmonies [icand] = disharmony;
+	}
+	return function ([disharmonies] (integer icand1, integer icand2) -> int {
+		const double disharmony1 = disharmonies [icand1], disharmony2 = disharmonies [icand2];
+		return ( disharmony1 < disharmony2 ? -1 : disharmony1 > disharmony2 ? +1 : 0 );
+	});
+}
+
 static void _OTGrammar_fillInProbabilities (OTGrammar me, integer itab) {
 	OTGrammarTableau tableau = & my tableaus [itab];
 	double maximumHarmony = tableau -> candidates [1]. harmony;
@@ -484,10 +659,10 @@ static void _OTGrammar_fillInProbabilities (OTGrammar me, integer itab) {
 }
 
 integer OTGrammar_getWinner (OTGrammar me, integer itab) {
-	integer icand_best = 1;
 	if (my decisionStrategy == kOTGrammar_decisionStrategy::MAXIMUM_ENTROPY ||
 		my decisionStrategy == kOTGrammar_decisionStrategy::EXPONENTIAL_MAXIMUM_ENTROPY)
 	{
+		integer icand_best = 1;
 		_OTGrammar_fillInHarmonies (me, itab);
 		_OTGrammar_fillInProbabilities (me, itab);
 		double cutOff = NUMrandomUniform (0.0, 1.0);
@@ -499,10 +674,12 @@ integer OTGrammar_getWinner (OTGrammar me, integer itab) {
 				break;
 			}
 		}
-	} else {
-		integer numberOfBestCandidates = 1;
+		return icand_best;
+	}
+	return OTGrammar_withCandidateComparison (me, itab, [me, itab] (auto const& compareCandidates) {
+		integer icand_best = 1, numberOfBestCandidates = 1;
 		for (integer icand = 2; icand <= my tableaus [itab]. numberOfCandidates; icand ++) {
-			int comparison = OTGrammar_compareCandidates (me, itab, icand, itab, icand_best);
+			const int comparison = compareCandidates (icand, icand_best);
 			if (comparison == -1) {
 				icand_best = icand;   // the current candidate is the unique best candidate found so far
 				numberOfBestCandidates = 1;
@@ -520,38 +697,44 @@ integer OTGrammar_getWinner (OTGrammar me, integer itab) {
 				}
 			}
 		}
-	}
-	return icand_best;
+		return icand_best;
+	});
 }
 
 integer OTGrammar_getNumberOfOptimalCandidates (OTGrammar me, integer itab) {
 	if (my decisionStrategy == kOTGrammar_decisionStrategy::MAXIMUM_ENTROPY ||
 		my decisionStrategy == kOTGrammar_decisionStrategy::EXPONENTIAL_MAXIMUM_ENTROPY) return 1;
-	integer icand_best = 1, numberOfBestCandidates = 1;
-	for (integer icand = 2; icand <= my tableaus [itab]. numberOfCandidates; icand ++) {
-		int comparison = OTGrammar_compareCandidates (me, itab, icand, itab, icand_best);
-		if (comparison == -1) {
-			icand_best = icand;   // the current candidate is the best candidate found so far
-			numberOfBestCandidates = 1;
-		} else if (comparison == 0) {
-			numberOfBestCandidates += 1;   // the current candidate is equally good as the best found before
+	return OTGrammar_withCandidateComparison (me, itab, [me, itab] (auto const& compareCandidates) {
+		integer icand_best = 1, numberOfBestCandidates = 1;
+		for (integer icand = 2; icand <= my tableaus [itab]. numberOfCandidates; icand ++) {
+			const int comparison = compareCandidates (icand, icand_best);
+			if (comparison == -1) {
+				icand_best = icand;   // the current candidate is the best candidate found so far
+				numberOfBestCandidates = 1;
+			} else if (comparison == 0) {
+				numberOfBestCandidates += 1;   // the current candidate is equally good as the best found before
+			}
 		}
-	}
-	return numberOfBestCandidates;
+		return numberOfBestCandidates;
+	});
 }
 
 bool OTGrammar_isCandidateGrammatical (OTGrammar me, integer itab, integer icand) {
-	for (integer jcand = 1; jcand <= my tableaus [itab]. numberOfCandidates; jcand ++)
-		if (jcand != icand && OTGrammar_compareCandidates (me, itab, jcand, itab, icand) < 0)
-			return false;
-	return true;
+	return OTGrammar_withCandidateComparison (me, itab, [me, itab, icand] (auto const& compareCandidates) {
+		for (integer jcand = 1; jcand <= my tableaus [itab]. numberOfCandidates; jcand ++)
+			if (jcand != icand && compareCandidates (jcand, icand) < 0)
+				return false;
+		return true;
+	});
 }
 
 bool OTGrammar_isCandidateSinglyGrammatical (OTGrammar me, integer itab, integer icand) {
-	for (integer jcand = 1; jcand <= my tableaus [itab]. numberOfCandidates; jcand ++)
-		if (jcand != icand && OTGrammar_compareCandidates (me, itab, jcand, itab, icand) <= 0)
-			return false;
-	return true;
+	return OTGrammar_withCandidateComparison (me, itab, [me, itab, icand] (auto const& compareCandidates) {
+		for (integer jcand = 1; jcand <= my tableaus [itab]. numberOfCandidates; jcand ++)
+			if (jcand != icand && compareCandidates (jcand, icand) <= 0)
+				return false;
+		return true;
+	});
 }
 
 void OTGrammar_getInterpretiveParse (OTGrammar me, conststring32 partialOutput, integer *out_bestTableau, integer *out_bestCandidate) {
@@ -2401,6 +2584,189 @@ double OTGrammar_Distributions_getFractionCorrect (OTGrammar me, Distributions t
 	}
 }
 
+void OTEnsemble_run (integer numberOfReplicates, std::function <void (integer replicate)> const& runReplicate) {
+	Melder_require (numberOfReplicates >= 1,
+		U"The number of replicates should be at least 1.");
+	autovector <uint64> seeds = newvectorraw <uint64> (numberOfReplicates);
+	for (integer ireplicate = 1; ireplicate <= numberOfReplicates; ireplicate ++)
+		seeds [ireplicate] = NUMrandom_seed ();
+	autoMelderWarningOff nowarn;   // warnings (e.g. that EDCD stalls) cannot be shown from worker threads
+	std::atomic <bool> someReplicateFailed { false };
+	const integer numberOfThreads = MelderThread_getNumberOfThreadsToUse (numberOfReplicates, 1);
+	MelderThread_runChunks (numberOfThreads, numberOfReplicates, [&] (integer /* ithread */, integer firstReplicate, integer lastReplicate) {
+		for (integer ireplicate = firstReplicate; ireplicate <= lastReplicate && ! someReplicateFailed; ireplicate ++) {
+			autoNUMrandomPrivateStream stream (seeds [ireplicate]);
+			try {
+				runReplicate (ireplicate);
+			} catch (MelderError) {
+				someReplicateFailed = true;   // so that the other threads stop early
+				Melder_throw (U"Replicate ", ireplicate, U" not completed.");
+			}
+		}
+	});
+}
+
+static autostring32 OTEnsemble_getHierarchy (constVECVU const& rankings, constSTRVEC const& constraintNames) {
+	autoINTVEC order = to_INTVEC (rankings.size);
+	std::sort (order.begin(), order.end(),
+		[&] (integer icons, integer jcons) {
+			if (rankings [icons] != rankings [jcons])
+				return rankings [icons] > rankings [jcons];
+			return str32cmp (constraintNames [icons], constraintNames [jcons]) < 0;   // tied constraints alphabetically, as in OTGrammar_sort ()
+		}
+	);
+	autoMelderString hierarchy;
+	for (integer i = 1; i <= order.size; i ++) {
+		if (i > 1)
+			MelderString_append (& hierarchy, rankings [order [i]] == rankings [order [i - 1]] ? U" = " : U" >> ");
+		MelderString_append (& hierarchy, constraintNames [order [i]]);
+	}
+	return Melder_dup (hierarchy.string);
+}
+
+autoTable OTEnsemble_createTable (constMATVU const& rankings, constSTRVEC const& constraintNames, constVECVU const& fractionsCorrect) {
+	try {
+		const integer numberOfReplicates = rankings.nrow, numberOfConstraints = rankings.ncol;
+		Melder_assert (constraintNames.size == numberOfConstraints);
+		Melder_assert (fractionsCorrect.size == numberOfReplicates);
+		autoTable thee = Table_createWithoutColumnNames (numberOfReplicates, 3 + numberOfConstraints);
+		Table_setColumnLabel (thee.get(), 1, U"replicate");
+		Table_setColumnLabel (thee.get(), 2, U"fractionCorrect");
+		Table_setColumnLabel (thee.get(), 3, U"hierarchy");
+		for (integer icons = 1; icons <= numberOfConstraints; icons ++)
+			Table_setColumnLabel (thee.get(), 3 + icons, constraintNames [icons]);
+		for (integer ireplicate = 1; ireplicate <= numberOfReplicates; ireplicate ++) {
+			Table_setNumericValue (thee.get(), ireplicate, 1, ireplicate);
+			Table_setNumericValue (thee.get(), ireplicate, 2, fractionsCorrect [ireplicate]);
+			autostring32 hierarchy = OTEnsemble_getHierarchy (rankings.row (ireplicate), constraintNames);
+			Table_setStringValue (thee.get(), ireplicate, 3, hierarchy.get());
+			for (integer icons = 1; icons <= numberOfConstraints; icons ++)
+				Table_setNumericValue (thee.get(), ireplicate, 3 + icons, rankings [ireplicate] [icons]);
+		}
+		return thee;
+	} catch (MelderError) {
+		Melder_throw (U"Ensemble table not created.");
+	}
+}
+
+autoTable OTEnsemble_tabulateHierarchies (Table ensemble) {
+	try {
+		const integer hierarchyColumn = Table_getColumnIndexFromColumnLabel (ensemble, U"hierarchy");
+		const integer fractionCorrectColumn = Table_getColumnIndexFromColumnLabel (ensemble, U"fractionCorrect");
+		const integer numberOfReplicates = ensemble -> rows.size;
+		/*
+			The distinct hierarchies, in the order of their first occurrence.
+		*/
+		struct Outcome {
+			conststring32 hierarchy;
+			integer count;
+			longdouble sumOfFractionsCorrect;
+		};
+		std::vector <Outcome> outcomes;
+		std::map <conststring32, integer, bool (*) (conststring32, conststring32)> outcomeIndex (
+			[] (conststring32 a, conststring32 b) { return str32cmp (a, b) < 0; }
+		);
+		for (integer ireplicate = 1; ireplicate <= numberOfReplicates; ireplicate ++) {
+			conststring32 hierarchy = Table_getStringValue_Assert (ensemble, ireplicate, hierarchyColumn);
+			const auto found = outcomeIndex.find (hierarchy);
+			integer ioutcome;
+			if (found == outcomeIndex.end ()) {
+				outcomes.push_back ({ hierarchy, 0, 0.0 });
+				ioutcome = integer (outcomes.size ()) - 1;
+				outcomeIndex [hierarchy] = ioutcome;
+			} else
+				ioutcome = found -> second;
+			outcomes [uinteger (ioutcome)]. count += 1;
+			outcomes [uinteger (ioutcome)]. sumOfFractionsCorrect += Table_getNumericValue_Assert (ensemble, ireplicate, fractionCorrectColumn);
+		}
+		std::stable_sort (outcomes.begin(), outcomes.end(),
+				[] (Outcome const& a, Outcome const& b) { return a.count > b.count; });
+		const conststring32 columnNames [] = { U"hierarchy", U"count", U"proportion", U"meanFractionCorrect" };
+		autoTable thee = Table_createWithColumnNames (integer (outcomes.size ()), ARRAY_TO_STRVEC (columnNames));
+		for (integer irow = 1; irow <= thy rows.size; irow ++) {
+			const Outcome& outcome = outcomes [uinteger (irow - 1)];
+			Table_setStringValue (thee.get(), irow, 1, outcome.hierarchy);
+			Table_setNumericValue (thee.get(), irow, 2, outcome.count);
+			Table_setNumericValue (thee.get(), irow, 3, double (outcome.count) / numberOfReplicates);
+			Table_setNumericValue (thee.get(), irow, 4, double (outcome.sumOfFractionsCorrect / outcome.count));
+		}
+		return thee;
+	} catch (MelderError) {
+		Melder_throw (ensemble, U": hierarchies not tabulated.");
+	}
+}
+
+static autoSTRVEC OTGrammar_getConstraintNames (OTGrammar me) {
+	autoSTRVEC result (my numberOfConstraints);
+	for (integer icons = 1; icons <= my numberOfConstraints; icons ++)
+		result [icons] = Melder_dup (my constraints [icons]. name.get());
+	return result;
+}
+
+autoTable OTGrammar_PairDistribution_learnEnsemble (OTGrammar me, PairDistribution thee, integer numberOfReplicates,
+	double evaluationNoise, enum kOTGrammar_rerankingStrategy updateRule, bool honourLocalRankings,
+	double initialPlasticity, integer replicationsPerPlasticity, double plasticityDecrement,
+	integer numberOfPlasticities, double relativePlasticityNoise, integer numberOfChews,
+	integer numberOfTestInputs, autoTable *out_hierarchies)
+{
+	try {
+		Melder_require (numberOfTestInputs >= 1,
+			U"The number of test inputs should be at least 1.");
+		autoMAT rankings = zero_MAT (numberOfReplicates, my numberOfConstraints);
+		autoVEC fractionsCorrect = zero_VEC (numberOfReplicates);
+		OTEnsemble_run (numberOfReplicates, [&] (integer ireplicate) {
+			autoOTGrammar grammar = Data_copy (me);
+			OTGrammar_PairDistribution_learn (grammar.get(), thee,
+				evaluationNoise, updateRule, honourLocalRankings,
+				initialPlasticity, replicationsPerPlasticity, plasticityDecrement,
+				numberOfPlasticities, relativePlasticityNoise, numberOfChews
+			);
+			for (integer icons = 1; icons <= my numberOfConstraints; icons ++)
+				rankings [ireplicate] [icons] = grammar -> constraints [icons]. ranking;
+			fractionsCorrect [ireplicate] = OTGrammar_PairDistribution_getFractionCorrect (grammar.get(), thee,
+					evaluationNoise, numberOfTestInputs);
+		});
+		autoTable ensemble = OTEnsemble_createTable (rankings.get(), OTGrammar_getConstraintNames (me).get(), fractionsCorrect.get());
+		if (out_hierarchies)
+			*out_hierarchies = OTEnsemble_tabulateHierarchies (ensemble.get());
+		return ensemble;
+	} catch (MelderError) {
+		Melder_throw (me, U" & ", thee, U": ensemble not learned.");
+	}
+}
+
+autoTable OTGrammar_Strings_learnEnsembleFromPartialOutputs (OTGrammar me, Strings partialOutputs, integer numberOfReplicates,
+	double evaluationNoise, enum kOTGrammar_rerankingStrategy updateRule, bool honourLocalRankings,
+	double plasticity, double relativePlasticityNoise, integer numberOfChews,
+	integer numberOfTestInputs, autoTable *out_hierarchies)
+{
+	try {
+		Melder_require (numberOfTestInputs >= 1,
+			U"The number of test inputs should be at least 1.");
+		autoDistributions partialOutputFrequencies = Strings_to_Distributions (partialOutputs);
+		autoMAT rankings = zero_MAT (numberOfReplicates, my numberOfConstraints);
+		autoVEC fractionsCorrect = zero_VEC (numberOfReplicates);
+		OTEnsemble_run (numberOfReplicates, [&] (integer ireplicate) {
+			autoOTGrammar grammar = Data_copy (me);
+			autoOTHistory history;
+			OTGrammar_learnFromPartialOutputs (grammar.get(), partialOutputs,
+				evaluationNoise, updateRule, honourLocalRankings,
+				plasticity, relativePlasticityNoise, numberOfChews, 0, & history
+			);
+			for (integer icons = 1; icons <= my numberOfConstraints; icons ++)
+				rankings [ireplicate] [icons] = grammar -> constraints [icons]. ranking;
+			fractionsCorrect [ireplicate] = OTGrammar_Distributions_getFractionCorrect (grammar.get(), partialOutputFrequencies.get(), 1,
+					evaluationNoise, numberOfTestInputs);
+		});
+		autoTable ensemble = OTEnsemble_createTable (rankings.get(), OTGrammar_getConstraintNames (me).get(), fractionsCorrect.get());
+		if (out_hierarchies)
+			*out_hierarchies = OTEnsemble_tabulateHierarchies (ensemble.get());
+		return ensemble;
+	} catch (MelderError) {
+		Melder_throw (me, U" & ", partialOutputs, U": ensemble not learned from partial outputs.");
+	}
+}
+
 void OTGrammar_removeConstraint (OTGrammar me, conststring32 constraintName) {
 	try {
 		integer removed = 0;
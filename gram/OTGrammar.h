@@ -26,6 +26,8 @@
 
 #include "OTGrammar_enums.h"
 
+#include <functional>
+
 #include "OTGrammar_def.h"
 
 Thing_define (OTHistory, TableOfReal) {
@@ -120,6 +122,35 @@ integer OTGrammar_PairDistribution_getMinimumNumberCorrect (OTGrammar me, PairDi
 double OTGrammar_Distributions_getFractionCorrect (OTGrammar me, Distributions thee, integer columnNumber,
 	double evaluationNoise, integer numberOfInputs);
 
+/*
+	Ensembles: independent replicates of a learning simulation, run in parallel.
+	Each replicate learns on its own copy of the grammar and draws from its own random stream;
+	the seeds of these streams are drawn beforehand from the default random stream,
+	so that the outcome does not depend on the number of threads,
+	and is reproducible after random_initializeWithSeedUnsafelyButPredictably ().
+	The grammar itself is not changed.
+
+	The resulting Table has one row per replicate, with the columns
+	"replicate", "fractionCorrect", "hierarchy" (e.g. "A >> B = C >> D"), and the final ranking of each constraint;
+	the hierarchies Table has one row per distinct final hierarchy, with the columns
+	"hierarchy", "count", "proportion" and "meanFractionCorrect", most frequent first.
+*/
+void OTEnsemble_run (integer numberOfReplicates, std::function <void (integer replicate)> const& runReplicate);
+autoTable OTEnsemble_createTable (constMATVU const& rankings, constSTRVEC const& constraintNames, constVECVU const& fractionsCorrect);
+autoTable OTEnsemble_tabulateHierarchies (Table ensemble);
+
+autoTable OTGrammar_PairDistribution_learnEnsemble (OTGrammar me, PairDistribution thee, integer numberOfReplicates,
+	double evaluationNoise, enum kOTGrammar_rerankingStrategy updateRule, bool honourLocalRankings,
+	double initialPlasticity, integer replicationsPerPlasticity, double plasticityDecrement,
+	integer numberOfPlasticities, double relativePlasticityNoise, integer numberOfChews,
+	integer numberOfTestInputs, autoTable *out_hierarchies);
+	/* fractionCorrect as in OTGrammar_PairDistribution_getFractionCorrect () */
+autoTable OTGrammar_Strings_learnEnsembleFromPartialOutputs (OTGrammar me, Strings partialOutputs, integer numberOfReplicates,
+	double evaluationNoise, enum kOTGrammar_rerankingStrategy updateRule, bool honourLocalRankings,
+	double plasticity, double relativePlasticityNoise, integer numberOfChews,
+	integer numberOfTestInputs, autoTable *out_hierarchies);
+	/* fractionCorrect as in OTGrammar_Distributions_getFractionCorrect (), with the frequencies of the partial outputs */
+
 void OTGrammar_checkIndex (OTGrammar me);
 
 autoOTGrammar OTGrammar_create_NoCoda_grammar ();
@@ -77,6 +77,13 @@ oo_DEFINE_STRUCT (OTGrammarTableau)
 	oo_INTEGER (numberOfCandidates)
 	oo_STRUCTVEC (OTGrammarCandidate, candidates, numberOfCandidates)
 
+	#if ! oo_READING && ! oo_WRITING && ! oo_COMPARING
+		oo_INTEGER (keyStamp)   // the key layout of the grammar for which the keys were computed
+		oo_INTEGER (numberOfKeys)   // numberOfCandidates * numberOfKeyWords
+		oo_INTVEC (keys, numberOfKeys)
+		oo_VEC (disharmonies, numberOfCandidates)   // under the weighted decision strategies
+	#endif
+
 oo_END_STRUCT (OTGrammarTableau)
 #undef ooSTRUCT
 
@@ -98,6 +105,22 @@ oo_DEFINE_CLASS (OTGrammar, Daata)
 	oo_INTEGER (numberOfTableaus)
 	oo_STRUCTVEC (OTGrammarTableau, tableaus, numberOfTableaus)
 
+	#if ! oo_READING && ! oo_WRITING && ! oo_COMPARING
+		/*
+			The layout of the rank-ordered keys with which the candidates are compared
+			under OPTIMALITY_THEORY (see OTGrammar_updateKeyLayout).
+		*/
+		oo_INTEGER (keyStamp)   // increases whenever the stratification of the constraints changes
+		oo_INTEGER (keyLayoutAge)   // the number of evaluations since then
+		oo_INTEGER (numberOfKeyWords)
+		oo_INTVEC (keyIndex, numberOfConstraints)   // the index for which the layout was computed...
+		oo_BOOLVEC (keyTiedToTheRight, numberOfConstraints)   // ...and its ties
+		oo_INTVEC (keyWord, numberOfConstraints)   // for the last constraint of each stratum: where the stratum goes (0 if nowhere)...
+		oo_INTVEC (keyShift, numberOfConstraints)   // ...and at which bit
+		oo_INTVEC (maximumMarks, numberOfConstraints)   // over all candidates; -1 if some candidate has negative marks
+		oo_VEC (weights, numberOfConstraints)   // the constraint weights under the weighted decision strategies
+	#endif
+
 	#if oo_READING
 		OTGrammar_sort (this);
 	#endif
@@ -982,6 +982,69 @@ void OTMulti_PairDistribution_learn (OTMulti me, PairDistribution thee, double e
 	}
 }
 
+double OTMulti_PairDistribution_getFractionCorrect (OTMulti me, PairDistribution thee,
+	double evaluationNoise, int direction, integer numberOfInputs)
+{
+	try {
+		integer numberOfCorrect = 0, numberOfTrials = 0;
+		for (integer ireplication = 1; ireplication <= numberOfInputs; ireplication ++) {
+			conststring32 form1, form2;
+			PairDistribution_peekPair (thee, & form1, & form2);
+			if (direction & OTMulti_LEARN_FORWARD) {
+				OTMulti_newDisharmonies (me, evaluationNoise);
+				const integer iwinner = OTMulti_getWinner (me, form1, U"");
+				if (iwinner != 0 && OTMulti_candidateMatches (me, iwinner, form2, U""))
+					numberOfCorrect ++;
+				numberOfTrials ++;
+			}
+			if (direction & OTMulti_LEARN_BACKWARD) {
+				OTMulti_newDisharmonies (me, evaluationNoise);
+				const integer iwinner = OTMulti_getWinner (me, form2, U"");
+				if (iwinner != 0 && OTMulti_candidateMatches (me, iwinner, form1, U""))
+					numberOfCorrect ++;
+				numberOfTrials ++;
+			}
+		}
+		return ( numberOfTrials > 0 ? (double) numberOfCorrect / numberOfTrials : undefined );
+	} catch (MelderError) {
+		Melder_throw (me, U" & ", thee, U": fraction correct not computed.");
+	}
+}
+
+autoTable OTMulti_PairDistribution_learnEnsemble (OTMulti me, PairDistribution thee, integer numberOfReplicates,
+	double evaluationNoise, enum kOTGrammar_rerankingStrategy updateRule, int direction,
+	double initialPlasticity, integer replicationsPerPlasticity, double plasticityDecrement,
+	integer numberOfPlasticities, double relativePlasticityNoise,
+	integer numberOfTestInputs, autoTable *out_hierarchies)
+{
+	try {
+		Melder_require (numberOfTestInputs >= 1,
+			U"The number of test inputs should be at least 1.");
+		autoMAT rankings = zero_MAT (numberOfReplicates, my numberOfConstraints);
+		autoVEC fractionsCorrect = zero_VEC (numberOfReplicates);
+		OTEnsemble_run (numberOfReplicates, [&] (integer ireplicate) {
+			autoOTMulti grammar = Data_copy (me);
+			OTMulti_PairDistribution_learn (grammar.get(), thee, evaluationNoise, updateRule, direction,
+				initialPlasticity, replicationsPerPlasticity, plasticityDecrement,
+				numberOfPlasticities, relativePlasticityNoise, 0, nullptr
+			);
+			for (integer icons = 1; icons <= my numberOfConstraints; icons ++)
+				rankings [ireplicate] [icons] = grammar -> constraints [icons]. ranking;
+			fractionsCorrect [ireplicate] = OTMulti_PairDistribution_getFractionCorrect (grammar.get(), thee,
+					evaluationNoise, direction, numberOfTestInputs);
+		});
+		autoSTRVEC constraintNames (my numberOfConstraints);
+		for (integer icons = 1; icons <= my numberOfConstraints; icons ++)
+			constraintNames [icons] = Melder_dup (my constraints [icons]. name.get());
+		autoTable ensemble = OTEnsemble_createTable (rankings.get(), constraintNames.get(), fractionsCorrect.get());
+		if (out_hierarchies)
+			*out_hierarchies = OTEnsemble_tabulateHierarchies (ensemble.get());
+		return ensemble;
+	} catch (MelderError) {
+		Melder_throw (me, U" & ", thee, U": ensemble not learned.");
+	}
+}
+
 static integer OTMulti_crucialCell (OTMulti me, integer icand, integer iwinner, integer numberOfOptimalCandidates, conststring32 form1, conststring32 form2)
 {
 	if (my numberOfCandidates < 2) return 0;   // if there is only one candidate, all cells can be greyed
@@ -51,6 +51,15 @@ void OTMulti_PairDistribution_learn (OTMulti me, PairDistribution thee,
 	double evaluationNoise, enum kOTGrammar_rerankingStrategy updateRule, int direction,
 	double initialPlasticity, integer replicationsPerPlasticity, double plasticityDecrement,
 	integer numberOfPlasticities, double relativePlasticityNoise, integer storeHistoryEvery, autoTable *history_out);
+double OTMulti_PairDistribution_getFractionCorrect (OTMulti me, PairDistribution thee,
+	double evaluationNoise, int direction, integer numberOfInputs);
+	/* the fraction of the directions that produce the other form of a pair, as in learning with the same direction */
+autoTable OTMulti_PairDistribution_learnEnsemble (OTMulti me, PairDistribution thee, integer numberOfReplicates,
+	double evaluationNoise, enum kOTGrammar_rerankingStrategy updateRule, int direction,
+	double initialPlasticity, integer replicationsPerPlasticity, double plasticityDecrement,
+	integer numberOfPlasticities, double relativePlasticityNoise,
+	integer numberOfTestInputs, autoTable *out_hierarchies);
+	/* see OTEnsemble_run () in OTGrammar.h */
 
 void OTMulti_drawTableau (OTMulti me, Graphics g, conststring32 form1, conststring32 form2, bool vertical, bool showDisharmonies);
 
@@ -906,6 +906,28 @@ DO
 	MODIFY_FIRST_OF_ONE_WEAK_AND_ONE_WITH_HISTORY_END
 }
 
+FORM (CONVERT_ONE_AND_ONE_TO_MULTIPLE__OTGrammar_Strings_learnEnsembleFromPartialOutputs, U"OTGrammar: Learn from partial adult outputs (ensemble)", nullptr) {
+	NATURAL (numberOfReplicates, U"Number of replicates", U"100")
+	REAL (evaluationNoise, U"Evaluation noise", U"2.0")
+	OPTIONMENU_ENUM (kOTGrammar_rerankingStrategy, updateRule,
+			U"Update rule", kOTGrammar_rerankingStrategy::SYMMETRIC_ALL)
+	REAL (plasticity, U"Plasticity", U"0.1")
+	REAL (relativePlasticitySpreading, U"Rel. plasticity spreading", U"0.1")
+	BOOLEAN (honourLocalRankings, U"Honour local rankings", 1)
+	NATURAL (numberOfChews, U"Number of chews", U"1")
+	NATURAL (numberOfTestInputs, U"Number of test inputs", U"10000")
+	OK
+DO
+	CONVERT_ONE_AND_ONE_TO_MULTIPLE (OTGrammar, Strings)
+		autoTable hierarchies;
+		autoTable ensemble = OTGrammar_Strings_learnEnsembleFromPartialOutputs (me, you, numberOfReplicates,
+				evaluationNoise, updateRule, honourLocalRankings,
+				plasticity, relativePlasticitySpreading, numberOfChews, numberOfTestInputs, & hierarchies);
+		praat_new (ensemble.move(), my name.get(), U"_ensemble");
+		praat_new (hierarchies.move(), my name.get(), U"_hierarchies");
+	CONVERT_ONE_AND_ONE_TO_MULTIPLE_END
+}
+
 // MARK: OTGRAMMAR & DISTRIBUTIONS
 
 FORM (QUERY_ONE_WEAK_AND_ONE_FOR_REAL__OTGrammar_Distributions_getFractionCorrect, U"OTGrammar & Distributions: Get fraction correct...", nullptr) {
@@ -1090,6 +1112,34 @@ DO
 	MODIFY_FIRST_OF_ONE_WEAK_AND_ONE_END
 }
 
+FORM (CONVERT_ONE_AND_ONE_TO_MULTIPLE__OTGrammar_PairDistribution_learnEnsemble, U"OTGrammar & PairDistribution: Learn (ensemble)", nullptr) {
+	NATURAL (numberOfReplicates, U"Number of replicates", U"100")
+	REAL (evaluationNoise, U"Evaluation noise", U"2.0")
+	OPTIONMENU_ENUM (kOTGrammar_rerankingStrategy, updateRule,
+			U"Update rule", kOTGrammar_rerankingStrategy::SYMMETRIC_ALL)
+	POSITIVE (initialPlasticity, U"Initial plasticity", U"1.0")
+	NATURAL (replicationsPerPlasticity, U"Replications per plasticity", U"100000")
+	REAL (plasticityDecrement, U"Plasticity decrement", U"0.1")
+	NATURAL (numberOfPlasticities, U"Number of plasticities", U"4")
+	REAL (relativePlasticitySpreading, U"Rel. plasticity spreading", U"0.1")
+	BOOLEAN (honourLocalRankings, U"Honour local rankings", true)
+	NATURAL (numberOfChews, U"Number of chews", U"1")
+	NATURAL (numberOfTestInputs, U"Number of test inputs", U"10000")
+	OK
+DO
+	CONVERT_ONE_AND_ONE_TO_MULTIPLE (OTGrammar, PairDistribution)
+		autoTable hierarchies;
+		autoTable ensemble = OTGrammar_PairDistribution_learnEnsemble (me, you, numberOfReplicates,
+			evaluationNoise, updateRule, honourLocalRankings,
+			initialPlasticity, replicationsPerPlasticity,
+			plasticityDecrement, numberOfPlasticities, relativePlasticitySpreading, numberOfChews,
+			numberOfTestInputs, & hierarchies
+		);
+		praat_new (ensemble.move(), my name.get(), U"_ensemble");
+		praat_new (hierarchies.move(), my name.get(), U"_hierarchies");
+	CONVERT_ONE_AND_ONE_TO_MULTIPLE_END
+}
+
 DIRECT (INFO_ONE_AND_ONE__OTGrammar_PairDistribution_listObligatoryRankings) {
 	INFO_ONE_AND_ONE (OTGrammar, PairDistribution)
 		OTGrammar_PairDistribution_listObligatoryRankings (me, you);
@@ -1412,6 +1462,35 @@ DO
 	MODIFY_FIRST_OF_ONE_WEAK_AND_ONE_WITH_HISTORY_END
 }
 
+FORM (CONVERT_ONE_AND_ONE_TO_MULTIPLE__OTMulti_PairDistribution_learnEnsemble, U"OTMulti & PairDistribution: Learn (ensemble)", nullptr) {
+	NATURAL (numberOfReplicates, U"Number of replicates", U"100")
+	REAL (evaluationNoise, U"Evaluation noise", U"2.0")
+	OPTIONMENU_ENUM (kOTGrammar_rerankingStrategy, updateRule,
+			U"Update rule", kOTGrammar_rerankingStrategy::SYMMETRIC_ALL)
+	OPTIONMENU (direction, U"Direction", 3)
+		OPTION (U"forward")
+		OPTION (U"backward")
+		OPTION (U"bidirectionally")
+	POSITIVE (initialPlasticity, U"Initial plasticity", U"1.0")
+	NATURAL (replicationsPerPlasticity, U"Replications per plasticity", U"100000")
+	REAL (plasticityDecrement, U"Plasticity decrement", U"0.1")
+	NATURAL (numberOfPlasticities, U"Number of plasticities", U"4")
+	REAL (relativePlasticitySpreading, U"Rel. plasticity spreading", U"0.1")
+	NATURAL (numberOfTestInputs, U"Number of test inputs", U"10000")
+	OK
+DO
+	CONVERT_ONE_AND_ONE_TO_MULTIPLE (OTMulti, PairDistribution)
+		autoTable hierarchies;
+		autoTable ensemble = OTMulti_PairDistribution_learnEnsemble (me, you, numberOfReplicates,
+			evaluationNoise, updateRule, direction,
+			initialPlasticity, replicationsPerPlasticity, plasticityDecrement, numberOfPlasticities,
+			relativePlasticitySpreading, numberOfTestInputs, & hierarchies
+		);
+		praat_new (ensemble.move(), my name.get(), U"_ensemble");
+		praat_new (hierarchies.move(), my name.get(), U"_hierarchies");
+	CONVERT_ONE_AND_ONE_TO_MULTIPLE_END
+}
+
 // MARK: OTMULTI & STRINGS
 
 FORM (CONVERT_ONE_WEAK_AND_ONE_TO_ONE__OTMulti_Strings_generateOptimalForms, U"OTGrammar: Inputs to outputs", U"OTGrammar: Inputs to outputs...") {
@@ -1831,6 +1910,8 @@ void praat_uvafon_gram_init () {
 			CONVERT_ONE_WEAK_AND_ONE_TO_ONE__OTGrammar_Strings_inputsToOutputs);
 	praat_addAction2 (classOTGrammar, 1, classStrings, 1, U"Learn from partial outputs...", nullptr, 0,
 			MODIFY_FIRST_OF_ONE_WEAK_AND_ONE_WITH_HISTORY__OTGrammar_Strings_learnFromPartialOutputs);
+	praat_addAction2 (classOTGrammar, 1, classStrings, 1, U"Learn from partial outputs (ensemble)...", nullptr, 0,
+			CONVERT_ONE_AND_ONE_TO_MULTIPLE__OTGrammar_Strings_learnEnsembleFromPartialOutputs);
 	praat_addAction2 (classOTGrammar, 1, classStrings, 2, U"Learn...", nullptr, 0,
 			MODIFY_FIRST_OF_ONE_WEAK_AND_TWO__OTGrammar_Stringses_learn);
 	praat_addAction2 (classOTGrammar, 1, classDistributions, 1, U"Learn from partial outputs...", nullptr, 0,
@@ -1847,6 +1928,8 @@ void praat_uvafon_gram_init () {
 			INFO_ONE_AND_ONE__OTGrammar_Distributions_listObligatoryRankings);
 	praat_addAction2 (classOTGrammar, 1, classPairDistribution, 1, U"Learn...", nullptr, 0,
 			MODIFY_FIRST_OF_ONE_WEAK_AND_ONE__OTGrammar_PairDistribution_learn);
+	praat_addAction2 (classOTGrammar, 1, classPairDistribution, 1, U"Learn (ensemble)...", nullptr, 0,
+			CONVERT_ONE_AND_ONE_TO_MULTIPLE__OTGrammar_PairDistribution_learnEnsemble);
 	praat_addAction2 (classOTGrammar, 1, classPairDistribution, 1, U"Find positive weights...", nullptr, 0,
 			MODIFY_FIRST_OF_ONE_AND_ONE__OTGrammar_PairDistribution_findPositiveWeights);
 	praat_addAction2 (classOTGrammar, 1, classPairDistribution, 1, U"Get fraction correct...", nullptr, 0,
@@ -1857,6 +1940,8 @@ void praat_uvafon_gram_init () {
 			INFO_ONE_AND_ONE__OTGrammar_PairDistribution_listObligatoryRankings);
 	praat_addAction2 (classOTMulti, 1, classPairDistribution, 1, U"Learn...", nullptr, 0,
 			MODIFY_FIRST_OF_ONE_WEAK_AND_ONE_WITH_HISTORY__OTMulti_PairDistribution_learn);
+	praat_addAction2 (classOTMulti, 1, classPairDistribution, 1, U"Learn (ensemble)...", nullptr, 0,
+			CONVERT_ONE_AND_ONE_TO_MULTIPLE__OTMulti_PairDistribution_learnEnsemble);
 	praat_addAction2 (classOTMulti, 1, classStrings, 1, U"Get outputs...", nullptr, 0,
 			CONVERT_ONE_WEAK_AND_ONE_TO_ONE__OTMulti_Strings_generateOptimalForms);
 
@@ -388,7 +388,9 @@ inline autoMAT mul_allowAllocation_MAT (constMATVU const& x, constMATVU const& y
 	return result;
 }
 /*
-	Rough matrix multiplication, using an in-cache inner loop if that is faster.
+	Rough matrix multiplication: not pairwise summation, but packed and cache-blocked
+	for all but the smallest matrices, independently of the strides of x and y.
+	Single-threaded, and without allocation, so that it can be used in any thread.
 */
 extern void _mul_fast_MAT_out (MATVU const& target, constMATVU const& x, constMATVU const& y) noexcept;
 inline void mul_fast_MAT_out  (MATVU const& target, constMATVU const& x, constMATVU const& y) {
@@ -402,6 +404,17 @@ inline autoMAT mul_fast_MAT (constMATVU const& x, constMATVU const& y) {
 	mul_fast_MAT_out (result.all(), x, y);
 	return result;
 }
+/*
+	The same as mul_fast_MAT_out, with the same result, but distributed over threads for large matrices.
+	For callers that are not themselves running in a worker thread.
+*/
+extern void _mul_fast_multithreaded_MAT_out (MATVU const& target, constMATVU const& x, constMATVU const& y);
+inline void mul_fast_multithreaded_MAT_out  (MATVU const& target, constMATVU const& x, constMATVU const& y) {
+	Melder_assert (target.nrow == x.nrow);
+	Melder_assert (target.ncol == y.ncol);
+	Melder_assert (x.ncol == y.nrow);
+	_mul_fast_multithreaded_MAT_out (target, x, y);
+}
 void MATmul_forceMetal_ (MATVU const& target, constMATVU const& x, constMATVU const& y);
 void MATmul_forceOpenCL_ (MATVU const& target, constMATVU const& x, constMATVU const& y);
 
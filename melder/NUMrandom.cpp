@@ -124,6 +124,9 @@ class NUMrandom_State { public:
 
 } states [17];
 
+static thread_local NUMrandom_State *theCurrentState = & states [0];
+static thread_local std::unique_ptr <NUMrandom_State> thePrivateState;
+
 /* initialize the array with a number of seeds */
 void NUMrandom_State :: init_by_array64 (uint64 init_key [], unsigned int key_length)
 {
@@ -208,6 +211,17 @@ void NUMrandom_initializeWithSeedUnsafelyButPredictably (uint64 seed) {
 	theInited = true;
 }
 
+void NUMrandom_usePrivateStream (uint64 seed) {
+	if (! thePrivateState)
+		thePrivateState = std::make_unique <NUMrandom_State> ();
+	thePrivateState -> init_genrand64 (seed);
+	thePrivateState -> secondAvailable = false;
+	theCurrentState = thePrivateState.get();
+}
+void NUMrandom_useDefaultStream () {
+	theCurrentState = & states [0];
+}
+
 /* Throughout the years, several versions for "zero or magic" have been proposed. Choose the fastest. */
 
 #define ZERO_OR_MAGIC_VERSION  3
@@ -222,7 +236,7 @@ void NUMrandom_initializeWithSeedUnsafelyButPredictably (uint64 seed) {
 #endif
 
 double NUMrandomFraction () {
-	NUMrandom_State *me = & states [0];
+	NUMrandom_State *me = theCurrentState;
 	uint64 x;
 
 	if (my index >= NN) {   // generate NN words at a time
@@ -287,6 +301,11 @@ double NUMrandomFraction_mt (int threadNumber) {
 	return (x >> 11) * (1.0/9007199254740992.0);
 }
 
+uint64 NUMrandom_seed () {
+	const uint64 high = uint64 (NUMrandomFraction () * 4294967296.0), low = uint64 (NUMrandomFraction () * 4294967296.0);
+	return (high << 32) | low;
+}
+
 double NUMrandomUniform (double lowest, double highest) {
 	return lowest + (highest - lowest) * NUMrandomFraction ();
 }
@@ -306,7 +325,7 @@ double NUMrandomBernoulli_real (double probability) {
 #define repeat  do
 #define until(cond)  while (! (cond))
 double NUMrandomGauss (double mean, double standardDeviation) {
-	NUMrandom_State *me = & states [0];
+	NUMrandom_State *me = theCurrentState;
 	/*
 		Knuth, p. 122.
 	*/
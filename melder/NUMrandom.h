@@ -38,6 +38,22 @@ double NUMrandomGauss_mt (int threadNumber, double mean, double standardDeviatio
 
 double NUMrandomPoisson (double mean);
 
+/*
+	By default, every thread draws from the same random stream, which is not thread-safe.
+	A thread can switch to a private stream, for instance for each replicate of a simulation
+	that runs in parallel with other replicates, so that the replicates are independent
+	and reproducible (if the seeds are).
+	The private stream is used by NUMrandomFraction () and everything built on it, but not by the _mt functions.
+*/
+void NUMrandom_usePrivateStream (uint64 seed);   // for the calling thread only
+void NUMrandom_useDefaultStream ();
+class autoNUMrandomPrivateStream {
+public:
+	autoNUMrandomPrivateStream (uint64 seed) { NUMrandom_usePrivateStream (seed); }
+	~autoNUMrandomPrivateStream () { NUMrandom_useDefaultStream (); }
+};
+uint64 NUMrandom_seed ();   // 64 random bits from the current stream, e.g. for seeding a private stream
+
 uint32 NUMhashString (conststring32 string);
 
 /* End of file NUMrandom.h */
@@ -1754,6 +1754,307 @@ void binputc128 (dcomplex z, FILE *f) {
 	}
 }
 
+/*
+	Bulk reading and writing of real numbers.
+
+	The element-wise routines above cost one fread or fwrite per number,
+	and on machines whose native byte order differs from the file's byte order
+	(e.g. big-endian Praat binary files on an Intel or ARM computer)
+	they also assemble every number from its bytes with `ldexp`.
+	The routines below move the data through a buffer of `bulkChunkSize` numbers,
+	so that a large Sound or Matrix costs a few large freads or fwrites,
+	and convert between the external and the internal format in a loop that compilers can vectorize.
+
+	The conversions give exactly the bytes and values of the element-wise routines on the same machine
+	(including Melder_debug 18 and 181), so that files do not change. Per number, this is one of:
+	- native: the hardware format, where the binario_ macros above say that it is the file's format
+	  (or for 64-bit numbers under Melder_debug 181): a 32-bit number is read or written with a cast
+	  from or to `float` (which rounds to nearest when writing), and a 64-bit number is copied unconverted;
+	- swapped: the bytes of a 64-bit number are only swapped, when writing to a file in the opposite byte order
+	  on a machine whose own 64-bit format is known (binputr64 () and binputr64LE () do that);
+	- portable: the bits are assembled or disassembled as in the element-wise routines,
+	  i.e. reading an infinity or a NaN gives `undefined`, and writing truncates the mantissa of a 32-bit number
+	  (towards zero) and writes a NaN as +infinity and -0.0 as +0.0.
+	On Linux, for instance, everything is portable; Melder_debug 18 makes everything portable everywhere.
+*/
+constexpr integer bulkChunkSize = 4096;
+
+static bool machineIsLittleEndian () {
+	const uint16 one = 1;
+	uint8 firstByte;
+	memcpy (& firstByte, & one, 1);
+	return firstByte == 1;
+}
+
+static bool bulkConversionIsPossible () {
+	return std::numeric_limits <float>::is_iec559 && sizeof (float) == 4 &&
+		std::numeric_limits <double>::is_iec559 && sizeof (double) == 8 &&
+		Melder_debug != 18;
+}
+
+struct BulkConversion {
+	bool swap;   // between the machine's byte order and the file's
+	bool portable;
+};
+
+static BulkConversion bulk_conversion (integer wordSize, bool bigEndian, bool writing) {
+	if (wordSize == 8 && Melder_debug == 181)
+		return { false, false };
+	if (Melder_debug != 18) {
+		const bool isNative = ( wordSize == 4 ?
+				( bigEndian ? binario_floatIEEE4msb : binario_floatIEEE4lsb ) :
+				( bigEndian ? binario_doubleIEEE8msb : binario_doubleIEEE8lsb ) );
+		if (isNative)
+			return { false, false };
+		const bool isNativeInTheOtherByteOrder = ( bigEndian ? binario_doubleIEEE8lsb : binario_doubleIEEE8msb );
+		if (wordSize == 8 && writing && isNativeInTheOtherByteOrder)
+			return { true, false };
+	}
+	return { bigEndian == machineIsLittleEndian (), true };
+}
+
+static inline uint32 float32Bits_portable (double x) {
+	const double absx = fabs (x);
+	const uint32 sign = ( x < 0.0 ? 0x8000'0000 : 0 );   // not for -0.0 or NaN
+	if (! (absx < 0x1p128))   // infinity, NaN, or too large for a float
+		return sign | 0x7F80'0000;
+	if (absx < 0x1p-126)   // denormalized (or zero) as a float
+		return sign | (uint32) (absx * 0x1p149);   // exact multiplication; conversion truncates
+	uint64 doubleBits;
+	memcpy (& doubleBits, & absx, 8);
+	return sign | (uint32) (((doubleBits >> 52) - (1023 - 127)) << 23) | (uint32) ((doubleBits >> 29) & 0x007F'FFFF);
+}
+
+static inline uint64 float64Bits_portable (double x) {
+	if (x == 0.0)
+		return 0;   // also for -0.0
+	if (isnan (x))
+		return 0x7FF0'0000'0000'0000;   // +infinity
+	uint64 bits;
+	memcpy (& bits, & x, 8);
+	return bits;   // finite numbers and infinities come through unchanged
+}
+
+template <bool swap, bool portable>
+static void bytesToR32_ (const byte *bytes, integer byteStride, integer n, double *out) {
+	for (integer i = 0; i < n; i ++) {
+		uint32 bits;
+		memcpy (& bits, bytes + i * byteStride, 4);
+		if (swap)
+			bits = __builtin_bswap32 (bits);
+		float x;
+		memcpy (& x, & bits, 4);
+		out [i] = ( portable && (bits & 0x7F80'0000) == 0x7F80'0000 ? undefined : (double) x );
+	}
+}
+
+template <bool swap, bool portable>
+static void r32ToBytes_ (const double *in, integer n, byte *bytes, integer byteStride) {
+	for (integer i = 0; i < n; i ++) {
+		uint32 bits;
+		if (portable)
+			bits = float32Bits_portable (in [i]);
+		else {
+			const float x32 = (float) in [i];   // convert down, with loss of precision
+			memcpy (& bits, & x32, 4);
+		}
+		if (swap)
+			bits = __builtin_bswap32 (bits);
+		memcpy (bytes + i * byteStride, & bits, 4);
+	}
+}
+
+template <bool swap, bool portable>
+static void bytesToR64_ (const byte *bytes, integer byteStride, integer n, double *out) {
+	for (integer i = 0; i < n; i ++) {
+		uint64 bits;
+		memcpy (& bits, bytes + i * byteStride, 8);
+		if (swap)
+			bits = __builtin_bswap64 (bits);
+		memcpy (& out [i], & bits, 8);
+		if (portable && (bits & 0x7FF0'0000'0000'0000) == 0x7FF0'0000'0000'0000)
+			out [i] = undefined;
+	}
+}
+
+template <bool swap, bool portable>
+static void r64ToBytes_ (const double *in, integer n, byte *bytes, integer byteStride) {
+	for (integer i = 0; i < n; i ++) {
+		uint64 bits;
+		if (portable)
+			bits = float64Bits_portable (in [i]);
+		else
+			memcpy (& bits, & in [i], 8);
+		if (swap)
+			bits = __builtin_bswap64 (bits);
+		memcpy (bytes + i * byteStride, & bits, 8);
+	}
+}
+
+void bulk_bytesToR32 (const byte *bytes, integer byteStride, integer n, bool bigEndian, double *out) {
+	const BulkConversion conversion = bulk_conversion (4, bigEndian, false);
+	if (conversion.portable)
+		( conversion.swap ? bytesToR32_ <true, true> : bytesToR32_ <false, true> ) (bytes, byteStride, n, out);
+	else
+		( conversion.swap ? bytesToR32_ <true, false> : bytesToR32_ <false, false> ) (bytes, byteStride, n, out);
+}
+
+void bulk_r32ToBytes (const double *in, integer n, bool bigEndian, byte *bytes, integer byteStride) {
+	const BulkConversion conversion = bulk_conversion (4, bigEndian, true);
+	if (conversion.portable)
+		( conversion.swap ? r32ToBytes_ <true, true> : r32ToBytes_ <false, true> ) (in, n, bytes, byteStride);
+	else
+		( conversion.swap ? r32ToBytes_ <true, false> : r32ToBytes_ <false, false> ) (in, n, bytes, byteStride);
+}
+
+void bulk_bytesToR64 (const byte *bytes, integer byteStride, integer n, bool bigEndian, double *out) {
+	const BulkConversion conversion = bulk_conversion (8, bigEndian, false);
+	if (conversion.portable)
+		( conversion.swap ? bytesToR64_ <true, true> : bytesToR64_ <false, true> ) (bytes, byteStride, n, out);
+	else
+		( conversion.swap ? bytesToR64_ <true, false> : bytesToR64_ <false, false> ) (bytes, byteStride, n, out);
+}
+
+void bulk_r64ToBytes (const double *in, integer n, bool bigEndian, byte *bytes, integer byteStride) {
+	const BulkConversion conversion = bulk_conversion (8, bigEndian, true);
+	if (conversion.portable)
+		( conversion.swap ? r64ToBytes_ <true, true> : r64ToBytes_ <false, true> ) (in, n, bytes, byteStride);
+	else
+		( conversion.swap ? r64ToBytes_ <true, false> : r64ToBytes_ <false, false> ) (in, n, bytes, byteStride);
+}
+
+template <typename Word>
+static void bulk_read (FILE *f, VECVU const& x, bool bigEndian, double (*bingetElement) (FILE *), conststring32 what) {
+	if (! bulkConversionIsPossible ()) {
+		for (integer i = 1; i <= x.size; i ++)
+			x [i] = bingetElement (f);
+		return;
+	}
+	const BulkConversion conversion = bulk_conversion (sizeof (Word), bigEndian, false);
+	if (! conversion.swap && ! conversion.portable && sizeof (Word) == sizeof (double) && x.stride == 1) {
+		/*
+			The unconverted copy, directly into the vector.
+		*/
+		if (x.size > 0 && fread (& x [1], sizeof (double), uinteger (x.size), f) != uinteger (x.size))
+			readError (f, what);
+		return;
+	}
+	Word bytes [bulkChunkSize];
+	double converted [bulkChunkSize];
+	for (integer first = 1; first <= x.size; first += bulkChunkSize) {
+		const integer n = std::min (bulkChunkSize, x.size - first + 1);
+		if (fread (bytes, sizeof (Word), uinteger (n), f) != uinteger (n))
+			readError (f, what);
+		double *out = ( x.stride == 1 ? & x [first] : converted );
+		if (sizeof (Word) == 4)
+			bulk_bytesToR32 (reinterpret_cast <const byte *> (bytes), 4, n, bigEndian, out);
+		else
+			bulk_bytesToR64 (reinterpret_cast <const byte *> (bytes), 8, n, bigEndian, out);
+		if (x.stride != 1)
+			for (integer i = 0; i < n; i ++)
+				x [first + i] = converted [i];
+	}
+}
+
+template <typename Word>
+static void bulk_write (constVECVU const& x, FILE *f, bool bigEndian, void (*binputElement) (double, FILE *), conststring32 what) {
+	if (! bulkConversionIsPossible ()) {
+		for (integer i = 1; i <= x.size; i ++)
+			binputElement (x [i], f);
+		return;
+	}
+	const BulkConversion conversion = bulk_conversion (sizeof (Word), bigEndian, true);
+	if (! conversion.swap && ! conversion.portable && sizeof (Word) == sizeof (double) && x.stride == 1) {
+		/*
+			The unconverted copy, directly from the vector.
+		*/
+		if (x.size > 0 && fwrite (& x [1], sizeof (double), uinteger (x.size), f) != uinteger (x.size))
+			writeError (what);
+		return;
+	}
+	Word bytes [bulkChunkSize];
+	double gathered [bulkChunkSize];
+	for (integer first = 1; first <= x.size; first += bulkChunkSize) {
+		const integer n = std::min (bulkChunkSize, x.size - first + 1);
+		const double *in = & x [first];
+		if (x.stride != 1) {
+			for (integer i = 0; i < n; i ++)
+				gathered [i] = x [first + i];
+			in = gathered;
+		}
+		if (sizeof (Word) == 4)
+			bulk_r32ToBytes (in, n, bigEndian, reinterpret_cast <byte *> (bytes), 4);
+		else
+			bulk_r64ToBytes (in, n, bigEndian, reinterpret_cast <byte *> (bytes), 8);
+		if (fwrite (bytes, sizeof (Word), uinteger (n), f) != uinteger (n))
+			writeError (what);
+	}
+}
+
+void bingetr32 (FILE *f, VECVU const& x) {
+	try {
+		bulk_read <uint32> (f, x, true, bingetr32, U"32-bit floating-point numbers.");
+	} catch (MelderError) {
+		Melder_throw (U"Floating-point numbers not read from 4 bytes each in binary file.");
+	}
+}
+
+void bingetr32LE (FILE *f, VECVU const& x) {
+	try {
+		bulk_read <uint32> (f, x, false, bingetr32LE, U"32-bit floating-point numbers.");
+	} catch (MelderError) {
+		Melder_throw (U"Floating-point numbers not read from 4 bytes each in binary file.");
+	}
+}
+
+void bingetr64 (FILE *f, VECVU const& x) {
+	try {
+		bulk_read <uint64> (f, x, true, bingetr64, U"64-bit floating-point numbers.");
+	} catch (MelderError) {
+		Melder_throw (U"Floating-point numbers not read from 8 bytes each in binary file.");
+	}
+}
+
+void bingetr64LE (FILE *f, VECVU const& x) {
+	try {
+		bulk_read <uint64> (f, x, false, bingetr64LE, U"64-bit floating-point numbers.");
+	} catch (MelderError) {
+		Melder_throw (U"Floating-point numbers not read from 8 bytes each in binary file.");
+	}
+}
+
+void binputr32 (constVECVU const& x, FILE *f) {
+	try {
+		bulk_write <uint32> (x, f, true, binputr32, U"32-bit floating-point numbers.");
+	} catch (MelderError) {
+		Melder_throw (U"Floating-point numbers not written to 4 bytes each in binary file.");
+	}
+}
+
+void binputr32LE (constVECVU const& x, FILE *f) {
+	try {
+		bulk_write <uint32> (x, f, false, binputr32LE, U"32-bit floating-point numbers.");
+	} catch (MelderError) {
+		Melder_throw (U"Floating-point numbers not written to 4 bytes each in binary file.");
+	}
+}
+
+void binputr64 (constVECVU const& x, FILE *f) {
+	try {
+		bulk_write <uint64> (x, f, true, binputr64, U"64-bit floating-point numbers.");
+	} catch (MelderError) {
+		Melder_throw (U"Floating-point numbers not written to 8 bytes each in binary file.");
+	}
+}
+
+void binputr64LE (constVECVU const& x, FILE *f) {
+	try {
+		bulk_write <uint64> (x, f, false, binputr64LE, U"64-bit floating-point numbers.");
+	} catch (MelderError) {
+		Melder_throw (U"Floating-point numbers not written to 8 bytes each in binary file.");
+	}
+}
+
 autostring8 bingets8 (FILE *f) {
 	try {
 		unsigned int length = bingetu8 (f);
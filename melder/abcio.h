@@ -170,6 +170,25 @@ double bingetr64 (FILE *f);   void binputr64 (double x, FILE *f);
 */
 double bingetr64LE (FILE *f);   void binputr64LE (double x, FILE *f);   // least significant bit first
 
+void bingetr32 (FILE *f, VECVU const& x);   void binputr32 (constVECVU const& x, FILE *f);
+void bingetr32LE (FILE *f, VECVU const& x);   void binputr32LE (constVECVU const& x, FILE *f);
+void bingetr64 (FILE *f, VECVU const& x);   void binputr64 (constVECVU const& x, FILE *f);
+void bingetr64LE (FILE *f, VECVU const& x);   void binputr64LE (constVECVU const& x, FILE *f);
+/*
+	Read or write a whole vector of real numbers in the same formats as above,
+	with a few large freads or fwrites and a tight (vectorizable) conversion loop.
+	The results are exactly those of the element-wise routines on the same machine.
+*/
+void bulk_bytesToR32 (const byte *bytes, integer byteStride, integer n, bool bigEndian, double *out);
+void bulk_r32ToBytes (const double *in, integer n, bool bigEndian, byte *bytes, integer byteStride);
+void bulk_bytesToR64 (const byte *bytes, integer byteStride, integer n, bool bigEndian, double *out);
+void bulk_r64ToBytes (const double *in, integer n, bool bigEndian, byte *bytes, integer byteStride);
+/*
+	Convert `n` numbers between memory and bytes in the same formats as above,
+	with the numbers `byteStride` bytes apart (e.g. the samples of one channel in an interleaved audio buffer),
+	exactly as the element-wise routines do on the same machine.
+*/
+
 double bingetr80 (FILE *f);   void binputr80 (double x, FILE *f);
 /*
 	Read or write a real number from or to 10 bytes in the stream `f`,
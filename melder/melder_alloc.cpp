@@ -19,9 +19,21 @@
 #include "melder.h"
 #include <wctype.h>
 #include <assert.h>
+#include <atomic>
+#include <map>
+#include <mutex>
+#if defined (UNIX) || defined (macintosh)
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <signal.h>
+	#include <unistd.h>
+#endif
 
-static int64 totalNumberOfAllocations = 0, totalNumberOfDeallocations = 0, totalAllocationSize = 0,
-	totalNumberOfMovingReallocs = 0, totalNumberOfReallocsInSitu = 0;
+/*
+	The statistics are atomic, so that memory can be allocated and freed in worker threads.
+*/
+static std::atomic <int64> totalNumberOfAllocations { 0 }, totalNumberOfDeallocations { 0 }, totalAllocationSize { 0 },
+	totalNumberOfMovingReallocs { 0 }, totalNumberOfReallocsInSitu { 0 };
 
 /*
  * The rainy-day fund.
@@ -265,8 +277,8 @@ int64 Melder_movingReallocationsCount () {
 #pragma mark - Generic memory functions for vectors and matrices
 
 namespace MelderArray { // reopen
-	int64 allocationCount = 0, deallocationCount = 0;
-	int64 cellAllocationCount = 0, cellDeallocationCount = 0;
+	static std::atomic <int64> allocationCount { 0 }, deallocationCount { 0 };
+	static std::atomic <int64> cellAllocationCount { 0 }, cellDeallocationCount { 0 };
 }
 
 int64 MelderArray_allocationCount () { return MelderArray :: allocationCount; }
@@ -289,10 +301,206 @@ byte * MelderArray:: _alloc_generic (integer cellSize, integer numberOfCells, kI
 	}
 }
 
+/*
+	The mapped payloads, indexed by their first cell,
+	so that `_free_generic` can recognize them and unmap them instead of freeing them.
+
+	Pages of a private mapping that have not been changed are still those of the file.
+	If the file is overwritten, they change; if it is truncated, touching them raises SIGBUS.
+	Therefore, Praat copies the payloads into memory before it writes to a mapped file itself
+	(see `_copyMappedPayloadsOfFileIntoMemory`), and for truncation by another program
+	a SIGBUS handler reports what happened before Praat goes down.
+*/
+namespace MelderArray { // reopen
+	struct MappedPayload {
+		void *base;   // page-aligned, as returned by mmap
+		size_t length;
+		#if defined (UNIX) || defined (macintosh)
+			dev_t device;   // the file, as identified by its device and inode
+			ino_t inode;
+		#endif
+		bool isFileBacked;   // false after being copied into memory
+	};
+	static std::map <byte *, MappedPayload> theMappedPayloads;
+	static std::mutex theMappedPayloadsMutex;
+	static std::atomic <integer> theNumberOfMappedPayloads { 0 };
+
+	#if defined (UNIX) || defined (macintosh)
+	/*
+		The address ranges of the mapped payloads, for the SIGBUS handler,
+		which can use neither the map nor the mutex, because these are not async-signal-safe.
+		The ranges are changed only under `theMappedPayloadsMutex`, and read without a lock by the handler;
+		a range is in use if its `begin` is not zero. If there are more mapped payloads than slots,
+		a bus error in the extra payloads is not diagnosed (it still crashes Praat, as it would without the handler).
+	*/
+	struct MappedRange {
+		std::atomic <uintptr_t> begin, end;
+	};
+	static_assert (std::atomic <uintptr_t>::is_always_lock_free);
+	constexpr integer theMaximumNumberOfMappedRanges = 64;
+	static MappedRange theMappedRanges [theMaximumNumberOfMappedRanges];
+
+	static void rememberMappedRange (void *base, size_t length) {
+		for (integer irange = 0; irange < theMaximumNumberOfMappedRanges; irange ++) {
+			MappedRange& range = theMappedRanges [irange];
+			if (range.begin.load (std::memory_order_relaxed) == 0) {
+				range.end.store (reinterpret_cast <uintptr_t> (base) + length, std::memory_order_relaxed);
+				range.begin.store (reinterpret_cast <uintptr_t> (base), std::memory_order_release);
+				return;
+			}
+		}
+	}
+	static void forgetMappedRange (void *base) {
+		for (integer irange = 0; irange < theMaximumNumberOfMappedRanges; irange ++) {
+			MappedRange& range = theMappedRanges [irange];
+			if (range.begin.load (std::memory_order_relaxed) == reinterpret_cast <uintptr_t> (base)) {
+				range.begin.store (0, std::memory_order_release);
+				return;
+			}
+		}
+	}
+	#endif
+}
+
+#if defined (UNIX) || defined (macintosh)
+/*
+	The handler does nothing but look up the address and call write ().
+	Because it is installed with SA_RESETHAND, the default action (a crash) is taken
+	when the faulting instruction is executed again.
+*/
+static void handleBusError (int /* signalNumber */, siginfo_t *info, void * /* context */) {
+	const uintptr_t address = reinterpret_cast <uintptr_t> (info -> si_addr);
+	bool addressIsInMappedPayload = false;
+	for (integer irange = 0; irange < MelderArray::theMaximumNumberOfMappedRanges; irange ++) {
+		const MelderArray::MappedRange& range = MelderArray::theMappedRanges [irange];
+		const uintptr_t begin = range.begin.load (std::memory_order_acquire);
+		if (begin != 0 && address >= begin && address < range.end.load (std::memory_order_relaxed))
+			addressIsInMappedPayload = true;
+	}
+	if (addressIsInMappedPayload) {
+		static const char message [] =
+			"\nPraat: the file from which an object was read as a mappable binary file "
+			"has been truncated or overwritten by another program,\n"
+			"so that the values of that object can no longer be accessed. Praat will crash now.\n"
+			"To prevent this, do not change a mappable binary file while an object read from it is in use.\n";
+		(void) ! write (2, message, sizeof message - 1);
+	}
+}
+
+static void installBusErrorHandler () {
+	static std::once_flag once;
+	std::call_once (once, [] {
+		struct sigaction action;
+		memset (& action, 0, sizeof action);
+		action.sa_sigaction = handleBusError;
+		action.sa_flags = SA_SIGINFO | SA_RESETHAND;
+		sigemptyset (& action.sa_mask);
+		sigaction (SIGBUS, & action, nullptr);
+	});
+}
+#endif
+
+byte * MelderArray:: _map_generic (FILE *f, int64 offset, integer cellSize, integer numberOfCells) {
+	if (numberOfCells <= 0 || offset < 0)
+		return nullptr;
+	#if defined (UNIX) || defined (macintosh)
+		const int64 pageSize = sysconf (_SC_PAGESIZE);
+		if (pageSize <= 0)
+			return nullptr;
+		const int64 alignedOffset = offset - offset % pageSize;
+		const size_t length = size_t (offset - alignedOffset) + size_t (numberOfCells) * size_t (cellSize);
+		/*
+			A private mapping is copy-on-write:
+			the pages are shared with the file (and with other processes that map the same file)
+			until somebody changes a value, and changes never find their way back into the file.
+		*/
+		void *base = mmap (nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileno (f), off_t (alignedOffset));
+		if (base == MAP_FAILED)
+			return nullptr;
+		struct stat fileStatus;
+		if (fstat (fileno (f), & fileStatus) != 0) {
+			munmap (base, length);
+			return nullptr;
+		}
+		installBusErrorHandler ();
+		byte *cells = reinterpret_cast <byte *> (base) + (offset - alignedOffset);
+		{
+			std::lock_guard <std::mutex> lock (theMappedPayloadsMutex);
+			theMappedPayloads [cells] = { base, length, fileStatus.st_dev, fileStatus.st_ino, true };
+			rememberMappedRange (base, length);
+			theNumberOfMappedPayloads += 1;
+		}
+		MelderArray::allocationCount += 1;
+		MelderArray::cellAllocationCount += numberOfCells;
+		return cells;
+	#else
+		(void) f;
+		(void) cellSize;
+		return nullptr;   // the caller will read the cells instead
+	#endif
+}
+
+void MelderArray:: _copyMappedPayloadsOfFileIntoMemory (const char *utf8path) {
+	#if defined (UNIX) || defined (macintosh)
+		if (theNumberOfMappedPayloads == 0)
+			return;   // the usual case: nothing to look up
+		struct stat fileStatus;
+		if (stat (utf8path, & fileStatus) != 0)
+			return;   // the file does not exist yet, so nothing can be mapped from it
+		/*
+			The file-backed pages are replaced with anonymous pages at the same addresses, one chunk at a time,
+			so that the copy never takes much more memory than the payload itself.
+			The buffer is allocated before locking, because freeing a tensor payload takes the same lock.
+		*/
+		const size_t chunkSize = 256 * size_t (sysconf (_SC_PAGESIZE));
+		autoBYTEVEC buffer = raw_BYTEVEC (integer (chunkSize));
+		std::lock_guard <std::mutex> lock (theMappedPayloadsMutex);
+		for (auto& entry : theMappedPayloads) {
+			MappedPayload& payload = entry.second;
+			if (! payload.isFileBacked || payload.device != fileStatus.st_dev || payload.inode != fileStatus.st_ino)
+				continue;
+			byte *base = reinterpret_cast <byte *> (payload.base);
+			for (size_t start = 0; start < payload.length; start += chunkSize) {
+				const size_t chunkLength = std::min (chunkSize, payload.length - start);
+				memcpy (buffer.cells, base + start, chunkLength);
+				void *chunk = mmap (base + start, chunkLength, PROT_READ | PROT_WRITE,
+						MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+				if (chunk == MAP_FAILED)
+					Melder_throw (U"Cannot copy an object that is mapped from this file into memory, so the file cannot be overwritten.");
+				memcpy (base + start, buffer.cells, chunkLength);
+			}
+			payload.isFileBacked = false;
+			forgetMappedRange (payload.base);   // no longer file-backed, so no bus errors
+		}
+	#else
+		(void) utf8path;
+	#endif
+}
+
+static bool unmapIfMapped (byte *cells) noexcept {
+	#if defined (UNIX) || defined (macintosh)
+		if (MelderArray::theNumberOfMappedPayloads == 0)
+			return false;   // the usual case: nothing to look up
+		std::lock_guard <std::mutex> lock (MelderArray::theMappedPayloadsMutex);
+		auto it = MelderArray::theMappedPayloads.find (cells);
+		if (it == MelderArray::theMappedPayloads.end ())
+			return false;
+		MelderArray::forgetMappedRange (it -> second.base);
+		munmap (it -> second.base, it -> second.length);
+		MelderArray::theMappedPayloads.erase (it);
+		MelderArray::theNumberOfMappedPayloads -= 1;
+		return true;
+	#else
+		(void) cells;
+		return false;
+	#endif
+}
+
 void MelderArray:: _free_generic (byte *cells, integer numberOfCells) noexcept {
 	if (! cells)
 		return;   // not an error
-	Melder_free (cells);
+	if (! unmapIfMapped (cells))
+		Melder_free (cells);
 	MelderArray::deallocationCount += 1;
 	MelderArray::cellDeallocationCount += numberOfCells;
 }
@@ -87,6 +87,28 @@ namespace MelderArray {
 		_free_generic (reinterpret_cast <byte *> (cells), numberOfCells);
 	}
 
+	/*
+		Map `numberOfCells` cells, starting at byte `offset` of the open file `f`, into memory,
+		copy-on-write (changes are not written back to the file).
+		The result can become the payload of a tensor, and is unmapped by `_free`.
+		Returns nullptr if mapping is not possible on this platform or for this file;
+		the caller should then read the cells in the usual way.
+	*/
+	byte * _map_generic (FILE *f, int64 offset, integer cellSize, integer numberOfCells);
+
+	template <class T>
+	T* _map (FILE *f, int64 offset, integer numberOfCells) {
+		return reinterpret_cast <T*> (MelderArray:: _map_generic (f, offset, sizeof (T), numberOfCells));
+	}
+
+	/*
+		Copy into memory all payloads that are mapped from the file at `utf8path`,
+		so that the file can be overwritten or truncated without affecting them.
+		The payloads stay at the same addresses.
+		Melder_fopen calls this before opening a file for writing.
+	*/
+	void _copyMappedPayloadsOfFileIntoMemory (const char *utf8path);
+
 }
 
 int64 MelderArray_allocationCount ();
@@ -766,6 +766,7 @@ typedef struct {
 	integer numberOfChannels;
 	integer numberOfSamples;
 	double *channels [FLAC__MAX_CHANNELS];
+	bool quiet, decoderReportedAnError;
 } MelderDecodeFlacContext;
 
 /* The same goes for MP3 */
@@ -832,16 +833,20 @@ static void Melder_DecodeMp3_convert (const MP3F_SAMPLE *channels [MP3F_MAX_CHAN
 }
 
 static void Melder_DecodeFlac_error (const FLAC__StreamDecoder *decoder, FLAC__StreamDecoderErrorStatus status, void *client_data) {
+	MelderDecodeFlacContext *c = (MelderDecodeFlacContext *) client_data;
 	(void) decoder;
-	(void) client_data;
-	Melder_warning (U"FLAC decoder error: ", Melder_peek8to32 (FLAC__StreamDecoderErrorStatusString [status]));
+	c -> decoderReportedAnError = true;
+	if (! c -> quiet)
+		Melder_warning (U"FLAC decoder error: ", Melder_peek8to32 (FLAC__StreamDecoderErrorStatusString [status]));
 }
 
-static void Melder_readFlacFile (FILE *f, MAT buffer) {
+static bool Melder_readFlacFile (FILE *f, MAT buffer, bool quiet) {
 	int result = 0;
 
 	MelderDecodeFlacContext c;
 	c.file = f;
+	c.quiet = quiet;
+	c.decoderReportedAnError = false;
 	c.numberOfChannels = buffer.nrow;
 	for (int ichan = 1; ichan <= buffer.nrow; ichan ++)
 		c.channels [ichan - 1] = & buffer [ichan] [1];
@@ -863,6 +868,7 @@ end:
 		FLAC__stream_decoder_delete (decoder);
 	if (result == 0)
 		Melder_throw (U"Error decoding FLAC file.");
+	return ! c.decoderReportedAnError;
 }
 
 static void Melder_readMp3File (FILE *f, MAT buffer) {
@@ -881,389 +887,315 @@ static void Melder_readMp3File (FILE *f, MAT buffer) {
 		Melder_throw (U"Error decoding MP3 file.");
 }
 
-void Melder_readAudioToFloat (FILE *f, int encoding, MAT buffer) {
+/*
+	Uncompressed samples are read and written a chunk of frames at a time, with one fread or fwrite per chunk.
+	Within a chunk, each channel is decoded from (or encoded into) the interleaved bytes by a loop
+	in which the number of bytes per sample, the byte order and (for mono and stereo) the number of channels
+	are compile-time constants, so that the compiler can unroll and vectorize it.
+	On x86_64 these loops are compiled a second time for AVX2, which is chosen at run time if the processor has it.
+
+	Integer samples are decoded by assembling the bytes into a left-justified 32-bit integer,
+	which is the sample value times 2^31 for any number of bytes;
+	this gives the same values as the earlier sample-by-sample code.
+	Encoding rounds half away from zero and clips, as before.
+
+	Floating-point samples are converted by bulk_bytesToR32 (), bulk_r32ToBytes (), bulk_bytesToR64 () and bulk_r64ToBytes ()
+	in abcio.cpp, i.e. exactly as bingetr32 (), binputr32 (), bingetr64 () and binputr64 ()
+	(and their little-endian versions) convert them on the same machine.
+*/
+constexpr integer pcm_BYTES_PER_CHUNK = 65536;
+
+#if defined (__x86_64__) && (defined (__GNUC__) || defined (__clang__))
+	#define pcm_HAVE_AVX2_DISPATCH  1
+	#define pcm_ALWAYS_INLINE  __attribute__ ((always_inline))
+#else
+	#define pcm_HAVE_AVX2_DISPATCH  0
+	#define pcm_ALWAYS_INLINE
+#endif
+
+template <int numberOfBytes, bool bigEndian>
+static inline pcm_ALWAYS_INLINE uint32 pcm_getLeftJustified (const byte *p) {
+	uint32 value = 0;
+	for (int ibyte = 0; ibyte < numberOfBytes; ibyte ++)   // from the most significant byte down
+		value |= (uint32) p [bigEndian ? ibyte : numberOfBytes - 1 - ibyte] << (24 - 8 * ibyte);
+	return value;
+}
+
+template <int numberOfBytes, bool bigEndian>
+static inline pcm_ALWAYS_INLINE void pcm_putRightJustified (uint32 value, byte *p) {
+	for (int ibyte = 0; ibyte < numberOfBytes; ibyte ++)   // from the most significant byte down
+		p [bigEndian ? ibyte : numberOfBytes - 1 - ibyte] = (byte) (value >> (8 * (numberOfBytes - 1 - ibyte)));
+}
+
+template <int numberOfBytes, bool bigEndian, bool isUnsigned, integer fixedNumberOfChannels>
+static inline pcm_ALWAYS_INLINE void pcm_decodeIntegers (const byte *bytes, integer numberOfChannels, integer n, double *out) {
+	const integer frameSize = ( fixedNumberOfChannels != 0 ? fixedNumberOfChannels : numberOfChannels ) * numberOfBytes;
+	for (integer i = 0; i < n; i ++) {
+		uint32 value = pcm_getLeftJustified <numberOfBytes, bigEndian> (bytes + i * frameSize);
+		if (isUnsigned)
+			value ^= 0x8000'0000;
+		out [i] = (int32) value * (1.0 / 32768 / 65536);
+	}
+}
+
+template <typename T, integer fixedNumberOfChannels>
+static inline pcm_ALWAYS_INLINE void pcm_decodeCompanded (const byte *bytes, integer numberOfChannels, integer n, double *out, const T *table) {
+	const integer frameSize = ( fixedNumberOfChannels != 0 ? fixedNumberOfChannels : numberOfChannels );
+	for (integer i = 0; i < n; i ++)
+		out [i] = table [bytes [i * frameSize]] * (1.0 / 32768);
+}
+
+template <integer fixedNumberOfChannels>
+static inline pcm_ALWAYS_INLINE void pcm_decodeChunk_inline (int encoding, const byte *bytes, integer numberOfFrames,
+	MAT const& buffer, integer firstSample)
+{
+	const integer numberOfChannels = buffer.nrow, bytesPerSample = Melder_bytesPerSamplePoint (encoding);
+	for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
+		const byte *channelBytes = bytes + (ichan - 1) * bytesPerSample;
+		double *out = & buffer [ichan] [firstSample];
+		constexpr integer C = fixedNumberOfChannels;
+		switch (encoding) {
+			case Melder_LINEAR_8_SIGNED: pcm_decodeIntegers <1, true, false, C> (channelBytes, numberOfChannels, numberOfFrames, out); break;
+			case Melder_LINEAR_8_UNSIGNED: pcm_decodeIntegers <1, true, true, C> (channelBytes, numberOfChannels, numberOfFrames, out); break;
+			case Melder_LINEAR_16_BIG_ENDIAN: pcm_decodeIntegers <2, true, false, C> (channelBytes, numberOfChannels, numberOfFrames, out); break;
+			case Melder_LINEAR_16_LITTLE_ENDIAN: pcm_decodeIntegers <2, false, false, C> (channelBytes, numberOfChannels, numberOfFrames, out); break;
+			case Melder_LINEAR_24_BIG_ENDIAN: pcm_decodeIntegers <3, true, false, C> (channelBytes, numberOfChannels, numberOfFrames, out); break;
+			case Melder_LINEAR_24_LITTLE_ENDIAN: pcm_decodeIntegers <3, false, false, C> (channelBytes, numberOfChannels, numberOfFrames, out); break;
+			case Melder_LINEAR_32_BIG_ENDIAN: pcm_decodeIntegers <4, true, false, C> (channelBytes, numberOfChannels, numberOfFrames, out); break;
+			case Melder_LINEAR_32_LITTLE_ENDIAN: pcm_decodeIntegers <4, false, false, C> (channelBytes, numberOfChannels, numberOfFrames, out); break;
+			case Melder_IEEE_FLOAT_32_BIG_ENDIAN: bulk_bytesToR32 (channelBytes, numberOfChannels * 4, numberOfFrames, true, out); break;
+			case Melder_IEEE_FLOAT_32_LITTLE_ENDIAN: bulk_bytesToR32 (channelBytes, numberOfChannels * 4, numberOfFrames, false, out); break;
+			case Melder_IEEE_FLOAT_64_BIG_ENDIAN: bulk_bytesToR64 (channelBytes, numberOfChannels * 8, numberOfFrames, true, out); break;
+			case Melder_IEEE_FLOAT_64_LITTLE_ENDIAN: bulk_bytesToR64 (channelBytes, numberOfChannels * 8, numberOfFrames, false, out); break;
+			case Melder_MULAW: pcm_decodeCompanded <int, C> (channelBytes, numberOfChannels, numberOfFrames, out, ulaw2linear); break;
+			case Melder_ALAW: pcm_decodeCompanded <short, C> (channelBytes, numberOfChannels, numberOfFrames, out, alaw2linear); break;
+		}
+	}
+}
+
+static inline pcm_ALWAYS_INLINE void pcm_decodeChunk_anyChannels_inline (int encoding, const byte *bytes, integer numberOfFrames,
+	MAT const& buffer, integer firstSample)
+{
+	if (buffer.nrow == 1)
+		pcm_decodeChunk_inline <1> (encoding, bytes, numberOfFrames, buffer, firstSample);
+	else if (buffer.nrow == 2)
+		pcm_decodeChunk_inline <2> (encoding, bytes, numberOfFrames, buffer, firstSample);
+	else
+		pcm_decodeChunk_inline <0> (encoding, bytes, numberOfFrames, buffer, firstSample);
+}
+
+/*
+	The integer encoders return the number of clipped samples.
+	A sample that is not a number is written as silence.
+*/
+template <int numberOfBytes, bool bigEndian, bool isUnsigned, integer fixedNumberOfChannels>
+static inline pcm_ALWAYS_INLINE integer pcm_encodeIntegers (const double *in, integer numberOfChannels, integer n, byte *bytes) {
+	const integer frameSize = ( fixedNumberOfChannels != 0 ? fixedNumberOfChannels : numberOfChannels ) * numberOfBytes;
+	integer numberOfClippedSamples = 0;
+	if (isUnsigned) {
+		for (integer i = 0; i < n; i ++) {
+			const double value = (in [i] + 1.0) * 128.0;
+			numberOfClippedSamples += ( value < 0.0 ) | ( value >= 256.0 );   // i.e. floor (value) outside 0 .. 255
+			double clipped = ( value > 255.0 ? 255.0 : value );
+			clipped = ( clipped < 0.0 ? 0.0 : clipped );
+			clipped = ( clipped == clipped ? clipped : 128.0 );
+			pcm_putRightJustified <numberOfBytes, bigEndian> ((uint32) (int32) clipped, bytes + i * frameSize);   // truncation is floor here
+		}
+	} else {
+		constexpr double scale = (double) ((int64) 1 << (8 * numberOfBytes - 1));
+		constexpr double lowest = - scale, highest = scale - 1.0;
+		for (integer i = 0; i < n; i ++) {
+			const double value = in [i] * scale;
+			numberOfClippedSamples += ( value <= lowest - 0.5 ) | ( value >= highest + 0.5 );   // i.e. round (value) outside lowest .. highest
+			double clipped = ( value > highest ? highest : value );
+			clipped = ( clipped < lowest ? lowest : clipped );
+			clipped = ( clipped == clipped ? clipped : 0.0 );
+			int32 rounded = (int32) clipped;   // towards zero...
+			const double remainder = clipped - rounded;
+			rounded += ( remainder >= 0.5 ) - ( remainder <= -0.5 );   // ...and then away from zero if that is nearer
+			pcm_putRightJustified <numberOfBytes, bigEndian> ((uint32) rounded, bytes + i * frameSize);
+		}
+	}
+	return numberOfClippedSamples;
+}
+
+template <integer fixedNumberOfChannels>
+static inline pcm_ALWAYS_INLINE integer pcm_encodeChunk_inline (int encoding, constMATVU const& buffer, integer firstSample,
+	integer numberOfFrames, byte *bytes)
+{
+	const integer numberOfChannels = buffer.nrow, bytesPerSample = Melder_bytesPerSamplePoint (encoding);
+	integer numberOfClippedSamples = 0;
+	for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
+		const double *in = & buffer [ichan] [firstSample];   // contiguous, because buffer.colStride == 1
+		byte *channelBytes = bytes + (ichan - 1) * bytesPerSample;
+		constexpr integer C = fixedNumberOfChannels;
+		switch (encoding) {
+			case Melder_LINEAR_8_SIGNED: numberOfClippedSamples += pcm_encodeIntegers <1, true, false, C> (in, numberOfChannels, numberOfFrames, channelBytes); break;
+			case Melder_LINEAR_8_UNSIGNED: numberOfClippedSamples += pcm_encodeIntegers <1, true, true, C> (in, numberOfChannels, numberOfFrames, channelBytes); break;
+			case Melder_LINEAR_16_BIG_ENDIAN: numberOfClippedSamples += pcm_encodeIntegers <2, true, false, C> (in, numberOfChannels, numberOfFrames, channelBytes); break;
+			case Melder_LINEAR_16_LITTLE_ENDIAN: numberOfClippedSamples += pcm_encodeIntegers <2, false, false, C> (in, numberOfChannels, numberOfFrames, channelBytes); break;
+			case Melder_LINEAR_24_BIG_ENDIAN: numberOfClippedSamples += pcm_encodeIntegers <3, true, false, C> (in, numberOfChannels, numberOfFrames, channelBytes); break;
+			case Melder_LINEAR_24_LITTLE_ENDIAN: numberOfClippedSamples += pcm_encodeIntegers <3, false, false, C> (in, numberOfChannels, numberOfFrames, channelBytes); break;
+			case Melder_LINEAR_32_BIG_ENDIAN: numberOfClippedSamples += pcm_encodeIntegers <4, true, false, C> (in, numberOfChannels, numberOfFrames, channelBytes); break;
+			case Melder_LINEAR_32_LITTLE_ENDIAN: numberOfClippedSamples += pcm_encodeIntegers <4, false, false, C> (in, numberOfChannels, numberOfFrames, channelBytes); break;
+			case Melder_IEEE_FLOAT_32_BIG_ENDIAN: bulk_r32ToBytes (in, numberOfFrames, true, channelBytes, numberOfChannels * 4); break;
+			case Melder_IEEE_FLOAT_32_LITTLE_ENDIAN: bulk_r32ToBytes (in, numberOfFrames, false, channelBytes, numberOfChannels * 4); break;
+			case Melder_IEEE_FLOAT_64_BIG_ENDIAN: bulk_r64ToBytes (in, numberOfFrames, true, channelBytes, numberOfChannels * 8); break;
+			case Melder_IEEE_FLOAT_64_LITTLE_ENDIAN: bulk_r64ToBytes (in, numberOfFrames, false, channelBytes, numberOfChannels * 8); break;
+		}
+	}
+	return numberOfClippedSamples;
+}
+
+static inline pcm_ALWAYS_INLINE integer pcm_encodeChunk_anyChannels_inline (int encoding, constMATVU const& buffer, integer firstSample,
+	integer numberOfFrames, byte *bytes)
+{
+	if (buffer.nrow == 1)
+		return pcm_encodeChunk_inline <1> (encoding, buffer, firstSample, numberOfFrames, bytes);
+	else if (buffer.nrow == 2)
+		return pcm_encodeChunk_inline <2> (encoding, buffer, firstSample, numberOfFrames, bytes);
+	else
+		return pcm_encodeChunk_inline <0> (encoding, buffer, firstSample, numberOfFrames, bytes);
+}
+
+static void pcm_decodeChunk_default (int encoding, const byte *bytes, integer numberOfFrames, MAT const& buffer, integer firstSample) {
+	pcm_decodeChunk_anyChannels_inline (encoding, bytes, numberOfFrames, buffer, firstSample);
+}
+static integer pcm_encodeChunk_default (int encoding, constMATVU const& buffer, integer firstSample, integer numberOfFrames, byte *bytes) {
+	return pcm_encodeChunk_anyChannels_inline (encoding, buffer, firstSample, numberOfFrames, bytes);
+}
+#if pcm_HAVE_AVX2_DISPATCH
+__attribute__ ((target ("avx2,fma")))
+static void pcm_decodeChunk_avx2 (int encoding, const byte *bytes, integer numberOfFrames, MAT const& buffer, integer firstSample) {
+	pcm_decodeChunk_anyChannels_inline (encoding, bytes, numberOfFrames, buffer, firstSample);
+}
+__attribute__ ((target ("avx2,fma")))
+static integer pcm_encodeChunk_avx2 (int encoding, constMATVU const& buffer, integer firstSample, integer numberOfFrames, byte *bytes) {
+	return pcm_encodeChunk_anyChannels_inline (encoding, buffer, firstSample, numberOfFrames, bytes);
+}
+#endif
+static bool pcm_useAvx2 () {
+	#if pcm_HAVE_AVX2_DISPATCH
+		static const bool useAvx2 = __builtin_cpu_supports ("avx2") && __builtin_cpu_supports ("fma");
+		return useAvx2;
+	#else
+		return false;
+	#endif
+}
+
+static conststring32 pcm_encodingDescription (int encoding) {
+	switch (encoding) {
+		case Melder_LINEAR_8_SIGNED: case Melder_LINEAR_8_UNSIGNED: return U"8-bit";
+		case Melder_LINEAR_16_BIG_ENDIAN: case Melder_LINEAR_16_LITTLE_ENDIAN: return U"16-bit";
+		case Melder_LINEAR_24_BIG_ENDIAN: case Melder_LINEAR_24_LITTLE_ENDIAN: return U"24-bit";
+		case Melder_LINEAR_32_BIG_ENDIAN: case Melder_LINEAR_32_LITTLE_ENDIAN: return U"32-bit";
+		case Melder_IEEE_FLOAT_32_BIG_ENDIAN: case Melder_IEEE_FLOAT_32_LITTLE_ENDIAN: return U"32-bit floating point";
+		case Melder_IEEE_FLOAT_64_BIG_ENDIAN: case Melder_IEEE_FLOAT_64_LITTLE_ENDIAN: return U"64-bit floating point";
+		case Melder_MULAW: return U"8-bit µ-law";
+		case Melder_ALAW: return U"8-bit A-law";
+		default: return U"";
+	}
+}
+
+/*
+	Read all samples of `buffer` from the interleaved frames at the current position of `f`.
+	If the file ends early, the remaining samples are set to zero, and the result is false.
+*/
+static bool pcm_readUncompressed (FILE *f, int encoding, MAT const& buffer) {
+	const integer numberOfChannels = buffer.nrow, numberOfSamples = buffer.ncol;
+	const integer frameSize = numberOfChannels * Melder_bytesPerSamplePoint (encoding);
+	const integer framesPerChunk = std::max (1_integer, pcm_BYTES_PER_CHUNK / frameSize);
+	autoBYTEVEC chunk = raw_BYTEVEC (std::min (framesPerChunk, std::max (numberOfSamples, 1_integer)) * frameSize);
+	const bool useAvx2 = pcm_useAvx2 ();
+	for (integer firstSample = 1; firstSample <= numberOfSamples; firstSample += framesPerChunk) {
+		const integer numberOfFrames = std::min (framesPerChunk, numberOfSamples - firstSample + 1);
+		const integer numberOfBytesRead = uinteger_to_integer (fread (chunk.cells, 1, integer_to_uinteger (numberOfFrames * frameSize), f));
+		const integer numberOfCompleteFramesRead = numberOfBytesRead / frameSize;
+		#if pcm_HAVE_AVX2_DISPATCH
+			if (useAvx2)
+				pcm_decodeChunk_avx2 (encoding, chunk.cells, numberOfCompleteFramesRead, buffer, firstSample);
+			else
+		#endif
+				pcm_decodeChunk_default (encoding, chunk.cells, numberOfCompleteFramesRead, buffer, firstSample);
+		if (numberOfCompleteFramesRead < numberOfFrames) {
+			/*
+				The last frame may be incomplete; keep the channels that are there.
+			*/
+			const integer firstMissingSample = firstSample + numberOfCompleteFramesRead;
+			const integer numberOfChannelsInLastFrame = (numberOfBytesRead % frameSize) / Melder_bytesPerSamplePoint (encoding);
+			if (numberOfChannelsInLastFrame > 0)
+				pcm_decodeChunk_default (encoding, chunk.cells + numberOfCompleteFramesRead * frameSize, 1, buffer, firstMissingSample);
+			buffer.part (numberOfChannelsInLastFrame + 1, numberOfChannels, firstMissingSample, firstMissingSample)  <<=  0.0;
+			buffer.part (1, numberOfChannels, firstMissingSample + 1, numberOfSamples)  <<=  0.0;
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+	Write all samples of `buffer` as interleaved frames; returns the number of clipped samples.
+*/
+static integer pcm_writeUncompressed (FILE *f, int encoding, constMATVU const& buffer) {
+	const integer numberOfChannels = buffer.nrow, numberOfSamples = buffer.ncol;
+	const integer frameSize = numberOfChannels * Melder_bytesPerSamplePoint (encoding);
+	const integer framesPerChunk = std::max (1_integer, pcm_BYTES_PER_CHUNK / frameSize);
+	autoMAT contiguousCopy;
+	constMATVU samples = buffer;
+	if (buffer.colStride != 1) {
+		contiguousCopy = copy_MAT (buffer);
+		samples = contiguousCopy.get();
+	}
+	autoBYTEVEC chunk = raw_BYTEVEC (std::min (framesPerChunk, std::max (numberOfSamples, 1_integer)) * frameSize);
+	const bool useAvx2 = pcm_useAvx2 ();
+	integer numberOfClippedSamples = 0;
+	for (integer firstSample = 1; firstSample <= numberOfSamples; firstSample += framesPerChunk) {
+		const integer numberOfFrames = std::min (framesPerChunk, numberOfSamples - firstSample + 1);
+		#if pcm_HAVE_AVX2_DISPATCH
+			if (useAvx2)
+				numberOfClippedSamples += pcm_encodeChunk_avx2 (encoding, samples, firstSample, numberOfFrames, chunk.cells);
+			else
+		#endif
+				numberOfClippedSamples += pcm_encodeChunk_default (encoding, samples, firstSample, numberOfFrames, chunk.cells);
+		const size_t numberOfBytes = integer_to_uinteger (numberOfFrames * frameSize);
+		if (fwrite (chunk.cells, 1, numberOfBytes, f) != numberOfBytes)
+			Melder_throw (U"Error in file while trying to write ", numberOfBytes, U" bytes of audio samples.");
+	}
+	return numberOfClippedSamples;
+}
+
+static bool readAudioToFloat (FILE *f, int encoding, MAT buffer, bool quiet) {
 	try {
-		integer numberOfChannels = buffer.nrow;
-		integer numberOfSamples = buffer.ncol;
 		switch (encoding) {
-			case Melder_LINEAR_8_SIGNED: {
-				try {
-					for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-						for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-							int8 value;
-							if (fread (& value, 1, 1, f) < 1) throw MelderError ();
-							buffer [ichan] [isamp] = value * (1.0 / 128);
-						}
-					}
-				} catch (MelderError) {
-					Melder_clearError ();
-					Melder_warning (U"File too small (", numberOfChannels, U"-channel 8-bit).\nMissing samples set to zero.");
-				}
-			} break;
+			case Melder_LINEAR_8_SIGNED:
 			case Melder_LINEAR_8_UNSIGNED:
-				try {
-					for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-						for (integer ichan = 1; ichan <= numberOfChannels; ichan ++)
-							buffer [ichan] [isamp] = bingetu8 (f) * (1.0 / 128) - 1.0;
-					}
-				} catch (MelderError) {
-					Melder_clearError ();
-					Melder_warning (U"File too small (", numberOfChannels, U"-channel 8-bit).\nMissing samples set to zero.");
-				}
-				break;
 			case Melder_LINEAR_16_BIG_ENDIAN:
 			case Melder_LINEAR_16_LITTLE_ENDIAN:
 			case Melder_LINEAR_24_BIG_ENDIAN:
 			case Melder_LINEAR_24_LITTLE_ENDIAN:
 			case Melder_LINEAR_32_BIG_ENDIAN:
 			case Melder_LINEAR_32_LITTLE_ENDIAN:
-			{
-				int numberOfBytesPerSamplePerChannel =
-					encoding == Melder_LINEAR_16_BIG_ENDIAN || encoding == Melder_LINEAR_16_LITTLE_ENDIAN ? 2 :
-					encoding == Melder_LINEAR_24_BIG_ENDIAN || encoding == Melder_LINEAR_24_LITTLE_ENDIAN ? 3 : 4;
-				double numberOfBytes_f = (double) numberOfChannels * (double) numberOfSamples * (double) numberOfBytesPerSamplePerChannel;
-				if (isinf (numberOfBytes_f) || numberOfBytes_f > (double) (1LL << 53)) {
-					Melder_throw (U"Cannot read ", numberOfBytes_f, U" bytes, "
-						U"because that crosses the 9-petabyte limit.");
-				}
-				if (numberOfBytes_f > (double) SIZE_MAX) {
-					Melder_throw (U"Cannot read ", numberOfBytes_f, U" bytes. "
-						U"Perhaps try a 64-bit edition of Praat?");
-				}
-				Melder_assert (numberOfBytes_f >= 0.0);
-				size_t numberOfBytes = (size_t) numberOfBytes_f;   // cast is safe because overflow and signedness have been checked
-				uint8 *bytes = (uint8 *) & buffer [numberOfChannels] [numberOfSamples] + sizeof (double) - numberOfBytes;
-				/*
-				 * Read 16-bit data into the last quarter of the buffer,
-				 * or 24-bit data into the last three-eighths of the buffer,
-				 * or 32-bit data into the last half of the buffer.
-				 */
-				size_t numberOfBytesRead = fread (bytes, 1, numberOfBytes, f);
-				if (numberOfChannels == 1) {
-					switch (encoding) {
-						case Melder_LINEAR_16_BIG_ENDIAN: {
-							for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								unsigned char byte1 = * bytes ++, byte2 = * bytes ++;
-								int value = (int) (int16) (((uint16) byte1 << 8) | (uint16) byte2);   // extend sign
-								buffer [1] [isamp] = value * (1.0 / 32768);
-							}
-						} break;
-						case Melder_LINEAR_16_LITTLE_ENDIAN: {
-							for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								unsigned char byte1 = * bytes ++, byte2 = * bytes ++;
-								int value = (int) (int16) (((uint16) byte2 << 8) | (uint16) byte1);   // extend sign
-								buffer [1] [isamp] = value * (1.0 / 32768);
-							}
-						} break;
-						case Melder_LINEAR_24_BIG_ENDIAN: {
-							for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								unsigned char byte1 = * bytes ++, byte2 = * bytes ++, byte3 = * bytes ++;
-								int32 value = (int32)
-									((uint32) ((uint32) byte1 << 24) |
-									 (uint32) ((uint32) byte2 << 16) |
-											  ((uint32) byte3 << 8));
-								buffer [1] [isamp] = value * (1.0 / 32768 / 65536);
-							}
-						} break;
-						case Melder_LINEAR_24_LITTLE_ENDIAN: {
-							for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								unsigned char byte1 = * bytes ++, byte2 = * bytes ++, byte3 = * bytes ++;
-								int32 value = (int32)
-									((uint32) ((uint32) byte3 << 24) |
-									 (uint32) ((uint32) byte2 << 16) |
-											  ((uint32) byte1 << 8));
-								buffer [1] [isamp] = value * (1.0 / 32768 / 65536);
-							}
-						} break;
-						case Melder_LINEAR_32_BIG_ENDIAN: {
-							for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								unsigned char byte1 = * bytes ++, byte2 = * bytes ++, byte3 = * bytes ++, byte4 = * bytes ++;
-								int32 value = (int32)
-									((uint32) ((uint32) byte1 << 24) |
-									 (uint32) ((uint32) byte2 << 16) |
-									 (uint32) ((uint32) byte3 << 8) |
-											   (uint32) byte4);
-								buffer [1] [isamp] = value * (1.0 / 32768 / 65536);
-							}
-						} break;
-						case Melder_LINEAR_32_LITTLE_ENDIAN: {
-							for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								unsigned char byte1 = * bytes ++, byte2 = * bytes ++, byte3 = * bytes ++, byte4 = * bytes ++;
-								int32 value = (int32)
-									((uint32) ((uint32) byte4 << 24) |
-									 (uint32) ((uint32) byte3 << 16) |
-									 (uint32) ((uint32) byte2 << 8) |
-											   (uint32) byte1);
-								buffer [1] [isamp] = value * (1.0 / 32768 / 65536);
-							}
-						} break;
-					}
-				} else if (numberOfChannels <= (int) sizeof (double) / numberOfBytesPerSamplePerChannel) {
-					switch (encoding) {
-						case Melder_LINEAR_16_BIG_ENDIAN: {
-							for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-									uint8 byte1 = * bytes ++, byte2 = * bytes ++;
-									int value = (int) (int16) (uint16) ((uint16) ((uint16) byte1 << 8) | (uint16) byte2);
-									buffer [ichan] [isamp] = value * (1.0 / 32768);
-								}
-							}
-						} break;
-						case Melder_LINEAR_16_LITTLE_ENDIAN: {
-							for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-									uint8 byte1 = * bytes ++, byte2 = * bytes ++;
-									int value = (int) (int16) (uint16) ((uint16) ((uint16) byte2 << 8) | (uint16) byte1);
-									buffer [ichan] [isamp] = value * (1.0 / 32768);
-								}
-							}
-						} break;
-						case Melder_LINEAR_24_BIG_ENDIAN: {
-							for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-									uint8 byte1 = * bytes ++, byte2 = * bytes ++, byte3 = * bytes ++;
-									uint32 unsignedValue =
-										(uint32) ((uint32) byte1 << 16) |
-										(uint32) ((uint32) byte2 << 8) |
-												  (uint32) byte3;
-									if ((byte1 & 128) != 0) unsignedValue |= 0xFF000000;   // extend sign
-									buffer [ichan] [isamp] = (int32) unsignedValue * (1.0 / 8388608);
-								}
-							}
-						} break;
-						case Melder_LINEAR_24_LITTLE_ENDIAN: {
-							for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-									uint8 byte1 = * bytes ++, byte2 = * bytes ++, byte3 = * bytes ++;
-									uint32 unsignedValue = ((uint32) byte3 << 16) | ((uint32) byte2 << 8) | (uint32) byte1;
-									if ((byte3 & 128) != 0) unsignedValue |= 0xFF000000;
-									buffer [ichan] [isamp] = (int32) unsignedValue * (1.0 / 8388608);
-								}
-							}
-						} break;
-						case Melder_LINEAR_32_BIG_ENDIAN: {
-							for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-									uint8 byte1 = * bytes ++, byte2 = * bytes ++, byte3 = * bytes ++, byte4 = * bytes ++;
-									int32 value = (int32)
-										((uint32) ((uint32) byte1 << 24) |
-										 (uint32) ((uint32) byte2 << 16) |
-										 (uint32) ((uint32) byte3 << 8) |
-												   (uint32) byte4);
-									buffer [ichan] [isamp] = value * (1.0 / 32768 / 65536);
-								}
-							}
-						} break;
-						case Melder_LINEAR_32_LITTLE_ENDIAN: {
-							for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-									uint8 byte1 = * bytes ++, byte2 = * bytes ++, byte3 = * bytes ++, byte4 = * bytes ++;
-									int32 value = (int32)
-										((uint32) ((uint32) byte4 << 24) |
-										 (uint32) ((uint32) byte3 << 16) |
-										 (uint32) ((uint32) byte2 << 8) |
-												   (uint32) byte1);
-									buffer [ichan] [isamp] = value * (1.0 / 32768 / 65536);
-								}
-							}
-						} break;
-					}
-				} else {
-					Melder_assert (sizeof (double) == 8);
-					int32 *ints = (int32 *) & buffer [1] [1];
-					switch (encoding) {
-						case Melder_LINEAR_16_BIG_ENDIAN: {
-							for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-									uint8 byte1 = * bytes ++, byte2 = * bytes ++;
-									int32 value = (int32)
-										((uint32) ((uint32) byte1 << 24) |
-										 (uint32) ((uint32) byte2 << 16));
-									* ints ++ = value;
-									* ints ++ = 0;   // the marker
-								}
-							}
-						} break;
-						case Melder_LINEAR_16_LITTLE_ENDIAN: {
-							for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-									uint8 byte1 = * bytes ++, byte2 = * bytes ++;
-									int32 value = (int32)
-										(((uint32) byte2 << 24) |
-										 ((uint32) byte1 << 16));
-									* ints ++ = value;
-									* ints ++ = 0;   // the marker
-								}
-							}
-						} break;
-						case Melder_LINEAR_24_BIG_ENDIAN: {
-							for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-									uint8 byte1 = * bytes ++, byte2 = * bytes ++, byte3 = * bytes ++;
-									int32 value = (int32)
-										(((uint32) byte1 << 24) |
-										 ((uint32) byte2 << 16) |
-										 ((uint32) byte3 << 8));
-									* ints ++ = value;
-									* ints ++ = 0;   // the marker
-								}
-							}
-						} break;
-						case Melder_LINEAR_24_LITTLE_ENDIAN: {
-							for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-									uint8 byte1 = * bytes ++, byte2 = * bytes ++, byte3 = * bytes ++;
-									int32 value = (int32)
-										(((uint32) byte3 << 24) |
-										 ((uint32) byte2 << 16) |
-										 ((uint32) byte1 << 8));
-									* ints ++ = value;
-									* ints ++ = 0;   // the marker
-								}
-							}
-						} break;
-						case Melder_LINEAR_32_BIG_ENDIAN: {
-							for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-									uint8 byte1 = * bytes ++, byte2 = * bytes ++, byte3 = * bytes ++, byte4 = * bytes ++;
-									int32 value = (int32)
-										(((uint32) byte1 << 24) |
-										 ((uint32) byte2 << 16) |
-										 ((uint32) byte3 << 8) |
-										  (uint32) byte4);
-									* ints ++ = value;
-									* ints ++ = 0;   // the marker
-								}
-							}
-						} break;
-						case Melder_LINEAR_32_LITTLE_ENDIAN: {
-							for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-								for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-									uint8 byte1 = * bytes ++, byte2 = * bytes ++, byte3 = * bytes ++, byte4 = * bytes ++;
-									int32 value = (int32)
-										(((uint32) byte4 << 24) |
-										 ((uint32) byte3 << 16) |
-										 ((uint32) byte2 << 8) |
-										  (uint32) byte1);
-									* ints ++ = value;
-									* ints ++ = 0;   // the marker
-								}
-							}
-						}
-					}
-					double *doubles = & buffer [1] [1];
-					integer n = numberOfSamples * numberOfChannels;
-					for (integer i = 0; i < n; i ++) {
-						int32 *valuePosition = (int32 *) & doubles [i];
-						int32 *markerPosition = valuePosition + 1;
-						if (! *markerPosition) {
-							int32 value = *valuePosition;
-							integer ichan = i / numberOfSamples, isamp = i % numberOfSamples;
-							for (integer other = isamp * numberOfChannels + ichan; other != i; ) {
-								int32 *otherValuePosition = (int32 *) & doubles [other];
-								*valuePosition = *otherValuePosition;
-								*markerPosition = 1;
-								valuePosition = otherValuePosition;
-								markerPosition = valuePosition + 1;
-								ichan = other / numberOfSamples, isamp = other % numberOfSamples;
-								other = isamp * numberOfChannels + ichan;
-							}
-							*valuePosition = value;
-							*markerPosition = 1;
-						}
-					}
-					for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-						for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-							buffer [ichan] [isamp] = * (int32 *) & buffer [ichan] [isamp] * (1.0 / 32768 / 65536);
-						}
-					}
-				}
-				if (numberOfBytesRead < numberOfBytes)
-					Melder_warning (U"File too small (", numberOfChannels, U"-channel ", numberOfBytesPerSamplePerChannel * 8, U"-bit).\n"
-						U"Missing samples were set to zero.");
-			} break;
 			case Melder_IEEE_FLOAT_32_BIG_ENDIAN:
-				try {
-					for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-						for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-							buffer [ichan] [isamp] = bingetr32 (f);
-						}
-					}
-				} catch (MelderError) {
-					Melder_clearError ();
-					Melder_warning (U"File too small (", numberOfChannels, U"-channel 32-bit floating point).\nMissing samples set to zero.");
-				}
-				break;
 			case Melder_IEEE_FLOAT_32_LITTLE_ENDIAN:
-				try {
-					for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-						for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-							buffer [ichan] [isamp] = bingetr32LE (f);
-						}
-					}
-				} catch (MelderError) {
-					Melder_clearError ();
-					Melder_warning (U"File too small (", numberOfChannels, U"-channel 32-bit floating point).\nMissing samples set to zero.");
-				}
-				break;
 			case Melder_IEEE_FLOAT_64_BIG_ENDIAN:
-				try {
-					for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-						for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-							buffer [ichan] [isamp] = bingetr64 (f);
-						}
-					}
-				} catch (MelderError) {
-					Melder_clearError ();
-					Melder_warning (U"File too small (", numberOfChannels, U"-channel 64-bit floating point).\nMissing samples set to zero.");
-				}
-				break;
 			case Melder_IEEE_FLOAT_64_LITTLE_ENDIAN:
-				try {
-					for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-						for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-							buffer [ichan] [isamp] = bingetr64LE (f);
-						}
-					}
-				} catch (MelderError) {
-					Melder_clearError ();
-					Melder_warning (U"File too small (", numberOfChannels, U"-channel 64-bit floating point).\nMissing samples set to zero.");
-				}
-				break;
 			case Melder_MULAW:
-				try {
-					for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-						for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-							buffer [ichan] [isamp] = ulaw2linear [bingetu8 (f)] * (1.0 / 32768);
-						}
-					}
-				} catch (MelderError) {
-					Melder_clearError ();
-					Melder_warning (U"File too small (", numberOfChannels, U"-channel 8-bit " "-law).\nMissing samples set to zero.");
-				}
-				break;
 			case Melder_ALAW:
-				try {
-					for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-						for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-							buffer [ichan] [isamp] = alaw2linear [bingetu8 (f)] * (1.0 / 32768);
-						}
-					}
-				} catch (MelderError) {
-					Melder_clearError ();
-					Melder_warning (U"File too small (", numberOfChannels, U"-channel 8-bit A-law).\nMissing samples set to zero.");
-				}
-				break;
+				if (pcm_readUncompressed (f, encoding, buffer))
+					return true;
+				if (! quiet)
+					Melder_warning (U"File too small (", buffer.nrow, U"-channel ", pcm_encodingDescription (encoding), U").\n"
+						U"Missing samples were set to zero.");
+				return false;
 			case Melder_FLAC_COMPRESSION_16:
 			case Melder_FLAC_COMPRESSION_24:
 			case Melder_FLAC_COMPRESSION_32:
-				Melder_readFlacFile (f, buffer);
-				break;
+				return Melder_readFlacFile (f, buffer, quiet);
 			case Melder_MPEG_COMPRESSION_16:
 			case Melder_MPEG_COMPRESSION_24:
 			case Melder_MPEG_COMPRESSION_32:
 				Melder_readMp3File (f, buffer);
-				break;
+				return true;
 			default:
 				Melder_throw (U"Unknown encoding ", encoding, U".");
 		}
@@ -1272,6 +1204,14 @@ void Melder_readAudioToFloat (FILE *f, int encoding, MAT buffer) {
 	}
 }
 
+void Melder_readAudioToFloat (FILE *f, int encoding, MAT buffer) {
+	(void) readAudioToFloat (f, encoding, buffer, false);
+}
+
+bool Melder_readAudioToFloat_quietly (FILE *f, int encoding, MAT buffer) {
+	return readAudioToFloat (f, encoding, buffer, true);
+}
+
 void Melder_readAudioToShort (FILE *f, integer numberOfChannels, int encoding, short *buffer, integer numberOfSamples) {
 	try {
 		integer n = numberOfSamples * numberOfChannels, i;
@@ -1445,116 +1385,18 @@ void MelderFile_writeFloatToAudio (MelderFile file, constMATVU const& buffer, in
 		integer nclipped = 0;
 		switch (encoding) {
 			case Melder_LINEAR_8_SIGNED:
-				for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-					for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-						double value = round (buffer [ichan] [isamp] * 128.0);
-						if (value < -128.0) { value = -128.0; nclipped ++; }
-						if (value > 127.0) { value = 127.0; nclipped ++; }
-						binputi8 ((int) value, f);
-					}
-				}
-				break;
 			case Melder_LINEAR_8_UNSIGNED:
-				for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-					for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-						double value = floor ((buffer [ichan] [isamp] + 1.0) * 128.0);
-						if (value < 0.0) { value = 0.0; nclipped ++; }
-						if (value > 255.0) { value = 255.0; nclipped ++; }
-						binputu8 ((int) value, f);
-					}
-				}
-				break;
 			case Melder_LINEAR_16_BIG_ENDIAN:
-				for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-					for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-						double value = round (buffer [ichan] [isamp] * 32768.0);
-						if (value < -32768.0) { value = -32768.0; nclipped ++; }
-						if (value > 32767.0) { value = 32767.0; nclipped ++; }
-						binputi16 ((int16) value, f);
-					}
-				}
-				break;
 			case Melder_LINEAR_16_LITTLE_ENDIAN:
-				for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-					for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-						double value = round (buffer [ichan] [isamp] * 32768.0);
-						if (value < -32768.0) { value = -32768.0; nclipped ++; }
-						if (value > 32767.0) { value = 32767.0; nclipped ++; }
-						binputi16LE ((int16) value, f);
-					}
-				}
-				break;
 			case Melder_LINEAR_24_BIG_ENDIAN:
-				for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-					for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-						double value = round (buffer [ichan] [isamp] * 8388608.0);
-						if (value < -8388608.0) { value = -8388608.0; nclipped ++; }
-						if (value > 8388607.0) { value = 8388607.0; nclipped ++; }
-						binputi24 ((int32) value, f);
-					}
-				}
-				break;
 			case Melder_LINEAR_24_LITTLE_ENDIAN:
-				for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-					for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-						double value = round (buffer [ichan] [isamp] * 8388608.0);
-						if (value < -8388608.0) { value = -8388608.0; nclipped ++; }
-						if (value > 8388607.0) { value = 8388607.0; nclipped ++; }
-						binputi24LE ((int32) value, f);
-					}
-				}
-				break;
 			case Melder_LINEAR_32_BIG_ENDIAN:
-				for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-					for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-						double value = round (buffer [ichan] [isamp] * 2147483648.0);
-						if (value < -2147483648.0) { value = -2147483648.0; nclipped ++; }
-						if (value > 2147483647.0) { value = 2147483647.0; nclipped ++; }
-						binputi32 ((int32) value, f);   // safe cast: rounding and range already handled
-					}
-				}
-				break;
 			case Melder_LINEAR_32_LITTLE_ENDIAN:
-				for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-					for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-						double value = round (buffer [ichan] [isamp] * 2147483648.0);
-						if (value < -2147483648.0) { value = -2147483648.0; nclipped ++; }
-						if (value > 2147483647.0) { value = 2147483647.0; nclipped ++; }
-						binputi32LE ((int32) value, f);
-					}
-				}
-				break;
 			case Melder_IEEE_FLOAT_32_BIG_ENDIAN:
-				for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-					for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-						double value = buffer [ichan] [isamp];
-						binputr32 (value, f);
-					}
-				}
-				break;
 			case Melder_IEEE_FLOAT_32_LITTLE_ENDIAN:
-				for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-					for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-						double value = buffer [ichan] [isamp];
-						binputr32LE (value, f);
-					}
-				}
-				break;
 			case Melder_IEEE_FLOAT_64_BIG_ENDIAN:
-				for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-					for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-						double value = buffer [ichan] [isamp];
-						binputr64 (value, f);
-					}
-				}
-				break;
 			case Melder_IEEE_FLOAT_64_LITTLE_ENDIAN:
-				for (integer isamp = 1; isamp <= numberOfSamples; isamp ++) {
-					for (integer ichan = 1; ichan <= numberOfChannels; ichan ++) {
-						double value = buffer [ichan] [isamp];
-						binputr64LE (value, f);
-					}
-				}
+				nclipped = pcm_writeUncompressed (f, encoding, buffer);
 				break;
 			case Melder_FLAC_COMPRESSION_16:
 			case Melder_FLAC_COMPRESSION_24:
@@ -68,6 +68,11 @@ int Melder_bytesPerSamplePoint (int encoding);
 void Melder_readAudioToFloat (FILE *f, int encoding, MAT buffer);
 /* Reads channels into buffer [ichannel], which are base-1.
  */
+bool Melder_readAudioToFloat_quietly (FILE *f, int encoding, MAT buffer);
+/* The same, but without warnings, so that it can be called from a worker thread.
+ * Returns false if Melder_readAudioToFloat would have warned
+ * (the file was too small, or the FLAC decoder reported an error).
+ */
 void Melder_readAudioToShort (FILE *f, integer numberOfChannels, int encoding, short *buffer, integer numberOfSamples);
 /* If stereo, buffer will contain alternating left and right values.
  * Buffer is base-0.
@@ -85,6 +85,9 @@ the behaviour of Praat will temporarily change in the following ways:
 54: ignore gdk_cairo_reset_clip
 55: trace Gui init, draw, destroy
 56: trace text styles
+57: MelderThread: always a single thread
+58: MelderThread: always four threads, regardless of the number of processors
+59: Pitch path finder: checkpointed backtracking, as for very long Pitch objects
 181: read and write native-endian real64
 900: use DG Meta Serif Science instead of Palatino
 1264: Mac: Sound_record_fixedTime uses microphone "FW Solo (1264)"
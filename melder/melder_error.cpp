@@ -40,7 +40,11 @@ void Melder_setCrashProc (void (*p_crashProc) (conststring32)) {
 }
 
 constexpr integer BUFFER_LENGTH = 2000;
-static char32 theErrorBuffer [BUFFER_LENGTH];   // safe in low-memory situations
+/*
+	Every thread has its own error buffer, so that a worker thread can throw and catch errors
+	without disturbing the error message of the main thread (or of other workers).
+*/
+static thread_local char32 theErrorBuffer [BUFFER_LENGTH];   // safe in low-memory situations
 
 void MelderError::_append (conststring32 message) {
 	if (! message)
@@ -508,6 +508,8 @@ FILE * Melder_fopen (MelderFile file, const char *type) {
 	Melder_32to8_fileSystem_inplace (file -> path, utf8path);
 	FILE *f;
 	file -> openForWriting = ( type [0] == 'w' || type [0] == 'a' || strchr (type, '+') );
+	if (file -> openForWriting)
+		MelderArray:: _copyMappedPayloadsOfFileIntoMemory (utf8path);   // because writing could change or truncate the file
 	if (str32equ (file -> path, U"<stdout>") && file -> openForWriting) {
 		f = stdout;
 	#ifdef CURLPRESENT
@@ -869,9 +871,9 @@ autostring32 MelderFile_readText (MelderFile file, autostring8 *string8) {
 			);
 			text8bit [length] = '\0';
 			/*
-				Count and repair null bytes.
+				Count and repair null bytes (if any: strlen () is much faster than the repair loop).
 			*/
-			if (length > 0) {
+			if (length > 0 && (int64) strlen (text8bit.get()) < length) {
 				int64 numberOfNullBytes = 0;
 				char *q = & text8bit [0];
 				for (integer i = 0; i < length; i ++)
@@ -891,51 +893,36 @@ autostring32 MelderFile_readText (MelderFile file, autostring8 *string8) {
 				text = Melder_8to32 (text8bit.get(), kMelder_textInputEncoding::UNDEFINED);
 			}
 		} else {
-			length = length / 2 - 1;   // Byte Order Mark subtracted. Length = number of UTF-16 codes
-			text = autostring32 (length + 1);
-			if (type == 1) {
-				for (int64 i = 0; i < length; i ++) {
-					const char16 kar1 = bingetu16 (f);
-					if (kar1 < 0xD800) {
-						text [i] = (const char32) kar1;   // convert up without sign extension
-					} else if (kar1 < 0xDC00) {
-						length --;
-						const char16 kar2 = bingetu16 (f);
-						if (kar2 >= 0xDC00 && kar2 <= 0xDFFF) {
-							text [i] = (const char32) (0x010000 +
-									(const char32) (((const char32) kar1 & 0x0003FF) << 10) +
-									(const char32)  ((const char32) kar2 & 0x0003FF));
-						} else {
-							text [i] = UNICODE_REPLACEMENT_CHARACTER;
-						}
-					} else if (kar1 < 0xE000) {
-						text [i] = UNICODE_REPLACEMENT_CHARACTER;
-					} else {
-						text [i] = (const char32) kar1;   // convert up without sign extension
-					}
-				}
-			} else {
-				for (int64 i = 0; i < length; i ++) {
-					const char16 kar1 = bingetu16LE (f);
-					if (kar1 < 0xD800) {
-						text [i] = (const char32) kar1;   // convert up without sign extension
-					} else if (kar1 < 0xDC00) {
-						length --;
-						const char16 kar2 = bingetu16LE (f);
-						if (kar2 >= 0xDC00 && kar2 <= 0xDFFF) {
-							text [i] = (const char32) (0x01'0000 +
-								(const char32) (((const char32) kar1 & 0x00'03FF) << 10) +
-								(const char32)  ((const char32) kar2 & 0x00'03FF));
-						} else {
-							text [i] = UNICODE_REPLACEMENT_CHARACTER;
-						}
-					} else if (kar1 < 0xE000) {
-						text [i] = UNICODE_REPLACEMENT_CHARACTER;
-					} else if (kar1 <= 0xFFFF) {
-						text [i] = (const char32) kar1;   // convert up without sign extension
-					} else {
-						Melder_fatal (U"MelderFile_readText: unsigned short greater than 0xFFFF: should not occur.");
-					}
+			/*
+				Read all the bytes at once, then decode them in memory
+				(reading two bytes at a time with bingetu16 () used to dominate the reading of large UTF-16 files).
+			*/
+			const int64 numberOfCodeUnits = length / 2 - 1;   // Byte Order Mark subtracted
+			autostring8 bytes (2 * numberOfCodeUnits);
+			const size_t numberOfBytesRead = fread_multi (bytes.get(), (size_t) (2 * numberOfCodeUnits), f);
+			Melder_require ((int64) numberOfBytesRead == 2 * numberOfCodeUnits,
+				U"The file contains ", 2 * numberOfCodeUnits, U" bytes after the byte-order mark, but we could read only ", numberOfBytesRead, U" of them.");
+			const char8 *codeUnits = (const char8 *) bytes.get();
+			const int highByte = ( type == 1 ? 0 : 1 ), lowByte = 1 - highByte;
+			auto getCodeUnit = [&] (int64 icodeUnit) -> char32 {
+				return ((char32) codeUnits [2 * icodeUnit + highByte] << 8) | (char32) codeUnits [2 * icodeUnit + lowByte];
+			};
+			text = autostring32 (numberOfCodeUnits + 1);
+			length = 0;   // the number of characters, which is less than the number of code units if there are surrogate pairs
+			for (int64 icodeUnit = 0; icodeUnit < numberOfCodeUnits; icodeUnit ++) {
+				const char32 kar1 = getCodeUnit (icodeUnit);
+				if (kar1 < 0xD800) {
+					text [length ++] = kar1;
+				} else if (kar1 < 0xDC00) {
+					const char32 kar2 = ( icodeUnit + 1 < numberOfCodeUnits ? getCodeUnit (++ icodeUnit) : 0 );
+					if (kar2 >= 0xDC00 && kar2 <= 0xDFFF)
+						text [length ++] = 0x01'0000 + ((kar1 & 0x00'03FF) << 10) + (kar2 & 0x00'03FF);
+					else
+						text [length ++] = UNICODE_REPLACEMENT_CHARACTER;
+				} else if (kar1 < 0xE000) {
+					text [length ++] = UNICODE_REPLACEMENT_CHARACTER;
+				} else {
+					text [length ++] = kar1;
 				}
 			}
 			text [length] = U'\0';
@@ -17,6 +17,7 @@
  */
 
 #include "melder.h"
+#include <thread>
 
 static void defaultProgress (double /*progress*/, conststring32 /*message*/) {
 }
@@ -30,18 +31,24 @@ int MelderProgress::_depth = 0;
 MelderProgress::ProgressProc MelderProgress::_p_progressProc = & defaultProgress;
 MelderProgress::MonitorProc MelderProgress::_p_monitorProc = & defaultMonitor;
 
+static const std::thread::id theMainThread = std::this_thread::get_id ();   // initialized at start-up
+
+bool MelderProgress::_isMainThread () {
+	return std::this_thread::get_id () == theMainThread;
+}
+
 void Melder_progressOff () { MelderProgress::_depth --; }
 void Melder_progressOn () { MelderProgress::_depth ++; }
 
 void MelderProgress::_doProgress (double progress, conststring32 message) {
-	if (! Melder_batch && MelderProgress::_depth >= 0 && Melder_debug != 14)
+	if (! Melder_batch && MelderProgress::_depth >= 0 && Melder_debug != 14 && MelderProgress::_isMainThread ())
 		MelderProgress::_p_progressProc (progress, message);
 }
 
 MelderString MelderProgress::_buffer;
 
 void * MelderProgress::_doMonitor (double progress, conststring32 message) {
-	if (! Melder_batch && MelderProgress::_depth >= 0) {
+	if (! Melder_batch && MelderProgress::_depth >= 0 && MelderProgress::_isMainThread ()) {
 		void *result = MelderProgress::_p_monitorProc (progress, message);
 		if (result)
 			return result;
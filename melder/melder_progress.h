@@ -108,6 +108,7 @@ namespace MelderProgress {
 	void _doProgress (double progress, conststring32 message);
 	void * _doMonitor (double progress, conststring32 message);
 	extern MelderString _buffer;
+	bool _isMainThread ();   // progress is shown only for work on the main thread, because it uses the GUI (and _buffer)
 }
 
 void Melder_progressOff ();
@@ -118,6 +119,8 @@ inline void Melder_progress (double progress) {
 }
 template <typename... Args>
 void Melder_progress (double progress, const MelderArg& first, Args... rest) {
+	if (! MelderProgress::_isMainThread ())
+		return;
 	MelderString_copy (& MelderProgress::_buffer, first, rest...);
 	MelderProgress::_doProgress (progress, MelderProgress::_buffer.string);
 }
@@ -136,6 +139,8 @@ inline void * Melder_monitor (double progress) {
 }
 template <typename... Args>
 void * Melder_monitor (double progress, const MelderArg& first, Args... rest) {
+	if (! MelderProgress::_isMainThread ())
+		return progress <= 0.0 ? nullptr /* no Graphics */ : (void *) -1 /* any non-null pointer */;
 	MelderString_copy (& MelderProgress::_buffer, first, rest...);
 	return MelderProgress::_doMonitor (progress, MelderProgress::_buffer.string);
 }
@@ -18,9 +18,10 @@
 
 #include "melder.h"
 #include "../kar/UnicodeData.h"
+#include <atomic>
 #define FREE_THRESHOLD_BYTES 10000LL
 
-static int64 totalNumberOfAllocations = 0, totalNumberOfDeallocations = 0, totalAllocationSize = 0, totalDeallocationSize = 0;
+static std::atomic <int64> totalNumberOfAllocations { 0 }, totalNumberOfDeallocations { 0 }, totalAllocationSize { 0 }, totalDeallocationSize { 0 };
 
 void MelderString16_free (MelderString16 *me) {
 	if (! my string) {
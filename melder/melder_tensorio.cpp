@@ -20,6 +20,45 @@
 
 /*** Typed I/O functions for vectors and matrices. ***/
 
+/*
+	The binary functions read and write their elements through `readBinaryElements_xxx` and `writeBinaryElements_xxx`.
+	For most storage types these go element by element,
+	but real numbers, which form the bulk of large files (Sounds, Spectrograms, Matrices),
+	are read and written in bulk (see `bingetr64 (FILE *, VECVU)` in abcio.cpp).
+*/
+#define ELEMENTWISE(T,storage)  \
+	static void readBinaryElements_##storage (FILE *f, const vectorview<T>& x) { \
+		for (integer i = 1; i <= x.size; i ++) \
+			x [i] = binget##storage (f); \
+	} \
+	static void writeBinaryElements_##storage (const constvectorview<T>& x, FILE *f) { \
+		for (integer i = 1; i <= x.size; i ++) \
+			binput##storage (x [i], f); \
+	}
+ELEMENTWISE (signed char, i8)
+ELEMENTWISE (int, i16)
+ELEMENTWISE (long, i32)
+ELEMENTWISE (integer, integer32BE)
+ELEMENTWISE (integer, integer16BE)
+ELEMENTWISE (unsigned char, u8)
+ELEMENTWISE (unsigned int, u16)
+ELEMENTWISE (unsigned long, u32)
+ELEMENTWISE (dcomplex, c64)
+ELEMENTWISE (dcomplex, c128)
+ELEMENTWISE (bool, eb)
+#undef ELEMENTWISE
+
+#define BULK(storage)  \
+	static void readBinaryElements_##storage (FILE *f, const VECVU& x) { \
+		binget##storage (f, x); \
+	} \
+	static void writeBinaryElements_##storage (const constVECVU& x, FILE *f) { \
+		binput##storage (x, f); \
+	}
+BULK (r32)
+BULK (r64)
+#undef BULK
+
 #define FUNCTION(T,storage)  \
 	void vector_writeText_##storage (const constvector<T>& vec, MelderFile file, conststring32 name) { \
 		texputintro (file, name, U" []: ", vec.size >= 1 ? nullptr : U"(empty)", 0,0,0); \
@@ -29,8 +68,7 @@
 		if (feof (file -> filePointer) || ferror (file -> filePointer)) Melder_throw (U"Write error."); \
 	} \
 	void vector_writeBinary_##storage (const constvector<T>& vec, FILE *f) { \
-		for (integer i = 1; i <= vec.size; i ++) \
-			binput##storage (vec [i], f); \
+		writeBinaryElements_##storage (vec, f); \
 		if (feof (f) || ferror (f)) Melder_throw (U"Write error."); \
 	} \
 	autovector<T> vector_readText_##storage (integer size, MelderReadText text, const char *name) { \
@@ -45,10 +83,8 @@
 		return result; \
 	} \
 	autovector<T> vector_readBinary_##storage (integer size, FILE *f) { \
-		autovector<T> result = newvectorzero<T> (size); \
-		for (integer i = 1; i <= size; i ++) { \
-			result [i] = binget##storage (f); \
-		} \
+		autovector<T> result = newvectorraw<T> (size); \
+		readBinaryElements_##storage (f, result.all()); \
 		return result; \
 	} \
 	void matrix_writeText_##storage (const constmatrix<T>& mat, MelderFile file, conststring32 name) { \
@@ -64,10 +100,7 @@
 		if (feof (file -> filePointer) || ferror (file -> filePointer)) Melder_throw (U"Write error."); \
 	} \
 	void matrix_writeBinary_##storage (const constmatrix<T>& mat, FILE *f) { \
-		for (integer irow = 1; irow <= mat.nrow; irow ++) { \
-			for (integer icol = 1; icol <= mat.ncol; icol ++) \
-				binput##storage (mat [irow] [icol], f); \
-		} \
+		writeBinaryElements_##storage (mat.asvector(), f); \
 		if (feof (f) || ferror (f)) Melder_throw (U"Write error."); \
 	} \
 	automatrix<T> matrix_readText_##storage (integer nrow, integer ncol, MelderReadText text, const char *name) { \
@@ -82,9 +115,8 @@
 		return result; \
 	} \
 	automatrix<T> matrix_readBinary_##storage (integer nrow, integer ncol, FILE *f) { \
-		automatrix<T> result = newmatrixzero<T> (nrow, ncol); \
-		for (integer irow = 1; irow <= nrow; irow ++) for (integer icol = 1; icol <= ncol; icol ++) \
-			result [irow] [icol] = binget##storage (f); \
+		automatrix<T> result = newmatrixraw<T> (nrow, ncol); \
+		readBinaryElements_##storage (f, vectorview<T> (result.cells, nrow * ncol, 1)); \
 		return result; \
 	} \
 	void tensor3_writeText_##storage (const consttensor3<T>& ten3, MelderFile file, conststring32 name) { \
@@ -103,13 +135,9 @@
 		if (feof (file -> filePointer) || ferror (file -> filePointer)) Melder_throw (U"Write error."); \
 	} \
 	void tensor3_writeBinary_##storage (const consttensor3<T>& ten3, FILE *f) { \
-		for (integer idim1 = 1; idim1 <= ten3.ndim1; idim1 ++) { \
-			for (integer idim2 = 1; idim2 <= ten3.ndim2; idim2 ++) { \
-				for (integer idim3 = 1; idim3 <= ten3.ndim3; idim3 ++) { \
-					binput##storage (ten3 [idim1] [idim2] [idim3], f); \
-				} \
-			} \
-		} \
+		for (integer idim1 = 1; idim1 <= ten3.ndim1; idim1 ++) \
+			for (integer idim2 = 1; idim2 <= ten3.ndim2; idim2 ++) \
+				writeBinaryElements_##storage (ten3 [idim1] [idim2], f); \
 		if (feof (f) || ferror (f)) Melder_throw (U"Write error."); \
 	} \
 	autotensor3<T> tensor3_readText_##storage (integer ndim1, integer ndim2, integer ndim3, MelderReadText text, const char *name) { \
@@ -128,14 +156,8 @@
 		return result; \
 	} \
 	autotensor3<T> tensor3_readBinary_##storage (integer ndim1, integer ndim2, integer ndim3, FILE *f) { \
-		autotensor3<T> result = newtensor3zero<T> (ndim1, ndim2, ndim3); \
-		for (integer idim1 = 1; idim1 <= result.ndim1; idim1 ++) { \
-			for (integer idim2 = 1; idim2 <= result.ndim2; idim2 ++) { \
-				for (integer idim3 = 1; idim3 <= result.ndim3; idim3 ++) { \
-					result [idim1] [idim2] [idim3] = binget##storage (f); \
-				} \
-			} \
-		} \
+		autotensor3<T> result = newtensor3raw<T> (ndim1, ndim2, ndim3); \
+		readBinaryElements_##storage (f, vectorview<T> (result.cells, ndim1 * ndim2 * ndim3, 1)); \
 		return result; \
 	}
 
@@ -109,9 +109,12 @@ bool Melder_str8IsValidUtf8 (const char *string) {
 }
 
 integer Melder_killReturns_inplace (char *text) {
+	char *firstReturn = strchr (text, 13);
+	if (! firstReturn)
+		return (integer) strlen (text);   // the usual case outside Windows: nothing to do
 	const char *from;
 	char *to;
-	for (from = text, to = text; *from != '\0'; from ++, to ++) {
+	for (from = firstReturn, to = firstReturn; *from != '\0'; from ++, to ++) {
 		if (*from == 13) {   // carriage return?
 			if (from [1] == '\n') {   // followed by linefeed? Must be a Windows text
 				from ++;   // ignore carriage return
@@ -52,6 +52,7 @@ Thing_define (Daata, Thing) {
 	virtual void v1_writeBinary (FILE * /* f */) { }
 	virtual void v1_readBinary (FILE * /* f */, int /* formatVersion */) { }
 	virtual void v_repair () { }   // after reading Praat data files created by others
+	virtual void v_invalidateAllDerivedDataCaches () { }   // after the data have been changed in place from outside, e.g. in an editor
 	// methods for scripting:
 	virtual bool v_hasGetNrow      () const { return false; }   virtual double        v_getNrow      ()                                       const { return undefined; }
 	virtual bool v_hasGetNcol      () const { return false; }   virtual double        v_getNcol      ()                                       const { return undefined; }
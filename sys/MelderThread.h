@@ -21,6 +21,7 @@
 #include <vector>
 #include "Thing.h"
 #include <thread>
+#include <exception>
 
 inline integer MelderThread_getNumberOfProcessors () {
 	return uinteger_to_integer (std::thread::hardware_concurrency ());
@@ -47,5 +48,76 @@ template <class T> void MelderThread_run (void (*func) (T *), autoSomeThing <T>
 	}
 }
 
+/*
+	For loops over independent elements (frames, channels, rows of a matrix, replicates...).
+	The number of threads is limited by the number of processors,
+	and by the requirement that each thread should get at least `minimumNumberOfElementsPerThread` elements,
+	so that small problems stay single-threaded.
+	For testing that results do not depend on the number of threads,
+	Melder_debug 57 forces a single thread, and Melder_debug 58 forces four threads (if there are at least four elements),
+	regardless of the number of processors.
+*/
+inline integer MelderThread_getNumberOfThreadsToUse (integer numberOfElements, integer minimumNumberOfElementsPerThread) {
+	Melder_assert (minimumNumberOfElementsPerThread >= 1);
+	if (Melder_debug == 57)
+		return 1;
+	if (Melder_debug == 58)
+		return Melder_clipped (1_integer, numberOfElements, 4_integer);
+	integer numberOfThreads = numberOfElements / minimumNumberOfElementsPerThread;
+	Melder_clipRight (& numberOfThreads, MelderThread_getNumberOfProcessors ());
+	Melder_clip (1_integer, & numberOfThreads, 16_integer);
+	return numberOfThreads;
+}
+
+/*
+	Calls func (threadNumber, firstElement, lastElement) for `numberOfThreads` consecutive chunks of 1 .. numberOfElements,
+	the last chunk in the calling thread. The threads are numbered from 1, so that callers
+	can preallocate per-thread buffers in the calling thread, instead of allocating inside the loops.
+	Allocating in a worker thread is allowed, though: the allocation statistics of melder_alloc.cpp
+	and melder_strings.cpp are atomic.
+	If a thread throws, the exception is rethrown in the calling thread after all threads have finished;
+	since every thread has its own error buffer, the message of a MelderError is carried over to the calling thread.
+*/
+template <typename Func> void MelderThread_runChunks (integer numberOfThreads, integer numberOfElements, Func const& func) {
+	Melder_assert (numberOfThreads >= 1);
+	if (numberOfElements <= 0)
+		return;
+	Melder_clipRight (& numberOfThreads, numberOfElements);
+	if (numberOfThreads == 1) {
+		func (1_integer, 1_integer, numberOfElements);
+		return;
+	}
+	const integer numberOfElementsPerThread = (numberOfElements - 1) / numberOfThreads + 1;
+	std::vector <std::exception_ptr> exceptions (integer_to_uinteger (numberOfThreads));
+	std::vector <autostring32> errorMessages (integer_to_uinteger (numberOfThreads));
+	const auto runChunk = [&] (integer ithread) {
+		const integer firstElement = 1 + (ithread - 1) * numberOfElementsPerThread;
+		const integer lastElement = std::min (ithread * numberOfElementsPerThread, numberOfElements);
+		try {
+			if (firstElement <= lastElement)
+				func (ithread, firstElement, lastElement);
+		} catch (MelderError) {
+			errorMessages [integer_to_uinteger (ithread - 1)] = Melder_dup (Melder_getError ());
+			Melder_clearError ();
+			exceptions [integer_to_uinteger (ithread - 1)] = std::current_exception ();
+		} catch (...) {
+			exceptions [integer_to_uinteger (ithread - 1)] = std::current_exception ();
+		}
+	};
+	std::vector <std::thread> thread (integer_to_uinteger (numberOfThreads - 1));
+	for (integer ithread = 1; ithread < numberOfThreads; ithread ++)
+		thread [integer_to_uinteger (ithread - 1)] = std::thread (runChunk, ithread);
+	runChunk (numberOfThreads);
+	for (std::thread& t : thread)
+		t. join ();
+	for (uinteger ithread = 0; ithread < exceptions.size (); ithread ++) {
+		if (exceptions [ithread]) {
+			if (errorMessages [ithread])
+				Melder_appendError_noLine (errorMessages [ithread].get());
+			std::rethrow_exception (exceptions [ithread]);
+		}
+	}
+}
+
 /* End of file MelderThread.h */
 #endif
@@ -20,7 +20,7 @@
 #include <time.h>
 #include "Thing.h"
 
-integer theTotalNumberOfThings;
+std::atomic <integer> theTotalNumberOfThings { 0 };
 
 void structThing :: v1_info () {
 	MelderInfo_writeLine (U"Object type: ", Thing_className (this));
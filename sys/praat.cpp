@@ -652,6 +652,11 @@ static void cb_Editor_dataChanged (Editor me) {
 		for (int ieditor = 0; ieditor < praat_MAXNUM_EDITORS; ieditor ++)
 			editingThisObject |= ( theCurrentPraatObjects -> list [iobject]. editors [ieditor] == me );
 		if (editingThisObject) {
+			/*
+				The editor (e.g. an Inspect window) may have changed the data in place,
+				so the object should forget what it derived from them (e.g. the index of an IntervalTier).
+			*/
+			theCurrentPraatObjects -> list [iobject]. object -> v_invalidateAllDerivedDataCaches ();
 			/*
 				Notify all editors associated with this object, *including myself*.
 				But the receiver will be able to check whether the notification comes from self or not;